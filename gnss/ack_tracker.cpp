@@ -0,0 +1,63 @@
+#include "ack_tracker.hpp"
+
+namespace wibot::protocal::gnss {
+
+AckTracker::AckTracker(uint32_t timeout, AckCallback callback, void* context)
+    : _timeout(timeout), _callback(callback), _context(context) {
+    reset();
+};
+
+void AckTracker::reset() {
+    _count   = 0;
+    acked    = 0;
+    naked    = 0;
+    timeouts = 0;
+};
+
+bool AckTracker::sent(uint16_t classId, uint32_t tag, uint32_t now) {
+    if (_count >= ACK_TRACKER_MAX_PENDING) {
+        return false;
+    }
+    _requests[_count++] = {.classId = classId, .tag = tag, .sentAt = now};
+    return true;
+};
+
+void AckTracker::_remove(uint32_t index, ACK_RESULT result) {
+    uint32_t tag = _requests[index].tag;
+    for (uint32_t i = index + 1; i < _count; i++) {
+        _requests[i - 1] = _requests[i];
+    }
+    _count--;
+    if (_callback != nullptr) {
+        _callback(_context, tag, result);
+    }
+};
+
+bool AckTracker::resolve(uint16_t classId, bool ack) {
+    for (uint32_t i = 0; i < _count; i++) {
+        if (_requests[i].classId == classId) {
+            if (ack) {
+                acked++;
+                _remove(i, ACK_RESULT::ACK);
+            } else {
+                naked++;
+                _remove(i, ACK_RESULT::NAK);
+            }
+            return true;
+        }
+    }
+    return false;
+};
+
+uint32_t AckTracker::expire(uint32_t now) {
+    uint32_t expired = 0;
+    // Sent in order, so the oldest times out first.
+    while (_count > 0 && now - _requests[0].sentAt >= _timeout) {
+        timeouts++;
+        expired++;
+        _remove(0, ACK_RESULT::TIMEOUT);
+    }
+    return expired;
+};
+
+}  // namespace wibot::protocal::gnss
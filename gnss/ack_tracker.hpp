@@ -0,0 +1,79 @@
+#ifndef __WWTALK_GNSS_ACK_TRACKER_HPP__
+#define __WWTALK_GNSS_ACK_TRACKER_HPP__
+#include "base.hpp"
+namespace wibot::protocal::gnss {
+
+#define ACK_TRACKER_MAX_PENDING 8
+
+enum class ACK_RESULT : uint8_t {
+    ACK = 0,
+    NAK,
+    TIMEOUT,
+};
+
+typedef void (*AckCallback)(void* context, uint32_t tag, ACK_RESULT result);
+
+/**
+ * Track the requests in flight until the receiver acknowledges them, so several can be sent
+ * without waiting. UBX and CASIC answers only carry the class and id of the request, and the
+ * receiver answers in order, so an answer resolves the oldest pending request of its class
+ * and id.
+ */
+class AckTracker {
+   public:
+    /**
+     * @param timeout In the unit of now, e.g. ms.
+     */
+    AckTracker(uint32_t timeout, AckCallback callback, void* context);
+
+    /**
+     * Record a request just sent.
+     * @param tag Passed back to the callback.
+     * @return Return false if ACK_TRACKER_MAX_PENDING requests are already in flight.
+     */
+    bool sent(uint16_t classId, uint32_t tag, uint32_t now);
+
+    /**
+     * Resolve the oldest pending request of classId.
+     * @return Return false if no request of classId is pending.
+     */
+    bool resolve(uint16_t classId, bool ack);
+
+    /**
+     * Time out the requests sent timeout or more before now.
+     * @return Return the number of requests timed out.
+     */
+    uint32_t expire(uint32_t now);
+
+    /**
+     * Drop all pending requests without calling the callback.
+     */
+    void reset();
+
+    inline uint32_t pending() const {
+        return _count;
+    };
+
+    uint32_t acked;
+    uint32_t naked;
+    uint32_t timeouts;
+
+   private:
+    struct Request {
+        uint16_t classId;
+        uint32_t tag;
+        uint32_t sentAt;
+    };
+
+    uint32_t       _timeout;
+    AckCallback    _callback;
+    void*          _context;
+    struct Request _requests[ACK_TRACKER_MAX_PENDING];  // oldest first.
+    uint32_t       _count;
+
+    void _remove(uint32_t index, ACK_RESULT result);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_ACK_TRACKER_HPP__
@@ -1,24 +1,82 @@
 #include "casic.hpp"
 
 namespace wibot::protocal::gnss {
-static inline bool checksum(uint8_t* msg, uint32_t length) {
-    uint32_t* p        = (uint32_t*)(msg + 2);
-    uint32_t  l        = (length - 6) / 4;
-    uint32_t  checksum = 0;
-    for (uint32_t i = 0; i < l; i++) {
-        checksum += *p++;
+
+void CasicChecksum::update(const uint8_t* data, uint32_t length) {
+    uint32_t i = 0;
+    for (; i < length && phase != 0; i++) {
+        update(data[i]);
+    }
+    uint32_t s = sum;
+    for (; i + 4 <= length; i += 4) {
+        s += gnss_u4(data + i);
     }
-    return checksum == *p;
-}
+    sum = s;
+    for (; i < length; i++) {
+        update(data[i]);
+    }
+};
+
+bool CasicNavPvView::validate(const uint8_t*, uint16_t length) {
+    return length == 80;
+};
+
+bool CasicNavTimeUtcView::validate(const uint8_t*, uint16_t length) {
+    return length == 24;
+};
+
+bool CasicNavSvInfoView::validate(const uint8_t* payload, uint16_t length) {
+    return length >= 8 && length == 8 + 12 * payload[4];
+};
+
+bool CasicRxmMeasxView::validate(const uint8_t* payload, uint16_t length) {
+    return length >= 16 && length == 16 + 32 * payload[11];
+};
 
 bool casic_parse(uint8_t* msg, uint32_t length, uint16_t* classId, void** payload) {
-    if (!checksum(msg, length)) {
+    if (length < CASIC_FRAME_OVERHEAD) {
         return false;
     }
-    msg += 4;
-    *classId = *(uint16_t*)msg;
-    msg += 2;
-    *payload = msg;
+    if (msg[0] != CASIC_SYNC_CHAR_1 || msg[1] != CASIC_SYNC_CHAR_2) {
+        return false;
+    }
+    uint32_t payloadLength = gnss_u2(msg + 2);
+    if (payloadLength + CASIC_FRAME_OVERHEAD != length || (payloadLength & 0x03) != 0) {
+        return false;
+    }
+
+    CasicChecksum checksum;
+    checksum.reset();
+    checksum.update(msg + 2, length - 6);
+    if (checksum.sum != gnss_u4(msg + length - 4)) {
+        return false;
+    }
+    *classId = CASIC_CLASSID(msg[4], msg[5]);
+    *payload = msg + CASIC_HEADER_SIZE;
     return true;
 };
+
+uint32_t casic_encode(uint8_t* buffer, uint32_t size, uint16_t classId, const uint8_t* payload,
+                      uint16_t length) {
+    if (size < (uint32_t)length + CASIC_FRAME_OVERHEAD || (length & 0x03) != 0) {
+        return 0;
+    }
+    buffer[0] = CASIC_SYNC_CHAR_1;
+    buffer[1] = CASIC_SYNC_CHAR_2;
+    buffer[2] = length & 0xFF;
+    buffer[3] = length >> 8;
+    buffer[4] = classId & 0xFF;
+    buffer[5] = classId >> 8;
+    if (payload != buffer + CASIC_HEADER_SIZE) {
+        memmove(buffer + CASIC_HEADER_SIZE, payload, length);
+    }
+
+    CasicChecksum checksum;
+    checksum.reset();
+    checksum.update(buffer + 2, length + 4);
+    for (uint32_t i = 0; i < 4; i++) {
+        buffer[CASIC_HEADER_SIZE + length + i] = checksum.sum >> (8 * i);
+    }
+    return length + CASIC_FRAME_OVERHEAD;
+};
 }  // namespace wibot::protocal::gnss
@@ -1,7 +1,31 @@
 #ifndef __WWTALK_GNSS_CASIC_HPP__
 #define __WWTALK_GNSS_CASIC_HPP__
 #include "base.hpp"
+#include "gnss_bytes.hpp"
 namespace wibot::protocal::gnss {
+
+#define CASIC_SYNC_CHAR_1 0xBA
+#define CASIC_SYNC_CHAR_2 0xCE
+#define CASIC_HEADER_SIZE 6  // sync chars, length, class and id.
+#define CASIC_FRAME_OVERHEAD 10
+
+/**
+ * Class in the low byte and id in the high byte, as UBX_CLASSID.
+ */
+#define CASIC_CLASSID(cls, id) ((uint16_t)((cls) | ((id) << 8)))
+
+#define CASIC_CLASSID_NAV_PV CASIC_CLASSID(0x01, 0x03)
+#define CASIC_CLASSID_NAV_TIMEUTC CASIC_CLASSID(0x01, 0x10)
+#define CASIC_CLASSID_NAV_GPSINFO CASIC_CLASSID(0x01, 0x20)
+#define CASIC_CLASSID_NAV_BDSINFO CASIC_CLASSID(0x01, 0x21)
+#define CASIC_CLASSID_RXM_MEASX CASIC_CLASSID(0x03, 0x10)
+#define CASIC_CLASSID_ACK_NACK CASIC_CLASSID(0x05, 0x00)
+#define CASIC_CLASSID_ACK_ACK CASIC_CLASSID(0x05, 0x01)
+#define CASIC_CLASSID_CFG_PRT CASIC_CLASSID(0x06, 0x00)
+#define CASIC_CLASSID_CFG_MSG CASIC_CLASSID(0x06, 0x01)
+#define CASIC_CLASSID_CFG_RATE CASIC_CLASSID(0x06, 0x04)
+#define CASIC_CLASSID_CFG_NAVX CASIC_CLASSID(0x06, 0x07)
+
 struct CasicFrameNavPv {
     uint32_t runTime;
     uint8_t  posValid;
@@ -29,7 +53,162 @@ struct CasicFrameNavPv {
     float    cAcc;
 } PACKED;
 
+/**
+ * Sum of the little-endian words from the length field to the end of the payload, updated as
+ * bytes arrive. A byte adds at its position in its word, so the sum does not depend on how the
+ * bytes are split or aligned.
+ */
+struct CasicChecksum {
+    uint32_t sum;
+    uint8_t  phase;  // position of the next byte in its word.
+
+    inline void reset() {
+        sum   = 0;
+        phase = 0;
+    };
+    inline void update(uint8_t data) {
+        sum += (uint32_t)data << (8 * phase);
+        phase = (phase + 1) & 0x03;
+    };
+    void update(const uint8_t* data, uint32_t length);
+};
+
+/**
+ * Views of payloads, read in place whatever their alignment, as the UBX views. validate checks
+ * the payload length against the length the message declares.
+ */
+class CasicNavPvView {
+   public:
+    explicit CasicNavPvView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t runTime() const { return gnss_u4(_p + 0); };  // ms
+    uint8_t  posValid() const { return gnss_u1(_p + 4); };
+    uint8_t  velValid() const { return gnss_u1(_p + 5); };
+    uint8_t  system() const { return gnss_u1(_p + 6); };
+    uint8_t  numSV() const { return gnss_u1(_p + 7); };
+    uint8_t  numSVGPS() const { return gnss_u1(_p + 8); };
+    uint8_t  numSVBDS() const { return gnss_u1(_p + 9); };
+    uint8_t  numSVGLN() const { return gnss_u1(_p + 10); };
+    float    pDop() const { return gnss_r4(_p + 12); };
+    double   lon() const { return gnss_r8(_p + 16); };  // deg
+    double   lat() const { return gnss_r8(_p + 24); };
+    float    height() const { return gnss_r4(_p + 32); };  // m
+    float    sepGeoid() const { return gnss_r4(_p + 36); };
+    float    hAcc() const { return gnss_r4(_p + 40); };
+    float    vAcc() const { return gnss_r4(_p + 44); };
+    float    velN() const { return gnss_r4(_p + 48); };  // m/s
+    float    velE() const { return gnss_r4(_p + 52); };
+    float    velU() const { return gnss_r4(_p + 56); };
+    float    speed3D() const { return gnss_r4(_p + 60); };
+    float    speed2D() const { return gnss_r4(_p + 64); };
+    float    heading() const { return gnss_r4(_p + 68); };  // deg
+    float    sAcc() const { return gnss_r4(_p + 72); };
+    float    cAcc() const { return gnss_r4(_p + 76); };
+
+   private:
+    const uint8_t* _p;
+};
+
+class CasicNavTimeUtcView {
+   public:
+    explicit CasicNavTimeUtcView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t runTime() const { return gnss_u4(_p + 0); };
+    float    tAcc() const { return gnss_r4(_p + 4); };   // s
+    float    msErr() const { return gnss_r4(_p + 8); };  // ms
+    uint16_t ms() const { return gnss_u2(_p + 12); };
+    uint16_t year() const { return gnss_u2(_p + 14); };
+    uint8_t  month() const { return gnss_u1(_p + 16); };
+    uint8_t  day() const { return gnss_u1(_p + 17); };
+    uint8_t  hour() const { return gnss_u1(_p + 18); };
+    uint8_t  min() const { return gnss_u1(_p + 19); };
+    uint8_t  sec() const { return gnss_u1(_p + 20); };
+    uint8_t  valid() const { return gnss_u1(_p + 21); };
+    uint8_t  timeSrc() const { return gnss_u1(_p + 22); };
+    uint8_t  dateValid() const { return gnss_u1(_p + 23); };
+
+   private:
+    const uint8_t* _p;
+};
+
+/**
+ * NAV-GPSINFO and NAV-BDSINFO, 8 bytes then 12 per satellite.
+ */
+class CasicNavSvInfoView {
+   public:
+    explicit CasicNavSvInfoView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t runTime() const { return gnss_u4(_p + 0); };
+    uint8_t  numViewSv() const { return gnss_u1(_p + 4); };
+    uint8_t  numFixSv() const { return gnss_u1(_p + 5); };
+    uint8_t  system() const { return gnss_u1(_p + 6); };
+
+    uint8_t  chn(uint32_t i) const { return gnss_u1(_sv(i) + 0); };
+    uint8_t  svid(uint32_t i) const { return gnss_u1(_sv(i) + 1); };
+    uint8_t  flags(uint32_t i) const { return gnss_u1(_sv(i) + 2); };
+    uint8_t  quality(uint32_t i) const { return gnss_u1(_sv(i) + 3); };
+    uint8_t  cn0(uint32_t i) const { return gnss_u1(_sv(i) + 4); };    // dBHz
+    int8_t   elev(uint32_t i) const { return gnss_i1(_sv(i) + 5); };   // deg
+    int16_t  azim(uint32_t i) const { return gnss_i2(_sv(i) + 6); };   // deg
+    float    prRes(uint32_t i) const { return gnss_r4(_sv(i) + 8); };  // m
+
+   private:
+    const uint8_t* _p;
+
+    inline const uint8_t* _sv(uint32_t i) const {
+        return _p + 8 + 12 * i;
+    };
+};
+
+/**
+ * RXM-MEASX, 16 bytes then 32 per measurement.
+ */
+class CasicRxmMeasxView {
+   public:
+    explicit CasicRxmMeasxView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    double   rcvTow() const { return gnss_r8(_p + 0); };  // s
+    uint16_t week() const { return gnss_u2(_p + 8); };
+    int8_t   leapS() const { return gnss_i1(_p + 10); };
+    uint8_t  numMeas() const { return gnss_u1(_p + 11); };
+    uint8_t  recStat() const { return gnss_u1(_p + 12); };
+
+    double   prMes(uint32_t i) const { return gnss_r8(_meas(i) + 0); };  // m
+    double   cpMes(uint32_t i) const { return gnss_r8(_meas(i) + 8); };  // cycles
+    float    doMes(uint32_t i) const { return gnss_r4(_meas(i) + 16); };  // Hz
+    uint8_t  gnssId(uint32_t i) const { return gnss_u1(_meas(i) + 20); };
+    uint8_t  svId(uint32_t i) const { return gnss_u1(_meas(i) + 21); };
+    uint8_t  freqId(uint32_t i) const { return gnss_u1(_meas(i) + 23); };
+    uint16_t lockTime(uint32_t i) const { return gnss_u2(_meas(i) + 24); };  // ms
+    uint8_t  cn0(uint32_t i) const { return gnss_u1(_meas(i) + 26); };
+    uint8_t  prStdev(uint32_t i) const { return gnss_u1(_meas(i) + 27); };
+    uint8_t  cpStdev(uint32_t i) const { return gnss_u1(_meas(i) + 28); };
+    uint8_t  doStdev(uint32_t i) const { return gnss_u1(_meas(i) + 29); };
+    uint8_t  trkStat(uint32_t i) const { return gnss_u1(_meas(i) + 30); };
+
+   private:
+    const uint8_t* _p;
+
+    inline const uint8_t* _meas(uint32_t i) const {
+        return _p + 16 + 32 * i;
+    };
+};
+
+/**
+ * Check a complete frame, including the sync chars, the length field and the checksum.
+ */
 bool casic_parse(uint8_t* msg, uint32_t length, uint16_t* classId, void** payload);
+
+/**
+ * Write a frame of classId into buffer, as ubx_encode. length must be a multiple of 4.
+ * @return Return the frame length, 0 if the buffer is too small.
+ */
+uint32_t casic_encode(uint8_t* buffer, uint32_t size, uint16_t classId, const uint8_t* payload,
+                      uint16_t length);
 }  // namespace wibot::protocal::gnss
 
 #endif  // __WWTALK_GNSS_CASIC_HPP__
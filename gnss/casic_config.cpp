@@ -0,0 +1,189 @@
+#include "casic_config.hpp"
+
+#include "nmea_encoder.hpp"
+#include "string.h"
+
+namespace wibot::protocal::gnss {
+
+static inline void casic_put(uint8_t* p, uint32_t value, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+        p[i] = value >> (8 * i);
+    }
+};
+
+static inline void casic_put_r4(uint8_t* p, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    casic_put(p, bits, 4);
+};
+
+CasicConfigEncoder::CasicConfigEncoder() {
+    begin(nullptr, 0);
+};
+
+void CasicConfigEncoder::begin(uint8_t* buffer, uint32_t size) {
+    _buffer      = buffer;
+    _size        = size;
+    _length      = 0;
+    commandCount = 0;
+};
+
+bool CasicConfigEncoder::_frame(uint16_t classId, const uint8_t* payload, uint16_t length) {
+    uint32_t written = casic_encode(_buffer + _length, _size - _length, classId, payload, length);
+    if (written == 0) {
+        return false;
+    }
+    _length += written;
+    commandCount++;
+    return true;
+};
+
+bool CasicConfigEncoder::cfg_prt(uint8_t portId, uint8_t protoMask, uint16_t mode,
+                                 uint32_t baudRate) {
+    uint8_t payload[8];
+    payload[0] = portId;
+    payload[1] = protoMask;
+    casic_put(payload + 2, mode, 2);
+    casic_put(payload + 4, baudRate, 4);
+    return _frame(CASIC_CLASSID_CFG_PRT, payload, sizeof(payload));
+};
+
+bool CasicConfigEncoder::cfg_msg(uint16_t classId, uint16_t rate) {
+    uint8_t payload[4];
+    casic_put(payload, classId, 2);
+    casic_put(payload + 2, rate, 2);
+    return _frame(CASIC_CLASSID_CFG_MSG, payload, sizeof(payload));
+};
+
+bool CasicConfigEncoder::cfg_rate(uint16_t interval) {
+    uint8_t payload[4];
+    casic_put(payload, interval, 2);
+    casic_put(payload + 2, 0, 2);
+    return _frame(CASIC_CLASSID_CFG_RATE, payload, sizeof(payload));
+};
+
+bool CasicConfigEncoder::cfg_navx(const struct CasicCfgNavx* navx) {
+    uint8_t payload[44];
+    casic_put(payload, navx->mask, 4);
+    payload[4]  = navx->dyModel;
+    payload[5]  = navx->fixMode;
+    payload[6]  = navx->minSVs;
+    payload[7]  = navx->maxSVs;
+    payload[8]  = navx->minCNO;
+    payload[9]  = 0;
+    payload[10] = navx->iniFix3D;
+    payload[11] = (uint8_t)navx->minElev;
+    payload[12] = navx->drLimit;
+    payload[13] = navx->navSystem;
+    casic_put(payload + 14, navx->wnRollOver, 2);
+    casic_put_r4(payload + 16, navx->fixedAlt);
+    casic_put_r4(payload + 20, navx->fixedAltVar);
+    casic_put_r4(payload + 24, navx->pDop);
+    casic_put_r4(payload + 28, navx->tDop);
+    casic_put_r4(payload + 32, navx->pAcc);
+    casic_put_r4(payload + 36, navx->tAcc);
+    casic_put_r4(payload + 40, navx->staticHoldTh);
+    return _frame(CASIC_CLASSID_CFG_NAVX, payload, sizeof(payload));
+};
+
+/**
+ * A sentence of integer fields, a negative value is an empty field.
+ */
+bool CasicConfigEncoder::_pcas(const char* address, const int32_t* values, uint32_t count) {
+    NmeaEncoder encoder;
+    encoder.begin((char*)_buffer + _length, _size - _length, address);
+    for (uint32_t i = 0; i < count; i++) {
+        if (values[i] < 0) {
+            encoder.field_empty();
+        } else {
+            encoder.field_int(values[i], 1);
+        }
+    }
+    uint32_t written = encoder.end();
+    if (written == 0) {
+        return false;
+    }
+    _length += written;
+    commandCount++;
+    return true;
+};
+
+bool CasicConfigEncoder::pcas_save() {
+    return _pcas("PCAS00", nullptr, 0);
+};
+
+bool CasicConfigEncoder::pcas_baud(uint32_t baudRate) {
+    static const uint32_t rates[] = {4800, 9600, 19200, 38400, 57600, 115200};
+    for (int32_t code = 0; code < (int32_t)(sizeof(rates) / sizeof(rates[0])); code++) {
+        if (rates[code] == baudRate) {
+            return _pcas("PCAS01", &code, 1);
+        }
+    }
+    return false;
+};
+
+bool CasicConfigEncoder::pcas_rate(uint16_t interval) {
+    int32_t value = interval;
+    return _pcas("PCAS02", &value, 1);
+};
+
+bool CasicConfigEncoder::pcas_output(const uint8_t* rates, uint32_t count) {
+    if (count > CASIC_PCAS_OUTPUT_COUNT) {
+        return false;
+    }
+    int32_t values[CASIC_PCAS_OUTPUT_COUNT];
+    for (uint32_t i = 0; i < CASIC_PCAS_OUTPUT_COUNT; i++) {
+        values[i] = i < count ? rates[i] : -1;
+    }
+    return _pcas("PCAS03", values, CASIC_PCAS_OUTPUT_COUNT);
+};
+
+bool CasicConfigEncoder::pcas_mode(uint8_t mode) {
+    int32_t value = mode;
+    return _pcas("PCAS04", &value, 1);
+};
+
+bool CasicConfigEncoder::pcas_restart(uint8_t mode) {
+    if (mode > 3) {
+        return false;
+    }
+    int32_t value = mode;
+    return _pcas("PCAS10", &value, 1);
+};
+
+uint32_t CasicConfigEncoder::_command_length(uint32_t offset) const {
+    if (_buffer[offset] == '$') {
+        uint32_t end = offset;
+        while (_buffer[end] != '\n') {
+            end++;
+        }
+        return end + 1 - offset;
+    }
+    return (_buffer[offset + 2] | (_buffer[offset + 3] << 8)) + CASIC_FRAME_OVERHEAD;
+};
+
+const uint8_t* CasicConfigEncoder::command(uint32_t index, uint32_t* length,
+                                           uint16_t* classId) const {
+    uint32_t offset = 0;
+    for (; index > 0 && offset < _length; index--) {
+        offset += _command_length(offset);
+    }
+    if (offset >= _length) {
+        return nullptr;
+    }
+    *length  = _command_length(offset);
+    *classId = _buffer[offset] == '$' ? 0 : CASIC_CLASSID(_buffer[offset + 4], _buffer[offset + 5]);
+    return _buffer + offset;
+};
+
+bool CasicAckTracker::receive(const struct CasicFrame* frame) {
+    uint16_t classId = frame->classId();
+    if ((classId != CASIC_CLASSID_ACK_ACK && classId != CASIC_CLASSID_ACK_NACK) ||
+        frame->length != 4) {
+        return false;
+    }
+    return resolve(CASIC_CLASSID(frame->payload[0], frame->payload[1]),
+                   classId == CASIC_CLASSID_ACK_ACK);
+};
+
+}  // namespace wibot::protocal::gnss
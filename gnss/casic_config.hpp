@@ -0,0 +1,124 @@
+#ifndef __WWTALK_GNSS_CASIC_CONFIG_HPP__
+#define __WWTALK_GNSS_CASIC_CONFIG_HPP__
+#include "ack_tracker.hpp"
+#include "base.hpp"
+#include "casic.hpp"
+#include "casic_framer.hpp"
+namespace wibot::protocal::gnss {
+
+#define CASIC_PCAS_OUTPUT_COUNT 18  // rate fields of $PCAS03.
+
+/**
+ * CFG-NAVX, fields applied according to mask.
+ */
+struct CasicCfgNavx {
+    uint32_t mask;
+    uint8_t  dyModel;
+    uint8_t  fixMode;
+    uint8_t  minSVs;
+    uint8_t  maxSVs;
+    uint8_t  minCNO;
+    uint8_t  iniFix3D;
+    int8_t   minElev;
+    uint8_t  drLimit;
+    uint8_t  navSystem;
+    uint16_t wnRollOver;
+    float    fixedAlt;
+    float    fixedAltVar;
+    float    pDop;
+    float    tDop;
+    float    pAcc;
+    float    tAcc;
+    float    staticHoldTh;
+};
+
+/**
+ * Write a burst of configuration commands, binary CFG frames and $PCAS sentences, back to back
+ * in a caller buffer. Every method returns false if the buffer is too small or an argument is
+ * out of range, and the command is not written.
+ */
+class CasicConfigEncoder {
+   public:
+    CasicConfigEncoder();
+
+    void begin(uint8_t* buffer, uint32_t size);
+
+    bool cfg_prt(uint8_t portId, uint8_t protoMask, uint16_t mode, uint32_t baudRate);
+    /**
+     * Output classId every rate solutions, 0 to disable it.
+     */
+    bool cfg_msg(uint16_t classId, uint16_t rate);
+    /**
+     * @param interval Solution interval in ms.
+     */
+    bool cfg_rate(uint16_t interval);
+    bool cfg_navx(const struct CasicCfgNavx* navx);
+
+    /**
+     * $PCAS00, save the configuration to flash.
+     */
+    bool pcas_save();
+    /**
+     * $PCAS01, baudRate from 4800 to 115200.
+     */
+    bool pcas_baud(uint32_t baudRate);
+    /**
+     * $PCAS02, interval in ms.
+     */
+    bool pcas_rate(uint16_t interval);
+    /**
+     * $PCAS03, rates of GGA, GLL, GSA, GSV, RMC, VTG, ZDA, ANT, DHV, LPS, -, -, UTC, GST, -, -,
+     * -, TIM in this order. Fields past count are left empty, which keeps their setting.
+     */
+    bool pcas_output(const uint8_t* rates, uint32_t count);
+    /**
+     * $PCAS04, constellations, e.g. 1 GPS, 2 BDS, 3 GPS and BDS.
+     */
+    bool pcas_mode(uint8_t mode);
+    /**
+     * $PCAS10, 0 hot, 1 warm, 2 cold and 3 factory start.
+     */
+    bool pcas_restart(uint8_t mode);
+
+    /**
+     * @return Return the length of the burst.
+     */
+    inline uint32_t length() const {
+        return _length;
+    };
+
+    /**
+     * @param classId Set to the class and id an ACK-ACK or ACK-NACK answers, 0 for a $PCAS
+     * sentence, which receivers do not answer.
+     * @return Return the command at index in the buffer, nullptr past the last command.
+     */
+    const uint8_t* command(uint32_t index, uint32_t* length, uint16_t* classId) const;
+
+    uint32_t commandCount;
+
+   private:
+    uint8_t* _buffer;
+    uint32_t _size;
+    uint32_t _length;
+
+    bool _frame(uint16_t classId, const uint8_t* payload, uint16_t length);
+    bool _pcas(const char* address, const int32_t* values, uint32_t count);
+    uint32_t _command_length(uint32_t offset) const;
+};
+
+/**
+ * AckTracker fed with ACK-ACK and ACK-NACK frames.
+ */
+class CasicAckTracker : public AckTracker {
+   public:
+    using AckTracker::AckTracker;
+
+    /**
+     * @return Return true if frame answers a pending request.
+     */
+    bool receive(const struct CasicFrame* frame);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_CASIC_CONFIG_HPP__
@@ -0,0 +1,14 @@
+#include "casic_framer.hpp"
+
+namespace wibot::protocal::gnss {
+
+bool CasicFramerTraits::header(const uint8_t* header, uint32_t* headerLength, uint32_t* length,
+                               CasicFrame* frame) {
+    frame->msgClass = header[4];
+    frame->msgId    = header[5];
+    *headerLength   = CASIC_HEADER_SIZE;
+    *length         = gnss_u2(header + 2);
+    return (*length & 0x03) == 0;
+};
+
+}  // namespace wibot::protocal::gnss
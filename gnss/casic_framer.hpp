@@ -0,0 +1,55 @@
+#ifndef __WWTALK_GNSS_CASIC_FRAMER_HPP__
+#define __WWTALK_GNSS_CASIC_FRAMER_HPP__
+#include "casic.hpp"
+#include "gnss_framer.hpp"
+namespace wibot::protocal::gnss {
+
+/**
+ * A validated frame, with the lifetime of a UbxFrame.
+ */
+struct CasicFrame {
+    uint8_t        msgClass;
+    uint8_t        msgId;
+    uint16_t       length;
+    const uint8_t* payload;
+
+    inline uint16_t classId() const {
+        return CASIC_CLASSID(msgClass, msgId);
+    };
+};
+
+/**
+ * The CASIC frame for GnssFramer: BA CE, the little-endian length, class, id and the payload,
+ * the sum of little-endian words over all but the sync chars. Payload lengths that are not a
+ * multiple of 4 are rejected with the header.
+ */
+struct CasicFramerTraits {
+    typedef CasicFrame    Frame;
+    typedef CasicChecksum Checksum;
+
+    static constexpr uint32_t SYNC_SIZE      = 2;
+    static constexpr uint8_t  SYNC[]         = {CASIC_SYNC_CHAR_1, CASIC_SYNC_CHAR_2};
+    static constexpr uint8_t  SYNC_MASK[]    = {0xFF, 0xFF};
+    static constexpr uint32_t HEADER_SIZE    = CASIC_HEADER_SIZE;
+    static constexpr uint32_t CHECKSUM_START = 2;
+    static constexpr uint32_t CHECKSUM_SIZE  = 4;
+
+    static bool header(const uint8_t* header, uint32_t* headerLength, uint32_t* length,
+                       CasicFrame* frame);
+    static inline bool check(const CasicChecksum& checksum, const uint8_t* bytes) {
+        return checksum.sum == gnss_u4(bytes);
+    };
+    static inline void complete(CasicFrame*){};
+};
+
+/**
+ * Split the bytes of a ring into CASIC frames, see GnssFramer.
+ */
+class CasicFramer : public GnssFramer<CasicFramerTraits> {
+   public:
+    using GnssFramer::GnssFramer;
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_CASIC_FRAMER_HPP__
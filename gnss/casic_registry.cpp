@@ -0,0 +1,17 @@
+#include "casic_registry.hpp"
+
+namespace wibot::protocal::gnss {
+
+bool CasicRegistry::message_register_default(CasicMessageHandler handler, void* context) {
+    return message_register(CASIC_CLASSID_NAV_PV, CasicNavPvView::validate, handler, context) &&
+           message_register(CASIC_CLASSID_NAV_TIMEUTC, CasicNavTimeUtcView::validate, handler,
+                            context) &&
+           message_register(CASIC_CLASSID_NAV_GPSINFO, CasicNavSvInfoView::validate, handler,
+                            context) &&
+           message_register(CASIC_CLASSID_NAV_BDSINFO, CasicNavSvInfoView::validate, handler,
+                            context) &&
+           message_register(CASIC_CLASSID_RXM_MEASX, CasicRxmMeasxView::validate, handler,
+                            context);
+};
+
+}  // namespace wibot::protocal::gnss
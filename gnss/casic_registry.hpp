@@ -0,0 +1,31 @@
+#ifndef __WWTALK_GNSS_CASIC_REGISTRY_HPP__
+#define __WWTALK_GNSS_CASIC_REGISTRY_HPP__
+#include "base.hpp"
+#include "casic.hpp"
+#include "casic_framer.hpp"
+#include "gnss_registry.hpp"
+namespace wibot::protocal::gnss {
+
+#define CASIC_REGISTRY_CLASS_MAX_COUNT 4
+#define CASIC_REGISTRY_MESSAGE_MAX_COUNT 16  // at most 255.
+
+typedef GnssMessageValidator         CasicMessageValidator;
+typedef GnssMessageEntry<CasicFrame> CasicMessageEntry;
+typedef CasicMessageEntry::Handler   CasicMessageHandler;
+
+/**
+ * CASIC messages keyed by class and id, see GnssRegistry.
+ */
+class CasicRegistry : public GnssRegistry<CasicFrame, CASIC_REGISTRY_CLASS_MAX_COUNT,
+                                          CASIC_REGISTRY_MESSAGE_MAX_COUNT> {
+   public:
+    /**
+     * Register NAV-PV, NAV-TIMEUTC, NAV-GPSINFO, NAV-BDSINFO and RXM-MEASX with the validate
+     * of their view, all handled by handler.
+     */
+    bool message_register_default(CasicMessageHandler handler, void* context);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_CASIC_REGISTRY_HPP__
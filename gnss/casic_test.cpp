@@ -0,0 +1,359 @@
+#include "casic_test.hpp"
+
+#include "CircularBuffer.hpp"
+#include "casic.hpp"
+#include "casic_config.hpp"
+#include "casic_framer.hpp"
+#include "casic_registry.hpp"
+#include "minunit.h"
+#include "nmea.hpp"
+#include "string.h"
+
+namespace wibot::protocal::gnss::test {
+
+static uint32_t casic_test_frame(uint8_t* buffer, uint8_t msgClass, uint8_t msgId,
+                                 const uint8_t* payload, uint16_t length) {
+    buffer[0] = CASIC_SYNC_CHAR_1;
+    buffer[1] = CASIC_SYNC_CHAR_2;
+    buffer[2] = length & 0xFF;
+    buffer[3] = length >> 8;
+    buffer[4] = msgClass;
+    buffer[5] = msgId;
+    memcpy(buffer + CASIC_HEADER_SIZE, payload, length);
+
+    // The checksum of the protocol description, word by word.
+    uint32_t checksum = ((uint32_t)msgId << 24) + ((uint32_t)msgClass << 16) + length;
+    for (uint32_t i = 0; i < length; i += 4) {
+        checksum += payload[i] | (payload[i + 1] << 8) | (payload[i + 2] << 16) |
+                    ((uint32_t)payload[i + 3] << 24);
+    }
+    for (uint32_t i = 0; i < 4; i++) {
+        buffer[CASIC_HEADER_SIZE + length + i] = checksum >> (8 * i);
+    }
+    return length + CASIC_FRAME_OVERHEAD;
+};
+
+static void casic_parse_test() {
+    uint8_t payload[80];
+    uint8_t storage[92];
+    for (int i = 0; i < 80; i++) {
+        payload[i] = i * 13;
+    }
+    // At an odd address, the words of the checksum are unaligned.
+    uint8_t* frame  = storage + 1;
+    uint32_t length = casic_test_frame(frame, 0x01, 0x03, payload, 80);
+
+    uint16_t classId;
+    void*    data;
+    MU_ASSERT(casic_parse(frame, length, &classId, &data));
+    MU_ASSERT(classId == CASIC_CLASSID_NAV_PV && data == frame + CASIC_HEADER_SIZE);
+    MU_ASSERT(!casic_parse(frame, length - 4, &classId, &data));
+    MU_ASSERT(!casic_parse(frame, 8, &classId, &data));
+    frame[10] ^= 1;
+    MU_ASSERT(!casic_parse(frame, length, &classId, &data));
+
+    // Split anywhere, the sum is the same.
+    CasicChecksum whole, split;
+    whole.reset();
+    whole.update(payload, 80);
+    split.reset();
+    split.update(payload, 3);
+    split.update(payload[3]);
+    split.update(payload + 4, 41);
+    split.update(payload + 45, 35);
+    MU_ASSERT(whole.sum == split.sum && split.phase == 0);
+}
+
+static void casic_framer_test() {
+    uint8_t         ring[256];
+    uint8_t         scratch[128];
+    CircularBuffer8 rb(ring, sizeof(ring));
+    CasicFramer     framer(rb, {.data = scratch, .size = sizeof(scratch)});
+    CasicFrame      frame;
+
+    uint8_t payload[100];
+    uint8_t stream[512];
+    for (int i = 0; i < 100; i++) {
+        payload[i] = i;
+    }
+    uint32_t length  = 0;
+    stream[length++] = 0x24;
+    stream[length++] = CASIC_SYNC_CHAR_1;  // a lone sync char.
+    length += casic_test_frame(stream + length, 0x01, 0x03, payload, 80);
+    length += casic_test_frame(stream + length, 0x01, 0x10, payload, 24);
+    uint32_t corrupted = length;
+    length += casic_test_frame(stream + length, 0x01, 0x20, payload, 20);
+    stream[corrupted + 12] ^= 0x10;
+    length += casic_test_frame(stream + length, 0x05, 0x01, payload, 4);
+
+    // Fed byte by byte, the checksum is updated across calls.
+    uint16_t classIds[4];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        rb.write(&stream[i], 1, true);
+        while (framer.parse(&frame)) {
+            MU_ASSERT(!memcmp(frame.payload, payload, frame.length));
+            if (count < 4) {
+                classIds[count] = frame.classId();
+            }
+            count++;
+        }
+    }
+    MU_ASSERT(count == 3 && framer.checksumErrors == 1);
+    MU_ASSERT(classIds[0] == CASIC_CLASSID_NAV_PV && classIds[1] == CASIC_CLASSID_NAV_TIMEUTC);
+    MU_ASSERT(classIds[2] == CASIC_CLASSID(0x05, 0x01));
+
+    // Lengths beyond the payload buffer or not a multiple of 4 are dropped on the header.
+    uint8_t bad[6] = {CASIC_SYNC_CHAR_1, CASIC_SYNC_CHAR_2, 0x06, 0x00, 0x01, 0x03};
+    rb.write(bad, sizeof(bad), true);
+    bad[3] = 0x10;
+    rb.write(bad, sizeof(bad), true);
+    length = casic_test_frame(stream, 0x01, 0x03, payload, 80);
+    rb.write(stream, length, true);
+    MU_ASSERT(framer.parse(&frame) && frame.classId() == CASIC_CLASSID_NAV_PV);
+    MU_ASSERT(framer.lengthErrors == 2);
+
+    // Payloads wrapping around the end of the ring are copied to the payload buffer.
+    for (int i = 0; i < 8; i++) {
+        length = casic_test_frame(stream, 0x01, 0x03, payload, 80);
+        rb.write(stream, length, true);
+        MU_ASSERT(framer.parse(&frame) && frame.length == 80);
+        MU_ASSERT(!memcmp(frame.payload, payload, 80));
+    }
+    MU_ASSERT(!framer.parse(&frame) && rb.getSize() == 0);
+}
+
+struct CasicTestRecord {
+    uint32_t count;
+    uint16_t classId;
+    double   lat;
+    uint8_t  hour;
+    uint8_t  svid;
+    int16_t  azim;
+    double   prMes;
+};
+
+static void casic_test_handler(void* context, const CasicFrame* frame) {
+    auto record = (CasicTestRecord*)context;
+    record->count++;
+    record->classId = frame->classId();
+    switch (frame->classId()) {
+        case CASIC_CLASSID_NAV_PV:
+            record->lat = CasicNavPvView(frame->payload).lat();
+            break;
+        case CASIC_CLASSID_NAV_TIMEUTC:
+            record->hour = CasicNavTimeUtcView(frame->payload).hour();
+            break;
+        case CASIC_CLASSID_NAV_GPSINFO:
+        case CASIC_CLASSID_NAV_BDSINFO: {
+            CasicNavSvInfoView info(frame->payload);
+            record->svid = info.svid(info.numViewSv() - 1);
+            record->azim = info.azim(info.numViewSv() - 1);
+        } break;
+        case CASIC_CLASSID_RXM_MEASX:
+            record->prMes = CasicRxmMeasxView(frame->payload).prMes(1);
+            break;
+        default:
+            break;
+    }
+};
+
+static void casic_registry_test() {
+    CasicTestRecord record;
+    memset(&record, 0, sizeof(record));
+    CasicRegistry registry;
+    MU_ASSERT(registry.message_register_default(casic_test_handler, &record));
+
+    uint8_t    storage[128];
+    uint8_t*   payload = storage + 1;
+    CasicFrame frame;
+    frame.payload = payload;
+
+    memset(storage, 0, sizeof(storage));
+    double lat = 31.2304567;
+    memcpy(payload + 24, &lat, sizeof(lat));  // little-endian host.
+    frame.msgClass = 0x01;
+    frame.msgId    = 0x03;
+    frame.length   = 80;
+    MU_ASSERT(registry.dispatch(&frame) && record.lat == lat);
+    frame.length = 76;
+    MU_ASSERT(!registry.dispatch(&frame) && registry.lengthErrors == 1);
+
+    memset(storage, 0, sizeof(storage));
+    payload[18]  = 23;
+    frame.msgId  = 0x10;
+    frame.length = 24;
+    MU_ASSERT(registry.dispatch(&frame) && record.hour == 23);
+
+    memset(storage, 0, sizeof(storage));
+    payload[4]      = 2;
+    payload[8 + 13] = 17;
+    payload[8 + 18] = 0x2C;  // 300 deg.
+    payload[8 + 19] = 0x01;
+    frame.msgId     = 0x21;
+    frame.length    = 8 + 12 * 2;
+    MU_ASSERT(registry.dispatch(&frame) && record.svid == 17 && record.azim == 300);
+
+    memset(storage, 0, sizeof(storage));
+    double pr   = 21345678.125;
+    payload[11] = 2;
+    memcpy(payload + 16 + 32, &pr, sizeof(pr));
+    frame.msgClass = 0x03;
+    frame.msgId    = 0x10;
+    frame.length   = 16 + 32 * 2;
+    MU_ASSERT(registry.dispatch(&frame) && record.prMes == pr);
+
+    frame.msgId = 0x11;
+    MU_ASSERT(!registry.dispatch(&frame) && registry.unknownCount == 1);
+    MU_ASSERT(record.count == 4);
+}
+
+/**
+ * Stand-in for a receiver on a loopback: applies CFG-PRT, CFG-MSG, CFG-RATE and CFG-NAVX and
+ * answers each, NACK for a baud rate it does not support. $PCAS sentences are checked and
+ * counted, they get no answer.
+ */
+struct CasicTestReceiver {
+    uint32_t baudRate;
+    uint16_t interval;
+    uint16_t msgRates[4];
+    uint8_t  minSVs;
+    float    pDop;
+    uint32_t sentences;
+    char     last[96];
+
+    void answer(CircularBuffer8& out, uint16_t classId, bool ack) {
+        uint8_t  frame[16];
+        uint8_t  payload[4] = {(uint8_t)(classId & 0xFF), (uint8_t)(classId >> 8), 0, 0};
+        uint16_t answer     = ack ? CASIC_CLASSID_ACK_ACK : CASIC_CLASSID_ACK_NACK;
+        uint32_t length     = casic_encode(frame, sizeof(frame), answer, payload, 4);
+        out.write(frame, length, false);
+    };
+
+    void process(const uint8_t* command, uint32_t length, CircularBuffer8& out) {
+        if (command[0] == '$') {
+            MU_ASSERT(length < sizeof(last));
+            memcpy(last, command, length);
+            last[length] = '\0';
+            MU_ASSERT(Sentence::check(last, true));
+            sentences++;
+            return;
+        }
+
+        uint8_t frame[64];
+        memcpy(frame, command, length);
+        uint16_t classId;
+        void*    data;
+        MU_ASSERT(casic_parse(frame, length, &classId, &data));
+        const uint8_t* payload = (const uint8_t*)data;
+        bool           ack     = true;
+        switch (classId) {
+            case CASIC_CLASSID_CFG_PRT:
+                ack = gnss_u4(payload + 4) <= 921600;
+                if (ack) baudRate = gnss_u4(payload + 4);
+                break;
+            case CASIC_CLASSID_CFG_MSG:
+                if (payload[0] == 0x01 && payload[1] < 4) {
+                    msgRates[payload[1]] = gnss_u2(payload + 2);
+                }
+                break;
+            case CASIC_CLASSID_CFG_RATE:
+                interval = gnss_u2(payload);
+                break;
+            case CASIC_CLASSID_CFG_NAVX:
+                minSVs = payload[6];
+                pDop   = gnss_r4(payload + 24);
+                break;
+            default:
+                ack = false;
+        }
+        answer(out, classId, ack);
+    };
+};
+
+struct CasicTestAcks {
+    uint32_t   count;
+    uint32_t   tags[16];
+    ACK_RESULT results[16];
+};
+
+static void casic_test_ack(void* context, uint32_t tag, ACK_RESULT result) {
+    auto acks                    = (CasicTestAcks*)context;
+    acks->tags[acks->count]      = tag;
+    acks->results[acks->count++] = result;
+};
+
+static void casic_config_test() {
+    uint8_t            burst[512];
+    CasicConfigEncoder encoder;
+    encoder.begin(burst, sizeof(burst));
+    MU_ASSERT(encoder.cfg_prt(0xFF, 0x33, 0x08C0, 115200));
+    MU_ASSERT(encoder.cfg_msg(CASIC_CLASSID(0x01, 0x03), 1));
+    MU_ASSERT(encoder.cfg_rate(200));
+    struct CasicCfgNavx navx;
+    memset(&navx, 0, sizeof(navx));
+    navx.mask   = 0x0004 | 0x0100;
+    navx.minSVs = 4;
+    navx.pDop   = 25.0f;
+    MU_ASSERT(encoder.cfg_navx(&navx));
+    MU_ASSERT(encoder.cfg_prt(0xFF, 0x33, 0x08C0, 2000000));  // NACK
+    const uint8_t rates[] = {1, 0, 1, 1, 1, 0, 0};
+    MU_ASSERT(encoder.pcas_output(rates, sizeof(rates)));
+    MU_ASSERT(encoder.pcas_baud(115200) && !encoder.pcas_baud(1200));
+    MU_ASSERT(encoder.pcas_rate(200) && encoder.pcas_mode(3) && encoder.pcas_save());
+    MU_ASSERT(!encoder.pcas_restart(4) && encoder.commandCount == 10);
+
+    uint32_t    length;
+    uint16_t    classId;
+    const char* sentence = (const char*)encoder.command(5, &length, &classId);
+    MU_ASSERT(sentence != nullptr && classId == 0);
+    MU_ASSERT(!strncmp(sentence, "$PCAS03,1,0,1,1,1,0,0,,,,,,,,,,,*32\r\n", length));
+    sentence = (const char*)encoder.command(6, &length, &classId);
+    MU_ASSERT(!strncmp(sentence, "$PCAS01,5*19\r\n", length) && length == 14);
+    MU_ASSERT(encoder.command(10, &length, &classId) == nullptr);
+
+    // The whole burst at once, then the answers.
+    uint8_t           ring[256];
+    uint8_t           scratch[16];
+    CircularBuffer8   fromReceiver(ring, sizeof(ring));
+    CasicFramer       framer(fromReceiver, {.data = scratch, .size = sizeof(scratch)});
+    CasicFrame        frame;
+    CasicTestAcks     acks;
+    CasicTestReceiver receiver;
+    memset(&acks, 0, sizeof(acks));
+    memset(&receiver, 0, sizeof(receiver));
+    CasicAckTracker tracker(1000, casic_test_ack, &acks);
+
+    for (uint32_t i = 0; i < encoder.commandCount; i++) {
+        const uint8_t* command = encoder.command(i, &length, &classId);
+        receiver.process(command, length, fromReceiver);
+        if (classId != 0) {
+            MU_ASSERT(tracker.sent(classId, i, 0));
+        }
+    }
+    MU_ASSERT(tracker.pending() == 5 && receiver.sentences == 5);
+    while (framer.parse(&frame)) {
+        MU_ASSERT(tracker.receive(&frame));
+    }
+    MU_ASSERT(tracker.pending() == 0 && tracker.acked == 4 && tracker.naked == 1);
+    MU_ASSERT(acks.tags[4] == 4 && acks.results[4] == ACK_RESULT::NAK);
+    MU_ASSERT(acks.tags[0] == 0 && acks.results[0] == ACK_RESULT::ACK);
+    MU_ASSERT(receiver.baudRate == 115200 && receiver.interval == 200);
+    MU_ASSERT(receiver.msgRates[3] == 1 && receiver.minSVs == 4 && receiver.pDop == 25.0f);
+    MU_ASSERT(!strcmp(receiver.last, "$PCAS00*01\r\n"));
+
+    // A full buffer keeps the commands written so far.
+    encoder.begin(burst, 30);
+    MU_ASSERT(encoder.cfg_prt(0, 0x33, 0x08C0, 9600) && !encoder.cfg_navx(&navx));
+    MU_ASSERT(!encoder.pcas_output(rates, sizeof(rates)) && encoder.commandCount == 1);
+    MU_ASSERT(encoder.length() == 18);
+}
+
+void casic_test() {
+    casic_parse_test();
+    casic_framer_test();
+    casic_registry_test();
+    casic_config_test();
+};
+
+}  // namespace wibot::protocal::gnss::test
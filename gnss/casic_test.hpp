@@ -0,0 +1,8 @@
+#ifndef __WWTALK_CASIC_TEST_HPP__
+#define __WWTALK_CASIC_TEST_HPP__
+
+namespace wibot::protocal::gnss::test {
+void casic_test();
+}
+
+#endif  // __WWTALK_CASIC_TEST_HPP__
@@ -0,0 +1,43 @@
+#ifndef __WWTALK_GNSS_BYTES_HPP__
+#define __WWTALK_GNSS_BYTES_HPP__
+#include "base.hpp"
+#include "string.h"
+namespace wibot::protocal::gnss {
+
+/**
+ * Little-endian fields at any alignment, as the binary protocols send them.
+ */
+static inline uint8_t gnss_u1(const uint8_t* p) {
+    return p[0];
+};
+static inline int8_t gnss_i1(const uint8_t* p) {
+    return (int8_t)p[0];
+};
+static inline uint16_t gnss_u2(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+};
+static inline int16_t gnss_i2(const uint8_t* p) {
+    return (int16_t)gnss_u2(p);
+};
+static inline uint32_t gnss_u4(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+};
+static inline int32_t gnss_i4(const uint8_t* p) {
+    return (int32_t)gnss_u4(p);
+};
+static inline float gnss_r4(const uint8_t* p) {
+    uint32_t bits = gnss_u4(p);
+    float    value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+};
+static inline double gnss_r8(const uint8_t* p) {
+    uint64_t bits = gnss_u4(p) | ((uint64_t)gnss_u4(p + 4) << 32);
+    double   value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_BYTES_HPP__
@@ -0,0 +1,231 @@
+#include "gnss_demux.hpp"
+
+namespace wibot::protocal::gnss {
+
+GnssDemux::GnssDemux(CircularBuffer8& buffer, Buffer8 frameBuffer, NmeaParser& nmea)
+    : strict(false),
+      nmeaCount(0),
+      ubxCount(0),
+      casicCount(0),
+      nmeaRejected(0),
+      checksumErrors(0),
+      lengthErrors(0),
+      droppedBytes(0),
+      _buffer(buffer),
+      _frameBuffer(frameBuffer),
+      _nmea(nmea),
+      _pending(0) {
+    reset();
+};
+
+void GnssDemux::reset() {
+    _stage  = GNSS_DEMUX_STAGE::SYNC;
+    _offset = 0;
+};
+
+/**
+ * Bytes from offset contiguous in the ring, at most count. The ring wraps once at most, the
+ * wrap point is found by bisection.
+ */
+const uint8_t* GnssDemux::_span(uint32_t offset, uint32_t count, uint32_t* length) {
+    const uint8_t* first = _buffer.peekPtr(offset);
+    if (_buffer.peekPtr(offset + count - 1) == first + count - 1) {
+        *length = count;
+        return first;
+    }
+    uint32_t low = 1, high = count - 1;  // contiguous for low bytes, not for high + 1.
+    while (low < high) {
+        uint32_t middle = (low + high + 1) / 2;
+        if (_buffer.peekPtr(offset + middle - 1) == first + middle - 1) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    *length = low;
+    return first;
+};
+
+void GnssDemux::_drop(uint32_t count) {
+    _buffer.readVirtual(count);
+    droppedBytes += count;
+};
+
+bool GnssDemux::_sync() {
+    uint32_t size = _buffer.getSize();
+    uint32_t skip = 0;
+    while (skip < size) {
+        uint32_t       length;
+        const uint8_t* p = _span(skip, size - skip, &length);
+        uint32_t       i = 0;
+        while (i < length && p[i] != '$' && p[i] != UBX_SYNC_CHAR_1 && p[i] != CASIC_SYNC_CHAR_1) {
+            i++;
+        }
+        skip += i;
+        if (i < length) break;
+    }
+    _drop(skip);
+    size -= skip;
+    if (size == 0) return false;
+
+    uint8_t first = _at(0);
+    if (first == '$') {
+        _stage  = GNSS_DEMUX_STAGE::NMEA;
+        _offset = 1;
+        return true;
+    }
+    if (size < 2) return false;
+    uint8_t second = _at(1);
+    if (first == UBX_SYNC_CHAR_1 && second == UBX_SYNC_CHAR_2) {
+        _stage = GNSS_DEMUX_STAGE::UBX;
+    } else if (first == CASIC_SYNC_CHAR_1 && second == CASIC_SYNC_CHAR_2) {
+        _stage = GNSS_DEMUX_STAGE::CASIC;
+    } else {
+        _drop(1);
+    }
+    return true;
+};
+
+/**
+ * Scan the sentence from where the last call stopped.
+ * @return Return true if it ended, with frame set if the parser accepted it.
+ */
+bool GnssDemux::_nmea_scan(GnssDemuxFrame* frame) {
+    uint32_t size = _buffer.getSize();
+    while (_offset < size) {
+        uint32_t       length;
+        const uint8_t* p = _span(_offset, size - _offset, &length);
+        for (uint32_t i = 0; i < length; i++) {
+            uint8_t c = p[i];
+            if (c >= 0x20 && c <= 0x7E && c != '$') continue;
+
+            uint32_t end = _offset + i;
+            if (c != '\n' && c != '\r') {
+                // Another start, or a byte that is not text: the sentence is cut.
+                nmeaRejected++;
+                _drop(end);
+                reset();
+                return true;
+            }
+            if (c == '\r') continue;
+
+            uint32_t sentenceLength = end + 1;
+            if (sentenceLength >= _frameBuffer.size) {
+                lengthErrors++;
+                _drop(sentenceLength);
+                reset();
+                return true;
+            }
+            char* sentence = (char*)_frameBuffer.data;
+            _buffer.peek(_frameBuffer.data, 0, sentenceLength);
+            sentence[sentenceLength] = '\0';
+            reset();
+
+            NmeaSentenceBase* entry;
+            if (!_nmea.sentence_entry_get(sentence, strict, &entry)) {
+                nmeaRejected++;
+                _buffer.readVirtual(sentenceLength);
+                return true;
+            }
+            frame->protocol = GNSS_PROTOCOL::NMEA;
+            frame->classId  = 0;
+            frame->length   = sentenceLength;
+            frame->payload  = nullptr;
+            frame->sentence = sentence;
+            frame->entry    = entry;
+            _pending        = sentenceLength;
+            nmeaCount++;
+            return true;
+        }
+        _offset += length;
+        // Too long for the frame buffer, or a full ring that no end of line can follow.
+        if (_offset >= _frameBuffer.size || _offset >= _buffer.getCapacity()) {
+            lengthErrors++;
+            _drop(_offset);
+            reset();
+            return true;
+        }
+    }
+    return false;
+};
+
+/**
+ * @return Return false if more bytes are needed, true once the frame is accepted or dropped.
+ */
+bool GnssDemux::_binary(GnssDemuxFrame* frame, GNSS_PROTOCOL protocol) {
+    bool     ubx      = protocol == GNSS_PROTOCOL::UBX;
+    uint32_t header   = ubx ? UBX_HEADER_SIZE : CASIC_HEADER_SIZE;
+    uint32_t overhead = ubx ? UBX_FRAME_OVERHEAD : CASIC_FRAME_OVERHEAD;
+    uint32_t size     = _buffer.getSize();
+    if (size < header) return false;
+
+    uint32_t lengthAt = ubx ? 4 : 2;
+    uint32_t total    = (_at(lengthAt) | (_at(lengthAt + 1) << 8)) + overhead;
+    // The ring must hold the frame too, the rest of a longer one never arrives.
+    if (total > _frameBuffer.size || total > _buffer.getCapacity()) {
+        lengthErrors++;
+        _drop(1);
+        reset();
+        return true;
+    }
+    if (size < total) return false;
+
+    uint32_t length;
+    uint8_t* data = (uint8_t*)_span(0, total, &length);
+    if (length < total) {
+        _buffer.peek(_frameBuffer.data, 0, total);
+        data = _frameBuffer.data;
+    }
+    reset();
+
+    uint16_t classId;
+    void*    payload;
+    bool     valid = ubx ? ubx_parse(data, total, &classId, &payload)
+                         : casic_parse(data, total, &classId, &payload);
+    if (!valid) {
+        // Resume after the sync chars, the frame may have been a false start.
+        checksumErrors++;
+        _drop(1);
+        return true;
+    }
+    frame->protocol = protocol;
+    frame->classId  = classId;
+    frame->length   = total - overhead;
+    frame->payload  = (const uint8_t*)payload;
+    frame->sentence = nullptr;
+    frame->entry    = nullptr;
+    _pending        = total;
+    if (ubx) {
+        ubxCount++;
+    } else {
+        casicCount++;
+    }
+    return true;
+};
+
+bool GnssDemux::parse(GnssDemuxFrame* frame) {
+    if (_pending) {
+        _buffer.readVirtual(_pending);
+        _pending = 0;
+    }
+
+    while (true) {
+        switch (_stage) {
+            case GNSS_DEMUX_STAGE::SYNC:
+                if (!_sync()) return false;
+                break;
+            case GNSS_DEMUX_STAGE::NMEA:
+                if (!_nmea_scan(frame)) return false;
+                break;
+            case GNSS_DEMUX_STAGE::UBX:
+                if (!_binary(frame, GNSS_PROTOCOL::UBX)) return false;
+                break;
+            case GNSS_DEMUX_STAGE::CASIC:
+                if (!_binary(frame, GNSS_PROTOCOL::CASIC)) return false;
+                break;
+        }
+        if (_pending) return true;
+    }
+};
+
+}  // namespace wibot::protocal::gnss
@@ -0,0 +1,95 @@
+#ifndef __WWTALK_GNSS_GNSS_DEMUX_HPP__
+#define __WWTALK_GNSS_GNSS_DEMUX_HPP__
+#include "CircularBuffer.hpp"
+#include "base.hpp"
+#include "casic.hpp"
+#include "nmea.hpp"
+#include "ubx.hpp"
+namespace wibot::protocal::gnss {
+
+enum class GNSS_PROTOCOL : uint8_t {
+    NONE = 0,
+    NMEA,
+    UBX,
+    CASIC,
+};
+
+enum class GNSS_DEMUX_STAGE : uint8_t {
+    SYNC = 0,  // seeking '$', 0xB5 0x62 or 0xBA 0xCE.
+    NMEA,      // seeking '\n'.
+    UBX,
+    CASIC,
+};
+
+/**
+ * A frame of any protocol, valid until the next parse or reset. NMEA sentences are copied to
+ * the frame buffer and terminated with '\0', binary frames point into the ring when they are
+ * contiguous there.
+ */
+struct GnssDemuxFrame {
+    GNSS_PROTOCOL     protocol;
+    uint16_t          classId;  // UBX and CASIC.
+    uint16_t          length;   // of the payload, or of the sentence.
+    const uint8_t*    payload;  // UBX and CASIC.
+    const char*       sentence;  // NMEA.
+    NmeaSentenceBase* entry;     // NMEA, the entry of the sentence in the parser.
+};
+
+/**
+ * Split a stream that interleaves NMEA, UBX and CASIC into frames, in one pass over the ring.
+ * A sync sequence is looked for between frames only, the payload of a binary frame is skipped
+ * by its length field and never read as a sentence start, and a sentence ends at the first
+ * byte that cannot be NMEA text, which may start a binary frame. Sentences go through
+ * NmeaParser::sentence_entry_get, binary frames through ubx_parse and casic_parse, frames
+ * they reject are dropped and scanning resumes after their first byte.
+ */
+class GnssDemux {
+   public:
+    /**
+     * @param frameBuffer Receives sentences and the binary frames that wrap around the end of
+     * the ring, its size bounds the length of all frames.
+     */
+    GnssDemux(CircularBuffer8& buffer, Buffer8 frameBuffer, NmeaParser& nmea);
+
+    /**
+     * Release the previous frame, then demultiplex the bytes received so far.
+     * @return Return true if a frame is complete, false if more bytes are needed.
+     */
+    bool parse(GnssDemuxFrame* frame);
+
+    /**
+     * Restart from a sync sequence, keep the bytes of the ring.
+     */
+    void reset();
+
+    bool strict;  // passed to sentence_entry_get, false by default.
+
+    uint32_t nmeaCount;
+    uint32_t ubxCount;
+    uint32_t casicCount;
+    uint32_t nmeaRejected;    // by sentence_entry_get, or cut by a non text byte.
+    uint32_t checksumErrors;  // of binary frames.
+    uint32_t lengthErrors;    // frames longer than the frame buffer.
+    uint32_t droppedBytes;
+
+   private:
+    CircularBuffer8& _buffer;
+    Buffer8          _frameBuffer;
+    NmeaParser&      _nmea;
+    GNSS_DEMUX_STAGE _stage;
+    uint32_t         _offset;   // bytes of the current frame scanned so far.
+    uint32_t         _pending;  // bytes of the last frame, released by the next parse.
+
+    inline uint8_t _at(uint32_t offset) {
+        return *_buffer.peekPtr(offset);
+    };
+    const uint8_t* _span(uint32_t offset, uint32_t count, uint32_t* length);
+    void           _drop(uint32_t count);
+    bool           _sync();
+    bool           _nmea_scan(GnssDemuxFrame* frame);
+    bool           _binary(GnssDemuxFrame* frame, GNSS_PROTOCOL protocol);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_GNSS_DEMUX_HPP__
@@ -0,0 +1,134 @@
+#include "gnss_demux_test.hpp"
+
+#include "CircularBuffer.hpp"
+#include "casic.hpp"
+#include "gnss_demux.hpp"
+#include "minunit.h"
+#include "nmea.hpp"
+#include "string.h"
+#include "ubx.hpp"
+
+namespace wibot::protocal::gnss::test {
+
+static const char* demuxRmc =
+    "$GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*62\r\n";
+static const char* demuxGga =
+    "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+
+static uint32_t gnss_demux_test_append(uint8_t* stream, uint32_t length, const char* text) {
+    memcpy(stream + length, text, strlen(text));
+    return length + strlen(text);
+};
+
+/**
+ * A stream of every protocol, in which binary payloads hold sentence starts, and a sentence is
+ * cut by a binary frame.
+ */
+static uint32_t gnss_demux_test_stream(uint8_t* stream) {
+    uint8_t payload[80];
+    for (uint32_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = i;
+    }
+    memcpy(payload + 8, demuxRmc, 40);
+    payload[60] = UBX_SYNC_CHAR_1;
+    payload[61] = UBX_SYNC_CHAR_2;
+
+    uint32_t length  = 0;
+    stream[length++] = 0x00;
+    length           = gnss_demux_test_append(stream, length, demuxRmc);
+    length += ubx_encode(stream + length, 256, UBX_CLASSID_NAV_PVT, payload, 76);
+    length = gnss_demux_test_append(stream, length, "$GPGGA,123519,4807");  // cut.
+    length += casic_encode(stream + length, 256, CASIC_CLASSID_NAV_PV, payload, 80);
+    length = gnss_demux_test_append(stream, length, demuxGga);
+    uint32_t corrupted = length;
+    length += ubx_encode(stream + length, 256, UBX_CLASSID(0x01, 0x35), payload, 20);
+    stream[corrupted + 10] ^= 0x01;
+    length = gnss_demux_test_append(stream, length, "$GPXYZ,1,2*00\r\n");  // unknown.
+    length += casic_encode(stream + length, 256, CASIC_CLASSID_ACK_ACK, payload, 4);
+    length = gnss_demux_test_append(stream, length, demuxRmc);
+    return length;
+};
+
+static void gnss_demux_run(uint32_t chunk) {
+    NmeaParser parser;
+    parser.sentence_register_default();
+    uint8_t         ring[160];
+    uint8_t         frameBuffer[128];
+    uint8_t         stream[1024];
+    CircularBuffer8 rb(ring, sizeof(ring));
+    GnssDemux       demux(rb, {.data = frameBuffer, .size = sizeof(frameBuffer)}, parser);
+    GnssDemuxFrame  frame;
+
+    GNSS_PROTOCOL protocols[8];
+    uint16_t      classIds[8];
+    uint32_t      count  = 0;
+    uint32_t      length = gnss_demux_test_stream(stream);
+    for (uint32_t offset = 0; offset < length; offset += chunk) {
+        uint32_t size = length - offset < chunk ? length - offset : chunk;
+        rb.write(stream + offset, size, false);
+        while (demux.parse(&frame)) {
+            if (count < 8) {
+                protocols[count] = frame.protocol;
+                classIds[count]  = frame.classId;
+            }
+            count++;
+            if (frame.protocol == GNSS_PROTOCOL::NMEA) {
+                union NmeaSentenceDataAny data;
+                MU_ASSERT(frame.entry->parse(&data, frame.sentence));
+                MU_ASSERT(frame.sentence[frame.length] == '\0');
+            } else if (frame.length > 8) {
+                MU_ASSERT(frame.payload[8] == '$' && frame.payload[0] == 0);
+            }
+        }
+    }
+    MU_ASSERT(count == 6);
+    MU_ASSERT(protocols[0] == GNSS_PROTOCOL::NMEA && protocols[5] == GNSS_PROTOCOL::NMEA);
+    MU_ASSERT(protocols[1] == GNSS_PROTOCOL::UBX && classIds[1] == UBX_CLASSID_NAV_PVT);
+    MU_ASSERT(protocols[2] == GNSS_PROTOCOL::CASIC && classIds[2] == CASIC_CLASSID_NAV_PV);
+    MU_ASSERT(protocols[3] == GNSS_PROTOCOL::NMEA);
+    MU_ASSERT(protocols[4] == GNSS_PROTOCOL::CASIC && classIds[4] == CASIC_CLASSID_ACK_ACK);
+    MU_ASSERT(demux.nmeaCount == 3 && demux.ubxCount == 1 && demux.casicCount == 2);
+    // The corrupted frame is rescanned from its second byte, its payload holds a cut sentence.
+    MU_ASSERT(demux.nmeaRejected == 3 && demux.checksumErrors == 1);
+    MU_ASSERT(!demux.parse(&frame) && rb.getSize() == 0);
+};
+
+/**
+ * A frame buffer larger than the ring, frames and sentences the ring cannot hold are dropped
+ * instead of waited for.
+ */
+static void gnss_demux_small_ring_test() {
+    NmeaParser parser;
+    parser.sentence_register_default();
+    uint8_t         ring[64];
+    uint8_t         frameBuffer[128];
+    uint8_t         stream[128];
+    CircularBuffer8 rb(ring, sizeof(ring));
+    GnssDemux       demux(rb, {.data = frameBuffer, .size = sizeof(frameBuffer)}, parser);
+    GnssDemuxFrame  frame;
+
+    uint8_t payload[4] = {1, 2, 3, 4};
+    uint8_t big[6]     = {UBX_SYNC_CHAR_1, UBX_SYNC_CHAR_2, 0x01, 0x07, 60, 0};
+    rb.write(big, sizeof(big), false);
+    uint32_t length = ubx_encode(stream, sizeof(stream), UBX_CLASSID_NAV_PVT, payload, 4);
+    rb.write(stream, length, false);
+    MU_ASSERT(demux.parse(&frame) && frame.protocol == GNSS_PROTOCOL::UBX);
+    MU_ASSERT(frame.length == 4 && demux.lengthErrors == 1);
+    MU_ASSERT(!demux.parse(&frame) && rb.getSize() == 0);
+
+    // A sentence without an end fills the ring.
+    memset(stream, 'A', sizeof(ring));
+    stream[0] = '$';
+    rb.write(stream, sizeof(ring), false);
+    MU_ASSERT(!demux.parse(&frame) && demux.lengthErrors == 2 && rb.getSize() == 0);
+};
+
+void gnss_demux_test() {
+    // Byte by byte, in chunks crossing frames, and frames wrapping around the ring.
+    gnss_demux_run(1);
+    gnss_demux_run(7);
+    gnss_demux_run(64);
+    gnss_demux_small_ring_test();
+};
+
+}  // namespace wibot::protocal::gnss::test
@@ -0,0 +1,8 @@
+#ifndef __WWTALK_GNSS_DEMUX_TEST_HPP__
+#define __WWTALK_GNSS_DEMUX_TEST_HPP__
+
+namespace wibot::protocal::gnss::test {
+void gnss_demux_test();
+}
+
+#endif  // __WWTALK_GNSS_DEMUX_TEST_HPP__
@@ -0,0 +1,285 @@
+#include "gnss_fix.hpp"
+
+#include "gnss_time.hpp"
+#include "math.h"
+#include "nmea_coord.hpp"
+#include "string.h"
+
+namespace wibot::protocal::gnss {
+
+#define GNSS_FIX_BATCH_SIZE 64
+#define GNSS_FIX_KNOT_MM_S_NUM 1852  // 1 kn = 1852 m/h = 1852 / 3.6 mm/s.
+#define GNSS_FIX_KNOT_MM_S_DEN 3600
+
+static_assert(sizeof(GnssFix) == 64, "GnssFix fills one cache line");
+
+void GnssFix::reset() {
+    memset(this, 0, sizeof(*this));
+};
+
+static inline uint32_t gnss_fix_ms_of_day(int32_t hour, int32_t min, int32_t sec) {
+    return ((hour * 60 + min) * 60 + sec) * 1000;
+};
+
+/**
+ * Indexed by carrSoln * 2 + diffSoln of the NAV-PVT flags.
+ */
+static const GNSS_FIX_SOLUTION ubxSolutions[8] = {
+    GNSS_FIX_SOLUTION::AUTONOMOUS, GNSS_FIX_SOLUTION::DIFFERENTIAL,
+    GNSS_FIX_SOLUTION::RTK_FLOAT,  GNSS_FIX_SOLUTION::RTK_FLOAT,
+    GNSS_FIX_SOLUTION::RTK_FIXED,  GNSS_FIX_SOLUTION::RTK_FIXED,
+    GNSS_FIX_SOLUTION::AUTONOMOUS, GNSS_FIX_SOLUTION::DIFFERENTIAL,
+};
+
+void GnssFixConvert::from_nav_pvt(const struct UbxFrameNavPvt* pvt, GnssFix* fix) {
+    uint8_t flags   = pvt->flags.flags;
+    uint8_t fixType = pvt->fixType <= 5 ? pvt->fixType : 0;
+    uint8_t fixOk   = flags & 0x01;
+    uint8_t height  = fixOk & (fixType == 3 || fixType == 4);
+
+    fix->lat    = pvt->lat;
+    fix->lon    = pvt->lon;
+    fix->height = pvt->height;
+    fix->hMSL   = pvt->hMSL;
+    fix->velN   = pvt->velN;
+    fix->velE   = pvt->velE;
+    fix->velD   = pvt->velD;
+    fix->gSpeed = pvt->gSpeed;
+    fix->course = pvt->heading;
+    fix->hAcc   = pvt->hAcc;
+    fix->vAcc   = pvt->vAcc;
+    fix->sAcc   = pvt->sAcc;
+
+    // nano is within a second of the time fields and may be negative. A time rounded below
+    // midnight is clamped to it rather than moved to the previous day.
+    int64_t ns = (int64_t)gnss_fix_ms_of_day(pvt->hour, pvt->min, pvt->sec) * 1000000 +
+                 pvt->nano + 500000;
+    fix->msOfDay = ns > 0 ? (uint32_t)(ns / 1000000) : 0;
+    fix->year    = pvt->year;
+    fix->month   = pvt->month;
+    fix->day     = pvt->day;
+    fix->pDOP    = pvt->pDOP;
+    fix->hDOP    = 0;
+
+    fix->fixType  = (GNSS_FIX_TYPE)fixType;
+    fix->solution = ubxSolutions[((flags >> 6) << 1 | ((flags >> 1) & 0x01)) & 0x07];
+    fix->numSV    = pvt->numSV;
+    fix->valid    = (pvt->valid.valid & (GNSS_FIX_VALID_DATE | GNSS_FIX_VALID_TIME)) |
+                 ((uint8_t)-fixOk &
+                  (GNSS_FIX_VALID_POSITION | GNSS_FIX_VALID_VELOCITY | GNSS_FIX_VALID_MOTION)) |
+                 ((uint8_t)-height & GNSS_FIX_VALID_HEIGHT) | GNSS_FIX_VALID_ACCURACY;
+};
+
+void GnssFixConvert::from_nav_pvt(const struct UbxFrameNavPvt* pvt, uint32_t count,
+                                  GnssFix* fixes) {
+    for (uint32_t i = 0; i < count; i++) {
+        from_nav_pvt(&pvt[i], &fixes[i]);
+    }
+};
+
+/**
+ * Indexed by posValid of NAV-PV: invalid, external, rough, kept, dead reckoning, fast mode, 2D,
+ * 3D and GNSS with dead reckoning.
+ */
+static const GNSS_FIX_TYPE casicFixTypes[9] = {
+    GNSS_FIX_TYPE::NONE,   GNSS_FIX_TYPE::NONE,           GNSS_FIX_TYPE::NONE,
+    GNSS_FIX_TYPE::NONE,   GNSS_FIX_TYPE::DEAD_RECKONING, GNSS_FIX_TYPE::FIX_2D,
+    GNSS_FIX_TYPE::FIX_2D, GNSS_FIX_TYPE::FIX_3D,         GNSS_FIX_TYPE::GNSS_DEAD_RECKONING,
+};
+
+void GnssFixConvert::from_nav_pv(const struct CasicFrameNavPv* pv, GnssFix* fix) {
+    GNSS_FIX_TYPE fixType  = casicFixTypes[pv->posValid <= 8 ? pv->posValid : 0];
+    uint8_t       position = fixType != GNSS_FIX_TYPE::NONE;
+    uint8_t       height =
+        fixType == GNSS_FIX_TYPE::FIX_3D || fixType == GNSS_FIX_TYPE::GNSS_DEAD_RECKONING;
+    uint8_t velocity = pv->velValid >= 4 && pv->velValid <= 8;
+
+    fix->lat    = (int32_t)lrint(pv->lat * 1e7);
+    fix->lon    = (int32_t)lrint(pv->lon * 1e7);
+    fix->height = (int32_t)lrintf(pv->height * 1000);
+    fix->hMSL   = (int32_t)lrintf((pv->height - pv->sepGeoid) * 1000);
+    fix->velN   = (int32_t)lrintf(pv->velN * 1000);
+    fix->velE   = (int32_t)lrintf(pv->velE * 1000);
+    fix->velD   = (int32_t)lrintf(pv->velU * -1000);
+    fix->gSpeed = (int32_t)lrintf(pv->speed2D * 1000);
+    fix->course = (int32_t)lrintf(pv->heading * 100000);
+    fix->hAcc   = (uint32_t)lrintf(pv->hAcc * 1000);
+    fix->vAcc   = (uint32_t)lrintf(pv->vAcc * 1000);
+    fix->sAcc   = (uint32_t)lrintf(pv->sAcc * 1000);
+
+    fix->msOfDay = 0;
+    fix->year    = 0;
+    fix->month   = 0;
+    fix->day     = 0;
+    fix->pDOP    = (uint16_t)lrintf(pv->pDop * 100);
+    fix->hDOP    = 0;
+
+    fix->fixType  = fixType;
+    fix->solution = GNSS_FIX_SOLUTION::AUTONOMOUS;
+    fix->numSV    = pv->numSV;
+    fix->valid    = ((uint8_t)-position & GNSS_FIX_VALID_POSITION) |
+                 ((uint8_t)-height & GNSS_FIX_VALID_HEIGHT) |
+                 ((uint8_t)-velocity & (GNSS_FIX_VALID_VELOCITY | GNSS_FIX_VALID_MOTION)) |
+                 GNSS_FIX_VALID_ACCURACY;
+};
+
+void GnssFixConvert::from_nav_pv(const struct CasicFrameNavPv* pv, uint32_t count,
+                                 GnssFix* fixes) {
+    for (uint32_t i = 0; i < count; i++) {
+        from_nav_pv(&pv[i], &fixes[i]);
+    }
+};
+
+void GnssFixConvert::merge_nav_timeutc(const CasicNavTimeUtcView& time, GnssFix* fix) {
+    fix->msOfDay = gnss_fix_ms_of_day(time.hour(), time.min(), time.sec()) + time.ms();
+    fix->year    = time.year();
+    fix->month   = time.month();
+    fix->day     = time.day();
+    fix->valid   = (fix->valid & ~(GNSS_FIX_VALID_DATE | GNSS_FIX_VALID_TIME)) |
+                 (time.dateValid() ? GNSS_FIX_VALID_DATE : 0) |
+                 (time.valid() ? GNSS_FIX_VALID_TIME : 0);
+};
+
+static inline void gnss_fix_merge_time(const struct NmeaTime* time, GnssFix* fix) {
+    if (time->hours < 0) {
+        fix->valid &= ~GNSS_FIX_VALID_TIME;
+        return;
+    }
+    fix->msOfDay = gnss_fix_ms_of_day(time->hours, time->minutes, time->seconds) +
+                   time->microseconds / 1000;
+    fix->valid |= GNSS_FIX_VALID_TIME;
+};
+
+/**
+ * The part of merge_rmc after the coordinates, converted one by one or by batch.
+ */
+static void gnss_fix_merge_rmc(const struct NmeaSentenceDataRmc* rmc, int32_t lat, int32_t lon,
+                               GnssFix* fix) {
+    gnss_fix_merge_time(&rmc->time, fix);
+    fix->valid &= ~(GNSS_FIX_VALID_DATE | GNSS_FIX_VALID_POSITION | GNSS_FIX_VALID_MOTION);
+    if (rmc->date.year >= 0) {
+        fix->year  = GnssTime::year_from_nmea(rmc->date.year);
+        fix->month = rmc->date.month;
+        fix->day   = rmc->date.day;
+        fix->valid |= GNSS_FIX_VALID_DATE;
+    }
+    if (!rmc->valid) {
+        fix->fixType = GNSS_FIX_TYPE::NONE;
+        return;
+    }
+
+    if (lat != NMEA_COORD_UNKNOWN_E7 && lon != NMEA_COORD_UNKNOWN_E7) {
+        fix->lat = lat;
+        fix->lon = lon;
+        fix->valid |= GNSS_FIX_VALID_POSITION;
+    }
+    int64_t knots, course;  // 1e-3 kn and 1e-5 deg.
+    if (NmeaCoord::to_fixed(&rmc->speed, 1000, &knots) &&
+        NmeaCoord::to_fixed(&rmc->course, 100000, &course)) {
+        fix->gSpeed = (int32_t)((knots * GNSS_FIX_KNOT_MM_S_NUM + GNSS_FIX_KNOT_MM_S_DEN / 2) /
+                                GNSS_FIX_KNOT_MM_S_DEN);
+        fix->course = (int32_t)course;
+        fix->valid |= GNSS_FIX_VALID_MOTION;
+    }
+};
+
+void GnssFixConvert::merge_rmc(const struct NmeaSentenceDataRmc* rmc, GnssFix* fix) {
+    int32_t lat, lon;
+    if (!NmeaCoord::to_degrees_e7(&rmc->latitude, &lat)) lat = NMEA_COORD_UNKNOWN_E7;
+    if (!NmeaCoord::to_degrees_e7(&rmc->longitude, &lon)) lon = NMEA_COORD_UNKNOWN_E7;
+    gnss_fix_merge_rmc(rmc, lat, lon, fix);
+};
+
+/**
+ * Indexed by the GGA fix quality: invalid, GPS, DGPS, PPS, RTK fixed, RTK float, estimated,
+ * manual and simulation.
+ */
+static const GNSS_FIX_TYPE ggaFixTypes[9] = {
+    GNSS_FIX_TYPE::NONE,           GNSS_FIX_TYPE::FIX_3D, GNSS_FIX_TYPE::FIX_3D,
+    GNSS_FIX_TYPE::FIX_3D,         GNSS_FIX_TYPE::FIX_3D, GNSS_FIX_TYPE::FIX_3D,
+    GNSS_FIX_TYPE::DEAD_RECKONING, GNSS_FIX_TYPE::NONE,   GNSS_FIX_TYPE::NONE,
+};
+static const GNSS_FIX_SOLUTION ggaSolutions[9] = {
+    GNSS_FIX_SOLUTION::AUTONOMOUS, GNSS_FIX_SOLUTION::AUTONOMOUS, GNSS_FIX_SOLUTION::DIFFERENTIAL,
+    GNSS_FIX_SOLUTION::AUTONOMOUS, GNSS_FIX_SOLUTION::RTK_FIXED,  GNSS_FIX_SOLUTION::RTK_FLOAT,
+    GNSS_FIX_SOLUTION::AUTONOMOUS, GNSS_FIX_SOLUTION::AUTONOMOUS, GNSS_FIX_SOLUTION::AUTONOMOUS,
+};
+
+static void gnss_fix_merge_gga(const struct NmeaSentenceDataGga* gga, int32_t lat, int32_t lon,
+                               GnssFix* fix) {
+    uint32_t quality = gga->fix_quality >= 0 && gga->fix_quality <= 8 ? gga->fix_quality : 0;
+    gnss_fix_merge_time(&gga->time, fix);
+    fix->fixType  = ggaFixTypes[quality];
+    fix->solution = ggaSolutions[quality];
+    fix->numSV    = gga->satellites_tracked < 0     ? 0
+                    : gga->satellites_tracked > 255 ? 255
+                                                    : gga->satellites_tracked;
+
+    int64_t hdop;
+    fix->hDOP = NmeaCoord::to_fixed(&gga->hdop, 100, &hdop) ? (uint16_t)hdop : 0;
+
+    fix->valid &= ~(GNSS_FIX_VALID_POSITION | GNSS_FIX_VALID_HEIGHT);
+    if (fix->fixType == GNSS_FIX_TYPE::NONE) return;
+
+    if (lat != NMEA_COORD_UNKNOWN_E7 && lon != NMEA_COORD_UNKNOWN_E7) {
+        fix->lat = lat;
+        fix->lon = lon;
+        fix->valid |= GNSS_FIX_VALID_POSITION;
+    }
+    int64_t altitude, separation;  // mm
+    if (NmeaCoord::to_fixed(&gga->altitude, 1000, &altitude) &&
+        NmeaCoord::to_fixed(&gga->height, 1000, &separation)) {
+        fix->hMSL   = (int32_t)altitude;
+        fix->height = (int32_t)(altitude + separation);
+        fix->valid |= GNSS_FIX_VALID_HEIGHT;
+    }
+};
+
+void GnssFixConvert::merge_gga(const struct NmeaSentenceDataGga* gga, GnssFix* fix) {
+    int32_t lat, lon;
+    if (!NmeaCoord::to_degrees_e7(&gga->latitude, &lat)) lat = NMEA_COORD_UNKNOWN_E7;
+    if (!NmeaCoord::to_degrees_e7(&gga->longitude, &lon)) lon = NMEA_COORD_UNKNOWN_E7;
+    gnss_fix_merge_gga(gga, lat, lon, fix);
+};
+
+/**
+ * The coordinates of a log are gathered by blocks and converted by the batch conversion of
+ * NmeaCoord, which runs 4 lanes at a time where the target allows.
+ */
+void GnssFixConvert::merge_rmc(const struct NmeaSentenceDataRmc* rmc, uint32_t count,
+                               GnssFix* fixes) {
+    struct NmeaFloat coords[2][GNSS_FIX_BATCH_SIZE];
+    int32_t          degrees[2][GNSS_FIX_BATCH_SIZE];
+    for (uint32_t base = 0; base < count; base += GNSS_FIX_BATCH_SIZE) {
+        uint32_t n = count - base < GNSS_FIX_BATCH_SIZE ? count - base : GNSS_FIX_BATCH_SIZE;
+        for (uint32_t i = 0; i < n; i++) {
+            coords[0][i] = rmc[base + i].latitude;
+            coords[1][i] = rmc[base + i].longitude;
+        }
+        NmeaCoord::to_degrees_e7(coords[0], n, degrees[0]);
+        NmeaCoord::to_degrees_e7(coords[1], n, degrees[1]);
+        for (uint32_t i = 0; i < n; i++) {
+            gnss_fix_merge_rmc(&rmc[base + i], degrees[0][i], degrees[1][i], &fixes[base + i]);
+        }
+    }
+};
+
+void GnssFixConvert::merge_gga(const struct NmeaSentenceDataGga* gga, uint32_t count,
+                               GnssFix* fixes) {
+    struct NmeaFloat coords[2][GNSS_FIX_BATCH_SIZE];
+    int32_t          degrees[2][GNSS_FIX_BATCH_SIZE];
+    for (uint32_t base = 0; base < count; base += GNSS_FIX_BATCH_SIZE) {
+        uint32_t n = count - base < GNSS_FIX_BATCH_SIZE ? count - base : GNSS_FIX_BATCH_SIZE;
+        for (uint32_t i = 0; i < n; i++) {
+            coords[0][i] = gga[base + i].latitude;
+            coords[1][i] = gga[base + i].longitude;
+        }
+        NmeaCoord::to_degrees_e7(coords[0], n, degrees[0]);
+        NmeaCoord::to_degrees_e7(coords[1], n, degrees[1]);
+        for (uint32_t i = 0; i < n; i++) {
+            gnss_fix_merge_gga(&gga[base + i], degrees[0][i], degrees[1][i], &fixes[base + i]);
+        }
+    }
+};
+
+}  // namespace wibot::protocal::gnss
@@ -0,0 +1,104 @@
+#ifndef __WWTALK_GNSS_GNSS_FIX_HPP__
+#define __WWTALK_GNSS_GNSS_FIX_HPP__
+#include "base.hpp"
+#include "casic.hpp"
+#include "nmea.hpp"
+#include "ubx.hpp"
+namespace wibot::protocal::gnss {
+
+/**
+ * Values of UbxFrameNavPvt::fixType.
+ */
+enum class GNSS_FIX_TYPE : uint8_t {
+    NONE = 0,
+    DEAD_RECKONING,
+    FIX_2D,
+    FIX_3D,
+    GNSS_DEAD_RECKONING,
+    TIME_ONLY,
+};
+
+enum class GNSS_FIX_SOLUTION : uint8_t {
+    AUTONOMOUS = 0,
+    DIFFERENTIAL,
+    RTK_FLOAT,
+    RTK_FIXED,
+};
+
+#define GNSS_FIX_VALID_DATE 0x01
+#define GNSS_FIX_VALID_TIME 0x02
+#define GNSS_FIX_VALID_POSITION 0x04  // lat and lon.
+#define GNSS_FIX_VALID_HEIGHT 0x08    // height and hMSL.
+#define GNSS_FIX_VALID_VELOCITY 0x10  // velN, velE and velD.
+#define GNSS_FIX_VALID_MOTION 0x20    // gSpeed and course.
+#define GNSS_FIX_VALID_ACCURACY 0x40  // hAcc, vAcc and sAcc.
+
+/**
+ * A fix in the units of UBX NAV-PVT, whatever the receiver, in one 64-byte cache line. Fields
+ * are meaningful only when their flag is set in valid. Time is UTC.
+ */
+struct GnssFix {
+    int32_t  lat;     // 1e-7 deg
+    int32_t  lon;     // 1e-7 deg
+    int32_t  height;  // mm above the ellipsoid.
+    int32_t  hMSL;    // mm above mean sea level.
+    int32_t  velN;    // mm/s
+    int32_t  velE;    // mm/s
+    int32_t  velD;    // mm/s
+    int32_t  gSpeed;  // mm/s
+    int32_t  course;  // 1e-5 deg, heading of motion.
+    uint32_t hAcc;    // mm
+    uint32_t vAcc;    // mm
+    uint32_t sAcc;    // mm/s
+    uint32_t msOfDay;
+    uint16_t year;
+    uint8_t  month;
+    uint8_t  day;
+    uint16_t pDOP;  // 0.01, 0 if unknown.
+    uint16_t hDOP;  // 0.01, 0 if unknown.
+
+    GNSS_FIX_TYPE     fixType;
+    GNSS_FIX_SOLUTION solution;
+    uint8_t           numSV;
+    uint8_t           valid;  // GNSS_FIX_VALID_*.
+
+    void reset();
+};
+
+/**
+ * Conversions to GnssFix, integer except for the float and double fields of CASIC. from_*
+ * fill a whole fix from a message that carries it, merge_* update the fields of a message that
+ * carries a part of it, as RMC and GGA of the same epoch. The batch versions convert the
+ * records of a log, fixes[i] from records[i].
+ */
+class GnssFixConvert {
+   public:
+    static void from_nav_pvt(const struct UbxFrameNavPvt* pvt, GnssFix* fix);
+    static void from_nav_pvt(const struct UbxFrameNavPvt* pvt, uint32_t count, GnssFix* fixes);
+
+    /**
+     * NAV-PV has no UTC time, merge NAV-TIMEUTC for it.
+     */
+    static void from_nav_pv(const struct CasicFrameNavPv* pv, GnssFix* fix);
+    static void from_nav_pv(const struct CasicFrameNavPv* pv, uint32_t count, GnssFix* fixes);
+    static void merge_nav_timeutc(const CasicNavTimeUtcView& time, GnssFix* fix);
+
+    /**
+     * Date, time, position, speed and course. The fix type is left to GGA, except for a void
+     * RMC which clears it.
+     */
+    static void merge_rmc(const struct NmeaSentenceDataRmc* rmc, GnssFix* fix);
+    static void merge_rmc(const struct NmeaSentenceDataRmc* rmc, uint32_t count,
+                          GnssFix* fixes);
+
+    /**
+     * Time, position, heights, fix type and solution, satellites and HDOP.
+     */
+    static void merge_gga(const struct NmeaSentenceDataGga* gga, GnssFix* fix);
+    static void merge_gga(const struct NmeaSentenceDataGga* gga, uint32_t count,
+                          GnssFix* fixes);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_GNSS_FIX_HPP__
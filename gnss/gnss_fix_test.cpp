@@ -0,0 +1,193 @@
+#include "gnss_fix_test.hpp"
+
+#include "gnss_fix.hpp"
+#include "minunit.h"
+#include "nmea.hpp"
+#include "string.h"
+
+namespace wibot::protocal::gnss::test {
+
+static void gnss_fix_ubx_test() {
+    struct UbxFrameNavPvt pvt;
+    memset(&pvt, 0, sizeof(pvt));
+    pvt.year        = 2026;
+    pvt.month       = 10;
+    pvt.day         = 18;
+    pvt.hour        = 12;
+    pvt.min         = 34;
+    pvt.sec         = 56;
+    pvt.valid.valid = 0x07;
+    pvt.nano        = -1500000;  // 55.9985 s
+    pvt.fixType     = 3;
+    pvt.flags.flags = 0x01 | 0x02 | (2 << 6);
+    pvt.numSV       = 21;
+    pvt.lon         = -1140388300;
+    pvt.lat         = 511163770;
+    pvt.height      = 1065000;
+    pvt.hMSL        = 1082000;
+    pvt.hAcc        = 14;
+    pvt.velN        = -120;
+    pvt.velD        = 5;
+    pvt.gSpeed      = 120;
+    pvt.heading     = 18000000;
+    pvt.pDOP        = 123;
+
+    GnssFix fix;
+    GnssFixConvert::from_nav_pvt(&pvt, &fix);
+    MU_ASSERT(fix.lat == 511163770 && fix.lon == -1140388300);
+    MU_ASSERT(fix.height == 1065000 && fix.hMSL == 1082000 && fix.hAcc == 14);
+    MU_ASSERT(fix.velN == -120 && fix.velD == 5 && fix.gSpeed == 120 && fix.course == 18000000);
+    MU_ASSERT(fix.year == 2026 && fix.month == 10 && fix.day == 18);
+    MU_ASSERT(fix.msOfDay == (12 * 3600 + 34 * 60 + 55) * 1000 + 999);  // rounded.
+    MU_ASSERT(fix.pDOP == 123 && fix.hDOP == 0 && fix.numSV == 21);
+    MU_ASSERT(fix.fixType == GNSS_FIX_TYPE::FIX_3D);
+    MU_ASSERT(fix.solution == GNSS_FIX_SOLUTION::RTK_FIXED);
+    MU_ASSERT(fix.valid == (GNSS_FIX_VALID_DATE | GNSS_FIX_VALID_TIME | GNSS_FIX_VALID_POSITION |
+                            GNSS_FIX_VALID_HEIGHT | GNSS_FIX_VALID_VELOCITY |
+                            GNSS_FIX_VALID_MOTION | GNSS_FIX_VALID_ACCURACY));
+
+    // Without gnssFixOK, only the time and the accuracy are kept.
+    pvt.flags.flags = 0x02;
+    pvt.valid.valid = 0x02;
+    pvt.hour        = 0;
+    pvt.min         = 0;
+    pvt.sec         = 0;
+    pvt.nano        = -700000;
+    struct UbxFrameNavPvt log[3] = {pvt, pvt, pvt};
+    GnssFix               fixes[3];
+    GnssFixConvert::from_nav_pvt(log, 3, fixes);
+    MU_ASSERT(fixes[2].valid == (GNSS_FIX_VALID_TIME | GNSS_FIX_VALID_ACCURACY));
+    MU_ASSERT(fixes[2].solution == GNSS_FIX_SOLUTION::DIFFERENTIAL);
+    MU_ASSERT(fixes[2].msOfDay == 0);  // clamped at midnight.
+}
+
+static void gnss_fix_casic_test() {
+    struct CasicFrameNavPv pv;
+    memset(&pv, 0, sizeof(pv));
+    pv.posValid = 7;
+    pv.velValid = 7;
+    pv.numSV    = 17;
+    pv.pDop     = 1.25f;
+    pv.lat      = 22.5431234;
+    pv.lon      = 113.9481235;
+    pv.height   = 52.345f;
+    pv.sepGeoid = -2.5f;
+    pv.hAcc     = 1.5f;
+    pv.velN     = 1.25f;
+    pv.velU     = 0.5f;
+    pv.speed2D  = 1.25f;
+    pv.heading  = 359.5f;
+
+    GnssFix fix;
+    GnssFixConvert::from_nav_pv(&pv, &fix);
+    MU_ASSERT(fix.lat == 225431234 && fix.lon == 1139481235);
+    MU_ASSERT(fix.height == 52345 && fix.hMSL == 54845);
+    MU_ASSERT(fix.velN == 1250 && fix.velD == -500 && fix.gSpeed == 1250);
+    MU_ASSERT(fix.course == 35950000 && fix.hAcc == 1500 && fix.pDOP == 125);
+    MU_ASSERT(fix.fixType == GNSS_FIX_TYPE::FIX_3D && fix.numSV == 17);
+    MU_ASSERT(fix.valid == (GNSS_FIX_VALID_POSITION | GNSS_FIX_VALID_HEIGHT |
+                            GNSS_FIX_VALID_VELOCITY | GNSS_FIX_VALID_MOTION |
+                            GNSS_FIX_VALID_ACCURACY));
+
+    uint8_t time[24];
+    memset(time, 0, sizeof(time));
+    time[12] = 250 & 0xFF;  // ms
+    time[14] = 2026 & 0xFF;
+    time[15] = 2026 >> 8;
+    time[16] = 10;
+    time[17] = 18;
+    time[18] = 1;
+    time[19] = 2;
+    time[20] = 3;
+    time[21] = 1;
+    time[23] = 1;
+    GnssFixConvert::merge_nav_timeutc(CasicNavTimeUtcView(time), &fix);
+    MU_ASSERT(fix.year == 2026 && fix.month == 10 && fix.day == 18);
+    MU_ASSERT(fix.msOfDay == 3723250);
+    MU_ASSERT(fix.valid & GNSS_FIX_VALID_DATE && fix.valid & GNSS_FIX_VALID_TIME);
+    MU_ASSERT(fix.valid & GNSS_FIX_VALID_POSITION);
+
+    // A 2D fix has no height, and a kept position no fix.
+    struct CasicFrameNavPv log[2] = {pv, pv};
+    log[0].posValid               = 6;
+    log[1].posValid               = 3;
+    log[1].velValid               = 0;
+    GnssFix fixes[2];
+    GnssFixConvert::from_nav_pv(log, 2, fixes);
+    MU_ASSERT(fixes[0].fixType == GNSS_FIX_TYPE::FIX_2D);
+    MU_ASSERT(!(fixes[0].valid & GNSS_FIX_VALID_HEIGHT));
+    MU_ASSERT(fixes[1].fixType == GNSS_FIX_TYPE::NONE);
+    MU_ASSERT(fixes[1].valid == GNSS_FIX_VALID_ACCURACY);
+}
+
+static void gnss_fix_nmea_test() {
+    NmeaSentenceRMC            rmcEntry;
+    NmeaSentenceGGA            ggaEntry;
+    struct NmeaSentenceDataRmc rmc;
+    struct NmeaSentenceDataGga gga;
+    MU_ASSERT(rmcEntry.parse(&rmc, "$GPRMC,123519.25,A,4807.038,N,01131.000,E,022.4,084.4,230394,"
+                                   "003.1,W*6A"));
+    MU_ASSERT(ggaEntry.parse(&gga, "$GPGGA,123519,4807.038,N,01131.000,W,4,08,0.9,545.4,M,46.9,"
+                                   "M,,*47"));
+
+    GnssFix fix;
+    fix.reset();
+    GnssFixConvert::merge_rmc(&rmc, &fix);
+    MU_ASSERT(fix.lat == 481173000 && fix.lon == 115166667);
+    MU_ASSERT(fix.year == 1994 && fix.month == 3 && fix.day == 23);
+    MU_ASSERT(fix.msOfDay == (12 * 3600 + 35 * 60 + 19) * 1000 + 250);
+    MU_ASSERT(fix.gSpeed == 11524 && fix.course == 8440000);  // 22.4 kn is 11.5236 m/s.
+    MU_ASSERT(fix.valid == (GNSS_FIX_VALID_DATE | GNSS_FIX_VALID_TIME | GNSS_FIX_VALID_POSITION |
+                            GNSS_FIX_VALID_MOTION));
+
+    GnssFixConvert::merge_gga(&gga, &fix);
+    MU_ASSERT(fix.lon == -115166667 && fix.hMSL == 545400 && fix.height == 592300);
+    MU_ASSERT(fix.fixType == GNSS_FIX_TYPE::FIX_3D);
+    MU_ASSERT(fix.solution == GNSS_FIX_SOLUTION::RTK_FIXED);
+    MU_ASSERT(fix.numSV == 8 && fix.hDOP == 90 && fix.msOfDay == 45319000);
+    MU_ASSERT(fix.valid & GNSS_FIX_VALID_HEIGHT && fix.valid & GNSS_FIX_VALID_MOTION);
+
+    // A void RMC, or a GGA without fix, drop the position.
+    rmc.valid = false;
+    GnssFixConvert::merge_rmc(&rmc, &fix);
+    MU_ASSERT(fix.fixType == GNSS_FIX_TYPE::NONE);
+    MU_ASSERT(!(fix.valid & (GNSS_FIX_VALID_POSITION | GNSS_FIX_VALID_MOTION)));
+    gga.fix_quality = 0;
+    GnssFixConvert::merge_gga(&gga, &fix);
+    MU_ASSERT(!(fix.valid & (GNSS_FIX_VALID_POSITION | GNSS_FIX_VALID_HEIGHT)));
+
+    // Batches, across the block size and with invalid coordinates, match record by record.
+    static struct NmeaSentenceDataRmc rmcLog[150];
+    static struct NmeaSentenceDataGga ggaLog[150];
+    static GnssFix                    batch[150];
+    static GnssFix                    single[150];
+    MU_ASSERT(rmcEntry.parse(&rmc, "$GPRMC,123519.25,A,4807.038,N,01131.000,E,022.4,084.4,230394,"
+                                   "003.1,W*6A"));
+    gga.fix_quality = 1;
+    for (uint32_t i = 0; i < 150; i++) {
+        rmcLog[i]                 = rmc;
+        rmcLog[i].latitude.value  = 4807038 - (int32_t)i * 7919;
+        rmcLog[i].longitude.value = -1131000 + (int32_t)i * 104729;
+        rmcLog[i].longitude.scale = i % 5 == 0 ? 0 : 1000;
+        ggaLog[i]                 = gga;
+        ggaLog[i].latitude        = rmcLog[i].longitude;
+        ggaLog[i].longitude       = rmcLog[i].latitude;
+        batch[i].reset();
+        single[i].reset();
+    }
+    GnssFixConvert::merge_rmc(rmcLog, 150, batch);
+    GnssFixConvert::merge_gga(ggaLog, 150, batch);
+    for (uint32_t i = 0; i < 150; i++) {
+        GnssFixConvert::merge_rmc(&rmcLog[i], &single[i]);
+        GnssFixConvert::merge_gga(&ggaLog[i], &single[i]);
+    }
+    MU_ASSERT(!memcmp(batch, single, sizeof(batch)));
+}
+
+void gnss_fix_test() {
+    gnss_fix_ubx_test();
+    gnss_fix_casic_test();
+    gnss_fix_nmea_test();
+};
+
+}  // namespace wibot::protocal::gnss::test
@@ -0,0 +1,201 @@
+#ifndef __WWTALK_GNSS_FRAMER_HPP__
+#define __WWTALK_GNSS_FRAMER_HPP__
+#include "CircularBuffer.hpp"
+#include "base.hpp"
+namespace wibot::protocal::gnss {
+
+enum class GNSS_FRAMER_STAGE : uint8_t {
+    SYNC = 0,  // seeking the sync chars.
+    HEADER,    // the fields up to the length of the frame.
+    PAYLOAD,   // the checksummed bytes, the header included.
+    CHECKSUM,
+};
+
+/**
+ * The state machine of the binary framers: sync chars, a header announcing the payload length,
+ * the payload and a checksum. The checksum is updated as bytes arrive, in one call over the
+ * bytes contiguous in the ring, so every byte is read once, and the frame stays in the ring
+ * until the next parse. Frames longer than the payload buffer, or than the ring, are dropped
+ * as soon as their header is read, which bounds the bytes held before resyncing on a corrupted
+ * length.
+ *
+ * A protocol is described by its Traits:
+ * - Frame, with length and payload fields, and Checksum, with reset() and update() over a byte
+ *   and over a span.
+ * - SYNC_SIZE bytes of SYNC, compared under SYNC_MASK.
+ * - HEADER_SIZE, the bytes decoded by header(header, &headerLength, &length, frame), which
+ *   fills the header fields of frame, false if the lengths are invalid.
+ * - CHECKSUM_START, the first checksummed byte, and CHECKSUM_SIZE, the bytes after the
+ *   payload that check(checksum, bytes) compares.
+ * - complete(frame), for the fields read from the payload.
+ */
+template <typename Traits>
+class GnssFramer {
+   public:
+    typedef typename Traits::Frame Frame;
+
+    /**
+     * @param payloadBuffer Receives the payloads that wrap around the end of the ring, its
+     * size is the longest accepted payload.
+     */
+    GnssFramer(CircularBuffer8& buffer, Buffer8 payloadBuffer)
+        : frameCount(0),
+          checksumErrors(0),
+          lengthErrors(0),
+          droppedBytes(0),
+          _buffer(buffer),
+          _payloadBuffer(payloadBuffer),
+          _pending(0) {
+        reset();
+    };
+
+    /**
+     * Release the previous frame, then frame the bytes received so far.
+     * @return Return true if a frame is complete, false if more bytes are needed.
+     */
+    bool parse(Frame* frame);
+
+    /**
+     * Restart from the sync chars, keep the bytes of the ring.
+     */
+    void reset() {
+        _stage        = GNSS_FRAMER_STAGE::SYNC;
+        _offset       = 0;
+        _headerLength = 0;
+        _length       = 0;
+    };
+
+    uint32_t frameCount;
+    uint32_t checksumErrors;
+    uint32_t lengthErrors;
+    uint32_t droppedBytes;
+
+   private:
+    CircularBuffer8&          _buffer;
+    Buffer8                   _payloadBuffer;
+    GNSS_FRAMER_STAGE         _stage;
+    uint32_t                  _offset;  // bytes of the current frame read so far.
+    uint32_t                  _headerLength;
+    uint32_t                  _length;
+    uint32_t                  _pending;  // bytes of the last frame, released by the next parse.
+    typename Traits::Checksum _checksum;
+    Frame                     _frame;  // the header fields of the current frame.
+
+    inline uint8_t _at(uint32_t offset) {
+        return *_buffer.peekPtr(offset);
+    };
+
+    /**
+     * @return Return true if the first bytes of the ring may start the sync chars.
+     */
+    inline bool _synced(uint32_t size) {
+        for (uint32_t i = 0; i < Traits::SYNC_SIZE && i < size; i++) {
+            if ((_at(i) & Traits::SYNC_MASK[i]) != Traits::SYNC[i]) return false;
+        }
+        return true;
+    };
+
+    void _resync() {
+        // Drop the first sync char, the frame may start anywhere after it.
+        _buffer.readVirtual(1);
+        droppedBytes++;
+        reset();
+    };
+};
+
+template <typename Traits>
+bool GnssFramer<Traits>::parse(Frame* frame) {
+    if (_pending) {
+        _buffer.readVirtual(_pending);
+        _pending = 0;
+    }
+
+    while (true) {
+        uint32_t size = _buffer.getSize();
+        switch (_stage) {
+            case GNSS_FRAMER_STAGE::SYNC: {
+                // Keep the bytes that may start the sync chars, drop the others.
+                while (size > 0 && !_synced(size)) {
+                    _buffer.readVirtual(1);
+                    droppedBytes++;
+                    size--;
+                }
+                if (size < Traits::SYNC_SIZE) return false;
+                _stage = GNSS_FRAMER_STAGE::HEADER;
+            } break;
+
+            case GNSS_FRAMER_STAGE::HEADER: {
+                if (size < Traits::HEADER_SIZE) return false;
+
+                // The fields are read in place unless the header wraps around the ring.
+                uint8_t        copy[Traits::HEADER_SIZE];
+                const uint8_t* header = _buffer.peekPtr(0);
+                if (_buffer.peekPtr(Traits::HEADER_SIZE - 1) != header + Traits::HEADER_SIZE - 1) {
+                    _buffer.peek(copy, 0, Traits::HEADER_SIZE);
+                    header = copy;
+                }
+                // A frame must fit in the ring too, the rest of a longer one never arrives.
+                if (!Traits::header(header, &_headerLength, &_length, &_frame) ||
+                    _length > _payloadBuffer.size ||
+                    _headerLength + Traits::CHECKSUM_SIZE + _length > _buffer.getCapacity()) {
+                    lengthErrors++;
+                    _resync();
+                    break;
+                }
+                _checksum.reset();
+                _offset = Traits::CHECKSUM_START;
+                _stage  = GNSS_FRAMER_STAGE::PAYLOAD;
+            } break;
+
+            case GNSS_FRAMER_STAGE::PAYLOAD: {
+                uint32_t end  = _headerLength + _length;
+                uint32_t stop = size < end ? size : end;
+                if (_offset < stop) {
+                    // Bytes contiguous in the ring are checked in one go, only a span across
+                    // the end of the ring is read byte by byte.
+                    const uint8_t* first = _buffer.peekPtr(_offset);
+                    if (_buffer.peekPtr(stop - 1) == first + (stop - 1 - _offset)) {
+                        _checksum.update(first, stop - _offset);
+                        _offset = stop;
+                    }
+                }
+                for (; _offset < stop; _offset++) {
+                    _checksum.update(_at(_offset));
+                }
+                if (_offset < end) return false;
+                _stage = GNSS_FRAMER_STAGE::CHECKSUM;
+            } break;
+
+            case GNSS_FRAMER_STAGE::CHECKSUM: {
+                if (size < _offset + Traits::CHECKSUM_SIZE) return false;
+
+                uint8_t checksum[Traits::CHECKSUM_SIZE];
+                _buffer.peek(checksum, _offset, Traits::CHECKSUM_SIZE);
+                if (!Traits::check(_checksum, checksum)) {
+                    checksumErrors++;
+                    _resync();
+                    break;
+                }
+
+                *frame         = _frame;
+                frame->length  = _length;
+                frame->payload = _buffer.peekPtr(_headerLength);
+                if (_length > 0 && _buffer.peekPtr(_headerLength + _length - 1) !=
+                                       frame->payload + _length - 1) {
+                    _buffer.peek(_payloadBuffer.data, _headerLength, _length);
+                    frame->payload = _payloadBuffer.data;
+                }
+                Traits::complete(frame);
+
+                _pending = _offset + Traits::CHECKSUM_SIZE;
+                frameCount++;
+                reset();
+                return true;
+            }
+        }
+    }
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_FRAMER_HPP__
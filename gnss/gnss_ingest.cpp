@@ -0,0 +1,181 @@
+#include "gnss_ingest.hpp"
+
+namespace wibot::protocal::gnss {
+
+#define GNSS_INGEST_STATE_SCHEDULED 0x01  // queued or running.
+#define GNSS_INGEST_STATE_PENDING 0x02    // bytes written since the last run started.
+
+static_assert((GNSS_INGEST_QUEUE_SIZE & (GNSS_INGEST_QUEUE_SIZE - 1)) == 0,
+              "GNSS_INGEST_QUEUE_SIZE must be a power of 2");
+static_assert(GNSS_INGEST_QUEUE_SIZE >= GNSS_INGEST_STREAM_MAX_COUNT,
+              "a queue must hold every stream");
+static_assert(GNSS_INGEST_STREAM_MAX_COUNT <= 255, "streams are queued as uint8_t");
+
+GnssIngestQueue::GnssIngestQueue() : _head(0), _tail(0) {
+    for (uint32_t i = 0; i < GNSS_INGEST_QUEUE_SIZE; i++) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+};
+
+bool GnssIngestQueue::push(uint8_t stream) {
+    uint32_t position = _head.load(std::memory_order_relaxed);
+    while (true) {
+        Cell*   cell = &_cells[position & (GNSS_INGEST_QUEUE_SIZE - 1)];
+        int32_t diff = (int32_t)(cell->sequence.load(std::memory_order_acquire) - position);
+        if (diff == 0) {
+            if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell->stream = stream;
+                cell->sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            position = _head.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+bool GnssIngestQueue::pop(uint8_t* stream) {
+    uint32_t position = _tail.load(std::memory_order_relaxed);
+    while (true) {
+        Cell*   cell = &_cells[position & (GNSS_INGEST_QUEUE_SIZE - 1)];
+        int32_t diff = (int32_t)(cell->sequence.load(std::memory_order_acquire) - (position + 1));
+        if (diff == 0) {
+            if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                *stream = cell->stream;
+                cell->sequence.store(position + GNSS_INGEST_QUEUE_SIZE, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            position = _tail.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+GnssIngest::GnssIngest(uint32_t workerCount) : _streamCount(0), _scheduled(0) {
+    if (workerCount < 1) workerCount = 1;
+    if (workerCount > GNSS_INGEST_WORKER_MAX_COUNT) workerCount = GNSS_INGEST_WORKER_MAX_COUNT;
+    _workerCount = workerCount;
+    for (uint32_t i = 0; i < GNSS_INGEST_WORKER_MAX_COUNT; i++) {
+        _workers[i].runCount   = 0;
+        _workers[i].stealCount = 0;
+    }
+};
+
+bool GnssIngest::stream_register(CircularBuffer8& buffer, Buffer8 inbox,
+                                 GnssIngestHandler handler, void* context, uint32_t* stream) {
+    if (_streamCount >= GNSS_INGEST_STREAM_MAX_COUNT || inbox.size == 0 ||
+        (inbox.size & (inbox.size - 1)) != 0) {
+        return false;
+    }
+    Stream* s        = &_streams[_streamCount];
+    s->buffer        = &buffer;
+    s->inbox         = inbox.data;
+    s->mask          = inbox.size - 1;
+    s->handler       = handler;
+    s->context       = context;
+    s->overflowBytes = 0;
+    s->state.store(0, std::memory_order_relaxed);
+    s->home.store(_streamCount % _workerCount, std::memory_order_relaxed);
+    s->head.store(0, std::memory_order_relaxed);
+    s->tail.store(0, std::memory_order_relaxed);
+    *stream = _streamCount++;
+    return true;
+};
+
+uint32_t GnssIngest::write(uint32_t stream, const uint8_t* data, uint32_t length) {
+    Stream*  s    = &_streams[stream];
+    uint32_t head = s->head.load(std::memory_order_relaxed);
+    uint32_t free = s->mask + 1 - (head - s->tail.load(std::memory_order_acquire));
+    if (length > free) {
+        s->overflowBytes += length - free;
+        length = free;
+    }
+    if (length == 0) return 0;
+
+    // Two spans at most, up to the end of the inbox and from its start.
+    uint32_t index = head & s->mask;
+    uint32_t first = s->mask + 1 - index;
+    if (first > length) first = length;
+    memcpy(s->inbox + index, data, first);
+    memcpy(s->inbox, data + first, length - first);
+    s->head.store(head + length, std::memory_order_release);
+
+    uint8_t state = s->state.fetch_or(GNSS_INGEST_STATE_SCHEDULED | GNSS_INGEST_STATE_PENDING,
+                                      std::memory_order_acq_rel);
+    if (!(state & GNSS_INGEST_STATE_SCHEDULED)) {
+        _scheduled.fetch_add(1, std::memory_order_relaxed);
+        _workers[s->home.load(std::memory_order_relaxed)].queue.push(stream);
+    }
+    return length;
+};
+
+bool GnssIngest::worker_poll(uint32_t worker) {
+    uint8_t stream;
+    if (_workers[worker].queue.pop(&stream)) {
+        _run(stream, worker);
+        return true;
+    }
+    for (uint32_t i = 1; i < _workerCount; i++) {
+        uint32_t victim = worker + i;
+        if (victim >= _workerCount) victim -= _workerCount;
+        if (_workers[victim].queue.pop(&stream)) {
+            // The stream stays with its new worker, its state is now in that cache.
+            _streams[stream].home.store(worker, std::memory_order_relaxed);
+            _workers[worker].stealCount++;
+            _run(stream, worker);
+            return true;
+        }
+    }
+    return false;
+};
+
+void GnssIngest::_run(uint32_t index, uint32_t worker) {
+    Stream* s = &_streams[index];
+    s->state.fetch_and(~GNSS_INGEST_STATE_PENDING, std::memory_order_acquire);
+
+    uint32_t head = s->head.load(std::memory_order_acquire);
+    uint32_t tail = s->tail.load(std::memory_order_relaxed);
+    while (tail != head) {
+        uint32_t offset = tail & s->mask;
+        uint32_t span   = s->mask + 1 - offset;
+        if (span > head - tail) span = head - tail;
+        uint32_t written = s->buffer->write(s->inbox + offset, span, false);
+        tail += written;
+        if (written < span) break;  // the ring is full, the rest waits for the next run.
+    }
+    s->tail.store(tail, std::memory_order_release);
+
+    s->handler(s->context, *s->buffer);
+    _workers[worker].runCount++;
+
+    // Bytes left in the inbox, or written during the run, run it again after the others.
+    uint8_t state = GNSS_INGEST_STATE_SCHEDULED;
+    if (tail != head ||
+        !s->state.compare_exchange_strong(state, 0, std::memory_order_acq_rel)) {
+        _workers[s->home.load(std::memory_order_relaxed)].queue.push(index);
+        return;
+    }
+    _scheduled.fetch_sub(1, std::memory_order_release);
+};
+
+bool GnssIngest::idle() const {
+    return _scheduled.load(std::memory_order_acquire) == 0;
+};
+
+uint32_t GnssIngest::overflow_bytes(uint32_t stream) const {
+    return _streams[stream].overflowBytes;
+};
+
+uint32_t GnssIngest::run_count(uint32_t worker) const {
+    return _workers[worker].runCount;
+};
+
+uint32_t GnssIngest::steal_count(uint32_t worker) const {
+    return _workers[worker].stealCount;
+};
+
+}  // namespace wibot::protocal::gnss
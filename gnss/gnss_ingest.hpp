@@ -0,0 +1,144 @@
+#ifndef __WWTALK_GNSS_GNSS_INGEST_HPP__
+#define __WWTALK_GNSS_GNSS_INGEST_HPP__
+#include <atomic>
+
+#include "CircularBuffer.hpp"
+#include "base.hpp"
+namespace wibot::protocal::gnss {
+
+#define GNSS_INGEST_STREAM_MAX_COUNT 64  // at most 255.
+#define GNSS_INGEST_WORKER_MAX_COUNT 16
+#define GNSS_INGEST_QUEUE_SIZE 64  // power of 2, at least GNSS_INGEST_STREAM_MAX_COUNT.
+#define GNSS_INGEST_CACHE_LINE 64
+
+/**
+ * Drain the ring of a stream, e.g. parse it with the UbxFramer, GnssDemux or MessageParser of
+ * the stream, which context points to. Called by one worker at a time for a stream.
+ */
+typedef void (*GnssIngestHandler)(void* context, CircularBuffer8& buffer);
+
+/**
+ * Bounded queue of stream indices, any thread pushes and pops. Every cell carries the position
+ * it is ready for, so a push or a pop is one compare and swap of a position without lock.
+ */
+class GnssIngestQueue {
+   public:
+    GnssIngestQueue();
+
+    /**
+     * @return Return false if the queue is full.
+     */
+    bool push(uint8_t stream);
+
+    /**
+     * @return Return false if the queue is empty.
+     */
+    bool pop(uint8_t* stream);
+
+   private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        uint8_t               stream;
+    };
+
+    alignas(GNSS_INGEST_CACHE_LINE) std::atomic<uint32_t> _head;  // next push.
+    alignas(GNSS_INGEST_CACHE_LINE) std::atomic<uint32_t> _tail;  // next pop.
+    Cell _cells[GNSS_INGEST_QUEUE_SIZE];
+};
+
+/**
+ * Parse the rings of many receivers with a few workers. A receiver is a stream: its producer,
+ * the thread that reads the port, writes bytes to the inbox of the stream, and a worker moves
+ * them to the ring of the stream and calls its handler. A worker pops the streams with pending
+ * bytes from its own queue first, then steals from the queues of the others, so idle ports
+ * cost no worker and busy ones spread over all of them.
+ *
+ * A stream is in one queue at most and run by one worker at a time, so its bytes are parsed in
+ * order without lock. It is queued to the last worker that ran it, which keeps its ring and
+ * parser state in the cache of that worker until another one steals it.
+ *
+ * No thread is created: the platform runs worker_poll from as many threads or tasks as the
+ * engine has workers, and decides what to do when there is nothing to poll. Streams are
+ * registered before the first write.
+ */
+class GnssIngest {
+   public:
+    /**
+     * @param workerCount 1 to GNSS_INGEST_WORKER_MAX_COUNT.
+     */
+    explicit GnssIngest(uint32_t workerCount);
+
+    /**
+     * @param inbox Bytes written and not yet moved to the ring, its size is a power of 2.
+     * @param stream Receives the index of the stream.
+     * @return Return false if the streams are full, or the inbox size is not a power of 2.
+     */
+    bool stream_register(CircularBuffer8& buffer, Buffer8 inbox, GnssIngestHandler handler,
+                         void* context, uint32_t* stream);
+
+    /**
+     * Queue bytes to a stream, from one producer per stream.
+     * @return Return the bytes accepted, less than length if the inbox is full.
+     */
+    uint32_t write(uint32_t stream, const uint8_t* data, uint32_t length);
+
+    /**
+     * Run one stream with pending bytes, from the queue of worker or stolen from another.
+     * @return Return false if no stream has pending bytes.
+     */
+    bool worker_poll(uint32_t worker);
+
+    /**
+     * @return Return true if no stream is queued or running.
+     */
+    bool idle() const;
+
+    uint32_t stream_count() const {
+        return _streamCount;
+    };
+    uint32_t worker_count() const {
+        return _workerCount;
+    };
+
+    /**
+     * Counters of a stream or a worker, exact once the producers and workers are stopped.
+     */
+    uint32_t overflow_bytes(uint32_t stream) const;
+    uint32_t run_count(uint32_t worker) const;
+    uint32_t steal_count(uint32_t worker) const;
+
+   private:
+    struct alignas(GNSS_INGEST_CACHE_LINE) Stream {
+        CircularBuffer8*  buffer;
+        uint8_t*          inbox;
+        uint32_t          mask;  // of the inbox.
+        GnssIngestHandler handler;
+        void*             context;
+
+        std::atomic<uint8_t> state;  // GNSS_INGEST_STATE_*.
+        std::atomic<uint8_t> home;   // the worker that queues it.
+
+        alignas(GNSS_INGEST_CACHE_LINE) std::atomic<uint32_t> head;  // written by the producer.
+        uint32_t overflowBytes;
+        alignas(GNSS_INGEST_CACHE_LINE) std::atomic<uint32_t> tail;  // moved by the workers.
+    };
+
+    struct alignas(GNSS_INGEST_CACHE_LINE) Worker {
+        GnssIngestQueue queue;
+        uint32_t        runCount;
+        uint32_t        stealCount;
+    };
+
+    Stream   _streams[GNSS_INGEST_STREAM_MAX_COUNT];
+    Worker   _workers[GNSS_INGEST_WORKER_MAX_COUNT];
+    uint32_t _streamCount;
+    uint32_t _workerCount;
+
+    std::atomic<uint32_t> _scheduled;  // streams queued or running.
+
+    void _run(uint32_t index, uint32_t worker);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_GNSS_INGEST_HPP__
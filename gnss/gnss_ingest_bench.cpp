@@ -0,0 +1,193 @@
+#include "gnss_ingest_bench.hpp"
+#ifdef __linux__
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "CircularBuffer.hpp"
+#include "gnss_ingest.hpp"
+#include "log.h"
+#include "minunit.h"
+#include "string.h"
+#include "ubx.hpp"
+#include "ubx_framer.hpp"
+
+LOGGER("gnss_ingest_bench")
+
+namespace wibot::protocal::gnss::test {
+
+#define GNSS_INGEST_BENCH_PAYLOAD_SIZE 92  // NAV-PVT.
+#define GNSS_INGEST_BENCH_FRAME_SIZE (GNSS_INGEST_BENCH_PAYLOAD_SIZE + UBX_FRAME_OVERHEAD)
+#define GNSS_INGEST_BENCH_BLOCK_FRAMES 40
+#define GNSS_INGEST_BENCH_FRAMES 40960  // of a run, whatever the number of streams.
+#define GNSS_INGEST_BENCH_CHUNK_SIZE 256
+#define GNSS_INGEST_BENCH_RING_SIZE 4096
+#define GNSS_INGEST_BENCH_INBOX_SIZE 4096
+
+struct GnssIngestBenchReceiver {
+    uint8_t         ring[GNSS_INGEST_BENCH_RING_SIZE];
+    uint8_t         inbox[GNSS_INGEST_BENCH_INBOX_SIZE];
+    uint8_t         scratch[GNSS_INGEST_BENCH_PAYLOAD_SIZE];
+    CircularBuffer8 buffer;
+    UbxFramer       framer;
+    uint32_t        frames;
+
+    GnssIngestBenchReceiver()
+        : buffer(ring, GNSS_INGEST_BENCH_RING_SIZE),
+          framer(buffer, {.data = scratch, .size = sizeof(scratch)}),
+          frames(0){};
+};
+
+static uint8_t benchBlock[GNSS_INGEST_BENCH_BLOCK_FRAMES * GNSS_INGEST_BENCH_FRAME_SIZE];
+static GnssIngestBenchReceiver benchReceivers[GNSS_INGEST_STREAM_MAX_COUNT];
+
+static uint64_t gnss_ingest_bench_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+};
+
+static void gnss_ingest_bench_handler(void* context, CircularBuffer8&) {
+    GnssIngestBenchReceiver* receiver = (GnssIngestBenchReceiver*)context;
+    UbxFrame                 frame;
+    while (receiver->framer.parse(&frame)) {
+        receiver->frames++;
+    }
+};
+
+static void gnss_ingest_bench_reset(uint32_t streams) {
+    for (uint32_t i = 0; i < streams; i++) {
+        GnssIngestBenchReceiver* receiver = &benchReceivers[i];
+        receiver->buffer.readVirtual(receiver->buffer.getSize());
+        receiver->framer.reset();
+        receiver->frames = 0;
+    }
+};
+
+static void gnss_ingest_bench_check(uint32_t streams) {
+    uint32_t frames = 0;
+    for (uint32_t i = 0; i < streams; i++) {
+        frames += benchReceivers[i].frames;
+        MU_ASSERT(benchReceivers[i].framer.checksumErrors == 0);
+    }
+    MU_ASSERT(frames == GNSS_INGEST_BENCH_FRAMES);
+};
+
+static void gnss_ingest_bench_log(const char* mode, uint32_t streams, uint32_t workers,
+                                  uint64_t elapsed, uint32_t steals) {
+    if (elapsed == 0) elapsed = 1;
+    double bytes = (double)GNSS_INGEST_BENCH_FRAMES * GNSS_INGEST_BENCH_FRAME_SIZE;
+    LOG_I("%s %2u streams, %2u threads: %.0f frames/s, %.1f MB/s, %u steals", mode, streams,
+          workers, GNSS_INGEST_BENCH_FRAMES * 1e9 / elapsed, bytes * 1e3 / elapsed, steals);
+};
+
+/**
+ * One producer feeds every stream a chunk at a time, as the reads of their ports would.
+ */
+static void gnss_ingest_bench_engine(uint32_t streams, uint32_t workers) {
+    GnssIngest ingest(workers);
+    gnss_ingest_bench_reset(streams);
+    for (uint32_t i = 0; i < streams; i++) {
+        uint32_t stream;
+        MU_ASSERT(ingest.stream_register(
+            benchReceivers[i].buffer,
+            {.data = benchReceivers[i].inbox, .size = GNSS_INGEST_BENCH_INBOX_SIZE},
+            gnss_ingest_bench_handler, &benchReceivers[i], &stream));
+    }
+
+    std::atomic<bool> stop(false);
+    std::thread       threads[GNSS_INGEST_WORKER_MAX_COUNT];
+    for (uint32_t w = 0; w < workers; w++) {
+        threads[w] = std::thread([&ingest, &stop, w]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (!ingest.worker_poll(w)) std::this_thread::yield();
+            }
+        });
+    }
+
+    uint32_t total = GNSS_INGEST_BENCH_FRAMES / streams * GNSS_INGEST_BENCH_FRAME_SIZE;
+    uint32_t offsets[GNSS_INGEST_STREAM_MAX_COUNT];
+    memset(offsets, 0, sizeof(offsets));
+    uint64_t start = gnss_ingest_bench_now();
+    for (uint32_t done = 0; done < streams;) {
+        uint32_t written = 0;
+        done             = 0;
+        for (uint32_t i = 0; i < streams; i++) {
+            uint32_t position = offsets[i] % sizeof(benchBlock);
+            uint32_t chunk    = GNSS_INGEST_BENCH_CHUNK_SIZE;
+            if (chunk > sizeof(benchBlock) - position) chunk = sizeof(benchBlock) - position;
+            if (chunk > total - offsets[i]) chunk = total - offsets[i];
+            uint32_t accepted = ingest.write(i, benchBlock + position, chunk);
+            offsets[i] += accepted;
+            written += accepted;
+            done += offsets[i] == total;
+        }
+        // Every inbox is full, a port would block on its read until the workers catch up.
+        if (written == 0) std::this_thread::yield();
+    }
+    while (!ingest.idle()) {
+        std::this_thread::yield();
+    }
+    uint64_t elapsed = gnss_ingest_bench_now() - start;
+    stop.store(true);
+    uint32_t steals = 0;
+    for (uint32_t w = 0; w < workers; w++) {
+        threads[w].join();
+        steals += ingest.steal_count(w);
+    }
+
+    gnss_ingest_bench_check(streams);
+    gnss_ingest_bench_log("engine", streams, workers, elapsed, steals);
+};
+
+/**
+ * The same bytes, read and parsed by a thread per stream.
+ */
+static void gnss_ingest_bench_threads(uint32_t streams) {
+    gnss_ingest_bench_reset(streams);
+    uint32_t    total = GNSS_INGEST_BENCH_FRAMES / streams * GNSS_INGEST_BENCH_FRAME_SIZE;
+    std::thread threads[GNSS_INGEST_STREAM_MAX_COUNT];
+    uint64_t    start = gnss_ingest_bench_now();
+    for (uint32_t i = 0; i < streams; i++) {
+        threads[i] = std::thread([i, total]() {
+            GnssIngestBenchReceiver* receiver = &benchReceivers[i];
+            for (uint32_t offset = 0; offset < total;) {
+                uint32_t position = offset % sizeof(benchBlock);
+                uint32_t chunk    = GNSS_INGEST_BENCH_CHUNK_SIZE;
+                if (chunk > sizeof(benchBlock) - position) chunk = sizeof(benchBlock) - position;
+                if (chunk > total - offset) chunk = total - offset;
+                offset += receiver->buffer.write(benchBlock + position, chunk, false);
+                gnss_ingest_bench_handler(receiver, receiver->buffer);
+            }
+        });
+    }
+    for (uint32_t i = 0; i < streams; i++) {
+        threads[i].join();
+    }
+    uint64_t elapsed = gnss_ingest_bench_now() - start;
+
+    gnss_ingest_bench_check(streams);
+    gnss_ingest_bench_log("thread per stream", streams, streams, elapsed, 0);
+};
+
+void gnss_ingest_bench() {
+    uint8_t payload[GNSS_INGEST_BENCH_PAYLOAD_SIZE];
+    for (uint32_t i = 0; i < GNSS_INGEST_BENCH_BLOCK_FRAMES; i++) {
+        memset(payload, i, sizeof(payload));
+        ubx_encode(benchBlock + i * GNSS_INGEST_BENCH_FRAME_SIZE, GNSS_INGEST_BENCH_FRAME_SIZE,
+                   UBX_CLASSID_NAV_PVT, payload, sizeof(payload));
+    }
+
+    LOG_I("%u hardware threads", std::thread::hardware_concurrency());
+    for (uint32_t streams = 1; streams <= GNSS_INGEST_STREAM_MAX_COUNT; streams *= 2) {
+        for (uint32_t workers = 1; workers <= 4; workers *= 2) {
+            gnss_ingest_bench_engine(streams, workers);
+        }
+        gnss_ingest_bench_threads(streams);
+    }
+};
+
+}  // namespace wibot::protocal::gnss::test
+
+#endif  // __linux__
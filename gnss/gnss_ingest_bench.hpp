@@ -0,0 +1,12 @@
+#ifndef __WWTALK_GNSS_INGEST_BENCH_HPP__
+#define __WWTALK_GNSS_INGEST_BENCH_HPP__
+
+namespace wibot::protocal::gnss::test {
+/**
+ * Throughput of GnssIngest from 1 to 64 UBX streams and 1 to 4 workers, against a thread per
+ * stream.
+ */
+void gnss_ingest_bench();
+}
+
+#endif  // __WWTALK_GNSS_INGEST_BENCH_HPP__
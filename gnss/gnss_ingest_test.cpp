@@ -0,0 +1,160 @@
+#include "gnss_ingest_test.hpp"
+
+#include "CircularBuffer.hpp"
+#include "gnss_ingest.hpp"
+#include "minunit.h"
+#include "string.h"
+#include "ubx.hpp"
+#include "ubx_framer.hpp"
+
+namespace wibot::protocal::gnss::test {
+
+#define GNSS_INGEST_TEST_STREAMS 6
+#define GNSS_INGEST_TEST_FRAMES 40
+#define GNSS_INGEST_TEST_PAYLOAD_SIZE 24
+
+/**
+ * A receiver: its inbox and framer, and the sequence numbers of the frames it parsed.
+ */
+struct GnssIngestTestReceiver {
+    uint8_t   inbox[64];
+    uint8_t   scratch[GNSS_INGEST_TEST_PAYLOAD_SIZE];
+    UbxFramer framer;
+    uint32_t  frames;
+    uint32_t  disorders;
+
+    GnssIngestTestReceiver(CircularBuffer8& buffer)
+        : framer(buffer, {.data = scratch, .size = sizeof(scratch)}), frames(0), disorders(0){};
+};
+
+static void gnss_ingest_test_handler(void* context, CircularBuffer8&) {
+    GnssIngestTestReceiver* receiver = (GnssIngestTestReceiver*)context;
+    UbxFrame                frame;
+    while (receiver->framer.parse(&frame)) {
+        receiver->disorders += gnss_u4(frame.payload) != receiver->frames;
+        receiver->frames++;
+    }
+};
+
+static uint32_t gnss_ingest_test_frame(uint8_t* buffer, uint32_t stream, uint32_t sequence) {
+    uint8_t* payload = buffer + UBX_HEADER_SIZE;
+    memset(payload, stream, GNSS_INGEST_TEST_PAYLOAD_SIZE);
+    memcpy(payload, &sequence, sizeof(sequence));
+    return ubx_encode(buffer, 64, UBX_CLASSID_NAV_PVT, payload, GNSS_INGEST_TEST_PAYLOAD_SIZE);
+};
+
+static void gnss_ingest_queue_test() {
+    GnssIngestQueue queue;
+    uint8_t         stream;
+    MU_ASSERT(!queue.pop(&stream));
+    for (uint32_t i = 0; i < GNSS_INGEST_QUEUE_SIZE; i++) {
+        MU_ASSERT(queue.push(i));
+    }
+    MU_ASSERT(!queue.push(0));
+    // First in, first out, across the end of the cells.
+    for (uint32_t round = 0; round < 3; round++) {
+        for (uint32_t i = 0; i < GNSS_INGEST_QUEUE_SIZE / 2; i++) {
+            MU_ASSERT(queue.pop(&stream) && stream == (round * 32 + i) % GNSS_INGEST_QUEUE_SIZE);
+            MU_ASSERT(queue.push(stream));
+        }
+    }
+};
+
+static void gnss_ingest_engine_test() {
+    static uint8_t         rings[GNSS_INGEST_TEST_STREAMS][128];
+    static CircularBuffer8 buffers[GNSS_INGEST_TEST_STREAMS] = {
+        {rings[0], 128}, {rings[1], 128}, {rings[2], 128},
+        {rings[3], 128}, {rings[4], 128}, {rings[5], 128},
+    };
+    static GnssIngestTestReceiver receivers[GNSS_INGEST_TEST_STREAMS] = {
+        {buffers[0]}, {buffers[1]}, {buffers[2]}, {buffers[3]}, {buffers[4]}, {buffers[5]},
+    };
+
+    GnssIngest ingest(2);
+    uint32_t   stream;
+    uint8_t    odd[48];
+    MU_ASSERT(!ingest.stream_register(buffers[0], {.data = odd, .size = sizeof(odd)},
+                                      gnss_ingest_test_handler, &receivers[0], &stream));
+    for (uint32_t i = 0; i < GNSS_INGEST_TEST_STREAMS; i++) {
+        MU_ASSERT(ingest.stream_register(buffers[i], {.data = receivers[i].inbox, .size = 64},
+                                         gnss_ingest_test_handler, &receivers[i], &stream));
+        MU_ASSERT(stream == i);
+    }
+    MU_ASSERT(ingest.idle() && !ingest.worker_poll(0) && !ingest.worker_poll(1));
+
+    // Every stream is queued once, however many writes before it runs.
+    uint8_t  frame[64];
+    uint32_t length = 0;
+    for (uint32_t i = 0; i < GNSS_INGEST_TEST_STREAMS; i++) {
+        length = gnss_ingest_test_frame(frame, i, 0);
+        MU_ASSERT(ingest.write(i, frame, 10) == 10);
+        MU_ASSERT(ingest.write(i, frame + 10, length - 10) == length - 10);
+    }
+    MU_ASSERT(!ingest.idle());
+    // Worker 1 runs its own streams, then steals those of worker 0.
+    uint32_t polls = 0;
+    while (ingest.worker_poll(1)) {
+        polls++;
+    }
+    MU_ASSERT(polls == GNSS_INGEST_TEST_STREAMS && ingest.idle());
+    MU_ASSERT(ingest.run_count(1) == GNSS_INGEST_TEST_STREAMS && ingest.steal_count(1) == 3);
+    for (uint32_t i = 0; i < GNSS_INGEST_TEST_STREAMS; i++) {
+        MU_ASSERT(receivers[i].frames == 1);
+    }
+    // The stolen streams are now queued to worker 1.
+    MU_ASSERT(ingest.write(0, frame, 1) == 1);
+    MU_ASSERT(ingest.worker_poll(1) && ingest.steal_count(1) == 3 && !ingest.worker_poll(0));
+    buffers[0].readVirtual(1);
+
+    // Frames split at every length and interleaved across streams, by both workers, in order.
+    // Bytes refused by a full inbox are written again.
+    uint32_t offsets[GNSS_INGEST_TEST_STREAMS];
+    uint32_t sequences[GNSS_INGEST_TEST_STREAMS];
+    uint8_t  frames[GNSS_INGEST_TEST_STREAMS][64];
+    for (uint32_t i = 0; i < GNSS_INGEST_TEST_STREAMS; i++) {
+        offsets[i]   = 0;
+        sequences[i] = 1;
+        gnss_ingest_test_frame(frames[i], i, 1);
+    }
+    uint32_t step = 0;
+    while (true) {
+        bool writing = false;
+        for (uint32_t i = 0; i < GNSS_INGEST_TEST_STREAMS; i++) {
+            if (sequences[i] >= GNSS_INGEST_TEST_FRAMES) continue;
+            writing        = true;
+            uint32_t chunk = 1 + (step++ * 7 + i) % 19;
+            if (chunk > length - offsets[i]) chunk = length - offsets[i];
+            offsets[i] += ingest.write(i, frames[i] + offsets[i], chunk);
+            if (offsets[i] == length) {
+                offsets[i] = 0;
+                gnss_ingest_test_frame(frames[i], i, ++sequences[i]);
+            }
+        }
+        if (!writing) break;
+        ingest.worker_poll(step & 1);
+    }
+    while (ingest.worker_poll(0) || ingest.worker_poll(1)) {
+    }
+    MU_ASSERT(ingest.idle());
+    for (uint32_t i = 0; i < GNSS_INGEST_TEST_STREAMS; i++) {
+        MU_ASSERT(receivers[i].frames == GNSS_INGEST_TEST_FRAMES);
+        MU_ASSERT(receivers[i].disorders == 0 && receivers[i].framer.checksumErrors == 0);
+    }
+
+    // A full inbox takes what fits and counts the rest.
+    uint8_t  bytes[100];
+    uint32_t overflow = ingest.overflow_bytes(2);
+    memset(bytes, 0, sizeof(bytes));
+    MU_ASSERT(ingest.write(2, bytes, sizeof(bytes)) == 64);
+    MU_ASSERT(ingest.overflow_bytes(2) == overflow + sizeof(bytes) - 64);
+    while (ingest.worker_poll(0) || ingest.worker_poll(1)) {
+    }
+    MU_ASSERT(ingest.idle() && receivers[2].framer.droppedBytes == 64);
+};
+
+void gnss_ingest_test() {
+    gnss_ingest_queue_test();
+    gnss_ingest_engine_test();
+};
+
+}  // namespace wibot::protocal::gnss::test
@@ -0,0 +1,127 @@
+#ifndef __WWTALK_GNSS_REGISTRY_HPP__
+#define __WWTALK_GNSS_REGISTRY_HPP__
+#include "base.hpp"
+#include "string.h"
+namespace wibot::protocal::gnss {
+
+typedef bool (*GnssMessageValidator)(const uint8_t* payload, uint16_t length);
+
+template <typename Frame>
+struct GnssMessageEntry {
+    typedef void (*Handler)(void* context, const Frame* frame);
+
+    uint16_t             classId;
+    GnssMessageValidator validate;
+    Handler              handler;
+    void*                context;
+};
+
+/**
+ * Messages of the binary protocols keyed by class and id, the class in the low byte of classId.
+ * Lookup is direct, one table per class indexed by id, and costs two loads whatever the number
+ * of entries, without the 64K entries of a flat table.
+ *
+ * Frame has length and payload fields and a classId(). CLASS_MAX_COUNT is the distinct message
+ * classes, MESSAGE_MAX_COUNT the entries, at most 255.
+ */
+template <typename Frame, uint32_t CLASS_MAX_COUNT, uint32_t MESSAGE_MAX_COUNT>
+class GnssRegistry {
+   public:
+    typedef GnssMessageEntry<Frame> Entry;
+    typedef typename Entry::Handler Handler;
+
+    static_assert(CLASS_MAX_COUNT <= 255 && MESSAGE_MAX_COUNT <= 255, "slots are one byte");
+
+    GnssRegistry() : unknownCount(0), lengthErrors(0), _pageCount(0), _entryCount(0) {
+        memset(_classes, 0, sizeof(_classes));
+        memset(_pages, 0, sizeof(_pages));
+    };
+
+    /**
+     * Register or replace the entry of classId. validate may be nullptr to accept any length.
+     * @return Return false if the class or message tables are full.
+     */
+    bool message_register(uint16_t classId, GnssMessageValidator validate, Handler handler,
+                          void* context);
+
+    const Entry* message_find(uint16_t classId) const;
+
+    /**
+     * Validate the payload length of a frame and call the handler of its entry.
+     * @return Return false if the message is unknown or its length is invalid.
+     */
+    bool dispatch(const Frame* frame);
+
+    uint32_t unknownCount;
+    uint32_t lengthErrors;
+
+   private:
+    uint8_t _classes[256];                 // page + 1 of every class, 0 if none.
+    uint8_t _pages[CLASS_MAX_COUNT][256];  // entry + 1 of every id.
+    Entry   _entries[MESSAGE_MAX_COUNT];
+    uint8_t _pageCount;
+    uint8_t _entryCount;
+};
+
+template <typename Frame, uint32_t CLASS_MAX_COUNT, uint32_t MESSAGE_MAX_COUNT>
+bool GnssRegistry<Frame, CLASS_MAX_COUNT, MESSAGE_MAX_COUNT>::message_register(
+    uint16_t classId, GnssMessageValidator validate, Handler handler, void* context) {
+    uint8_t msgClass = classId & 0xFF;
+    uint8_t msgId    = classId >> 8;
+
+    if (_classes[msgClass] == 0) {
+        if (_pageCount >= CLASS_MAX_COUNT) {
+            return false;
+        }
+        _classes[msgClass] = ++_pageCount;
+    }
+    uint8_t* slot = &_pages[_classes[msgClass] - 1][msgId];
+    if (*slot == 0) {
+        if (_entryCount >= MESSAGE_MAX_COUNT) {
+            return false;
+        }
+        *slot = ++_entryCount;
+    }
+
+    Entry* entry    = &_entries[*slot - 1];
+    entry->classId  = classId;
+    entry->validate = validate;
+    entry->handler  = handler;
+    entry->context  = context;
+    return true;
+};
+
+template <typename Frame, uint32_t CLASS_MAX_COUNT, uint32_t MESSAGE_MAX_COUNT>
+const typename GnssRegistry<Frame, CLASS_MAX_COUNT, MESSAGE_MAX_COUNT>::Entry*
+GnssRegistry<Frame, CLASS_MAX_COUNT, MESSAGE_MAX_COUNT>::message_find(uint16_t classId) const {
+    uint8_t page = _classes[classId & 0xFF];
+    if (page == 0) {
+        return nullptr;
+    }
+    uint8_t slot = _pages[page - 1][classId >> 8];
+    if (slot == 0) {
+        return nullptr;
+    }
+    return &_entries[slot - 1];
+};
+
+template <typename Frame, uint32_t CLASS_MAX_COUNT, uint32_t MESSAGE_MAX_COUNT>
+bool GnssRegistry<Frame, CLASS_MAX_COUNT, MESSAGE_MAX_COUNT>::dispatch(const Frame* frame) {
+    const Entry* entry = message_find(frame->classId());
+    if (entry == nullptr) {
+        unknownCount++;
+        return false;
+    }
+    if (entry->validate != nullptr && !entry->validate(frame->payload, frame->length)) {
+        lengthErrors++;
+        return false;
+    }
+    if (entry->handler != nullptr) {
+        entry->handler(entry->context, frame);
+    }
+    return true;
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_REGISTRY_HPP__
@@ -0,0 +1,181 @@
+#include "gnss_time.hpp"
+
+namespace wibot::protocal::gnss {
+
+/**
+ * GPS time, seconds from 1980-01-06, at which GPS-UTC becomes i + 1.
+ */
+static const uint32_t gpsLeapSeconds[] = {
+    46828801,    // 1981-07-01
+    78364802,    // 1982-07-01
+    109900803,   // 1983-07-01
+    173059204,   // 1985-07-01
+    252028805,   // 1988-01-01
+    315187206,   // 1990-01-01
+    346723207,   // 1991-01-01
+    393984008,   // 1992-07-01
+    425520009,   // 1993-07-01
+    457056010,   // 1994-07-01
+    504489611,   // 1996-01-01
+    551750412,   // 1997-07-01
+    599184013,   // 1999-01-01
+    820108814,   // 2006-01-01
+    914803215,   // 2009-01-01
+    1025136016,  // 2012-07-01
+    1119744017,  // 2015-07-01
+    1167264018,  // 2017-01-01
+};
+
+#define GNSS_TIME_LEAP_COUNT (sizeof(gpsLeapSeconds) / sizeof(gpsLeapSeconds[0]))
+
+static const uint8_t monthLengths[2][12] = {
+    {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
+    {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
+};
+
+static inline bool gnss_time_is_leap(int32_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+};
+
+GnssTime::GnssTime() : cacheMisses(0), _year(0), _month(0), _days(0), _length(0){};
+
+int32_t GnssTime::days_from_civil(int32_t year, uint32_t month, uint32_t day) {
+    // Years from March, so that the leap day ends the year, in eras of 400 years.
+    year -= month <= 2;
+    int32_t  era = (year >= 0 ? year : year - 399) / 400;
+    uint32_t yoe = (uint32_t)(year - era * 400);
+    uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+};
+
+int32_t GnssTime::year_from_nmea(int32_t year) {
+    if (year >= 100) return year;
+    return year + (year < 80 ? 2000 : 1900);
+};
+
+int32_t GnssTime::leap_seconds(int64_t gpsSeconds) {
+    // Most times are after the last leap second, search from it.
+    int32_t i = GNSS_TIME_LEAP_COUNT;
+    while (i > 0 && gpsSeconds < gpsLeapSeconds[i - 1]) {
+        i--;
+    }
+    return i;
+};
+
+bool GnssTime::from_gps(uint32_t week, uint32_t towMs, int32_t nano, int64_t* ns) {
+    if (towMs >= GNSS_TIME_SECONDS_PER_WEEK * 1000U || nano <= -GNSS_TIME_NS_PER_SECOND ||
+        nano >= GNSS_TIME_NS_PER_SECOND) {
+        return false;
+    }
+    int64_t seconds = (int64_t)week * GNSS_TIME_SECONDS_PER_WEEK + towMs / 1000;
+    *ns = (seconds + GNSS_TIME_GPS_EPOCH - leap_seconds(seconds)) * GNSS_TIME_NS_PER_SECOND +
+          (int64_t)(towMs % 1000) * 1000000 + nano;
+    return true;
+};
+
+int64_t GnssTime::from_run_time(uint32_t runTime, uint32_t anchorRunTime, int64_t anchorNs) {
+    return anchorNs + (int64_t)(int32_t)(runTime - anchorRunTime) * 1000000;
+};
+
+bool GnssTime::_date(int32_t year, int32_t month, int32_t day, int32_t* days) {
+    if (year != _year || month != _month) {
+        if (month < 1 || month > 12 || year < 1) return false;
+        cacheMisses++;
+        _year   = year;
+        _month  = month;
+        _days   = days_from_civil(year, month, 1);
+        _length = monthLengths[gnss_time_is_leap(year)][month - 1];
+    }
+    if (day < 1 || day > _length) return false;
+    *days = _days + day - 1;
+    return true;
+};
+
+bool GnssTime::from_utc(int32_t year, int32_t month, int32_t day, int32_t hour, int32_t minute,
+                        int32_t second, int32_t nano, int64_t* ns) {
+    int32_t days;
+    if ((uint32_t)hour > 23 || (uint32_t)minute > 59 || (uint32_t)second > 60 ||
+        nano <= -GNSS_TIME_NS_PER_SECOND || nano >= GNSS_TIME_NS_PER_SECOND ||
+        !_date(year, month, day, &days)) {
+        return false;
+    }
+    int64_t seconds = (int64_t)days * GNSS_TIME_SECONDS_PER_DAY + hour * 3600 + minute * 60 +
+                      second;
+    *ns = seconds * GNSS_TIME_NS_PER_SECOND + nano;
+    return true;
+};
+
+bool GnssTime::from_nmea(const struct NmeaDate* date, const struct NmeaTime* time, int64_t* ns) {
+    if (date->year < 0 || time->microseconds < 0) return false;
+    return from_utc(year_from_nmea(date->year), date->month, date->day, time->hours,
+                    time->minutes, time->seconds, time->microseconds * 1000, ns);
+};
+
+bool GnssTime::from_nav_pvt(const struct UbxFrameNavPvt* pvt, int64_t* ns) {
+    if (!pvt->valid.validDate || !pvt->valid.validTime) return false;
+    return from_utc(pvt->year, pvt->month, pvt->day, pvt->hour, pvt->min, pvt->sec, pvt->nano,
+                    ns);
+};
+
+bool GnssTime::from_fix(const GnssFix* fix, int64_t* ns) {
+    int32_t days;
+    if ((~fix->valid & (GNSS_FIX_VALID_DATE | GNSS_FIX_VALID_TIME)) ||
+        fix->msOfDay >= GNSS_TIME_SECONDS_PER_DAY * 1000U + 1000 ||
+        !_date(fix->year, fix->month, fix->day, &days)) {
+        return false;
+    }
+    *ns = ((int64_t)days * GNSS_TIME_SECONDS_PER_DAY * 1000 + fix->msOfDay) * 1000000;
+    return true;
+};
+
+uint32_t GnssTime::from_rmc(const struct NmeaSentenceDataRmc* rmc, uint32_t count, int64_t* ns) {
+    uint32_t converted = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (from_nmea(&rmc[i].date, &rmc[i].time, &ns[i])) {
+            converted++;
+        } else {
+            ns[i] = GNSS_TIME_INVALID;
+        }
+    }
+    return converted;
+};
+
+uint32_t GnssTime::from_nav_pvt(const struct UbxFrameNavPvt* pvt, uint32_t count, int64_t* ns) {
+    uint32_t converted = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (from_nav_pvt(&pvt[i], &ns[i])) {
+            converted++;
+        } else {
+            ns[i] = GNSS_TIME_INVALID;
+        }
+    }
+    return converted;
+};
+
+uint32_t GnssTime::from_fix(const GnssFix* fixes, uint32_t count, int64_t* ns) {
+    uint32_t converted = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (from_fix(&fixes[i], &ns[i])) {
+            converted++;
+        } else {
+            ns[i] = GNSS_TIME_INVALID;
+        }
+    }
+    return converted;
+};
+
+uint32_t GnssTime::from_gps(const uint16_t* weeks, const uint32_t* towMs, uint32_t count,
+                            int64_t* ns) {
+    uint32_t converted = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (from_gps(weeks[i], towMs[i], 0, &ns[i])) {
+            converted++;
+        } else {
+            ns[i] = GNSS_TIME_INVALID;
+        }
+    }
+    return converted;
+};
+
+}  // namespace wibot::protocal::gnss
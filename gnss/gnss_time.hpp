@@ -0,0 +1,103 @@
+#ifndef __WWTALK_GNSS_GNSS_TIME_HPP__
+#define __WWTALK_GNSS_GNSS_TIME_HPP__
+#include "base.hpp"
+#include "gnss_fix.hpp"
+#include "nmea.hpp"
+#include "ubx.hpp"
+namespace wibot::protocal::gnss {
+
+#define GNSS_TIME_NS_PER_SECOND 1000000000LL
+#define GNSS_TIME_SECONDS_PER_DAY 86400
+#define GNSS_TIME_SECONDS_PER_WEEK 604800
+#define GNSS_TIME_GPS_EPOCH 315964800LL  // 1980-01-06 in Unix seconds.
+#define GNSS_TIME_INVALID INT64_MIN      // written by the batch versions for invalid records.
+
+/**
+ * Conversions of receiver time to Unix nanoseconds, UTC without leap seconds as time_t: the
+ * leap second 23:59:60 is the same second as the following 00:00:00. Fields are checked for
+ * range, so a conversion never reads a table out of bounds, nor returns an unrelated time.
+ *
+ * Days from the civil date are computed without mktime or timegm, and cached for the month of
+ * the last conversion, which is the month of every record of a log but the few around its end.
+ * The cache makes an instance per stream, static methods are stateless.
+ */
+class GnssTime {
+   public:
+    GnssTime();
+
+    /**
+     * Days from 1970-01-01 of a proleptic Gregorian date, negative before. Not checked.
+     */
+    static int32_t days_from_civil(int32_t year, uint32_t month, uint32_t day);
+
+    /**
+     * The full year of a two-digit NMEA year, those of the GPS era: 80 to 99 are 1980 to 1999,
+     * 0 to 79 are 2000 to 2079. Years from 100 are returned as is.
+     */
+    static int32_t year_from_nmea(int32_t year);
+
+    /**
+     * GPS-UTC seconds at GPS time gpsSeconds, seconds from 1980-01-06. The table ends at the
+     * leap second of 2016-12-31, the last one announced.
+     */
+    static int32_t leap_seconds(int64_t gpsSeconds);
+
+    /**
+     * GPS time to UTC. week is the full week number, without the rollover of 1024 weeks.
+     * @return Return false if towMs is beyond a week or nano beyond a second.
+     */
+    static bool from_gps(uint32_t week, uint32_t towMs, int32_t nano, int64_t* ns);
+
+    /**
+     * The time of a run time in ms since power on, as CasicFrameNavPv::runTime, from a message
+     * that carries both, e.g. NAV-TIMEUTC. Valid across the wrap of runTime, 49 days.
+     */
+    static int64_t from_run_time(uint32_t runTime, uint32_t anchorRunTime, int64_t anchorNs);
+
+    /**
+     * Broken-down UTC. second may be 60, nano is signed as UbxFrameNavPvt::nano.
+     * @return Return false if a field is out of range.
+     */
+    bool from_utc(int32_t year, int32_t month, int32_t day, int32_t hour, int32_t minute,
+                  int32_t second, int32_t nano, int64_t* ns);
+
+    /**
+     * Two-digit years are converted by year_from_nmea.
+     * @return Return false if the date or the time is empty or out of range.
+     */
+    bool from_nmea(const struct NmeaDate* date, const struct NmeaTime* time, int64_t* ns);
+
+    /**
+     * @return Return false unless both validDate and validTime are set.
+     */
+    bool from_nav_pvt(const struct UbxFrameNavPvt* pvt, int64_t* ns);
+
+    /**
+     * @return Return false unless both GNSS_FIX_VALID_DATE and GNSS_FIX_VALID_TIME are set.
+     */
+    bool from_fix(const GnssFix* fix, int64_t* ns);
+
+    /**
+     * Batch versions, ns[i] from records[i], GNSS_TIME_INVALID if it does not convert.
+     * @return Return the number of records converted.
+     */
+    uint32_t from_rmc(const struct NmeaSentenceDataRmc* rmc, uint32_t count, int64_t* ns);
+    uint32_t from_nav_pvt(const struct UbxFrameNavPvt* pvt, uint32_t count, int64_t* ns);
+    uint32_t from_fix(const GnssFix* fixes, uint32_t count, int64_t* ns);
+    static uint32_t from_gps(const uint16_t* weeks, const uint32_t* towMs, uint32_t count,
+                             int64_t* ns);
+
+    uint32_t cacheMisses;
+
+   private:
+    int32_t _year;  // of the cached month, 0 if none.
+    int32_t _month;
+    int32_t _days;    // days from 1970-01-01 of the first day of the cached month.
+    int32_t _length;  // days of the cached month.
+
+    bool _date(int32_t year, int32_t month, int32_t day, int32_t* days);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_GNSS_TIME_HPP__
@@ -0,0 +1,157 @@
+#include "gnss_time_test.hpp"
+
+#include "gnss_time.hpp"
+#include "minunit.h"
+#include "string.h"
+
+namespace wibot::protocal::gnss::test {
+
+#define GNSS_TIME_TEST_NS(seconds) ((int64_t)(seconds) * GNSS_TIME_NS_PER_SECOND)
+
+static void gnss_time_civil_test() {
+    MU_ASSERT(GnssTime::days_from_civil(1970, 1, 1) == 0);
+    MU_ASSERT(GnssTime::days_from_civil(1969, 12, 31) == -1);
+    MU_ASSERT(GnssTime::days_from_civil(1980, 1, 6) == 3657);
+    MU_ASSERT(GnssTime::days_from_civil(2000, 3, 1) == 11017);
+    MU_ASSERT(GnssTime::days_from_civil(2100, 3, 1) - GnssTime::days_from_civil(2100, 2, 28) == 1);
+    MU_ASSERT(GnssTime::year_from_nmea(80) == 1980 && GnssTime::year_from_nmea(99) == 1999);
+    MU_ASSERT(GnssTime::year_from_nmea(0) == 2000 && GnssTime::year_from_nmea(79) == 2079);
+    MU_ASSERT(GnssTime::year_from_nmea(2024) == 2024);
+
+    // The cache gives the days of the formula, through every month of 1900 to 2100.
+    GnssTime time;
+    int64_t  ns;
+    int32_t  days   = GnssTime::days_from_civil(1900, 1, 1);
+    uint32_t errors = 0;
+    for (int32_t year = 1900; year < 2100; year++) {
+        for (int32_t month = 1; month <= 12; month++) {
+            for (int32_t day = 1; day <= 31; day++) {
+                if (!time.from_utc(year, month, day, 0, 0, 0, 0, &ns)) {
+                    errors += day <= 28;
+                    break;
+                }
+                errors += ns != GNSS_TIME_TEST_NS((int64_t)days * 86400);
+                days++;
+            }
+        }
+    }
+    MU_ASSERT(errors == 0);
+    MU_ASSERT(days == GnssTime::days_from_civil(2100, 1, 1));
+    MU_ASSERT(time.cacheMisses == 200 * 12);
+
+    MU_ASSERT(time.from_utc(2026, 10, 18, 12, 34, 56, 250000000, &ns));
+    MU_ASSERT(ns == GNSS_TIME_TEST_NS(1792326896) + 250000000);
+    MU_ASSERT(time.from_utc(2026, 10, 18, 12, 34, 56, -250000000, &ns));
+    MU_ASSERT(ns == GNSS_TIME_TEST_NS(1792326896) - 250000000);
+    MU_ASSERT(time.from_utc(2016, 12, 31, 23, 59, 60, 0, &ns));
+    MU_ASSERT(ns == GNSS_TIME_TEST_NS(1483228800));
+    MU_ASSERT(time.from_utc(2024, 2, 29, 0, 0, 0, 0, &ns));
+    MU_ASSERT(!time.from_utc(2023, 2, 29, 0, 0, 0, 0, &ns));
+    MU_ASSERT(!time.from_utc(2026, 13, 1, 0, 0, 0, 0, &ns));
+    MU_ASSERT(!time.from_utc(2026, 0, 1, 0, 0, 0, 0, &ns));
+    MU_ASSERT(!time.from_utc(2026, 10, 0, 0, 0, 0, 0, &ns));
+    MU_ASSERT(!time.from_utc(2026, 10, 18, 24, 0, 0, 0, &ns));
+    MU_ASSERT(!time.from_utc(2026, 10, 18, -1, 0, 0, 0, &ns));
+    MU_ASSERT(!time.from_utc(2026, 10, 18, 0, 0, 61, 0, &ns));
+    MU_ASSERT(!time.from_utc(2026, 10, 18, 0, 0, 0, 1000000000, &ns));
+};
+
+static void gnss_time_gps_test() {
+    MU_ASSERT(GnssTime::leap_seconds(0) == 0);
+    MU_ASSERT(GnssTime::leap_seconds(46828800) == 0);
+    MU_ASSERT(GnssTime::leap_seconds(46828801) == 1);
+    MU_ASSERT(GnssTime::leap_seconds(1167264017) == 17);
+    MU_ASSERT(GnssTime::leap_seconds(1167264018) == 18);
+
+    int64_t ns;
+    MU_ASSERT(GnssTime::from_gps(0, 0, 0, &ns) && ns == GNSS_TIME_TEST_NS(GNSS_TIME_GPS_EPOCH));
+    MU_ASSERT(GnssTime::from_gps(2441, 45314250, 125, &ns));
+    MU_ASSERT(ns == GNSS_TIME_TEST_NS(1792326896) + 250000125);
+
+    // 1167264017 is the leap second, it repeats the following second as UTC does in time_t.
+    int64_t  before, leap, after;
+    uint32_t week = 1167264017 / GNSS_TIME_SECONDS_PER_WEEK;
+    uint32_t tow  = 1167264017 % GNSS_TIME_SECONDS_PER_WEEK;
+    MU_ASSERT(GnssTime::from_gps(week, (tow - 1) * 1000, 0, &before));
+    MU_ASSERT(GnssTime::from_gps(week, tow * 1000, 0, &leap));
+    MU_ASSERT(GnssTime::from_gps(week, (tow + 1) * 1000, 0, &after));
+    MU_ASSERT(before == GNSS_TIME_TEST_NS(1483228799));
+    MU_ASSERT(leap == GNSS_TIME_TEST_NS(1483228800) && after == leap);
+
+    MU_ASSERT(!GnssTime::from_gps(2441, GNSS_TIME_SECONDS_PER_WEEK * 1000, 0, &ns));
+    MU_ASSERT(!GnssTime::from_gps(2441, 0, -1000000000, &ns));
+
+    // Run time across its wrap.
+    int64_t anchor = GNSS_TIME_TEST_NS(1792326896);
+    MU_ASSERT(GnssTime::from_run_time(0xFFFFFC18, 0xFFFFFC18, anchor) == anchor);
+    MU_ASSERT(GnssTime::from_run_time(1000, 0xFFFFFC18, anchor) == anchor + GNSS_TIME_TEST_NS(2));
+    MU_ASSERT(GnssTime::from_run_time(0xFFFFF830, 1000, anchor) == anchor - GNSS_TIME_TEST_NS(3));
+
+    uint16_t weeks[3] = {2441, 2441, 2441};
+    uint32_t tows[3]  = {45314000, GNSS_TIME_SECONDS_PER_WEEK * 1000, 45315000};
+    int64_t  times[3];
+    MU_ASSERT(GnssTime::from_gps(weeks, tows, 3, times) == 2);
+    MU_ASSERT(times[0] == GNSS_TIME_TEST_NS(1792326896) && times[1] == GNSS_TIME_INVALID);
+    MU_ASSERT(times[2] == GNSS_TIME_TEST_NS(1792326897));
+};
+
+static void gnss_time_record_test() {
+    GnssTime                   time;
+    int64_t                    ns;
+    NmeaSentenceRMC            rmcEntry;
+    struct NmeaSentenceDataRmc rmc[3];
+    MU_ASSERT(rmcEntry.parse(&rmc[0], "$GPRMC,123519.25,A,4807.038,N,01131.000,E,022.4,084.4,"
+                                      "230394,003.1,W*6A"));
+    MU_ASSERT(time.from_nmea(&rmc[0].date, &rmc[0].time, &ns));
+    MU_ASSERT(ns == GNSS_TIME_TEST_NS(764426119) + 250000000);
+
+    // Two-digit years of the GPS era, four-digit years of ZDA as they are.
+    struct NmeaDate date = {18, 10, 26};
+    struct NmeaTime utc  = {12, 34, 56, 0};
+    MU_ASSERT(time.from_nmea(&date, &utc, &ns) && ns == GNSS_TIME_TEST_NS(1792326896));
+    date.year = 2026;
+    MU_ASSERT(time.from_nmea(&date, &utc, &ns) && ns == GNSS_TIME_TEST_NS(1792326896));
+    date.year = -1;
+    MU_ASSERT(!time.from_nmea(&date, &utc, &ns));
+
+    rmc[1]            = rmc[0];
+    rmc[1].date.year  = -1;  // empty date field.
+    rmc[2]            = rmc[0];
+    rmc[2].time.hours = 13;
+    int64_t times[3];
+    MU_ASSERT(time.from_rmc(rmc, 3, times) == 2);
+    MU_ASSERT(times[0] == GNSS_TIME_TEST_NS(764426119) + 250000000);
+    MU_ASSERT(times[1] == GNSS_TIME_INVALID);
+    MU_ASSERT(times[2] == times[0] + GNSS_TIME_TEST_NS(3600));
+
+    // NAV-PVT, and the GnssFix converted from it, are the same time to the ms.
+    struct UbxFrameNavPvt pvt[2];
+    memset(pvt, 0, sizeof(pvt));
+    pvt[0].year        = 2026;
+    pvt[0].month       = 10;
+    pvt[0].day         = 18;
+    pvt[0].hour        = 12;
+    pvt[0].min         = 34;
+    pvt[0].sec         = 57;
+    pvt[0].nano        = -750000000;
+    pvt[0].valid.valid = 0x03;
+    pvt[1]             = pvt[0];
+    pvt[1].valid.valid = 0x02;
+    MU_ASSERT(time.from_nav_pvt(pvt, 2, times) == 1);
+    MU_ASSERT(times[0] == GNSS_TIME_TEST_NS(1792326896) + 250000000);
+    MU_ASSERT(times[1] == GNSS_TIME_INVALID);
+
+    GnssFix fixes[2];
+    GnssFixConvert::from_nav_pvt(pvt, 2, fixes);
+    MU_ASSERT(time.from_fix(fixes, 2, times) == 1);
+    MU_ASSERT(times[0] == GNSS_TIME_TEST_NS(1792326896) + 250000000);
+    MU_ASSERT(times[1] == GNSS_TIME_INVALID);
+};
+
+void gnss_time_test() {
+    gnss_time_civil_test();
+    gnss_time_gps_test();
+    gnss_time_record_test();
+};
+
+}  // namespace wibot::protocal::gnss::test
@@ -7,6 +7,7 @@
 
 #include "ctype.h"
 #include "math.h"
+#include "nmea_kernel.hpp"
 #include "string.h"
 namespace wibot::protocal::gnss {
 
@@ -21,32 +22,6 @@ static int hex2int(char c) {
 static inline bool minmea_isfield(char c) {
     return isprint((unsigned char)c) && c != ',' && c != '*';
 };
-/**
- * Convert a fixed-point value to a floating-point value.
- * Returns NaN for "unknown" values.
- */
-static inline float nmea_tofloat(struct NmeaFloat* f) {
-    if (f->scale == 0) return NAN;
-    return (float)f->value / (float)f->scale;
-};
-
-/**
- * Convert a raw coordinate to a floating point DD.DDD... value.
- * Returns NaN for "unknown" values.
- */
-static inline float nmea_tocoord(struct NmeaFloat* f) {
-    if (f->scale == 0) return NAN;
-    int_least32_t degrees = f->value / (f->scale * 100);
-    int_least32_t minutes = f->value % (f->scale * 100);
-    return (float)degrees + (float)minutes / (60 * f->scale);
-};
-
-//     /**
-//  * Convert GPS UTC date/time representation to a UNIX timestamp.
-//  */
-//     int minmea_gettime(struct timespec *ts, const struct NmeaDate *date,
-//     const struct NmeaTime *time_);
-
 /**
  * Rescale a fixed-point value to a different scale. Rounds towards zero.
  */
@@ -60,19 +35,57 @@ static inline int_least32_t nmea_rescale(struct NmeaFloat* f, int_least32_t new_
         return f->value * (new_scale / f->scale);
 };
 
+NmeaParser::NmeaParser() : NmeaParser(entries, NMEA_SENTENCE_ENTRY_SIZE){};
+
+NmeaParser::NmeaParser(NmeaSentenceBase** table, uint32_t capacity)
+    : _table(table), _capacity(capacity), _count(0), _subscribed(~0U) {
+    // Probes wrap with a mask.
+    while (_capacity & (_capacity - 1)) {
+        _capacity &= _capacity - 1;
+    }
+    for (uint32_t i = 0; i < _capacity; i++) {
+        _table[i] = nullptr;
+    }
+    dropped_reset();
+};
+
+void NmeaParser::subscribe(uint32_t sentences) {
+    _subscribed = sentences;
+};
+
+void NmeaParser::dropped_reset() {
+    for (uint32_t i = 0; i < NMEA_SENTENCE_ID_COUNT; i++) {
+        dropped[i] = 0;
+    }
+};
+
 bool NmeaParser::sentence_register(NmeaSentenceBase* entry) {
-    for (uint32_t i = 0; i < NMEA_SENTENCE_ENTRY_SIZE; i++) {
-        if (this->entries[i] == NULL) {
-            this->entries[i] = entry;
+    if (_capacity == 0) {
+        return false;
+    }
+    uint32_t mask = _capacity - 1;
+    for (uint32_t i = entry->hash() & mask;; i = (i + 1) & mask) {
+        if (_table[i] == entry) {
+            return true;
+        }
+        if (_table[i] == nullptr) {
+            // Keep at least one empty slot, so that probing always ends.
+            if (_count + 1 >= _capacity) {
+                return false;
+            }
+            _table[i] = entry;
+            _count++;
             return true;
         }
     }
-    return false;
 };
 bool NmeaParser::sentence_register_default() {
     static NmeaSentenceRMC RMC;
     sentence_register(&RMC);
 
+    static NmeaSentenceGGA GGA;
+    sentence_register(&GGA);
+
     static NmeaSentenceGSA GSA;
     sentence_register(&GSA);
 
@@ -91,37 +104,101 @@ bool NmeaParser::sentence_register_default() {
     static NmeaSentenceZDA ZDA;
     sentence_register(&ZDA);
 
+    static NmeaSentenceGNS GNS;
+    sentence_register(&GNS);
+
+    static NmeaSentenceGBS GBS;
+    sentence_register(&GBS);
+
+    static NmeaSentenceHDT HDT;
+    sentence_register(&HDT);
+
+    static NmeaSentenceTHS THS;
+    sentence_register(&THS);
+
     return true;
 };
 
+NmeaSentenceBase* NmeaParser::_probe(uint32_t hash, bool anyTalker, const char* address,
+                                     uint32_t length) const {
+    uint32_t mask = _capacity - 1;
+    for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+        NmeaSentenceBase* te = _table[i];
+        if (te == nullptr) {
+            return nullptr;
+        }
+        if ((te->talker == NMEA_TALKER_ANY) == anyTalker && te->match(address, length)) {
+            return te;
+        }
+    }
+};
+
+NmeaSentenceBase* NmeaParser::sentence_entry_find(const char* address, uint32_t length) const {
+    if (length == 0 || _count == 0) {
+        return nullptr;
+    }
+    // Talker specific and proprietary entries first, then any talker entries of the type.
+    NmeaSentenceBase* te =
+        _probe(nmea_hash(NMEA_HASH_INIT, address, length), false, address, length);
+    if (te == nullptr && address[0] != 'P' && length > 2) {
+        te = _probe(nmea_hash(NMEA_HASH_INIT, address + 2, length - 2), true, address, length);
+    }
+    return te;
+};
+
 /**
  * Determine sentence identifier.
  */
 bool NmeaParser::sentence_entry_get(const char* sentence, bool strict, NmeaSentenceBase** result) {
-    if (!Sentence::check(sentence, strict)) {
+    // Look at the address first, the checksum is only worth checking for wanted sentences.
+    if (*sentence != '$') {
         return false;
     }
 
-    char type[6];
-    if (!Sentence::scan(sentence, "t", type)) {
+    // The address field runs from "$" to the first "," or "*".
+    uint32_t length = 0;
+    while (minmea_isfield(sentence[1 + length])) {
+        if (++length > NMEA_ADDRESS_MAX_LENGTH) {
+            return false;
+        }
+    }
+
+    NmeaSentenceBase* te = sentence_entry_find(sentence + 1, length);
+    if (te == nullptr) {
+        dropped[NMEA_UNKNOWN]++;
+        return false;
+    }
+    if (!(_subscribed & NMEA_SENTENCE_BIT(te->id))) {
+        dropped[te->id]++;
         return false;
     }
 
-    for (int32_t i = 0; i < NMEA_SENTENCE_ENTRY_SIZE; i++) {
-        NmeaSentenceBase* te = this->entries[i];
-        if (te == nullptr) {
-            return false;
-        }
-        if (te->match(sentence)) {
-            *result = te;
-            return true;
-        }
+    if (!Sentence::check(sentence, strict)) {
+        return false;
     }
-    return false;
+    *result = te;
+    return true;
 };
 
-bool NmeaSentenceBase::match(const char* sentence) {
-    return memcmp(sentence, this->talkerStr, 2) && memcmp(sentence + 2, this->idStr, 3);
+bool NmeaSentenceBase::match(const char* address, uint32_t length) const {
+    uint32_t idLength = strlen(this->idStr);
+    switch (this->talker) {
+        case NMEA_TALKER_PROPRIETARY:
+            return length == idLength && !memcmp(address, this->idStr, idLength);
+        case NMEA_TALKER_ANY:
+            return length == idLength + 2 && !memcmp(address + 2, this->idStr, idLength);
+        default:
+            return length == idLength + 2 && !memcmp(address, this->talkerStr, 2) &&
+                   !memcmp(address + 2, this->idStr, idLength);
+    }
+};
+
+uint32_t NmeaSentenceBase::hash() const {
+    uint32_t hash = NMEA_HASH_INIT;
+    if (this->talker != NMEA_TALKER_PROPRIETARY && this->talker != NMEA_TALKER_ANY) {
+        hash = nmea_hash(hash, this->talkerStr, 2);
+    }
+    return nmea_hash(hash, this->idStr, strlen(this->idStr));
 };
 
 bool NmeaSentenceRMC::parse(void* frame, const char* sentence) {
@@ -171,11 +248,11 @@ bool NmeaSentenceGSA::parse(void* frame, const char* sentence) {
     auto data = (NmeaSentenceDataGsa*)frame;
     char type[6];
 
-    if (!Sentence::scan(sentence, "tciiiiiiiiiiiiifff", type, &data->mode, &data->fix_type,
+    if (!Sentence::scan(sentence, "tciiiiiiiiiiiiifff;i", type, &data->mode, &data->fix_type,
                         &data->sats[0], &data->sats[1], &data->sats[2], &data->sats[3],
                         &data->sats[4], &data->sats[5], &data->sats[6], &data->sats[7],
                         &data->sats[8], &data->sats[9], &data->sats[10], &data->sats[11],
-                        &data->pdop, &data->hdop, &data->vdop))
+                        &data->pdop, &data->hdop, &data->vdop, &data->system_id))
         return false;
     if (strcmp(type + 2, "GSA")) return false;
 
@@ -236,6 +313,23 @@ bool NmeaSentenceGSV::parse(void* frame, const char* sentence) {
     }
     if (strcmp(type + 2, "GSV")) return false;
 
+    // NMEA 4.10 appends a signal ID after the satellites, which the scan above has taken for
+    // the number of the first missing satellite.
+    NmeaFields fields;
+    NmeaKernel::tokenize(sentence, strlen(sentence), &fields);
+    data->signal_id = 0;
+    if (fields.count > 4 && (fields.count - 4) % 4 == 1) {
+        uint32_t last = fields.count - 1;
+        if (fields.length(last) == 1) {
+            int id = hex2int(sentence[fields.start[last]]);
+            if (id == -1) return false;
+            data->signal_id = id;
+        }
+        for (uint32_t i = (fields.count - 4) / 4; i < 4; i++) {
+            data->sats[i] = (struct NmeaSatInfo){0, 0, 0, 0};
+        }
+    }
+
     return true;
 };
 
@@ -277,18 +371,93 @@ bool NmeaSentenceZDA::parse(void* frame, const char* sentence) {
     return true;
 };
 
+bool NmeaSentenceGNS::parse(void* frame, const char* sentence) {
+    auto data = (NmeaSentenceDataGns*)frame;
+    // $GNGNS,112257.00,3844.24011,N,00908.43828,W,AN,03,10.5,,*57
+    // $GNGNS,181604.00,,,,,NN,00,99.99,,,,,V*0B
+    char type[6];
+    int  latitude_direction;
+    int  longitude_direction;
+
+    // The mode field holds one character per system, make sure it fits.
+    NmeaFields fields;
+    NmeaKernel::tokenize(sentence, strlen(sentence), &fields);
+    if (fields.count > 6 && fields.length(6) >= NMEA_GNS_MODE_SIZE) return false;
+
+    data->station_id = 0;
+    data->nav_status = '\0';
+    if (!Sentence::scan(sentence, "tTfdfdsifff;fic", type, &data->time, &data->latitude,
+                        &latitude_direction, &data->longitude, &longitude_direction, data->mode,
+                        &data->satellites_used, &data->hdop, &data->altitude, &data->height,
+                        &data->dgps_age, &data->station_id, &data->nav_status))
+        return false;
+    if (strcmp(type + 2, "GNS")) return false;
+
+    data->latitude.value *= latitude_direction;
+    data->longitude.value *= longitude_direction;
+
+    return true;
+};
+
+bool NmeaSentenceGBS::parse(void* frame, const char* sentence) {
+    auto data = (NmeaSentenceDataGbs*)frame;
+    // $GPGBS,235458.00,1.4,1.3,3.1,03,,-21.4,3.8,1,0*5B
+    char type[6];
+    char signal;
+
+    if (!Sentence::scan(sentence, "tTfffifff;ic", type, &data->time, &data->latitude_error,
+                        &data->longitude_error, &data->altitude_error, &data->failed_sat,
+                        &data->probability, &data->bias, &data->bias_deviation,
+                        &data->system_id, &signal))
+        return false;
+    if (strcmp(type + 2, "GBS")) return false;
+
+    data->signal_id = 0;
+    if (signal) {
+        data->signal_id = hex2int(signal);
+        if (data->signal_id == -1) return false;
+    }
+
+    return true;
+};
+
+bool NmeaSentenceHDT::parse(void* frame, const char* sentence) {
+    auto data = (NmeaSentenceDataHdt*)frame;
+    // $GPHDT,274.07,T*03
+    char type[6];
+    char c_true;
+
+    if (!Sentence::scan(sentence, "tfc", type, &data->heading, &c_true)) return false;
+    if (strcmp(type + 2, "HDT")) return false;
+    if (c_true != 'T' && c_true != '\0') return false;
+
+    return true;
+};
+
+bool NmeaSentenceTHS::parse(void* frame, const char* sentence) {
+    auto data = (NmeaSentenceDataThs*)frame;
+    // $GPTHS,77.52,E*32
+    char type[6];
+
+    if (!Sentence::scan(sentence, "tfc", type, &data->heading, &data->mode)) return false;
+    if (strcmp(type + 2, "THS")) return false;
+
+    return true;
+};
+
 bool Sentence::check(const char* sentence, bool strict) {
-    uint8_t checksum = 0x00;
+    uint32_t length = strlen(sentence);
 
     // Sequence length is limited.
-    if (strlen(sentence) > MINMEA_MAX_LENGTH + 3) return false;
+    if (length > MINMEA_MAX_LENGTH + 3) return false;
 
     // A valid sentence starts with "$".
-    if (*sentence++ != '$') return false;
+    if (*sentence != '$') return false;
 
     // The optional reducer is an XOR of all bytes between "$" and "*".
-    while (*sentence && *sentence != '*' && isprint((unsigned char)*sentence))
-        checksum ^= *sentence++;
+    NmeaKernelResult scanned;
+    NmeaKernel::scan(sentence, length, &scanned);
+    sentence += scanned.stop;
 
     // If reducer is present...
     if (*sentence == '*') {
@@ -301,7 +470,7 @@ bool Sentence::check(const char* sentence, bool strict) {
         int expected = upper << 4 | lower;
 
         // Check for reducer mismatch.
-        if (checksum != expected) return false;
+        if (scanned.checksum != expected) return false;
     } else if (strict) {
         // Discard non-checksummed frames in strict mode.
         return false;
@@ -335,6 +504,176 @@ bool Sentence::talker_id(char talker[3], const char* sentence) {
 
     return true;
 };
+bool Sentence::field_char(const char* field, uint32_t length, char* value) {
+    *value = length ? *field : '\0';
+    return true;
+};
+
+bool Sentence::field_direction(const char* field, uint32_t length, int* value) {
+    *value = 0;
+    if (!length) return true;
+
+    switch (*field) {
+        case 'N':
+        case 'E':
+            *value = 1;
+            return true;
+        case 'S':
+        case 'W':
+            *value = -1;
+            return true;
+        default:
+            return false;
+    }
+};
+
+bool Sentence::field_float(const char* field, uint32_t length, struct NmeaFloat* result) {
+    int           sign  = 0;
+    int_least32_t value = -1;
+    int_least32_t scale = 0;
+
+    for (uint32_t i = 0; i < length; i++) {
+        char c = field[i];
+        if (c == '+' && !sign && value == -1) {
+            sign = 1;
+        } else if (c == '-' && !sign && value == -1) {
+            sign = -1;
+        } else if (isdigit((unsigned char)c)) {
+            int digit = c - '0';
+            if (value == -1) value = 0;
+            if (value > (INT_LEAST32_MAX - digit) / 10) {
+                /* we ran out of bits, what do we do? */
+                if (scale) {
+                    /* truncate extra precision */
+                    break;
+                } else {
+                    /* integer overflow. bail out. */
+                    return false;
+                }
+            }
+            value = (10 * value) + digit;
+            if (scale) scale *= 10;
+        } else if (c == '.' && scale == 0) {
+            scale = 1;
+        } else if (c == ' ') {
+            /* Allow spaces at the start of the field. Not NMEA
+             * conformant, but some modules do this. */
+            if (sign != 0 || value != -1 || scale != 0) return false;
+        } else {
+            return false;
+        }
+    }
+
+    if ((sign || scale) && value == -1) return false;
+
+    if (value == -1) {
+        /* No digits were scanned. */
+        value = 0;
+        scale = 0;
+    } else if (scale == 0) {
+        /* No decimal point. */
+        scale = 1;
+    }
+    if (sign) value *= sign;
+
+    *result = (struct NmeaFloat){value, scale};
+    return true;
+};
+
+bool Sentence::field_int(const char* field, uint32_t length, int* value) {
+    *value = 0;
+    if (!length) return true;
+
+    // Same as strtol, without reading past the field.
+    uint32_t i = 0;
+    while (i < length && isspace((unsigned char)field[i])) {
+        i++;
+    }
+    int sign = 1;
+    if (i < length && (field[i] == '+' || field[i] == '-')) {
+        if (field[i] == '-') sign = -1;
+        i++;
+    }
+    uint32_t digits = 0;
+    long     result = 0;
+    while (i < length && isdigit((unsigned char)field[i])) {
+        if (result < INT32_MAX) result = result * 10 + (field[i] - '0');
+        i++;
+        digits++;
+    }
+    if (!digits || i != length) return false;
+
+    *value = (int)(sign * result);
+    return true;
+};
+
+bool Sentence::field_hex(const char* field, uint32_t length, int* value) {
+    if (length != 1) return false;
+    *value = hex2int(*field);
+    return *value != -1;
+};
+
+bool Sentence::field_string(const char* field, uint32_t length, char* value) {
+    memcpy(value, field, length);
+    value[length] = '\0';
+    return true;
+};
+
+bool Sentence::field_date(const char* field, uint32_t length, struct NmeaDate* date) {
+    int d = -1, m = -1, y = -1;
+
+    if (length) {
+        // Always six digits.
+        if (length < 6) return false;
+        for (int f = 0; f < 6; f++)
+            if (!isdigit((unsigned char)field[f])) return false;
+
+        d = (field[0] - '0') * 10 + (field[1] - '0');
+        m = (field[2] - '0') * 10 + (field[3] - '0');
+        y = (field[4] - '0') * 10 + (field[5] - '0');
+    }
+
+    date->day   = d;
+    date->month = m;
+    date->year  = y;
+    return true;
+};
+
+bool Sentence::field_time(const char* field, uint32_t length, struct NmeaTime* time_) {
+    int h = -1, i = -1, s = -1, u = -1;
+
+    if (length) {
+        // Minimum required: integer time.
+        if (length < 6) return false;
+        for (int f = 0; f < 6; f++)
+            if (!isdigit((unsigned char)field[f])) return false;
+
+        h = (field[0] - '0') * 10 + (field[1] - '0');
+        i = (field[2] - '0') * 10 + (field[3] - '0');
+        s = (field[4] - '0') * 10 + (field[5] - '0');
+
+        // Extra: fractional time. Saved as microseconds.
+        uint32_t pos = 6;
+        if (pos < length && field[pos++] == '.') {
+            uint32_t value = 0;
+            uint32_t scale = 1000000LU;
+            while (pos < length && isdigit((unsigned char)field[pos]) && scale > 1) {
+                value = (value * 10) + (field[pos++] - '0');
+                scale /= 10;
+            }
+            u = value * scale;
+        } else {
+            u = 0;
+        }
+    }
+
+    time_->hours        = h;
+    time_->minutes      = i;
+    time_->seconds      = s;
+    time_->microseconds = u;
+    return true;
+};
+
 /**
  * Scanf-like processor for NMEA sentences. Supports the following formats:
  * c - single character (char *)
@@ -349,27 +688,21 @@ bool Sentence::talker_id(char talker[3], const char* sentence) {
 bool Sentence::scan(const char* sentence, const char* format, ...) {
     bool    result   = false;
     bool    optional = false;
-    uint8_t crc      = 0;
     va_list ap;
     va_start(ap, format);
 
-    const char* field = sentence;
-    char        c     = *sentence;
-#define next_field()                            \
-    do {                                        \
-        /* Progress to the next field. */       \
-        while (minmea_isfield(c)) {             \
-            crc ^= c;                           \
-            c = *++sentence;                    \
-        }                                       \
-        /* Make sure there is a field there. */ \
-        if (c == ',') {                         \
-            crc ^= c;                           \
-            c     = *++sentence;                \
-            field = sentence;                   \
-        } else {                                \
-            field = NULL;                       \
-        }                                       \
+    NmeaFields fields;
+    NmeaKernel::tokenize(sentence, strlen(sentence), &fields);
+
+    uint32_t    index  = 0;
+    const char* field  = sentence;
+    uint32_t    length = fields.length(0);
+#define next_field()                                                            \
+    do {                                                                        \
+        /* Progress to the next field, if there is one. */                      \
+        index++;                                                                \
+        field  = (index < fields.count) ? sentence + fields.start[index] : NULL; \
+        length = field ? fields.length(index) : 0;                              \
     } while (0)
 
     while (*format) {
@@ -388,109 +721,23 @@ bool Sentence::scan(const char* sentence, const char* format, ...) {
 
         switch (type) {
             case 'c': {  // Single character field (char).
-                char value = '\0';
-
-                if (field && minmea_isfield(*field)) value = *field;
-
-                *va_arg(ap, char*) = value;
+                field_char(field, length, va_arg(ap, char*));
             } break;
 
             case 'd': {  // Single character direction field (int).
-                int value = 0;
-
-                if (field && minmea_isfield(*field)) {
-                    switch (*field) {
-                        case 'N':
-                        case 'E':
-                            value = 1;
-                            break;
-                        case 'S':
-                        case 'W':
-                            value = -1;
-                            break;
-                        default:
-                            goto parse_error;
-                    }
-                }
-
-                *va_arg(ap, int*) = value;
+                if (!field_direction(field, length, va_arg(ap, int*))) goto parse_error;
             } break;
 
             case 'f': {  // Fractional value with scale (struct NmeaFloat).
-                int           sign  = 0;
-                int_least32_t value = -1;
-                int_least32_t scale = 0;
-
-                if (field) {
-                    while (minmea_isfield(*field)) {
-                        if (*field == '+' && !sign && value == -1) {
-                            sign = 1;
-                        } else if (*field == '-' && !sign && value == -1) {
-                            sign = -1;
-                        } else if (isdigit((unsigned char)*field)) {
-                            int digit = *field - '0';
-                            if (value == -1) value = 0;
-                            if (value > (INT_LEAST32_MAX - digit) / 10) {
-                                /* we ran out of bits, what do we do? */
-                                if (scale) {
-                                    /* truncate extra precision */
-                                    break;
-                                } else {
-                                    /* integer overflow. bail out. */
-                                    goto parse_error;
-                                }
-                            }
-                            value = (10 * value) + digit;
-                            if (scale) scale *= 10;
-                        } else if (*field == '.' && scale == 0) {
-                            scale = 1;
-                        } else if (*field == ' ') {
-                            /* Allow spaces at the start of the field. Not NMEA
-                             * conformant, but some modules do this. */
-                            if (sign != 0 || value != -1 || scale != 0) goto parse_error;
-                        } else {
-                            goto parse_error;
-                        }
-                        field++;
-                    }
-                }
-
-                if ((sign || scale) && value == -1) goto parse_error;
-
-                if (value == -1) {
-                    /* No digits were scanned. */
-                    value = 0;
-                    scale = 0;
-                } else if (scale == 0) {
-                    /* No decimal point. */
-                    scale = 1;
-                }
-                if (sign) value *= sign;
-
-                *va_arg(ap, struct NmeaFloat*) = (struct NmeaFloat){value, scale};
+                if (!field_float(field, length, va_arg(ap, struct NmeaFloat*))) goto parse_error;
             } break;
 
             case 'i': {  // Integer value, default 0 (int).
-                int value = 0;
-
-                if (field) {
-                    char* endptr;
-                    value = strtol(field, &endptr, 10);
-                    if (minmea_isfield(*endptr)) goto parse_error;
-                }
-
-                *va_arg(ap, int*) = value;
+                if (!field_int(field, length, va_arg(ap, int*))) goto parse_error;
             } break;
 
             case 's': {  // String value (char *).
-                char* buf = va_arg(ap, char*);
-
-                if (field) {
-                    while (minmea_isfield(*field))
-                        *buf++ = *field++;
-                }
-
-                *buf = '\0';
+                field_string(field, length, va_arg(ap, char*));
             } break;
 
             case 't': {  // NMEA talker+sentence identifier (char *).
@@ -498,8 +745,7 @@ bool Sentence::scan(const char* sentence, const char* format, ...) {
                 if (!field) goto parse_error;
 
                 if (field[0] != '$') goto parse_error;
-                for (int f = 0; f < 5; f++)
-                    if (!minmea_isfield(field[1 + f])) goto parse_error;
+                if (length < 6) goto parse_error;
 
                 char* buf = va_arg(ap, char*);
                 memcpy(buf, field + 1, 5);
@@ -507,64 +753,11 @@ bool Sentence::scan(const char* sentence, const char* format, ...) {
             } break;
 
             case 'D': {  // Date (int, int, int), -1 if empty.
-                struct NmeaDate* date = va_arg(ap, struct NmeaDate*);
-
-                int d = -1, m = -1, y = -1;
-
-                if (field && minmea_isfield(*field)) {
-                    // Always six digits.
-                    for (int f = 0; f < 6; f++)
-                        if (!isdigit((unsigned char)field[f])) goto parse_error;
-
-                    char dArr[] = {field[0], field[1], '\0'};
-                    char mArr[] = {field[2], field[3], '\0'};
-                    char yArr[] = {field[4], field[5], '\0'};
-                    d           = strtol(dArr, NULL, 10);
-                    m           = strtol(mArr, NULL, 10);
-                    y           = strtol(yArr, NULL, 10);
-                }
-
-                date->day   = d;
-                date->month = m;
-                date->year  = y;
+                if (!field_date(field, length, va_arg(ap, struct NmeaDate*))) goto parse_error;
             } break;
 
             case 'T': {  // Time (int, int, int, int), -1 if empty.
-                struct NmeaTime* time_ = va_arg(ap, struct NmeaTime*);
-
-                int h = -1, i = -1, s = -1, u = -1;
-
-                if (field && minmea_isfield(*field)) {
-                    // Minimum required: integer time.
-                    for (int f = 0; f < 6; f++)
-                        if (!isdigit((unsigned char)field[f])) goto parse_error;
-
-                    char hArr[] = {field[0], field[1], '\0'};
-                    char iArr[] = {field[2], field[3], '\0'};
-                    char sArr[] = {field[4], field[5], '\0'};
-                    h           = strtol(hArr, NULL, 10);
-                    i           = strtol(iArr, NULL, 10);
-                    s           = strtol(sArr, NULL, 10);
-                    field += 6;
-
-                    // Extra: fractional time. Saved as microseconds.
-                    if (*field++ == '.') {
-                        uint32_t value = 0;
-                        uint32_t scale = 1000000LU;
-                        while (isdigit((unsigned char)*field) && scale > 1) {
-                            value = (value * 10) + (*field++ - '0');
-                            scale /= 10;
-                        }
-                        u = value * scale;
-                    } else {
-                        u = 0;
-                    }
-                }
-
-                time_->hours        = h;
-                time_->minutes      = i;
-                time_->seconds      = s;
-                time_->microseconds = u;
+                if (!field_time(field, length, va_arg(ap, struct NmeaTime*))) goto parse_error;
             } break;
 
             case '_': {  // Ignore the field.
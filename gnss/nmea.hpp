@@ -3,7 +3,9 @@
 #include "base.hpp"
 namespace wibot::protocal::gnss {
 
-#define NMEA_SENTENCE_ENTRY_SIZE 16
+#define NMEA_SENTENCE_ENTRY_SIZE 32  // hash slots of the built-in table, power of 2.
+
+#define NMEA_ADDRESS_MAX_LENGTH 15
 
 #define MINMEA_MAX_LENGTH 80
 
@@ -18,12 +20,36 @@ enum NMEA_SENTENCE_ID {
     NMEA_SENTENCE_GSV,
     NMEA_SENTENCE_VTG,
     NMEA_SENTENCE_ZDA,
+    NMEA_SENTENCE_GNS,
+    NMEA_SENTENCE_GBS,
+    NMEA_SENTENCE_HDT,
+    NMEA_SENTENCE_THS,
+    NMEA_SENTENCE_PROPRIETARY,
 };
 
+#define NMEA_SENTENCE_ID_COUNT (NMEA_SENTENCE_PROPRIETARY + 1)
+
+#define NMEA_HASH_INIT 2166136261U
+
+/**
+ * FNV-1a, continued from hash, NMEA_HASH_INIT to start.
+ */
+static inline uint32_t nmea_hash(uint32_t hash, const char* data, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)data[i];
+        hash *= 16777619U;
+    }
+    return hash;
+};
+
+#define NMEA_SENTENCE_BIT(id) (1U << (id))
+
 enum NMEA_TALKER {
     NMEA_TALKER_GN = 0,
     NMEA_TALKER_GP,
     NMEA_TALKER_BD,
+    NMEA_TALKER_ANY,          // match the type with any talker.
+    NMEA_TALKER_PROPRIETARY,  // "$P..." sentences, matched by the whole address.
 };
 
 struct NmeaSentence {
@@ -120,6 +146,17 @@ enum NMEA_GSA_FIX_TYPE {
     NMEA_GPGSA_FIX_3D   = 3,
 };
 
+// System ID added to GSA and GSV in NMEA 4.10.
+enum NMEA_SYSTEM_ID {
+    NMEA_SYSTEM_UNKNOWN = 0,
+    NMEA_SYSTEM_GPS     = 1,
+    NMEA_SYSTEM_GLONASS = 2,
+    NMEA_SYSTEM_GALILEO = 3,
+    NMEA_SYSTEM_BEIDOU  = 4,
+    NMEA_SYSTEM_QZSS    = 5,
+    NMEA_SYSTEM_NAVIC   = 6,
+};
+
 struct NmeaSentenceDataGsa {
     char             mode;
     int              fix_type;
@@ -127,6 +164,7 @@ struct NmeaSentenceDataGsa {
     struct NmeaFloat pdop;
     struct NmeaFloat hdop;
     struct NmeaFloat vdop;
+    int              system_id;  // 0 if not present.
 };
 
 struct NmeaSatInfo {
@@ -141,6 +179,7 @@ struct NmeaSentenceDataGsv {
     int                msg_nr;
     int                total_sats;
     struct NmeaSatInfo sats[4];
+    int                signal_id;  // 0 if not present.
 };
 
 struct NmeaSentenceDataVtg {
@@ -158,6 +197,62 @@ struct NmeaSentenceDataZda {
     int             minute_offset;
 };
 
+#define NMEA_GNS_MODE_SIZE 8
+
+struct NmeaSentenceDataGns {
+    struct NmeaTime  time;
+    struct NmeaFloat latitude;
+    struct NmeaFloat longitude;
+    char             mode[NMEA_GNS_MODE_SIZE];  // one FAA mode per system.
+    int              satellites_used;
+    struct NmeaFloat hdop;
+    struct NmeaFloat altitude;
+    struct NmeaFloat height;
+    struct NmeaFloat dgps_age;
+    int              station_id;
+    char             nav_status;  // NMEA 4.10, '\0' if not present.
+};
+
+struct NmeaSentenceDataGbs {
+    struct NmeaTime  time;
+    struct NmeaFloat latitude_error;
+    struct NmeaFloat longitude_error;
+    struct NmeaFloat altitude_error;
+    int              failed_sat;
+    struct NmeaFloat probability;
+    struct NmeaFloat bias;
+    struct NmeaFloat bias_deviation;
+    int              system_id;  // NMEA 4.10, 0 if not present.
+    int              signal_id;  // NMEA 4.10, 0 if not present.
+};
+
+struct NmeaSentenceDataHdt {
+    struct NmeaFloat heading;
+};
+
+struct NmeaSentenceDataThs {
+    struct NmeaFloat heading;
+    char             mode;
+};
+
+/**
+ * Data of any built-in sentence.
+ */
+union NmeaSentenceDataAny {
+    struct NmeaSentenceDataRmc rmc;
+    struct NmeaSentenceDataGga gga;
+    struct NmeaSentenceDataGsa gsa;
+    struct NmeaSentenceDataGll gll;
+    struct NmeaSentenceDataGst gst;
+    struct NmeaSentenceDataGsv gsv;
+    struct NmeaSentenceDataVtg vtg;
+    struct NmeaSentenceDataZda zda;
+    struct NmeaSentenceDataGns gns;
+    struct NmeaSentenceDataGbs gbs;
+    struct NmeaSentenceDataHdt hdt;
+    struct NmeaSentenceDataThs ths;
+};
+
 class Sentence {
    public:
     static bool    check(const char* sentence, bool strict);
@@ -175,8 +270,27 @@ class Sentence {
      * Returns true on success. See library source code for details.
      */
     static bool    scan(const char* sentence, const char* format, ...);
+
+    /**
+     * Decode a single field of length bytes, as the matching scan format does. An empty
+     * field gives the default value. Return false if the field is malformed. field_hex
+     * takes a single hex digit, as the signal id of GSV and GSA, and rejects an empty field.
+     */
+    static bool field_char(const char* field, uint32_t length, char* value);
+    static bool field_direction(const char* field, uint32_t length, int* value);
+    static bool field_float(const char* field, uint32_t length, struct NmeaFloat* value);
+    static bool field_int(const char* field, uint32_t length, int* value);
+    static bool field_hex(const char* field, uint32_t length, int* value);
+    static bool field_string(const char* field, uint32_t length, char* value);
+    static bool field_date(const char* field, uint32_t length, struct NmeaDate* value);
+    static bool field_time(const char* field, uint32_t length, struct NmeaTime* value);
 };
 
+/**
+ * Parser of one sentence type. An entry is matched by its talker and type, e.g. "GP" + "RMC",
+ * by its type with any talker, or, for proprietary sentences, by the whole address field,
+ * e.g. "PUBX".
+ */
 class NmeaSentenceBase {
    public:
     NmeaSentenceBase(NMEA_SENTENCE_ID id, const char* idStr, NMEA_TALKER talker,
@@ -184,10 +298,18 @@ class NmeaSentenceBase {
         : id(id), idStr(idStr), talker(talker), talkerStr(talkerStr){};
 
     virtual bool     parse(void* frame, const char* sentence) = 0;
-    bool             match(const char* sentence);
+    /**
+     * Match the address field of a sentence, e.g. "GNRMC".
+     */
+    bool             match(const char* address, uint32_t length) const;
+    /**
+     * Hash of the key this entry is matched with.
+     */
+    uint32_t         hash() const;
     NMEA_SENTENCE_ID id;
 
    private:
+    friend class NmeaParser;
     const char* idStr;
     NMEA_TALKER talker;
     const char* talkerStr;
@@ -197,69 +319,151 @@ class NmeaSentenceGNBase : public NmeaSentenceBase {
    public:
     NmeaSentenceGNBase(NMEA_SENTENCE_ID id, const char* idStr)
         : NmeaSentenceBase(id, idStr, NMEA_TALKER_GN, "GN"){};
-    bool parse(void* frame, const char* sentence) override;
 };
 
-class NmeaSentenceRMC : public NmeaSentenceGNBase {
+class NmeaSentenceAnyTalkerBase : public NmeaSentenceBase {
    public:
-    NmeaSentenceRMC() : NmeaSentenceGNBase(NMEA_SENTENCE_RMC, "RMC"){};
+    NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_ID id, const char* idStr)
+        : NmeaSentenceBase(id, idStr, NMEA_TALKER_ANY, nullptr){};
+};
+
+class NmeaSentenceProprietaryBase : public NmeaSentenceBase {
+   public:
+    /**
+     * @param address Whole address field without '$', e.g. "PUBX".
+     */
+    explicit NmeaSentenceProprietaryBase(const char* address)
+        : NmeaSentenceBase(NMEA_SENTENCE_PROPRIETARY, address, NMEA_TALKER_PROPRIETARY,
+                           nullptr){};
+};
+
+class NmeaSentenceRMC : public NmeaSentenceAnyTalkerBase {
+   public:
+    NmeaSentenceRMC() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_RMC, "RMC"){};
     bool parse(void* frame, const char* sentence);
 };
 
-class NmeaSentenceGGA : public NmeaSentenceGNBase {
+class NmeaSentenceGGA : public NmeaSentenceAnyTalkerBase {
+   public:
+    NmeaSentenceGGA() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_GGA, "GGA"){};
+    virtual bool parse(void* frame, const char* sentence) override;
+};
+
+class NmeaSentenceGSA : public NmeaSentenceAnyTalkerBase {
+   public:
+    NmeaSentenceGSA() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_GSA, "GSA"){};
+    virtual bool parse(void* frame, const char* sentence) override;
+};
+
+class NmeaSentenceGLL : public NmeaSentenceAnyTalkerBase {
+   public:
+    NmeaSentenceGLL() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_GLL, "GLL"){};
+    virtual bool parse(void* frame, const char* sentence) override;
+};
+
+class NmeaSentenceGST : public NmeaSentenceAnyTalkerBase {
    public:
-    NmeaSentenceGGA() : NmeaSentenceGNBase(NMEA_SENTENCE_GGA, "GGA"){};
+    NmeaSentenceGST() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_GST, "GST"){};
     virtual bool parse(void* frame, const char* sentence) override;
 };
 
-class NmeaSentenceGSA : public NmeaSentenceGNBase {
+class NmeaSentenceGSV : public NmeaSentenceAnyTalkerBase {
    public:
-    NmeaSentenceGSA() : NmeaSentenceGNBase(NMEA_SENTENCE_GSA, "GSA"){};
+    NmeaSentenceGSV() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_GSV, "GSV"){};
     virtual bool parse(void* frame, const char* sentence) override;
 };
 
-class NmeaSentenceGLL : public NmeaSentenceGNBase {
+class NmeaSentenceVTG : public NmeaSentenceAnyTalkerBase {
    public:
-    NmeaSentenceGLL() : NmeaSentenceGNBase(NMEA_SENTENCE_GLL, "GLL"){};
+    NmeaSentenceVTG() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_VTG, "VTG"){};
     virtual bool parse(void* frame, const char* sentence) override;
 };
 
-class NmeaSentenceGST : public NmeaSentenceGNBase {
+class NmeaSentenceZDA : public NmeaSentenceAnyTalkerBase {
    public:
-    NmeaSentenceGST() : NmeaSentenceGNBase(NMEA_SENTENCE_GST, "GST"){};
+    NmeaSentenceZDA() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_ZDA, "ZDA"){};
     virtual bool parse(void* frame, const char* sentence) override;
 };
 
-class NmeaSentenceGSV : public NmeaSentenceGNBase {
+class NmeaSentenceGNS : public NmeaSentenceAnyTalkerBase {
    public:
-    NmeaSentenceGSV() : NmeaSentenceGNBase(NMEA_SENTENCE_GSV, "GSV"){};
+    NmeaSentenceGNS() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_GNS, "GNS"){};
     virtual bool parse(void* frame, const char* sentence) override;
 };
 
-class NmeaSentenceVTG : public NmeaSentenceGNBase {
+class NmeaSentenceGBS : public NmeaSentenceAnyTalkerBase {
    public:
-    NmeaSentenceVTG() : NmeaSentenceGNBase(NMEA_SENTENCE_VTG, "VTG"){};
+    NmeaSentenceGBS() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_GBS, "GBS"){};
     virtual bool parse(void* frame, const char* sentence) override;
 };
 
-class NmeaSentenceZDA : public NmeaSentenceGNBase {
+class NmeaSentenceHDT : public NmeaSentenceAnyTalkerBase {
    public:
-    NmeaSentenceZDA() : NmeaSentenceGNBase(NMEA_SENTENCE_ZDA, "ZDA"){};
+    NmeaSentenceHDT() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_HDT, "HDT"){};
     virtual bool parse(void* frame, const char* sentence) override;
 };
 
+class NmeaSentenceTHS : public NmeaSentenceAnyTalkerBase {
+   public:
+    NmeaSentenceTHS() : NmeaSentenceAnyTalkerBase(NMEA_SENTENCE_THS, "THS"){};
+    virtual bool parse(void* frame, const char* sentence) override;
+};
+
+/**
+ * Sentence registry, hashed by address. A talker specific entry takes precedence over an any
+ * talker entry of the same type. Lookup is two hash lookups at most, talker specific then any
+ * talker, each a linear probe whose length is bounded by the load factor of the table.
+ */
 class NmeaParser {
    public:
+    NmeaParser();
+    /**
+     * Use a caller provided hash table, for more than the built-in NMEA_SENTENCE_ENTRY_SIZE
+     * slots. capacity is rounded down to a power of 2, the slots above are left unused, and
+     * should be at least twice the number of entries.
+     */
+    NmeaParser(NmeaSentenceBase** table, uint32_t capacity);
+
+    /**
+     * @return Return false if the table is at its load limit, capacity - 1 entries, one slot is
+     * kept empty so that a lookup always ends. Registering an entry again succeeds.
+     */
     bool sentence_register(NmeaSentenceBase* entry);
     bool sentence_register_default();
 
     /**
-     * Determine sentence identifier.
+     * Determine sentence identifier. The address is looked up before the checksum is checked,
+     * unknown and unsubscribed sentences are dropped without any further work.
      */
     bool sentence_entry_get(const char* sentence, bool strict, NmeaSentenceBase** result);
 
+    /**
+     * Only accept the sentences of NMEA_SENTENCE_BIT(id) set in sentences, all proprietary
+     * entries share NMEA_SENTENCE_PROPRIETARY. All sentences are accepted by default.
+     */
+    void subscribe(uint32_t sentences);
+
+    /**
+     * Sentences dropped by sentence_entry_get per NMEA_SENTENCE_ID, for being unsubscribed, or
+     * at NMEA_UNKNOWN for an address without entry.
+     */
+    uint32_t dropped[NMEA_SENTENCE_ID_COUNT];
+    void     dropped_reset();
+
+    /**
+     * Find the entry of an address field, e.g. "GPRMC" or "PUBX".
+     */
+    NmeaSentenceBase* sentence_entry_find(const char* address, uint32_t length) const;
+
    private:
-    NmeaSentenceBase* entries[NMEA_SENTENCE_ENTRY_SIZE];
+    NmeaSentenceBase*  entries[NMEA_SENTENCE_ENTRY_SIZE];
+    NmeaSentenceBase** _table;
+    uint32_t           _capacity;
+    uint32_t           _count;
+    uint32_t           _subscribed;
+
+    NmeaSentenceBase* _probe(uint32_t hash, bool anyTalker, const char* address,
+                             uint32_t length) const;
 };
 
 /**
@@ -0,0 +1,155 @@
+#include "nmea_bench.hpp"
+#ifdef __linux__
+
+#include <chrono>
+
+#include "log.h"
+#include "minunit.h"
+#include "nmea.hpp"
+#include "nmea_corpus.hpp"
+#include "string.h"
+
+LOGGER("nmea_bench")
+
+namespace wibot::protocal::gnss::test {
+
+#define NMEA_BENCH_CORPUS_SIZE 4096
+#define NMEA_BENCH_ROUNDS 32
+#define NMEA_BENCH_SEED 20261018
+
+static struct NmeaCorpusSentence benchCorpus[NMEA_BENCH_CORPUS_SIZE];
+static uint16_t                  benchIndices[NMEA_BENCH_CORPUS_SIZE];
+
+static const char* benchNames[] = {"", "RMC", "GGA", "GSA", "GLL", "GST", "GSV",
+                                   "VTG", "ZDA", "GNS", "GBS", "HDT", "THS"};
+
+static uint64_t nmea_bench_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+};
+
+static uint32_t nmea_bench_fields(const struct NmeaCorpusSentence* sentence) {
+    uint32_t count = 1;
+    for (const char* c = sentence->text; *c && *c != '*' && *c != '\r'; c++) {
+        count += (*c == ',');
+    }
+    return count;
+};
+
+static bool nmea_bench_decode(NmeaParser& parser, const char* sentence, bool strict) {
+    NmeaSentenceBase*         entry;
+    union NmeaSentenceDataAny data;
+    return parser.sentence_entry_get(sentence, strict, &entry) && entry->parse(&data, sentence);
+};
+
+static void nmea_bench_conformance(NmeaParser& parser) {
+    uint32_t accepted[2] = {0, 0};
+    uint32_t rejected[2] = {0, 0};
+    uint32_t mismatches  = 0;
+    for (uint32_t i = 0; i < NMEA_BENCH_CORPUS_SIZE; i++) {
+        const struct NmeaCorpusSentence* sentence = &benchCorpus[i];
+        bool decodable = sentence->id != NMEA_UNKNOWN && !sentence->corrupted;
+        for (int strict = 0; strict < 2; strict++) {
+            bool expected = decodable && (sentence->checksum || !strict);
+            bool decoded  = nmea_bench_decode(parser, sentence->text, strict);
+            if (decoded) {
+                accepted[strict]++;
+            } else {
+                rejected[strict]++;
+            }
+            if (decoded != expected) {
+                mismatches++;
+                LOG_E("%s %s", strict ? "strict" : "non-strict", sentence->text);
+            }
+        }
+    }
+    MU_ASSERT(mismatches == 0);
+    LOG_I("non-strict: %u accepted, %u rejected", accepted[0], rejected[0]);
+    LOG_I("strict: %u accepted, %u rejected", accepted[1], rejected[1]);
+};
+
+static void nmea_bench_throughput(NmeaParser& parser) {
+    volatile uint32_t sink = 0;
+    for (int id = NMEA_SENTENCE_RMC; id < NMEA_SENTENCE_PROPRIETARY; id++) {
+        uint32_t count  = 0;
+        uint32_t fields = 0;
+        for (uint32_t i = 0; i < NMEA_BENCH_CORPUS_SIZE; i++) {
+            const struct NmeaCorpusSentence* sentence = &benchCorpus[i];
+            if (sentence->id != id || sentence->corrupted) continue;
+            benchIndices[count++] = i;
+            fields += nmea_bench_fields(sentence);
+        }
+        if (count == 0) continue;
+
+        uint64_t start = nmea_bench_now();
+        for (int round = 0; round < NMEA_BENCH_ROUNDS; round++) {
+            for (uint32_t i = 0; i < count; i++) {
+                sink = sink + nmea_bench_decode(parser, benchCorpus[benchIndices[i]].text, false);
+            }
+        }
+        uint64_t elapsed = nmea_bench_now() - start;
+        if (elapsed == 0) elapsed = 1;
+
+        double sentences = (double)count * NMEA_BENCH_ROUNDS;
+        LOG_I("%s: %u sentences, %.0f sentences/s, %.1f ns/sentence, %.1f ns/field",
+              benchNames[id], count, sentences * 1e9 / elapsed, elapsed / sentences,
+              elapsed / (sentences * fields / count));
+    }
+};
+
+static void nmea_bench_subscription(NmeaParser& parser) {
+    volatile uint32_t sink = 0;
+    for (int subscribed = 0; subscribed < 2; subscribed++) {
+        parser.subscribe(subscribed ? NMEA_SENTENCE_BIT(NMEA_SENTENCE_RMC) |
+                                          NMEA_SENTENCE_BIT(NMEA_SENTENCE_GGA)
+                                    : ~0U);
+        parser.dropped_reset();
+
+        uint64_t start = nmea_bench_now();
+        for (int round = 0; round < NMEA_BENCH_ROUNDS; round++) {
+            for (uint32_t i = 0; i < NMEA_BENCH_CORPUS_SIZE; i++) {
+                sink = sink + nmea_bench_decode(parser, benchCorpus[i].text, false);
+            }
+        }
+        uint64_t elapsed = nmea_bench_now() - start;
+
+        uint32_t dropped = 0;
+        for (int id = 0; id < NMEA_SENTENCE_ID_COUNT; id++) {
+            dropped += parser.dropped[id];
+        }
+        LOG_I("%s: %.1f ns/sentence, %u dropped", subscribed ? "RMC+GGA" : "all",
+              (double)elapsed / ((double)NMEA_BENCH_CORPUS_SIZE * NMEA_BENCH_ROUNDS),
+              dropped / NMEA_BENCH_ROUNDS);
+    }
+    parser.subscribe(~0U);
+};
+
+void nmea_bench() {
+    NmeaParser parser;
+    parser.sentence_register_default();
+
+    // About 6% of the sentences without checksum, and 3% of the others corrupted.
+    NmeaCorpus generator(NMEA_BENCH_SEED);
+    generator.noChecksumRate = 16;
+    generator.corruptRate    = 8;
+    generator.generate(benchCorpus, NMEA_BENCH_CORPUS_SIZE);
+
+    // Same seed, same corpus.
+    NmeaCorpus                replay(NMEA_BENCH_SEED);
+    struct NmeaCorpusSentence first[8];
+    replay.noChecksumRate = 16;
+    replay.corruptRate    = 8;
+    replay.generate(first, 8);
+    for (int i = 0; i < 8; i++) {
+        MU_ASSERT(!strcmp(first[i].text, benchCorpus[i].text));
+    }
+
+    nmea_bench_conformance(parser);
+    nmea_bench_throughput(parser);
+    nmea_bench_subscription(parser);
+};
+
+}  // namespace wibot::protocal::gnss::test
+
+#endif  // __linux__
@@ -0,0 +1,11 @@
+#ifndef __WWTALK_NMEA_BENCH_HPP__
+#define __WWTALK_NMEA_BENCH_HPP__
+
+namespace wibot::protocal::gnss::test {
+/**
+ * Conformance of NmeaParser over a generated corpus, then its throughput per sentence type.
+ */
+void nmea_bench();
+}
+
+#endif  // __WWTALK_NMEA_BENCH_HPP__
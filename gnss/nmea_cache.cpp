@@ -0,0 +1,93 @@
+#include "nmea_cache.hpp"
+
+#include "nmea_kernel.hpp"
+#include "string.h"
+
+namespace wibot::protocal::gnss {
+
+NmeaSentenceCache::NmeaSentenceCache(NmeaParser& parser) : _parser(parser) {
+    init(0);
+};
+
+void NmeaSentenceCache::init(uint32_t sentences) {
+    _sentences = sentences;
+    reset();
+};
+
+void NmeaSentenceCache::reset() {
+    hits      = 0;
+    misses    = 0;
+    _gsaIndex = 0;
+    for (uint32_t i = 0; i < NMEA_CACHE_SLOT_COUNT; i++) {
+        _slots[i].length = 0;
+    }
+};
+
+bool NmeaSentenceCache::parse(const char* sentence, bool strict, NmeaSentenceBase** entry,
+                              const union NmeaSentenceDataAny** data, bool* unchanged) {
+    *unchanged = false;
+
+    // GSA of an epoch are told apart by their system id, or their order without one. Any
+    // other sentence ends the run, a rejected one too.
+    uint8_t gsaIndex = _gsaIndex;
+    _gsaIndex        = 0;
+    if (!_parser.sentence_entry_get(sentence, strict, entry)) return false;
+
+    NMEA_SENTENCE_ID id = (*entry)->id;
+    if (id <= NMEA_UNKNOWN || id >= NMEA_SENTENCE_PROPRIETARY) return false;
+
+    if (!(_sentences & NMEA_SENTENCE_BIT(id))) {
+        if (!(*entry)->parse(&_data, sentence)) return false;
+        if (id == NMEA_SENTENCE_GSA) {
+            _gsaIndex = gsaIndex + 1;
+        }
+        *data = &_data;
+        return true;
+    }
+
+    // Checked by sentence_entry_get, the sentence fits NMEA_CACHE_SENTENCE_SIZE.
+    NmeaFields fields;
+    NmeaKernel::tokenize(sentence, strlen(sentence), &fields);
+    uint32_t length = fields.end;
+
+    uint32_t key = nmea_hash(NMEA_HASH_INIT, sentence, fields.length(0));
+    if (id == NMEA_SENTENCE_GSV && fields.count > 2) {
+        key = nmea_hash(key, sentence + fields.start[2], fields.length(2));
+        if (fields.count > 4 && (fields.count - 4) % 4 == 1) {
+            uint32_t last = fields.count - 1;
+            key           = nmea_hash(key, sentence + fields.start[last], fields.length(last));
+        }
+    } else if (id == NMEA_SENTENCE_GSA) {
+        if (fields.count > 18) {
+            key = nmea_hash(key, sentence + fields.start[18], fields.length(18));
+        }
+        key = nmea_hash(key, (const char*)&gsaIndex, 1);
+    }
+
+    NmeaCacheSlot* slot = &_slots[key & (NMEA_CACHE_SLOT_COUNT - 1)];
+    if (slot->length == length && slot->key == key && slot->id == id &&
+        !memcmp(slot->raw, sentence, length)) {
+        hits++;
+        if (id == NMEA_SENTENCE_GSA) {
+            _gsaIndex = gsaIndex + 1;
+        }
+        *data      = &slot->data;
+        *unchanged = true;
+        return true;
+    }
+
+    misses++;
+    slot->length = 0;
+    if (!(*entry)->parse(&slot->data, sentence)) return false;
+    memcpy(slot->raw, sentence, length);
+    if (id == NMEA_SENTENCE_GSA) {
+        _gsaIndex = gsaIndex + 1;
+    }
+    slot->key    = key;
+    slot->id     = id;
+    slot->length = length;
+    *data        = &slot->data;
+    return true;
+};
+
+}  // namespace wibot::protocal::gnss
@@ -0,0 +1,65 @@
+#ifndef __WWTALK_GNSS_NMEA_CACHE_HPP__
+#define __WWTALK_GNSS_NMEA_CACHE_HPP__
+#include "base.hpp"
+#include "nmea.hpp"
+namespace wibot::protocal::gnss {
+
+#define NMEA_CACHE_SLOT_COUNT 16  // power of 2.
+
+#define NMEA_CACHE_SENTENCE_SIZE (MINMEA_MAX_LENGTH + 3)
+
+struct NmeaCacheSlot {
+    uint32_t                   key;
+    NMEA_SENTENCE_ID           id;
+    uint8_t                    length;  // 0 if the slot is empty.
+    char                       raw[NMEA_CACHE_SENTENCE_SIZE];
+    union NmeaSentenceDataAny  data;
+};
+
+/**
+ * Skip decoding sentences that repeat the last accepted one. A sentence is keyed by its
+ * address, GSV also by its message number and signal id, and GSA by its system id and its
+ * order among the GSA accepted in a row, so every fragment of a sequence has its own slot. If
+ * the raw bytes up to the checksum equal the ones of the last accepted sentence of the same
+ * key, the data decoded then is returned as is. Slots are direct mapped by key, a colliding
+ * key only causes a miss.
+ */
+class NmeaSentenceCache {
+   public:
+    explicit NmeaSentenceCache(NmeaParser& parser);
+
+    /**
+     * @param sentences NMEA_SENTENCE_BIT of the built-in sentences to cache, the others are
+     * decoded every time.
+     */
+    void init(uint32_t sentences);
+
+    /**
+     * Forget every cached sentence.
+     */
+    void reset();
+
+    /**
+     * Decode a sentence of a built-in type.
+     * @param entry Entry of the sentence.
+     * @param data Decoded data, valid until the next parse.
+     * @param unchanged Set if the sentence equals the last accepted one of its key.
+     * @return Return false if the sentence is not recognized, not built-in or malformed.
+     */
+    bool parse(const char* sentence, bool strict, NmeaSentenceBase** entry,
+               const union NmeaSentenceDataAny** data, bool* unchanged);
+
+    uint32_t hits;
+    uint32_t misses;
+
+   private:
+    NmeaParser&               _parser;
+    uint32_t                  _sentences;
+    NmeaCacheSlot             _slots[NMEA_CACHE_SLOT_COUNT];
+    union NmeaSentenceDataAny _data;
+    uint8_t                   _gsaIndex;  // GSA accepted in a row.
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NMEA_CACHE_HPP__
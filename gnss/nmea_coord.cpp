@@ -0,0 +1,143 @@
+#include "nmea_coord.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NMEA_COORD_LANES 4
+#else
+#define NMEA_COORD_LANES 0
+#endif
+
+namespace wibot::protocal::gnss {
+
+#define NMEA_COORD_BATCH_SIZE 64
+
+bool NmeaCoord::to_degrees(const struct NmeaFloat* coord, int64_t unit, int64_t* result) {
+    if (coord->scale <= 0) return false;
+
+    int64_t scale     = coord->scale;
+    int64_t magnitude = coord->value < 0 ? -(int64_t)coord->value : coord->value;
+    int64_t degrees   = magnitude / (100 * scale);
+    int64_t minutes   = magnitude % (100 * scale);
+    if (degrees > 180 || minutes >= 60 * scale) return false;
+
+    // minutes < 2^31 and unit <= 10^9, the product fits.
+    int64_t value = degrees * unit + (minutes * unit + 30 * scale) / (60 * scale);
+    *result       = coord->value < 0 ? -value : value;
+    return true;
+};
+
+bool NmeaCoord::to_nanodegrees(const struct NmeaFloat* coord, int64_t* result) {
+    return to_degrees(coord, NMEA_COORD_NANODEGREE, result);
+};
+
+bool NmeaCoord::to_degrees_e7(const struct NmeaFloat* coord, int32_t* result) {
+    int64_t value;
+    if (!to_degrees(coord, NMEA_COORD_DEGREE_E7, &value)) return false;
+    *result = (int32_t)value;
+    return true;
+};
+
+bool NmeaCoord::to_fixed(const struct NmeaFloat* value, int64_t unit, int64_t* result) {
+    if (value->scale <= 0) return false;
+
+    int64_t scale     = value->scale;
+    int64_t magnitude = value->value < 0 ? -(int64_t)value->value : value->value;
+    int64_t fixed     = (magnitude * unit + scale / 2) / scale;
+    *result           = value->value < 0 ? -fixed : fixed;
+    return true;
+};
+
+void NmeaCoord::to_nanodegrees_scalar(const struct NmeaFloat* coords, uint32_t count,
+                                      int64_t* result) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (!to_degrees(&coords[i], NMEA_COORD_NANODEGREE, &result[i])) {
+            result[i] = NMEA_COORD_UNKNOWN_NANO;
+        }
+    }
+};
+
+#if NMEA_COORD_LANES == 4
+/**
+ * Convert 4 coordinates in double lanes. Every intermediate is an integer below 2^53, and
+ * every quotient is floored far enough from the next integer, so the result is exact. Lanes
+ * whose scale does not divide unit, or that are invalid, are left to the scalar conversion.
+ */
+static inline uint32_t convert_lanes(const struct NmeaFloat* coords, double unit,
+                                     int64_t* result) {
+    const __m256i raw =
+        _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)coords),
+                                    _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7));
+    const __m256d value = _mm256_cvtepi32_pd(_mm256_castsi256_si128(raw));
+    const __m256d scale = _mm256_cvtepi32_pd(_mm256_extracti128_si256(raw, 1));
+
+    const __m256d negative  = _mm256_cmp_pd(value, _mm256_setzero_pd(), _CMP_LT_OQ);
+    const __m256d magnitude = _mm256_andnot_pd(_mm256_set1_pd(-0.0), value);
+    const __m256d hundred   = _mm256_mul_pd(scale, _mm256_set1_pd(100.0));
+    const __m256d degrees   = _mm256_floor_pd(_mm256_div_pd(magnitude, hundred));
+    const __m256d minutes   = _mm256_sub_pd(magnitude, _mm256_mul_pd(degrees, hundred));
+    const __m256d ratio     = _mm256_div_pd(_mm256_set1_pd(unit), scale);
+
+    __m256d valid = _mm256_cmp_pd(scale, _mm256_setzero_pd(), _CMP_GT_OQ);
+    valid = _mm256_and_pd(valid, _mm256_cmp_pd(ratio, _mm256_floor_pd(ratio), _CMP_EQ_OQ));
+    valid = _mm256_and_pd(valid, _mm256_cmp_pd(degrees, _mm256_set1_pd(180.0), _CMP_LE_OQ));
+    valid = _mm256_and_pd(valid, _mm256_cmp_pd(minutes, _mm256_mul_pd(scale, _mm256_set1_pd(60.0)),
+                                               _CMP_LT_OQ));
+
+    // minutes * ratio < 60 * unit, rounded to the nearest unit, halves up.
+    const __m256d fraction = _mm256_floor_pd(_mm256_div_pd(
+        _mm256_add_pd(_mm256_mul_pd(minutes, ratio), _mm256_set1_pd(30.0)), _mm256_set1_pd(60.0)));
+    const __m256d total = _mm256_add_pd(_mm256_mul_pd(degrees, _mm256_set1_pd(unit)), fraction);
+
+    // Below 2^52, adding 2^52 leaves the integer in the low mantissa bits.
+    const __m256d magic   = _mm256_set1_pd(4503599627370496.0);
+    __m256i       integer = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(total, magic)),
+                                             _mm256_castpd_si256(magic));
+    const __m256i sign    = _mm256_castpd_si256(negative);
+    integer               = _mm256_sub_epi64(_mm256_xor_si256(integer, sign), sign);
+    _mm256_storeu_si256((__m256i*)result, integer);
+
+    return (uint32_t)_mm256_movemask_pd(valid);
+};
+#endif
+
+static void convert(const struct NmeaFloat* coords, uint32_t count, int64_t unit,
+                    int64_t* result) {
+    uint32_t i = 0;
+#if NMEA_COORD_LANES == 4
+    for (; i + NMEA_COORD_LANES <= count; i += NMEA_COORD_LANES) {
+        uint32_t valid = convert_lanes(&coords[i], (double)unit, &result[i]);
+        for (uint32_t lane = 0; valid != 0xF && lane < NMEA_COORD_LANES; lane++) {
+            if (valid & (1U << lane)) continue;
+            if (!NmeaCoord::to_degrees(&coords[i + lane], unit, &result[i + lane])) {
+                result[i + lane] = NMEA_COORD_UNKNOWN_NANO;
+            }
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        if (!NmeaCoord::to_degrees(&coords[i], unit, &result[i])) {
+            result[i] = NMEA_COORD_UNKNOWN_NANO;
+        }
+    }
+};
+
+void NmeaCoord::to_nanodegrees(const struct NmeaFloat* coords, uint32_t count, int64_t* result) {
+    convert(coords, count, NMEA_COORD_NANODEGREE, result);
+};
+
+void NmeaCoord::to_degrees_e7(const struct NmeaFloat* coords, uint32_t count, int32_t* result) {
+    int64_t batch[NMEA_COORD_BATCH_SIZE];
+    while (count) {
+        uint32_t length = count < NMEA_COORD_BATCH_SIZE ? count : NMEA_COORD_BATCH_SIZE;
+        convert(coords, length, NMEA_COORD_DEGREE_E7, batch);
+        for (uint32_t i = 0; i < length; i++) {
+            result[i] = batch[i] == NMEA_COORD_UNKNOWN_NANO ? NMEA_COORD_UNKNOWN_E7
+                                                            : (int32_t)batch[i];
+        }
+        coords += length;
+        result += length;
+        count -= length;
+    }
+};
+
+}  // namespace wibot::protocal::gnss
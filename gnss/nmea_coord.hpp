@@ -0,0 +1,47 @@
+#ifndef __WWTALK_GNSS_NMEA_COORD_HPP__
+#define __WWTALK_GNSS_NMEA_COORD_HPP__
+#include "base.hpp"
+#include "nmea.hpp"
+namespace wibot::protocal::gnss {
+
+#define NMEA_COORD_NANODEGREE 1000000000LL
+#define NMEA_COORD_DEGREE_E7 10000000LL  // unit of UbxFrameNavPvt::lat and lon.
+
+#define NMEA_COORD_UNKNOWN_NANO INT64_MIN
+#define NMEA_COORD_UNKNOWN_E7 INT32_MIN
+
+/**
+ * Integer conversion of NMEA fixed-point values, without float. Results are rounded to the
+ * nearest unit, halves away from zero, and are exact for every NmeaFloat.
+ */
+class NmeaCoord {
+   public:
+    /**
+     * Convert a ddmm.mmmm (or dddmm.mmmm) coordinate to units of 1/unit degree, e.g.
+     * NMEA_COORD_NANODEGREE. unit is at most NMEA_COORD_NANODEGREE. Return false for unknown
+     * values (scale 0), more than 180 degrees or 60 minutes.
+     */
+    static bool to_degrees(const struct NmeaFloat* coord, int64_t unit, int64_t* result);
+    static bool to_nanodegrees(const struct NmeaFloat* coord, int64_t* result);
+    static bool to_degrees_e7(const struct NmeaFloat* coord, int32_t* result);
+
+    /**
+     * Convert a plain fixed-point value to units of 1/unit, e.g. 1000 for millimetres from
+     * metres. unit is at most 1000000000. Return false for unknown values.
+     */
+    static bool to_fixed(const struct NmeaFloat* value, int64_t unit, int64_t* result);
+
+    /**
+     * Convert count coordinates, invalid ones give NMEA_COORD_UNKNOWN_NANO or
+     * NMEA_COORD_UNKNOWN_E7. Uses AVX2 when the target supports it, the results are identical
+     * to the scalar conversion.
+     */
+    static void to_nanodegrees(const struct NmeaFloat* coords, uint32_t count, int64_t* result);
+    static void to_degrees_e7(const struct NmeaFloat* coords, uint32_t count, int32_t* result);
+    static void to_nanodegrees_scalar(const struct NmeaFloat* coords, uint32_t count,
+                                      int64_t* result);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NMEA_COORD_HPP__
@@ -0,0 +1,252 @@
+#include "nmea_corpus.hpp"
+
+#include "string.h"
+
+namespace wibot::protocal::gnss {
+
+#define NMEA_CORPUS_MAX_SATELLITES 12
+
+static const char* corpusTalkers[]  = {"GP", "GL", "GA", "BD"};
+static const int   corpusPrnBase[]  = {1, 65, 1, 1};
+static const char  corpusAlphabet[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+NmeaCorpus::NmeaCorpus(uint32_t seed)
+    : noChecksumRate(0),
+      corruptRate(0),
+      _state(seed ? seed : 0x9E3779B9U),
+      _epochCount(0),
+      _time{12, 35, 19, 0},
+      _date{18, 10, 26},
+      _latitude{480703812, 100000},
+      _longitude{113100045, 100000},
+      _version(NMEA_CORPUS_VERSION_23){};
+
+uint32_t NmeaCorpus::random() {
+    // xorshift32
+    _state ^= _state << 13;
+    _state ^= _state >> 17;
+    _state ^= _state << 5;
+    return _state;
+};
+
+void NmeaCorpus::generate(struct NmeaCorpusSentence* sentences, uint32_t count) {
+    _sentences = sentences;
+    _index     = 0;
+    _count     = count;
+    // An epoch cut at the end of sentences is not continued by the next call.
+    while (_index < _count) {
+        _epoch();
+    }
+};
+
+char* NmeaCorpus::_slot() {
+    return _index < _count ? _sentences[_index].text : _scratch;
+};
+
+bool NmeaCorpus::_push(NMEA_SENTENCE_ID id, uint32_t length) {
+    if (_index >= _count) return false;
+    if (length == 0) return true;
+
+    struct NmeaCorpusSentence* sentence = &_sentences[_index++];
+    sentence->length    = length;
+    sentence->id        = id;
+    sentence->checksum  = true;
+    sentence->corrupted = false;
+
+    // Always draw, so that the rates do not change the rest of the corpus.
+    uint32_t dropChecksum = random() & 0xFF;
+    uint32_t corrupt      = random() & 0xFF;
+    uint32_t position     = random();
+    char     replacement  = corpusAlphabet[random() % (sizeof(corpusAlphabet) - 1)];
+
+    char*    star         = strchr(sentence->text, '*');
+    uint32_t stop         = star - sentence->text;
+    if (dropChecksum < noChecksumRate) {
+        memcpy(star, "\r\n", 3);
+        sentence->length   = stop + 2;
+        sentence->checksum = false;
+    } else if (corrupt < corruptRate) {
+        // Anything but the '$', a single byte change always breaks the checksum.
+        position = 1 + position % (stop - 1);
+        if (sentence->text[position] == replacement) {
+            replacement = (replacement == 'Z') ? 'Y' : 'Z';
+        }
+        sentence->text[position] = replacement;
+        sentence->corrupted      = true;
+    }
+    return true;
+};
+
+void NmeaCorpus::_satellites(const char* talker, const char* gsaTalker, int system) {
+    int count = 4 + random() % (NMEA_CORPUS_MAX_SATELLITES - 3);
+    int prns[NMEA_CORPUS_MAX_SATELLITES];
+    int prn = corpusPrnBase[system] + random() % 8;
+    for (int i = 0; i < count; i++) {
+        prns[i] = prn;
+        prn += 1 + random() % 2;
+    }
+    int systemId = _version == NMEA_CORPUS_VERSION_23 ? 0 : system + 1;
+
+    struct NmeaSentenceDataGsa gsa;
+    memset(&gsa, 0, sizeof(gsa));
+    gsa.mode      = 'A';
+    gsa.fix_type  = 3;
+    gsa.pdop      = {12 + (int32_t)(random() % 10), 10};
+    gsa.hdop      = {8 + (int32_t)(random() % 5), 10};
+    gsa.vdop      = {9 + (int32_t)(random() % 8), 10};
+    gsa.system_id = systemId;
+    for (int i = 0; i < count; i++) {
+        gsa.sats[i] = prns[i];
+    }
+    if (!_push(NMEA_SENTENCE_GSA,
+               _encoder.encode_gsa(_slot(), NMEA_CORPUS_SENTENCE_SIZE, gsaTalker, &gsa)))
+        return;
+
+    struct NmeaSentenceDataGsv gsv;
+    int                        total = (count + 3) / 4;
+    for (int msg = 0; msg < total; msg++) {
+        memset(&gsv, 0, sizeof(gsv));
+        gsv.total_msgs = total;
+        gsv.msg_nr     = msg + 1;
+        gsv.total_sats = count;
+        gsv.signal_id  = systemId ? 1 : 0;
+        for (int i = 0; i < 4 && msg * 4 + i < count; i++) {
+            gsv.sats[i].nr        = prns[msg * 4 + i];
+            gsv.sats[i].elevation = 5 + random() % 85;
+            gsv.sats[i].azimuth   = random() % 360;
+            gsv.sats[i].snr       = (random() & 7) ? 20 + random() % 31 : 0;
+        }
+        if (!_push(NMEA_SENTENCE_GSV,
+                   _encoder.encode_gsv(_slot(), NMEA_CORPUS_SENTENCE_SIZE, talker, &gsv)))
+            return;
+    }
+};
+
+void NmeaCorpus::_epoch() {
+    _version = (NMEA_CORPUS_VERSION)(random() % NMEA_CORPUS_VERSION_COUNT);
+    bool        legacy  = _version == NMEA_CORPUS_VERSION_23;
+    const char* talker  = legacy ? "GP" : "GN";
+    char        faaMode = legacy ? NMEA_FAA_MODE_AUTONOMOUS : NMEA_FAA_MODE_DIFFERENTIAL;
+
+    // 10 Hz, with a slow random walk of the position.
+    _time.microseconds += 100000;
+    if (_time.microseconds == 1000000) {
+        _time.microseconds = 0;
+        if (++_time.seconds == 60) {
+            _time.seconds = 0;
+            if (++_time.minutes == 60) {
+                _time.minutes = 0;
+                _time.hours   = (_time.hours + 1) % 24;
+            }
+        }
+    }
+    _latitude.value += (int32_t)(random() % 101) - 50;
+    _longitude.value += (int32_t)(random() % 101) - 50;
+
+    struct NmeaSentenceDataRmc rmc;
+    memset(&rmc, 0, sizeof(rmc));
+    rmc.time      = _time;
+    rmc.valid     = true;
+    rmc.latitude  = _latitude;
+    rmc.longitude = _longitude;
+    rmc.speed     = {(int32_t)(random() % 200), 10};
+    rmc.course    = {(int32_t)(random() % 3600), 10};
+    rmc.date      = _date;
+    rmc.variation = {-11, 10};
+    if (!_push(NMEA_SENTENCE_RMC,
+               _encoder.encode_rmc(_slot(), NMEA_CORPUS_SENTENCE_SIZE, talker, &rmc)))
+        return;
+
+    struct NmeaSentenceDataGga gga;
+    memset(&gga, 0, sizeof(gga));
+    gga.time               = _time;
+    gga.latitude           = _latitude;
+    gga.longitude          = _longitude;
+    gga.fix_quality        = legacy ? 1 : 4;
+    gga.satellites_tracked = 8 + random() % 20;
+    gga.hdop               = {8 + (int32_t)(random() % 5), 10};
+    gga.altitude           = {5454 + (int32_t)(random() % 21) - 10, 10};
+    gga.altitude_units     = 'M';
+    gga.height             = {469, 10};
+    gga.height_units       = 'M';
+    if (!_push(NMEA_SENTENCE_GGA,
+               _encoder.encode_gga(_slot(), NMEA_CORPUS_SENTENCE_SIZE, talker, &gga)))
+        return;
+
+    if (_version == NMEA_CORPUS_VERSION_411) {
+        // $GNGNS,112257.00,3844.24011,N,00908.43828,W,AAAN,14,0.9,545.4,46.9,,,S*hh
+        _encoder.begin(_slot(), NMEA_CORPUS_SENTENCE_SIZE, "GNGNS");
+        _encoder.field_time(&_time);
+        _encoder.field_direction(&_latitude, 4, 'N', 'S');
+        _encoder.field_direction(&_longitude, 5, 'E', 'W');
+        _encoder.field_string("DDAN");
+        _encoder.field_int(gga.satellites_tracked, 2);
+        _encoder.field_float(&gga.hdop, 1);
+        _encoder.field_float(&gga.altitude, 1);
+        _encoder.field_float(&gga.height, 1);
+        _encoder.field_empty();
+        _encoder.field_empty();
+        _encoder.field_char((random() & 1) ? 'S' : 'C');
+        if (!_push(NMEA_SENTENCE_GNS, _encoder.end())) return;
+    }
+
+    for (int system = 0; system < (legacy ? 1 : 4); system++) {
+        _satellites(corpusTalkers[system], legacy ? "GP" : "GN", system);
+        if (_index >= _count) return;
+    }
+
+    struct NmeaSentenceDataVtg vtg;
+    memset(&vtg, 0, sizeof(vtg));
+    vtg.true_track_degrees     = rmc.course;
+    vtg.magnetic_track_degrees = {rmc.course.value + 11, 10};
+    vtg.speed_knots            = rmc.speed;
+    vtg.speed_kph              = {rmc.speed.value * 1852 / 1000, 10};
+    vtg.faa_mode               = (enum NMEA_FAA_MODE)faaMode;
+    if (!_push(NMEA_SENTENCE_VTG,
+               _encoder.encode_vtg(_slot(), NMEA_CORPUS_SENTENCE_SIZE, talker, &vtg)))
+        return;
+
+    struct NmeaSentenceDataGll gll;
+    memset(&gll, 0, sizeof(gll));
+    gll.latitude  = _latitude;
+    gll.longitude = _longitude;
+    gll.time      = _time;
+    gll.status    = NMEA_GLL_STATUS_DATA_VALID;
+    gll.mode      = faaMode;
+    if (!_push(NMEA_SENTENCE_GLL,
+               _encoder.encode_gll(_slot(), NMEA_CORPUS_SENTENCE_SIZE, talker, &gll)))
+        return;
+
+    struct NmeaSentenceDataGst gst;
+    memset(&gst, 0, sizeof(gst));
+    gst.time                      = _time;
+    gst.rms_deviation             = {(int32_t)(random() % 100), 10};
+    gst.semi_major_deviation      = {(int32_t)(random() % 100), 10};
+    gst.semi_minor_deviation      = {(int32_t)(random() % 100), 10};
+    gst.semi_major_orientation    = {(int32_t)(random() % 1800), 10};
+    gst.latitude_error_deviation  = {(int32_t)(random() % 100), 10};
+    gst.longitude_error_deviation = {(int32_t)(random() % 100), 10};
+    gst.altitude_error_deviation  = {(int32_t)(random() % 100), 10};
+    if (!_push(NMEA_SENTENCE_GST,
+               _encoder.encode_gst(_slot(), NMEA_CORPUS_SENTENCE_SIZE, talker, &gst)))
+        return;
+
+    struct NmeaSentenceDataZda zda;
+    memset(&zda, 0, sizeof(zda));
+    zda.time       = _time;
+    zda.date       = (struct NmeaDate){_date.day, _date.month, 2000 + _date.year};
+    if (!_push(NMEA_SENTENCE_ZDA,
+               _encoder.encode_zda(_slot(), NMEA_CORPUS_SENTENCE_SIZE, talker, &zda)))
+        return;
+
+    if ((_epochCount++ & 15) == 0) {
+        _encoder.begin(_slot(), NMEA_CORPUS_SENTENCE_SIZE, "GPTXT");
+        _encoder.field_string("01");
+        _encoder.field_string("01");
+        _encoder.field_string("02");
+        _encoder.field_string("ANTSTATUS=OK");
+        _push(NMEA_UNKNOWN, _encoder.end());
+    }
+};
+
+}  // namespace wibot::protocal::gnss
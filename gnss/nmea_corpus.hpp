@@ -0,0 +1,73 @@
+#ifndef __WWTALK_GNSS_NMEA_CORPUS_HPP__
+#define __WWTALK_GNSS_NMEA_CORPUS_HPP__
+#include "base.hpp"
+#include "nmea.hpp"
+#include "nmea_encoder.hpp"
+namespace wibot::protocal::gnss {
+
+#define NMEA_CORPUS_SENTENCE_SIZE (MINMEA_MAX_LENGTH + 8)
+
+enum NMEA_CORPUS_VERSION {
+    NMEA_CORPUS_VERSION_23 = 0,  // GP talker only, FAA modes.
+    NMEA_CORPUS_VERSION_410,     // GN talker, GSA system id, GSV signal id.
+    NMEA_CORPUS_VERSION_411,     // 4.10, plus GNS with navigational status.
+    NMEA_CORPUS_VERSION_COUNT,
+};
+
+struct NmeaCorpusSentence {
+    char             text[NMEA_CORPUS_SENTENCE_SIZE];  // '\0' terminated, with "\r\n".
+    uint8_t          length;
+    /**
+     * Type of the sentence, NMEA_UNKNOWN for sentences no built-in entry decodes, e.g. TXT.
+     */
+    NMEA_SENTENCE_ID id;
+    bool             checksum;   // "*HH" present.
+    bool             corrupted;  // one byte replaced after the checksum was computed.
+};
+
+/**
+ * Deterministic generator of receiver output: every epoch has RMC, GGA, VTG, GLL, GST, ZDA,
+ * GSA and GSV of up to 4 systems (GP, GL, GA, BD), and now and then a TXT banner. The NMEA
+ * version is drawn per epoch. The same seed always gives the same corpus.
+ */
+class NmeaCorpus {
+   public:
+    explicit NmeaCorpus(uint32_t seed);
+
+    /**
+     * Chance, out of 256, that a sentence has no checksum, and that a sentence with a
+     * checksum has one byte corrupted. Both default to 0.
+     */
+    uint8_t noChecksumRate;
+    uint8_t corruptRate;
+
+    /**
+     * Fill sentences with the next count sentences.
+     */
+    void generate(struct NmeaCorpusSentence* sentences, uint32_t count);
+
+    uint32_t random();
+
+   private:
+    NmeaEncoder                _encoder;
+    uint32_t                   _state;
+    uint32_t                   _epochCount;
+    struct NmeaTime            _time;
+    struct NmeaDate            _date;
+    struct NmeaFloat           _latitude;
+    struct NmeaFloat           _longitude;
+    NMEA_CORPUS_VERSION        _version;
+    struct NmeaCorpusSentence* _sentences;
+    uint32_t                   _index;
+    uint32_t                   _count;
+    char                       _scratch[NMEA_CORPUS_SENTENCE_SIZE];
+
+    void  _epoch();
+    void  _satellites(const char* talker, const char* gsaTalker, int system);
+    char* _slot();
+    bool  _push(NMEA_SENTENCE_ID id, uint32_t length);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NMEA_CORPUS_HPP__
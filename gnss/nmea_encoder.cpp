@@ -0,0 +1,437 @@
+#include "nmea_encoder.hpp"
+
+#include "string.h"
+
+namespace wibot::protocal::gnss {
+
+static const char digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char hexDigits[] = "0123456789ABCDEF";
+
+NmeaEncoder::NmeaEncoder()
+    : timeDecimals(2), _buffer(nullptr), _size(0), _length(0), _checksum(0), _overflow(true){};
+
+uint32_t NmeaEncoder::utoa(char* out, uint32_t value, uint32_t digits) {
+    char     tmp[16];
+    uint32_t pos = sizeof(tmp);
+
+    // Two digits per division.
+    while (value >= 100) {
+        uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        tmp[--pos] = digitPairs[pair + 1];
+        tmp[--pos] = digitPairs[pair];
+    }
+    if (value >= 10) {
+        tmp[--pos] = digitPairs[value * 2 + 1];
+        tmp[--pos] = digitPairs[value * 2];
+    } else {
+        tmp[--pos] = '0' + value;
+    }
+
+    uint32_t count   = sizeof(tmp) - pos;
+    uint32_t padding = digits > count ? digits - count : 0;
+    for (uint32_t i = 0; i < padding; i++) {
+        out[i] = '0';
+    }
+    memcpy(out + padding, tmp + pos, count);
+    return padding + count;
+};
+
+void NmeaEncoder::_put(char c) {
+    // Keep one byte for the terminating '\0'.
+    if (_length + 1 >= _size) {
+        _overflow = true;
+        return;
+    }
+    _buffer[_length++] = c;
+    _checksum ^= c;
+};
+
+void NmeaEncoder::_write(const char* data, uint32_t length) {
+    if (_length + length >= _size) {
+        _overflow = true;
+        return;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        _checksum ^= data[i];
+    }
+    memcpy(_buffer + _length, data, length);
+    _length += length;
+};
+
+void NmeaEncoder::_separator() {
+    _put(',');
+};
+
+void NmeaEncoder::begin(char* buffer, uint32_t size, const char* address) {
+    _buffer   = buffer;
+    _size     = size;
+    _length   = 0;
+    _overflow = false;
+    _put('$');
+    _checksum = 0;
+    _write(address, strlen(address));
+};
+
+void NmeaEncoder::field_empty() {
+    _separator();
+};
+
+void NmeaEncoder::field_char(char value) {
+    _separator();
+    if (value) _put(value);
+};
+
+void NmeaEncoder::field_string(const char* value) {
+    _separator();
+    _write(value, strlen(value));
+};
+
+void NmeaEncoder::field_int(int32_t value, uint32_t digits) {
+    char     tmp[24];
+    uint32_t length    = 0;
+    uint32_t magnitude = value < 0 ? -(uint32_t)value : value;
+    _separator();
+    if (value < 0) tmp[length++] = '-';
+    if (digits > 16) digits = 16;
+    length += utoa(tmp + length, magnitude, digits);
+    _write(tmp, length);
+};
+
+void NmeaEncoder::field_float(const struct NmeaFloat* value, uint32_t intDigits) {
+    _separator();
+    if (value->scale == 0) return;
+
+    uint32_t decimals = 0;
+    for (int32_t scale = value->scale; scale > 1; scale /= 10) {
+        decimals++;
+    }
+    if (intDigits == 0) intDigits = 1;
+    if (intDigits > 8) intDigits = 8;
+
+    char     digits[24];
+    char     tmp[28];
+    uint32_t length = 0;
+    uint32_t raw    = value->value < 0 ? -(uint32_t)value->value : value->value;
+    uint32_t count  = utoa(digits, raw, intDigits + decimals);
+
+    if (value->value < 0) tmp[length++] = '-';
+    memcpy(tmp + length, digits, count - decimals);
+    length += count - decimals;
+    if (decimals) {
+        tmp[length++] = '.';
+        memcpy(tmp + length, digits + count - decimals, decimals);
+        length += decimals;
+    }
+    _write(tmp, length);
+};
+
+void NmeaEncoder::field_direction(const struct NmeaFloat* value, uint32_t intDigits,
+                                  char positive, char negative) {
+    struct NmeaFloat magnitude = *value;
+    if (magnitude.value < 0) magnitude.value = -magnitude.value;
+    field_float(&magnitude, intDigits);
+    field_char(value->scale == 0 ? '\0' : (value->value < 0 ? negative : positive));
+};
+
+void NmeaEncoder::field_time(const struct NmeaTime* value) {
+    _separator();
+    if (value->hours < 0) return;
+
+    char     tmp[16];
+    uint32_t length = 0;
+    length += utoa(tmp + length, value->hours, 2);
+    length += utoa(tmp + length, value->minutes, 2);
+    length += utoa(tmp + length, value->seconds, 2);
+
+    // The scanner keeps at most six fractional digits.
+    uint32_t fraction = value->microseconds;
+    uint32_t decimals = 6;
+    while (decimals > timeDecimals && fraction % 10 == 0) {
+        fraction /= 10;
+        decimals--;
+    }
+    if (decimals) {
+        tmp[length++] = '.';
+        length += utoa(tmp + length, fraction, decimals);
+    }
+    _write(tmp, length);
+};
+
+void NmeaEncoder::field_date(const struct NmeaDate* value) {
+    _separator();
+    if (value->day < 0) return;
+
+    char     tmp[8];
+    uint32_t length = 0;
+    length += utoa(tmp + length, value->day, 2);
+    length += utoa(tmp + length, value->month, 2);
+    length += utoa(tmp + length, value->year % 100, 2);
+    _write(tmp, length);
+};
+
+uint32_t NmeaEncoder::end() {
+    if (_overflow || _length + 6 > _size) return 0;
+    uint8_t checksum   = _checksum;
+    _buffer[_length++] = '*';
+    _buffer[_length++] = hexDigits[checksum >> 4];
+    _buffer[_length++] = hexDigits[checksum & 0x0F];
+    _buffer[_length++] = '\r';
+    _buffer[_length++] = '\n';
+    _buffer[_length]   = '\0';
+    return _length;
+};
+
+/**
+ * Write the "$ttXXX" address of a sentence.
+ */
+static inline void address_of(char (&address)[6], const char* talker, const char* type) {
+    address[0] = talker[0];
+    address[1] = talker[1];
+    memcpy(address + 2, type, 3);
+    address[5] = '\0';
+};
+
+uint32_t NmeaEncoder::encode_rmc(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataRmc* data) {
+    // $GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*62
+    char address[6];
+    address_of(address, talker, "RMC");
+    begin(buffer, size, address);
+    field_time(&data->time);
+    field_char(data->valid ? 'A' : 'V');
+    field_direction(&data->latitude, 4, 'N', 'S');
+    field_direction(&data->longitude, 5, 'E', 'W');
+    field_float(&data->speed, 1);
+    field_float(&data->course, 1);
+    field_date(&data->date);
+    field_direction(&data->variation, 1, 'E', 'W');
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_gga(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataGga* data) {
+    // $GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47
+    char address[6];
+    address_of(address, talker, "GGA");
+    begin(buffer, size, address);
+    field_time(&data->time);
+    field_direction(&data->latitude, 4, 'N', 'S');
+    field_direction(&data->longitude, 5, 'E', 'W');
+    field_int(data->fix_quality, 1);
+    field_int(data->satellites_tracked, 2);
+    field_float(&data->hdop, 1);
+    field_float(&data->altitude, 1);
+    field_char(data->altitude_units);
+    field_float(&data->height, 1);
+    field_char(data->height_units);
+    field_float(&data->dgps_age, 1);
+    field_empty();  // DGPS station ID.
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_gsa(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataGsa* data) {
+    // $GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39
+    char address[6];
+    address_of(address, talker, "GSA");
+    begin(buffer, size, address);
+    field_char(data->mode);
+    field_int(data->fix_type, 1);
+    for (uint32_t i = 0; i < 12; i++) {
+        if (data->sats[i]) {
+            field_int(data->sats[i], 2);
+        } else {
+            field_empty();
+        }
+    }
+    field_float(&data->pdop, 1);
+    field_float(&data->hdop, 1);
+    field_float(&data->vdop, 1);
+    if (data->system_id) field_int(data->system_id, 1);
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_gll(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataGll* data) {
+    // $GPGLL,3723.2475,N,12158.3416,W,161229.487,A,A*41
+    char address[6];
+    address_of(address, talker, "GLL");
+    begin(buffer, size, address);
+    field_direction(&data->latitude, 4, 'N', 'S');
+    field_direction(&data->longitude, 5, 'E', 'W');
+    field_time(&data->time);
+    field_char(data->status);
+    if (data->mode) field_char(data->mode);
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_gst(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataGst* data) {
+    // $GPGST,024603.00,3.2,6.6,4.7,47.3,5.8,5.6,22.0*58
+    char address[6];
+    address_of(address, talker, "GST");
+    begin(buffer, size, address);
+    field_time(&data->time);
+    field_float(&data->rms_deviation, 1);
+    field_float(&data->semi_major_deviation, 1);
+    field_float(&data->semi_minor_deviation, 1);
+    field_float(&data->semi_major_orientation, 1);
+    field_float(&data->latitude_error_deviation, 1);
+    field_float(&data->longitude_error_deviation, 1);
+    field_float(&data->altitude_error_deviation, 1);
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_gsv(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataGsv* data) {
+    // $GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D
+    char address[6];
+    address_of(address, talker, "GSV");
+    begin(buffer, size, address);
+    field_int(data->total_msgs, 1);
+    field_int(data->msg_nr, 1);
+    field_int(data->total_sats, 2);
+
+    uint32_t count = 4;
+    while (count > 0 && data->sats[count - 1].nr == 0) {
+        count--;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        const struct NmeaSatInfo* sat = &data->sats[i];
+        if (sat->nr == 0) {
+            field_empty();
+            field_empty();
+            field_empty();
+            field_empty();
+            continue;
+        }
+        field_int(sat->nr, 2);
+        field_int(sat->elevation, 2);
+        field_int(sat->azimuth, 3);
+        field_int(sat->snr, 2);
+    }
+    if (data->signal_id) {
+        _separator();
+        _put(hexDigits[data->signal_id & 0x0F]);
+    }
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_vtg(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataVtg* data) {
+    // $GPVTG,096.5,T,083.5,M,0.0,N,0.0,K,D*22
+    char address[6];
+    address_of(address, talker, "VTG");
+    begin(buffer, size, address);
+    field_float(&data->true_track_degrees, 1);
+    field_char('T');
+    field_float(&data->magnetic_track_degrees, 1);
+    field_char('M');
+    field_float(&data->speed_knots, 1);
+    field_char('N');
+    field_float(&data->speed_kph, 1);
+    field_char('K');
+    if (data->faa_mode) field_char(data->faa_mode);
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_zda(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataZda* data) {
+    // $GPZDA,201530.00,04,07,2002,00,00*60
+    char address[6];
+    address_of(address, talker, "ZDA");
+    begin(buffer, size, address);
+    field_time(&data->time);
+    field_int(data->date.day, 2);
+    field_int(data->date.month, 2);
+    field_int(data->date.year, 4);
+    field_int(data->hour_offset, 2);
+    field_int(data->minute_offset, 2);
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_gns(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataGns* data) {
+    // $GNGNS,181604.00,,,,,NN,00,99.99,,,,,V*23
+    char address[6];
+    address_of(address, talker, "GNS");
+    begin(buffer, size, address);
+    field_time(&data->time);
+    field_direction(&data->latitude, 4, 'N', 'S');
+    field_direction(&data->longitude, 5, 'E', 'W');
+    field_string(data->mode);
+    field_int(data->satellites_used, 2);
+    field_float(&data->hdop, 1);
+    field_float(&data->altitude, 1);
+    field_float(&data->height, 1);
+    field_float(&data->dgps_age, 1);
+    if (data->station_id) {
+        field_int(data->station_id, 4);
+    } else {
+        field_empty();
+    }
+    if (data->nav_status) field_char(data->nav_status);
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_gbs(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataGbs* data) {
+    // $GPGBS,235458.00,1.4,1.3,3.1,03,,-21.4,3.8,1,0*5A
+    char address[6];
+    address_of(address, talker, "GBS");
+    begin(buffer, size, address);
+    field_time(&data->time);
+    field_float(&data->latitude_error, 1);
+    field_float(&data->longitude_error, 1);
+    field_float(&data->altitude_error, 1);
+    if (data->failed_sat) {
+        field_int(data->failed_sat, 2);
+    } else {
+        field_empty();
+    }
+    field_float(&data->probability, 1);
+    field_float(&data->bias, 1);
+    field_float(&data->bias_deviation, 1);
+    if (data->system_id || data->signal_id) {
+        field_int(data->system_id, 1);
+        _separator();
+        _put(hexDigits[data->signal_id & 0x0F]);
+    }
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_hdt(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataHdt* data) {
+    // $GPHDT,274.07,T*03
+    char address[6];
+    address_of(address, talker, "HDT");
+    begin(buffer, size, address);
+    field_float(&data->heading, 1);
+    field_char('T');
+    return end();
+};
+
+uint32_t NmeaEncoder::encode_ths(char* buffer, uint32_t size, const char* talker,
+                                 const struct NmeaSentenceDataThs* data) {
+    // $GPTHS,77.52,E*34
+    char address[6];
+    address_of(address, talker, "THS");
+    begin(buffer, size, address);
+    field_float(&data->heading, 1);
+    field_char(data->mode);
+    return end();
+};
+
+}  // namespace wibot::protocal::gnss
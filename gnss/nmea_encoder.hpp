@@ -0,0 +1,93 @@
+#ifndef __WWTALK_GNSS_NMEA_ENCODER_HPP__
+#define __WWTALK_GNSS_NMEA_ENCODER_HPP__
+#include "base.hpp"
+#include "nmea.hpp"
+namespace wibot::protocal::gnss {
+
+/**
+ * Write sentences into a caller buffer, terminated with "*HH\r\n" and a '\0'. Every encode_*
+ * method returns the sentence length without the '\0', or 0 if the buffer is too small.
+ * Decoding the output with the matching NmeaSentence* gives back the same data.
+ */
+class NmeaEncoder {
+   public:
+    NmeaEncoder();
+
+    /**
+     * Minimum number of fractional digits of time fields, more are written if the
+     * microseconds need them. Default 2.
+     */
+    uint8_t timeDecimals;
+
+    uint32_t encode_rmc(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataRmc* data);
+    uint32_t encode_gga(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataGga* data);
+    uint32_t encode_gsa(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataGsa* data);
+    uint32_t encode_gll(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataGll* data);
+    uint32_t encode_gst(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataGst* data);
+    uint32_t encode_gsv(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataGsv* data);
+    uint32_t encode_vtg(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataVtg* data);
+    uint32_t encode_zda(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataZda* data);
+    uint32_t encode_gns(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataGns* data);
+    uint32_t encode_gbs(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataGbs* data);
+    uint32_t encode_hdt(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataHdt* data);
+    uint32_t encode_ths(char* buffer, uint32_t size, const char* talker,
+                        const struct NmeaSentenceDataThs* data);
+
+    /**
+     * Build a sentence field by field, e.g. for proprietary sentences. address is everything
+     * between '$' and the first ',', e.g. "GPRMC" or "PUBX".
+     */
+    void     begin(char* buffer, uint32_t size, const char* address);
+    void     field_empty();
+    void     field_char(char value);
+    void     field_string(const char* value);
+    /**
+     * Integer with at least digits digits, zero padded.
+     */
+    void     field_int(int32_t value, uint32_t digits);
+    /**
+     * Fixed-point value, empty if scale is 0. The integer part is zero padded to intDigits.
+     */
+    void     field_float(const struct NmeaFloat* value, uint32_t intDigits);
+    /**
+     * Magnitude of a signed fixed-point value followed by its direction, both empty if scale
+     * is 0.
+     */
+    void     field_direction(const struct NmeaFloat* value, uint32_t intDigits, char positive,
+                             char negative);
+    void     field_time(const struct NmeaTime* value);
+    void     field_date(const struct NmeaDate* value);
+    uint32_t end();
+
+    /**
+     * Write value as decimal ASCII, zero padded to at least digits. Returns the length.
+     * out must hold 10 characters or digits, whichever is more.
+     */
+    static uint32_t utoa(char* out, uint32_t value, uint32_t digits);
+
+   private:
+    char*    _buffer;
+    uint32_t _size;
+    uint32_t _length;
+    uint8_t  _checksum;
+    bool     _overflow;
+
+    void _put(char c);
+    void _write(const char* data, uint32_t length);
+    void _separator();
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NMEA_ENCODER_HPP__
@@ -0,0 +1,127 @@
+#include "nmea_epoch.hpp"
+
+#include "gnss_time.hpp"
+#include "string.h"
+
+namespace wibot::protocal::gnss {
+
+NmeaEpochAggregator::NmeaEpochAggregator(NmeaParser& parser) : _parser(parser) {
+    init(0, nullptr, nullptr);
+};
+
+void NmeaEpochAggregator::init(uint32_t completeSet, NmeaFixCallback callback, void* context) {
+    _completeSet = completeSet;
+    _callback    = callback;
+    _context     = context;
+    _emitted     = false;
+    lateCount    = 0;
+    memset(&_fix, 0, sizeof(_fix));
+    _fix.time = (struct NmeaTime){-1, -1, -1, -1};
+};
+
+bool NmeaEpochAggregator::feed(const char* sentence, bool strict) {
+    NmeaSentenceBase* entry;
+    if (!_parser.sentence_entry_get(sentence, strict, &entry)) {
+        return false;
+    }
+    if (!entry->parse(&_data, sentence)) {
+        return false;
+    }
+    _merge(entry->id);
+    if (_emitted) {
+        lateCount++;
+        return true;
+    }
+
+    if (_completeSet && (_fix.sentences & _completeSet) == _completeSet) {
+        flush();
+    }
+    return true;
+};
+
+void NmeaEpochAggregator::flush() {
+    if (_emitted || _fix.sentences == 0) return;
+    _emitted = true;
+    if (_callback != nullptr) _callback(_context, &_fix);
+};
+
+void NmeaEpochAggregator::_epoch(const struct NmeaTime* time) {
+    if (time->hours == -1) return;
+    if (_fix.time.hours != -1 && !memcmp(&_fix.time, time, sizeof(*time))) return;
+
+    // Sentences without time, received before the first timed one, belong to this epoch.
+    if (_fix.time.hours != -1) {
+        flush();
+        memset(&_fix, 0, sizeof(_fix));
+        _emitted = false;
+    }
+    _fix.time = *time;
+};
+
+void NmeaEpochAggregator::_merge(NMEA_SENTENCE_ID id) {
+    switch (id) {
+        case NMEA_SENTENCE_RMC: {
+            _epoch(&_data.rmc.time);
+            _fix.valid     = _data.rmc.valid;
+            _fix.latitude  = _data.rmc.latitude;
+            _fix.longitude = _data.rmc.longitude;
+            _fix.speed     = _data.rmc.speed;
+            _fix.course    = _data.rmc.course;
+            _fix.variation = _data.rmc.variation;
+            if (!(_fix.sentences & NMEA_SENTENCE_BIT(NMEA_SENTENCE_ZDA))) {
+                // RMC years have two digits.
+                _fix.date = _data.rmc.date;
+                if (_fix.date.year >= 0) {
+                    _fix.date.year = GnssTime::year_from_nmea(_fix.date.year);
+                }
+            }
+        } break;
+
+        case NMEA_SENTENCE_GGA: {
+            _epoch(&_data.gga.time);
+            _fix.latitude           = _data.gga.latitude;
+            _fix.longitude          = _data.gga.longitude;
+            _fix.fix_quality        = _data.gga.fix_quality;
+            _fix.satellites_tracked = _data.gga.satellites_tracked;
+            _fix.hdop               = _data.gga.hdop;
+            _fix.altitude           = _data.gga.altitude;
+            _fix.height             = _data.gga.height;
+            _fix.dgps_age           = _data.gga.dgps_age;
+        } break;
+
+        case NMEA_SENTENCE_GSA: {
+            _fix.fix_type = _data.gsa.fix_type;
+            _fix.pdop     = _data.gsa.pdop;
+            _fix.hdop     = _data.gsa.hdop;
+            _fix.vdop     = _data.gsa.vdop;
+        } break;
+
+        case NMEA_SENTENCE_GLL: {
+            _epoch(&_data.gll.time);
+            _fix.latitude  = _data.gll.latitude;
+            _fix.longitude = _data.gll.longitude;
+            if (_data.gll.mode) _fix.faa_mode = _data.gll.mode;
+        } break;
+
+        case NMEA_SENTENCE_GST: {
+            _epoch(&_data.gst.time);
+        } break;
+
+        case NMEA_SENTENCE_VTG: {
+            _fix.course = _data.vtg.true_track_degrees;
+            _fix.speed  = _data.vtg.speed_knots;
+            if (_data.vtg.faa_mode) _fix.faa_mode = _data.vtg.faa_mode;
+        } break;
+
+        case NMEA_SENTENCE_ZDA: {
+            _epoch(&_data.zda.time);
+            _fix.date = _data.zda.date;
+        } break;
+
+        default:
+            break;
+    }
+    if (id > 0) _fix.sentences |= NMEA_SENTENCE_BIT(id);
+};
+
+}  // namespace wibot::protocal::gnss
@@ -0,0 +1,82 @@
+#ifndef __WWTALK_GNSS_NMEA_EPOCH_HPP__
+#define __WWTALK_GNSS_NMEA_EPOCH_HPP__
+#include "base.hpp"
+#include "nmea.hpp"
+namespace wibot::protocal::gnss {
+
+/**
+ * Fields of all sentences of one epoch.
+ */
+struct NmeaFix {
+    struct NmeaTime  time;
+    struct NmeaDate  date;  // ZDA date if present, otherwise RMC date, with a four digit year.
+    bool             valid;
+    struct NmeaFloat latitude;
+    struct NmeaFloat longitude;
+    struct NmeaFloat altitude;
+    struct NmeaFloat height;
+    struct NmeaFloat speed;  // knots
+    struct NmeaFloat course;
+    struct NmeaFloat variation;
+    int              fix_quality;
+    int              fix_type;
+    int              satellites_tracked;
+    struct NmeaFloat pdop;
+    struct NmeaFloat hdop;
+    struct NmeaFloat vdop;
+    struct NmeaFloat dgps_age;
+    char             faa_mode;
+    /**
+     * NMEA_SENTENCE_BIT of every sentence merged into this fix.
+     */
+    uint32_t         sentences;
+};
+
+typedef void (*NmeaFixCallback)(void* context, const struct NmeaFix* fix);
+
+/**
+ * Merge the sentences of an epoch into one fix. Sentences carrying a time open a new epoch
+ * when the time changes, sentences without one (GSA, VTG) join the current epoch. The fix is
+ * emitted once per epoch, as soon as all sentences of the complete set have been merged, or
+ * when the next epoch starts. Sentences of the epoch that arrive after it is emitted are counted
+ * in lateCount.
+ */
+class NmeaEpochAggregator {
+   public:
+    explicit NmeaEpochAggregator(NmeaParser& parser);
+
+    /**
+     * @param completeSet NMEA_SENTENCE_BIT of the sentences that complete an epoch. 0 means
+     * the epoch is only completed by a time change.
+     */
+    void init(uint32_t completeSet, NmeaFixCallback callback, void* context);
+
+    /**
+     * Parse and merge one sentence.
+     * @return Return true if the sentence is recognized and merged.
+     */
+    bool feed(const char* sentence, bool strict);
+
+    /**
+     * Emit the current epoch if it has not been emitted yet.
+     */
+    void flush();
+
+    uint32_t lateCount;  // sentences of an epoch already emitted, left out of its fix.
+
+   private:
+    NmeaParser&     _parser;
+    uint32_t        _completeSet;
+    NmeaFixCallback _callback;
+    void*           _context;
+    bool            _emitted;
+    struct NmeaFix  _fix;
+    union NmeaSentenceDataAny _data;
+
+    void _epoch(const struct NmeaTime* time);
+    void _merge(NMEA_SENTENCE_ID id);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NMEA_EPOCH_HPP__
@@ -0,0 +1,285 @@
+#include "nmea_kernel.hpp"
+
+#include "string.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NMEA_KERNEL_LANES 32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define NMEA_KERNEL_LANES 16
+#else
+#define NMEA_KERNEL_LANES 0
+#endif
+
+namespace wibot::protocal::gnss {
+
+#define NMEA_KERNEL_NOT_FOUND 0xFFFFFFFFU
+
+static inline uint64_t length_mask(uint32_t length) {
+    return length >= NMEA_KERNEL_BLOCK_SIZE ? ~0ULL : ((1ULL << length) - 1);
+};
+
+static inline bool is_terminator(char c) {
+    return c == '*' || c < 0x20 || c > 0x7E;
+};
+
+#if NMEA_KERNEL_LANES == 32
+typedef __m256i Lane;
+
+static inline Lane lane_load(const char* p) {
+    return _mm256_loadu_si256((const __m256i*)p);
+};
+static inline uint64_t lane_eq(Lane v, char c) {
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)));
+};
+static inline uint64_t lane_printable(Lane v) {
+    Lane p = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(0x1F)),
+                              _mm256_cmpgt_epi8(_mm256_set1_epi8(0x7F), v));
+    return (uint32_t)_mm256_movemask_epi8(p);
+};
+/**
+ * XOR the bytes [from, to) of v into acc.
+ */
+static inline Lane lane_xor_range(Lane acc, Lane v, uint32_t from, uint32_t to) {
+    const Lane iota = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+                                       17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+    Lane       sel  = _mm256_andnot_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(from), iota),
+                                          _mm256_cmpgt_epi8(_mm256_set1_epi8(to), iota));
+    return _mm256_xor_si256(acc, _mm256_and_si256(v, sel));
+};
+static inline Lane lane_zero() {
+    return _mm256_setzero_si256();
+};
+static inline uint8_t lane_reduce(Lane acc) {
+    __m128i x = _mm_xor_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    x         = _mm_xor_si128(x, _mm_srli_si128(x, 8));
+    x         = _mm_xor_si128(x, _mm_srli_si128(x, 4));
+    x         = _mm_xor_si128(x, _mm_srli_si128(x, 2));
+    x         = _mm_xor_si128(x, _mm_srli_si128(x, 1));
+    return (uint8_t)_mm_cvtsi128_si32(x);
+};
+#elif NMEA_KERNEL_LANES == 16
+typedef __m128i Lane;
+
+static inline Lane lane_load(const char* p) {
+    return _mm_loadu_si128((const __m128i*)p);
+};
+static inline uint64_t lane_eq(Lane v, char c) {
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+};
+static inline uint64_t lane_printable(Lane v) {
+    Lane p = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x1F)),
+                           _mm_cmplt_epi8(v, _mm_set1_epi8(0x7F)));
+    return (uint32_t)_mm_movemask_epi8(p);
+};
+/**
+ * XOR the bytes [from, to) of v into acc.
+ */
+static inline Lane lane_xor_range(Lane acc, Lane v, uint32_t from, uint32_t to) {
+    const Lane iota = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    Lane       sel  = _mm_andnot_si128(_mm_cmpgt_epi8(_mm_set1_epi8(from), iota),
+                                       _mm_cmpgt_epi8(_mm_set1_epi8(to), iota));
+    return _mm_xor_si128(acc, _mm_and_si128(v, sel));
+};
+static inline Lane lane_zero() {
+    return _mm_setzero_si128();
+};
+static inline uint8_t lane_reduce(Lane acc) {
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 4));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 2));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 1));
+    return (uint8_t)_mm_cvtsi128_si32(acc);
+};
+#endif
+
+#if NMEA_KERNEL_LANES
+/**
+ * Classify a block and, while stop is not found, XOR the bytes from `from` into acc.
+ * data must be readable for a whole block.
+ */
+static void block_scan(const char* data, uint32_t length, NmeaKernelMask* mask, uint32_t from,
+                       uint32_t* stop, Lane* acc) {
+    const uint64_t laneBits = (1ULL << NMEA_KERNEL_LANES) - 1;
+    const uint64_t valid    = length_mask(length);
+    NmeaKernelMask m        = {0, 0, 0, 0, 0};
+
+    for (uint32_t i = 0; i < NMEA_KERNEL_BLOCK_SIZE; i += NMEA_KERNEL_LANES) {
+        Lane     v       = lane_load(data + i);
+        uint64_t eol     = lane_eq(v, '\r') | lane_eq(v, '\n');
+        uint64_t star    = lane_eq(v, '*');
+        uint64_t invalid = ~lane_printable(v) & ~eol & laneBits;
+
+        m.dollar |= lane_eq(v, '$') << i;
+        m.comma |= lane_eq(v, ',') << i;
+        m.star |= star << i;
+        m.eol |= eol << i;
+        m.invalid |= invalid << i;
+
+        if (acc != nullptr && *stop == NMEA_KERNEL_NOT_FOUND && i < length) {
+            uint64_t term = (star | eol | invalid) & (valid >> i);
+            uint32_t to   = length - i < NMEA_KERNEL_LANES ? length - i : NMEA_KERNEL_LANES;
+            if (term) {
+                to    = __builtin_ctzll(term);
+                *stop = i + to;
+            }
+            *acc = lane_xor_range(*acc, v, i == 0 ? from : 0, to);
+        }
+    }
+
+    mask->dollar  = m.dollar & valid;
+    mask->comma   = m.comma & valid;
+    mask->star    = m.star & valid;
+    mask->eol     = m.eol & valid;
+    mask->invalid = m.invalid & valid;
+};
+#endif
+
+void NmeaKernel::classify_scalar(const char* data, uint32_t length, NmeaKernelMask* mask) {
+    NmeaKernelMask m = {0, 0, 0, 0, 0};
+    if (length > NMEA_KERNEL_BLOCK_SIZE) length = NMEA_KERNEL_BLOCK_SIZE;
+    for (uint32_t i = 0; i < length; i++) {
+        char     c   = data[i];
+        uint64_t bit = 1ULL << i;
+        if (c == '$') m.dollar |= bit;
+        if (c == ',') m.comma |= bit;
+        if (c == '*') m.star |= bit;
+        if (c == '\r' || c == '\n') {
+            m.eol |= bit;
+        } else if (c < 0x20 || c > 0x7E) {
+            m.invalid |= bit;
+        }
+    }
+    *mask = m;
+};
+
+void NmeaKernel::classify(const char* data, uint32_t length, NmeaKernelMask* mask) {
+#if NMEA_KERNEL_LANES
+    if (length > NMEA_KERNEL_BLOCK_SIZE) length = NMEA_KERNEL_BLOCK_SIZE;
+    if (length < NMEA_KERNEL_BLOCK_SIZE) {
+        char pad[NMEA_KERNEL_BLOCK_SIZE] = {0};
+        memcpy(pad, data, length);
+        block_scan(pad, length, mask, 0, nullptr, nullptr);
+    } else {
+        block_scan(data, length, mask, 0, nullptr, nullptr);
+    }
+#else
+    classify_scalar(data, length, mask);
+#endif
+};
+
+void NmeaKernel::scan_scalar(const char* sentence, uint32_t length, NmeaKernelResult* result) {
+    const uint32_t max = NMEA_KERNEL_BLOCK_SIZE * NMEA_KERNEL_SENTENCE_BLOCKS;
+    if (length > max) length = max;
+
+    uint32_t stop     = NMEA_KERNEL_NOT_FOUND;
+    uint8_t  checksum = 0;
+    uint32_t i        = (length > 0 && sentence[0] == '$') ? 1 : 0;
+    for (; i < length; i++) {
+        if (is_terminator(sentence[i])) {
+            stop = i;
+            break;
+        }
+        checksum ^= sentence[i];
+    }
+
+    result->blockCount = 0;
+    for (uint32_t offset = 0; offset < length; offset += NMEA_KERNEL_BLOCK_SIZE) {
+        classify_scalar(sentence + offset, length - offset, &result->masks[result->blockCount++]);
+        if (stop != NMEA_KERNEL_NOT_FOUND && stop < offset + NMEA_KERNEL_BLOCK_SIZE) break;
+    }
+    result->stop     = stop == NMEA_KERNEL_NOT_FOUND ? length : stop;
+    result->checksum = checksum;
+};
+
+void NmeaKernel::scan(const char* sentence, uint32_t length, NmeaKernelResult* result) {
+#if NMEA_KERNEL_LANES
+    const uint32_t max = NMEA_KERNEL_BLOCK_SIZE * NMEA_KERNEL_SENTENCE_BLOCKS;
+    if (length > max) length = max;
+
+    uint32_t from = (length > 0 && sentence[0] == '$') ? 1 : 0;
+    uint32_t stop = NMEA_KERNEL_NOT_FOUND;
+    Lane     acc  = lane_zero();
+
+    result->blockCount = 0;
+    result->stop       = length;
+    for (uint32_t offset = 0; offset < length; offset += NMEA_KERNEL_BLOCK_SIZE) {
+        const char* block = sentence + offset;
+        uint32_t    size  = length - offset;
+        char        pad[NMEA_KERNEL_BLOCK_SIZE];
+        if (size < NMEA_KERNEL_BLOCK_SIZE) {
+            memset(pad, 0, sizeof(pad));
+            memcpy(pad, block, size);
+            block = pad;
+        }
+        block_scan(block, size, &result->masks[result->blockCount++], offset == 0 ? from : 0,
+                   &stop, &acc);
+        if (stop != NMEA_KERNEL_NOT_FOUND) {
+            result->stop = offset + stop;
+            break;
+        }
+    }
+    result->checksum = lane_reduce(acc);
+#else
+    scan_scalar(sentence, length, result);
+#endif
+};
+
+void NmeaKernel::tokenize(const char* sentence, uint32_t length, NmeaFields* fields) {
+    fields->start[0] = 0;
+    fields->count    = 1;
+    fields->end      = length;
+
+    for (uint32_t offset = 0; offset < length; offset += NMEA_KERNEL_BLOCK_SIZE) {
+        NmeaKernelMask mask;
+        classify(sentence + offset, length - offset, &mask);
+
+        uint64_t term   = mask.star | mask.eol | mask.invalid;
+        uint64_t commas = mask.comma;
+        if (term) commas &= (term & -term) - 1;
+
+        while (commas) {
+            uint32_t position = offset + __builtin_ctzll(commas);
+            if (fields->count == NMEA_FIELD_MAX_COUNT) {
+                fields->end = position;
+                return;
+            }
+            fields->start[fields->count++] = position + 1;
+            commas &= commas - 1;
+        }
+        if (term) {
+            fields->end = offset + __builtin_ctzll(term);
+            return;
+        }
+    }
+};
+
+uint32_t NmeaKernel::split(const char* data, uint32_t length,
+                           void (*found)(void* context, const char* sentence, uint32_t length),
+                           void* context) {
+    int32_t start = -1;
+
+    for (uint32_t offset = 0; offset < length; offset += NMEA_KERNEL_BLOCK_SIZE) {
+        NmeaKernelMask mask;
+        classify(data + offset, length - offset, &mask);
+
+        uint64_t marks = mask.dollar | mask.eol;
+        while (marks) {
+            uint32_t position = offset + __builtin_ctzll(marks);
+            if (data[position] == '$') {
+                // A new start drops any unterminated sentence before it.
+                start = position;
+            } else {
+                if (start >= 0) {
+                    found(context, data + start, position - start);
+                    start = -1;
+                }
+            }
+            marks &= marks - 1;
+        }
+    }
+    return start >= 0 ? start : length;
+};
+
+}  // namespace wibot::protocal::gnss
@@ -0,0 +1,88 @@
+#ifndef __WWTALK_GNSS_NMEA_KERNEL_HPP__
+#define __WWTALK_GNSS_NMEA_KERNEL_HPP__
+#include "base.hpp"
+namespace wibot::protocal::gnss {
+
+#define NMEA_KERNEL_BLOCK_SIZE 64
+#define NMEA_KERNEL_SENTENCE_BLOCKS 2  // enough for MINMEA_MAX_LENGTH.
+
+#define NMEA_FIELD_MAX_COUNT 32
+
+/**
+ * Byte classes of one 64 bytes block, bit n is set if byte n is of that class.
+ */
+struct NmeaKernelMask {
+    uint64_t dollar;   // '$'
+    uint64_t comma;    // ','
+    uint64_t star;     // '*'
+    uint64_t eol;      // '\r' or '\n'
+    uint64_t invalid;  // any other non printable byte.
+};
+
+struct NmeaKernelResult {
+    /**
+     * Index of the first '*', '\r', '\n' or non printable byte, or the length if there is none.
+     */
+    uint32_t stop;
+    /**
+     * XOR of all bytes between the leading '$' and stop.
+     */
+    uint8_t  checksum;
+    uint8_t  blockCount;
+    /**
+     * Masks of the blocks up to and including the one holding stop.
+     */
+    NmeaKernelMask masks[NMEA_KERNEL_SENTENCE_BLOCKS];
+};
+
+/**
+ * Field offsets of a sentence, field 0 is the "$xxxxx" address field.
+ */
+struct NmeaFields {
+    uint16_t start[NMEA_FIELD_MAX_COUNT];
+    uint16_t end;  // offset of the terminator of the last field.
+    uint8_t  count;
+
+    inline uint32_t length(uint32_t index) const {
+        return (index + 1 < count ? start[index + 1] - 1 : end) - start[index];
+    };
+};
+
+/**
+ * One pass classifier for NMEA text. Uses AVX2 or SSE2 when the target supports it, otherwise
+ * the scalar implementation. Both produce identical results.
+ */
+class NmeaKernel {
+   public:
+    /**
+     * Classify one block of at most NMEA_KERNEL_BLOCK_SIZE bytes. Bits past length are cleared.
+     */
+    static void classify(const char* data, uint32_t length, NmeaKernelMask* mask);
+    static void classify_scalar(const char* data, uint32_t length, NmeaKernelMask* mask);
+
+    /**
+     * Checksum and classify a sentence in a single pass. Only the first
+     * NMEA_KERNEL_SENTENCE_BLOCKS blocks are considered.
+     */
+    static void scan(const char* sentence, uint32_t length, NmeaKernelResult* result);
+    static void scan_scalar(const char* sentence, uint32_t length, NmeaKernelResult* result);
+
+    /**
+     * Split a sentence into fields at ',' up to the first terminator. Fields past
+     * NMEA_FIELD_MAX_COUNT are dropped.
+     */
+    static void tokenize(const char* sentence, uint32_t length, NmeaFields* fields);
+
+    /**
+     * Find the sentences of a block of text, calling found for every "$...\n" span. The span
+     * excludes the line end. Returns the number of bytes consumed, any partial sentence at the
+     * end is left for the next call.
+     */
+    static uint32_t split(const char* data, uint32_t length,
+                          void (*found)(void* context, const char* sentence, uint32_t length),
+                          void* context);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NMEA_KERNEL_HPP__
@@ -0,0 +1,232 @@
+#include "nmea_satellite.hpp"
+
+#include "string.h"
+
+namespace wibot::protocal::gnss {
+
+NmeaSatelliteAssembler::NmeaSatelliteAssembler() {
+    reset();
+};
+
+void NmeaSatelliteAssembler::reset() {
+    memset(_groups, 0, sizeof(_groups));
+    memset(_used, 0, sizeof(_used));
+    _groupCount = 0;
+    _current    = nullptr;
+    _gsaEpoch   = false;
+    fixType     = 0;
+    pdop        = (struct NmeaFloat){0, 0};
+    hdop        = (struct NmeaFloat){0, 0};
+    vdop        = (struct NmeaFloat){0, 0};
+};
+
+uint8_t NmeaSatelliteAssembler::system_of_talker(const char* talker) {
+    if (talker[0] == 'G') {
+        switch (talker[1]) {
+            case 'P':
+                return NMEA_SYSTEM_GPS;
+            case 'L':
+                return NMEA_SYSTEM_GLONASS;
+            case 'A':
+                return NMEA_SYSTEM_GALILEO;
+            case 'B':
+                return NMEA_SYSTEM_BEIDOU;
+            case 'Q':
+                return NMEA_SYSTEM_QZSS;
+            case 'I':
+                return NMEA_SYSTEM_NAVIC;
+            default:
+                return NMEA_SYSTEM_UNKNOWN;
+        }
+    }
+    if (talker[0] == 'B' && talker[1] == 'D') return NMEA_SYSTEM_BEIDOU;
+    return NMEA_SYSTEM_UNKNOWN;
+};
+
+/**
+ * System of a satellite number in the NMEA 2.3 numbering used by "GN" sentences.
+ */
+uint8_t NmeaSatelliteAssembler::system_of_prn(int prn) {
+    if (prn >= 1 && prn <= 64) return NMEA_SYSTEM_GPS;  // GPS and SBAS.
+    if (prn >= 65 && prn <= 96) return NMEA_SYSTEM_GLONASS;
+    if (prn >= 193 && prn <= 199) return NMEA_SYSTEM_QZSS;
+    if (prn >= 201 && prn <= 263) return NMEA_SYSTEM_BEIDOU;
+    if (prn >= 301 && prn <= 336) return NMEA_SYSTEM_GALILEO;
+    if (prn >= 401 && prn <= 463) return NMEA_SYSTEM_BEIDOU;
+    return NMEA_SYSTEM_UNKNOWN;
+};
+
+uint8_t NmeaSatelliteAssembler::group_count() const {
+    return _groupCount;
+};
+
+const struct NmeaSatelliteGroup* NmeaSatelliteAssembler::group_at(uint8_t index) const {
+    return index < _groupCount ? &_groups[index] : nullptr;
+};
+
+const struct NmeaSatelliteGroup* NmeaSatelliteAssembler::group_get(uint8_t system,
+                                                                   uint8_t signalId) const {
+    for (uint8_t i = 0; i < _groupCount; i++) {
+        if (_groups[i].system == system && _groups[i].signalId == signalId) return &_groups[i];
+    }
+    return nullptr;
+};
+
+bool NmeaSatelliteAssembler::group_copy(uint8_t system, uint8_t signalId,
+                                        struct NmeaSatelliteGroup* copy) const {
+    const struct NmeaSatelliteGroup* group = group_get(system, signalId);
+    if (group == nullptr) return false;
+
+    uint32_t version = __atomic_load_n(&group->version, __ATOMIC_ACQUIRE);
+    if (version & 1) return false;
+    memcpy(copy, group, sizeof(*copy));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&group->version, __ATOMIC_RELAXED) == version;
+};
+
+struct NmeaSatelliteGroup* NmeaSatelliteAssembler::_group(uint8_t system, uint8_t signalId,
+                                                          bool create) {
+    for (uint8_t i = 0; i < _groupCount; i++) {
+        if (_groups[i].system == system && _groups[i].signalId == signalId) return &_groups[i];
+    }
+    if (!create || _groupCount == NMEA_SATELLITE_GROUP_SIZE) return nullptr;
+
+    struct NmeaSatelliteGroup* group = &_groups[_groupCount++];
+    group->system                    = system;
+    group->signalId                  = signalId;
+    return group;
+};
+
+uint8_t NmeaSatelliteAssembler::_system(const char* talker,
+                                        const struct NmeaSentenceDataGsv* data) {
+    if (talker[0] != 'G' || talker[1] != 'N') return system_of_talker(talker);
+    for (uint32_t i = 0; i < 4; i++) {
+        if (data->sats[i].nr != 0) return system_of_prn(data->sats[i].nr);
+    }
+    // No satellite to tell, as the last fragment of the sequence may be.
+    return _current != nullptr && _current->nextMsg != 0 ? _current->system
+                                                         : (uint8_t)NMEA_SYSTEM_UNKNOWN;
+};
+
+bool NmeaSatelliteAssembler::feed_gsv(const char* talker, const struct NmeaSentenceDataGsv* data,
+                                      const struct NmeaSatelliteGroup** completed) {
+    _gsaEpoch = false;
+    if (data->total_msgs < 1 || data->msg_nr < 1 || data->msg_nr > data->total_msgs) {
+        return false;
+    }
+
+    struct NmeaSatelliteGroup* group = _group(_system(talker, data), data->signal_id,
+                                              data->msg_nr == 1);
+    if (group == nullptr) return false;
+    _current = group;
+    if (data->msg_nr == 1) {
+        if ((group->version & 1) == 0) {
+            // Odd while updated, the stores of the sequence come after it.
+            __atomic_store_n(&group->version, group->version + 1, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+        }
+        group->sequence++;
+        group->totalMsgs = data->total_msgs;
+        group->nextMsg   = 1;
+    }
+    if (group->nextMsg != data->msg_nr || group->totalMsgs != data->total_msgs) {
+        if (group->nextMsg != 0) {
+            // Lost a fragment, wait for the next sequence.
+            group->nextMsg = 0;
+            __atomic_store_n(&group->version, group->version + 1, __ATOMIC_RELEASE);
+        }
+        return false;
+    }
+    group->totalSats = data->total_sats;
+
+    for (uint32_t i = 0; i < 4; i++) {
+        if (data->sats[i].nr != 0) _update(group, &data->sats[i]);
+    }
+
+    if (data->msg_nr < data->total_msgs) {
+        group->nextMsg++;
+        return false;
+    }
+
+    group->nextMsg = 0;
+    _complete(group);
+    if (completed != nullptr) *completed = group;
+    return true;
+};
+
+void NmeaSatelliteAssembler::_update(struct NmeaSatelliteGroup* group,
+                                     const struct NmeaSatInfo* info) {
+    struct NmeaSatellite* sat = nullptr;
+    for (uint8_t i = 0; i < group->count; i++) {
+        if (group->sats[i].info.nr == info->nr) {
+            sat = &group->sats[i];
+            break;
+        }
+    }
+    if (sat == nullptr && group->count < NMEA_SATELLITE_GROUP_SATELLITE_SIZE) {
+        sat       = &group->sats[group->count++];
+        sat->used = false;
+    }
+    for (uint8_t i = 0; sat == nullptr && i < group->count; i++) {
+        // The table is full, a satellite this sequence has not reported makes room.
+        if (group->sats[i].sequence != group->sequence) {
+            sat       = &group->sats[i];
+            sat->used = false;
+        }
+    }
+    if (sat == nullptr) return;
+    sat->info     = *info;
+    sat->sequence = group->sequence;
+};
+
+void NmeaSatelliteAssembler::_complete(struct NmeaSatelliteGroup* group) {
+    const struct NmeaSatelliteUsed* used =
+        group->system < NMEA_SATELLITE_SYSTEM_SIZE ? &_used[group->system] : nullptr;
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < group->count; i++) {
+        struct NmeaSatellite* sat = &group->sats[i];
+        if (sat->sequence != group->sequence) continue;  // out of view, not reported.
+
+        sat->used = false;
+        for (uint8_t j = 0; used != nullptr && j < used->count; j++) {
+            if (used->prns[j] == sat->info.nr) {
+                sat->used = true;
+                break;
+            }
+        }
+        if (count != i) group->sats[count] = *sat;
+        count++;
+    }
+    group->count = count;
+    __atomic_store_n(&group->version, group->version + 1, __ATOMIC_RELEASE);
+};
+
+void NmeaSatelliteAssembler::feed_gsa(const char* talker, const struct NmeaSentenceDataGsa* data) {
+    if (!_gsaEpoch) {
+        // First GSA of a new epoch, systems it no longer lists are not used either.
+        for (uint32_t i = 0; i < NMEA_SATELLITE_SYSTEM_SIZE; i++) {
+            _used[i].count = 0;
+        }
+        _gsaEpoch = true;
+    }
+
+    uint8_t system = data->system_id ? data->system_id : system_of_talker(talker);
+
+    for (uint32_t i = 0; i < 12; i++) {
+        int prn = data->sats[i];
+        if (prn <= 0) continue;
+
+        uint8_t satSystem = system ? system : system_of_prn(prn);
+        if (satSystem >= NMEA_SATELLITE_SYSTEM_SIZE) continue;
+
+        struct NmeaSatelliteUsed* used = &_used[satSystem];
+        if (used->count < NMEA_SATELLITE_GROUP_SATELLITE_SIZE) used->prns[used->count++] = prn;
+    }
+
+    fixType = data->fix_type;
+    pdop    = data->pdop;
+    hdop    = data->hdop;
+    vdop    = data->vdop;
+};
+
+}  // namespace wibot::protocal::gnss
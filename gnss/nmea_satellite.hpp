@@ -0,0 +1,104 @@
+#ifndef __WWTALK_GNSS_NMEA_SATELLITE_HPP__
+#define __WWTALK_GNSS_NMEA_SATELLITE_HPP__
+#include "base.hpp"
+#include "nmea.hpp"
+namespace wibot::protocal::gnss {
+
+#define NMEA_SATELLITE_GROUP_SIZE 8
+#define NMEA_SATELLITE_GROUP_SATELLITE_SIZE 32
+#define NMEA_SATELLITE_SYSTEM_SIZE 7
+
+struct NmeaSatellite {
+    struct NmeaSatInfo info;
+    uint8_t            sequence;  // sequence that last reported this satellite.
+    bool               used;      // listed by a GSA of the same system.
+};
+
+/**
+ * Satellites in view of one system and signal. version is odd while a sequence updates the
+ * group, and even once it is complete or dropped, see group_copy.
+ */
+struct NmeaSatelliteGroup {
+    uint8_t  system;
+    uint8_t  signalId;
+    uint8_t  count;
+    uint8_t  totalSats;  // as reported by the receiver, may exceed the table.
+    uint8_t  totalMsgs;
+    uint8_t  nextMsg;    // while assembling, 0 when no sequence is in progress.
+    uint8_t  sequence;
+    uint32_t version;
+
+    struct NmeaSatellite sats[NMEA_SATELLITE_GROUP_SATELLITE_SIZE];
+};
+
+/**
+ * Satellites used in the solution, collected over all GSA sentences of an epoch.
+ */
+struct NmeaSatelliteUsed {
+    uint8_t  count;
+    uint16_t prns[NMEA_SATELLITE_GROUP_SATELLITE_SIZE];
+};
+
+/**
+ * Assembles GSV fragments into a satellite table per system and signal. Every fragment updates
+ * the satellites it reports in place, found by number, and the last fragment of the sequence
+ * removes those the sequence no longer reported. Out of order fragments drop the sequence until
+ * the next first fragment, the satellites updated so far are kept.
+ *
+ * A "GN" talker mixes systems, the system of its sequence is the one of the first satellite of
+ * each fragment, as NMEA 4.10 receivers send a sequence per system.
+ *
+ * GSA lists at most 12 satellites, receivers split larger and multi system solutions into
+ * several GSA sentences, which are merged here and marked on the groups when they complete. The
+ * first GSA after a GSV starts the lists of a new epoch, for every system.
+ */
+class NmeaSatelliteAssembler {
+   public:
+    NmeaSatelliteAssembler();
+
+    /**
+     * Feed one GSV fragment.
+     * @param talker Two character talker identifier, e.g. "GP".
+     * @param completed Set to the group when this fragment completes its sequence.
+     * @return Return true if a group is complete.
+     */
+    bool feed_gsv(const char* talker, const struct NmeaSentenceDataGsv* data,
+                  const struct NmeaSatelliteGroup** completed);
+    void feed_gsa(const char* talker, const struct NmeaSentenceDataGsa* data);
+
+    const struct NmeaSatelliteGroup* group_get(uint8_t system, uint8_t signalId) const;
+
+    /**
+     * Copy a group, for a reader interrupting the feed, e.g. in another task.
+     * @return Return false if the group is not found, or is being updated, try again later.
+     */
+    bool group_copy(uint8_t system, uint8_t signalId, struct NmeaSatelliteGroup* copy) const;
+    uint8_t                          group_count() const;
+    const struct NmeaSatelliteGroup* group_at(uint8_t index) const;
+    void                             reset();
+
+    int              fixType;
+    struct NmeaFloat pdop;
+    struct NmeaFloat hdop;
+    struct NmeaFloat vdop;
+
+    static uint8_t system_of_talker(const char* talker);
+    static uint8_t system_of_prn(int prn);
+
+   private:
+    struct NmeaSatelliteGroup  _groups[NMEA_SATELLITE_GROUP_SIZE];
+    uint8_t                    _groupCount;
+    struct NmeaSatelliteGroup* _current;  // the group of the last fragment.
+    struct NmeaSatelliteUsed   _used[NMEA_SATELLITE_SYSTEM_SIZE];
+    bool                       _gsaEpoch;  // GSA sentences of the epoch are being collected.
+
+    struct NmeaSatelliteGroup* _group(uint8_t system, uint8_t signalId, bool create);
+    uint8_t                    _system(const char* talker, const struct NmeaSentenceDataGsv* data);
+    void                       _update(struct NmeaSatelliteGroup* group,
+                                       const struct NmeaSatInfo* info);
+    void                       _complete(struct NmeaSatelliteGroup* group);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NMEA_SATELLITE_HPP__
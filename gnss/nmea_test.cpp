@@ -1,31 +1,630 @@
 #include "nmea.hpp"
 
+#include "minunit.h"
+#include "nmea_cache.hpp"
+#include "nmea_coord.hpp"
+#include "nmea_encoder.hpp"
+#include "nmea_epoch.hpp"
+#include "nmea_kernel.hpp"
+#include "nmea_satellite.hpp"
 #include "nmea_test.hpp"
+#include "nmea_view.hpp"
+#include "string.h"
 
 namespace wibot::protocal::gnss::test {
 NmeaParser parser;
 
-static void nmea_test_sentence(const char* sentence);
+static const char* kernelSentences[] = {
+    "$GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*62",
+    "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n",
+    "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n",
+    "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39",
+    "$GPVTG,096.5,T,083.5,M,0.0,N,0.0,K,D*22\n",
+    "$GPGST,024603.00,3.2,6.6,4.7,47.3,5.8,5.6,22.0",
+    "$GPZDA,201530.00,04,07,2002,00,00\x01*60",
+    "GPGLL,3723.2475,N,12158.3416,W,161229.487,A,A*41",
+    "$",
+    "",
+};
 
-void nmea_test() {
-    parser.sentence_register_default();
+static void nmea_test_sentence(const char* sentence, bool accepted);
+
+static void nmea_kernel_test() {
+    for (auto sentence : kernelSentences) {
+        uint32_t         length = strlen(sentence);
+        NmeaKernelResult fast;
+        NmeaKernelResult slow;
+        NmeaKernel::scan(sentence, length, &fast);
+        NmeaKernel::scan_scalar(sentence, length, &slow);
+        MU_ASSERT(fast.stop == slow.stop);
+        MU_ASSERT(fast.checksum == slow.checksum);
+        MU_ASSERT(fast.blockCount == slow.blockCount);
+        MU_ASSERT(memcmp(fast.masks, slow.masks, sizeof(NmeaKernelMask) * fast.blockCount) == 0);
+        if (sentence[fast.stop] == '*') {
+            MU_ASSERT(fast.checksum == Sentence::checksum(sentence));
+        }
+    }
+
+    NmeaFields fields;
+    NmeaKernel::tokenize(kernelSentences[3], strlen(kernelSentences[3]), &fields);
+    MU_ASSERT(fields.count == 18);
+    MU_ASSERT(fields.length(0) == 6);
+    MU_ASSERT(fields.length(5) == 0);
+    MU_ASSERT(fields.length(17) == 3);
+}
+
+static void nmea_satellite_test() {
+    static const char* gsv[] = {
+        "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74",
+        "$GPGSV,3,2,11,14,25,170,00,16,57,208,39,18,67,296,40,19,40,246,00*74",
+        "$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D",
+    };
+    NmeaSentenceGSV                  gsvEntry;
+    NmeaSentenceGSA                  gsaEntry;
+    NmeaSentenceDataGsv              data;
+    NmeaSentenceDataGsa              gsa;
+    NmeaSatelliteAssembler           assembler;
+    const struct NmeaSatelliteGroup* group = nullptr;
+
+    MU_ASSERT(gsaEntry.parse(&gsa, "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39"));
+    assembler.feed_gsa("GP", &gsa);
+
+    // The last fragment alone does not complete a sequence.
+    MU_ASSERT(gsvEntry.parse(&data, gsv[2]));
+    MU_ASSERT(!assembler.feed_gsv("GP", &data, &group));
+
+    for (uint32_t i = 0; i < 3; i++) {
+        MU_ASSERT(gsvEntry.parse(&data, gsv[i]));
+        MU_ASSERT(assembler.feed_gsv("GP", &data, &group) == (i == 2));
+    }
+    MU_ASSERT(group != nullptr);
+    if (group != nullptr) {
+        MU_ASSERT(group->system == NMEA_SYSTEM_GPS);
+        MU_ASSERT(group->count == 11);
+        MU_ASSERT(group->sats[1].info.nr == 4 && group->sats[1].used);
+        MU_ASSERT(group->sats[0].info.nr == 3 && !group->sats[0].used);
+    }
+
+    MU_ASSERT(gsvEntry.parse(&data, "$GPGSV,1,1,02,03,03,111,00,04,15,270,00,1*67"));
+    MU_ASSERT(data.signal_id == 1 && data.sats[2].nr == 0);
+    MU_ASSERT(assembler.feed_gsv("GP", &data, &group));
+    MU_ASSERT(group->signalId == 1 && group->count == 2);
+    MU_ASSERT(assembler.group_count() == 2);
+
+    // A sequence cut short keeps the satellites, updated or not, and can be read again.
+    const struct NmeaSatelliteGroup* gps = assembler.group_get(NMEA_SYSTEM_GPS, 0);
+    struct NmeaSatelliteGroup        copy;
+    MU_ASSERT(gsvEntry.parse(&data, gsv[0]));
+    MU_ASSERT(!assembler.feed_gsv("GP", &data, &group));
+    MU_ASSERT(gps->version == 3 && !assembler.group_copy(NMEA_SYSTEM_GPS, 0, &copy));
+    MU_ASSERT(gsvEntry.parse(&data, gsv[2]));
+    MU_ASSERT(!assembler.feed_gsv("GP", &data, &group));
+    MU_ASSERT(gps->count == 11 && gps->version == 4 && gps->sats[4].info.nr == 14);
+    MU_ASSERT(assembler.group_copy(NMEA_SYSTEM_GPS, 0, &copy) && copy.count == 11);
+
+    // "GN" sequences of different systems are kept apart.
+    MU_ASSERT(gsvEntry.parse(&data, "$GNGSV,1,1,02,03,03,111,00,04,15,270,00,1*7C"));
+    MU_ASSERT(assembler.feed_gsv("GN", &data, &group) && group->system == NMEA_SYSTEM_GPS);
+    MU_ASSERT(gsvEntry.parse(&data, "$GNGSV,1,1,02,65,03,111,00,66,15,270,00,1*78"));
+    MU_ASSERT(assembler.feed_gsv("GN", &data, &group) && group->system == NMEA_SYSTEM_GLONASS);
+    MU_ASSERT(group->count == 2 && group->sats[0].info.nr == 65);
+    MU_ASSERT(assembler.group_get(NMEA_SYSTEM_GPS, 1)->version == 4);
+    MU_ASSERT(assembler.group_count() == 3);
+
+    // Satellites a sequence no longer reports are removed.
+    MU_ASSERT(gsvEntry.parse(&data, "$GPGSV,1,1,01,04,15,270,00,1*50"));
+    MU_ASSERT(assembler.feed_gsv("GP", &data, &group) && group->count == 1);
+    MU_ASSERT(group->sats[0].info.nr == 4 && group->version == 6);
+
+    // A new epoch of GSA lists GLONASS only, no GPS satellite is used anymore.
+    MU_ASSERT(gsaEntry.parse(&gsa, "$GNGSA,A,3,65,66,,,,,,,,,,,2.5,1.3,2.1,2*37"));
+    assembler.feed_gsa("GN", &gsa);
+    for (uint32_t i = 0; i < 3; i++) {
+        MU_ASSERT(gsvEntry.parse(&data, gsv[i]));
+        MU_ASSERT(assembler.feed_gsv("GP", &data, &group) == (i == 2));
+    }
+    MU_ASSERT(group == gps && gps->count == 11 && gps->version == 6);
+    for (uint32_t i = 0; i < gps->count; i++) {
+        MU_ASSERT(!gps->sats[i].used);
+    }
+}
+
+static void nmea_epoch_test_fix(void* context, const struct NmeaFix* fix) {
+    auto fixes = (struct NmeaFix*)context;
+    fixes[fixes[0].sentences == 0 ? 0 : 1] = *fix;
+}
+
+static void nmea_epoch_test() {
+    static const char* sentences[] = {
+        "$GNRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E",
+        "$GNGGA,081836,3751.65,S,14507.36,E,1,08,0.9,545.4,M,46.9,M,,",
+        "$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1",
+        "$GNRMC,081837,A,3751.66,S,14507.36,E,000.0,360.0,130998,011.3,E",
+        "$GNGGA,081837,3751.66,S,14507.36,E,1,09,0.9,545.4,M,46.9,M,,",
+    };
+    struct NmeaFix      fixes[2];
+    NmeaEpochAggregator aggregator(parser);
+
+    memset(fixes, 0, sizeof(fixes));
+    aggregator.init(0, nmea_epoch_test_fix, fixes);
+    for (auto sentence : sentences) {
+        MU_ASSERT(aggregator.feed(sentence, false));
+    }
+    MU_ASSERT(fixes[0].time.seconds == 36 && fixes[1].sentences == 0);
+    MU_ASSERT(fixes[0].date.year == 1998 && fixes[0].date.month == 9);
+    MU_ASSERT(fixes[0].satellites_tracked == 8 && fixes[0].fix_type == 3);
+    MU_ASSERT(fixes[0].sentences == (NMEA_SENTENCE_BIT(NMEA_SENTENCE_RMC) |
+                                     NMEA_SENTENCE_BIT(NMEA_SENTENCE_GGA) |
+                                     NMEA_SENTENCE_BIT(NMEA_SENTENCE_GSA)));
+    aggregator.flush();
+    MU_ASSERT(fixes[1].time.seconds == 37 && fixes[1].satellites_tracked == 9);
+
+    memset(fixes, 0, sizeof(fixes));
+    aggregator.init(NMEA_SENTENCE_BIT(NMEA_SENTENCE_RMC) | NMEA_SENTENCE_BIT(NMEA_SENTENCE_GGA),
+                    nmea_epoch_test_fix, fixes);
+    for (uint32_t i = 0; i < 2; i++) {
+        aggregator.feed(sentences[i], false);
+    }
+    MU_ASSERT(fixes[0].time.seconds == 36);
+    aggregator.feed(sentences[2], false);
+    MU_ASSERT(aggregator.lateCount == 1);
+    aggregator.feed(sentences[3], false);
+    MU_ASSERT(fixes[1].sentences == 0 && aggregator.lateCount == 1);
+}
+
+static void nmea_encoder_test() {
+    static const char* sentences[] = {
+        "$GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*62\r\n",
+        "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n",
+        "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n",
+        "$GPGLL,3723.2475,N,12158.3416,W,161229.487,A,A*41\r\n",
+        "$GPGST,024603.00,3.2,6.6,4.7,47.3,5.8,5.6,22.0*58\r\n",
+        "$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D\r\n",
+        "$GPVTG,096.5,T,083.5,M,0.0,N,0.0,K,D*22\r\n",
+        "$GPZDA,201530.00,04,07,2002,00,00*60\r\n",
+        "$GNGNS,181604.00,,,,,NN,00,99.99,,,,,V*23\r\n",
+        "$GPGBS,235458.00,1.4,1.3,3.1,03,,-21.4,3.8,1,0*5A\r\n",
+        "$GPHDT,274.07,T*03\r\n",
+        "$GPTHS,77.52,E*34\r\n",
+    };
+    NmeaEncoder encoder;
+    char        buffer[MINMEA_MAX_LENGTH + 4];
+    uint32_t    length;
+
+    NmeaSentenceDataRmc rmc[2];
+    NmeaSentenceRMC     rmcEntry;
+    memset(rmc, 0, sizeof(rmc));
+    encoder.timeDecimals = 0;
+    MU_ASSERT(rmcEntry.parse(&rmc[0], sentences[0]));
+    length = encoder.encode_rmc(buffer, sizeof(buffer), "GP", &rmc[0]);
+    MU_ASSERT(length == strlen(buffer) && Sentence::check(buffer, true));
+    MU_ASSERT(rmcEntry.parse(&rmc[1], buffer) && !memcmp(&rmc[0], &rmc[1], sizeof(rmc[0])));
+    MU_ASSERT(encoder.encode_rmc(buffer, 20, "GP", &rmc[0]) == 0);
+
+    NmeaSentenceDataGga gga[2];
+    NmeaSentenceGGA     ggaEntry;
+    memset(gga, 0, sizeof(gga));
+    MU_ASSERT(ggaEntry.parse(&gga[0], sentences[1]));
+    length = encoder.encode_gga(buffer, sizeof(buffer), "GP", &gga[0]);
+    MU_ASSERT(length == strlen(sentences[1]) && !strcmp(buffer, sentences[1]));
+    MU_ASSERT(ggaEntry.parse(&gga[1], buffer) && !memcmp(&gga[0], &gga[1], sizeof(gga[0])));
+
+    NmeaSentenceDataGsa gsa[2];
+    NmeaSentenceGSA     gsaEntry;
+    memset(gsa, 0, sizeof(gsa));
+    MU_ASSERT(gsaEntry.parse(&gsa[0], sentences[2]));
+    encoder.encode_gsa(buffer, sizeof(buffer), "GP", &gsa[0]);
+    MU_ASSERT(!strcmp(buffer, sentences[2]));
+    MU_ASSERT(gsaEntry.parse(&gsa[1], buffer) && !memcmp(&gsa[0], &gsa[1], sizeof(gsa[0])));
 
-    nmea_test_sentence("");
+    NmeaSentenceDataGll gll[2];
+    NmeaSentenceGLL     gllEntry;
+    memset(gll, 0, sizeof(gll));
+    MU_ASSERT(gllEntry.parse(&gll[0], sentences[3]));
+    encoder.encode_gll(buffer, sizeof(buffer), "GP", &gll[0]);
+    MU_ASSERT(!strcmp(buffer, sentences[3]));
+    MU_ASSERT(gllEntry.parse(&gll[1], buffer) && !memcmp(&gll[0], &gll[1], sizeof(gll[0])));
+
+    NmeaSentenceDataGst gst[2];
+    NmeaSentenceGST     gstEntry;
+    memset(gst, 0, sizeof(gst));
+    encoder.timeDecimals = 2;
+    MU_ASSERT(gstEntry.parse(&gst[0], sentences[4]));
+    encoder.encode_gst(buffer, sizeof(buffer), "GP", &gst[0]);
+    MU_ASSERT(!strcmp(buffer, sentences[4]));
+    MU_ASSERT(gstEntry.parse(&gst[1], buffer) && !memcmp(&gst[0], &gst[1], sizeof(gst[0])));
+
+    NmeaSentenceDataGsv gsv[2];
+    NmeaSentenceGSV     gsvEntry;
+    memset(gsv, 0, sizeof(gsv));
+    MU_ASSERT(gsvEntry.parse(&gsv[0], sentences[5]));
+    encoder.encode_gsv(buffer, sizeof(buffer), "GP", &gsv[0]);
+    MU_ASSERT(gsvEntry.parse(&gsv[1], buffer) && !memcmp(&gsv[0], &gsv[1], sizeof(gsv[0])));
+
+    NmeaSentenceDataVtg vtg[2];
+    NmeaSentenceVTG     vtgEntry;
+    memset(vtg, 0, sizeof(vtg));
+    MU_ASSERT(vtgEntry.parse(&vtg[0], sentences[6]));
+    encoder.encode_vtg(buffer, sizeof(buffer), "GP", &vtg[0]);
+    MU_ASSERT(vtgEntry.parse(&vtg[1], buffer) && !memcmp(&vtg[0], &vtg[1], sizeof(vtg[0])));
+
+    NmeaSentenceDataZda zda[2];
+    NmeaSentenceZDA     zdaEntry;
+    memset(zda, 0, sizeof(zda));
+    MU_ASSERT(zdaEntry.parse(&zda[0], sentences[7]));
+    encoder.encode_zda(buffer, sizeof(buffer), "GP", &zda[0]);
+    MU_ASSERT(!strcmp(buffer, sentences[7]));
+    MU_ASSERT(zdaEntry.parse(&zda[1], buffer) && !memcmp(&zda[0], &zda[1], sizeof(zda[0])));
+
+    NmeaSentenceDataGns gns[2];
+    NmeaSentenceGNS     gnsEntry;
+    memset(gns, 0, sizeof(gns));
+    MU_ASSERT(gnsEntry.parse(&gns[0], sentences[8]));
+    encoder.encode_gns(buffer, sizeof(buffer), "GN", &gns[0]);
+    MU_ASSERT(!strcmp(buffer, sentences[8]));
+    MU_ASSERT(gnsEntry.parse(&gns[1], buffer) && !memcmp(&gns[0], &gns[1], sizeof(gns[0])));
+    MU_ASSERT(gnsEntry.parse(&gns[0],
+                             "$GNGNS,112257.00,3844.24011,N,00908.43828,W,AN,03,10.5,,*57"));
+    encoder.encode_gns(buffer, sizeof(buffer), "GN", &gns[0]);
+    MU_ASSERT(gnsEntry.parse(&gns[1], buffer) && !memcmp(&gns[0], &gns[1], sizeof(gns[0])));
+
+    NmeaSentenceDataGbs gbs[2];
+    NmeaSentenceGBS     gbsEntry;
+    memset(gbs, 0, sizeof(gbs));
+    MU_ASSERT(gbsEntry.parse(&gbs[0], sentences[9]));
+    encoder.encode_gbs(buffer, sizeof(buffer), "GP", &gbs[0]);
+    MU_ASSERT(!strcmp(buffer, sentences[9]));
+    MU_ASSERT(gbsEntry.parse(&gbs[1], buffer) && !memcmp(&gbs[0], &gbs[1], sizeof(gbs[0])));
+
+    NmeaSentenceDataHdt hdt[2];
+    NmeaSentenceHDT     hdtEntry;
+    memset(hdt, 0, sizeof(hdt));
+    MU_ASSERT(hdtEntry.parse(&hdt[0], sentences[10]));
+    encoder.encode_hdt(buffer, sizeof(buffer), "GP", &hdt[0]);
+    MU_ASSERT(!strcmp(buffer, sentences[10]));
+    MU_ASSERT(hdtEntry.parse(&hdt[1], buffer) && !memcmp(&hdt[0], &hdt[1], sizeof(hdt[0])));
+
+    NmeaSentenceDataThs ths[2];
+    NmeaSentenceTHS     thsEntry;
+    memset(ths, 0, sizeof(ths));
+    MU_ASSERT(thsEntry.parse(&ths[0], sentences[11]));
+    encoder.encode_ths(buffer, sizeof(buffer), "GP", &ths[0]);
+    MU_ASSERT(!strcmp(buffer, sentences[11]));
+    MU_ASSERT(thsEntry.parse(&ths[1], buffer) && !memcmp(&ths[0], &ths[1], sizeof(ths[0])));
 }
 
-static void nmea_test_sentence(const char* sentence) {
-    NmeaSentenceBase*   entry;
-    NmeaSentenceDataRmc rmc = {0};
-    parser.sentence_entry_get(sentence, true, &entry);
-    switch (entry->id) {
-        case NMEA_SENTENCE_RMC:
+class NmeaTestProprietary : public NmeaSentenceProprietaryBase {
+   public:
+    explicit NmeaTestProprietary(const char* address) : NmeaSentenceProprietaryBase(address){};
+    bool parse(void*, const char*) override {
+        return true;
+    };
+};
+
+class NmeaTestGpRmc : public NmeaSentenceBase {
+   public:
+    NmeaTestGpRmc() : NmeaSentenceBase(NMEA_SENTENCE_RMC, "RMC", NMEA_TALKER_GP, "GP"){};
+    bool parse(void*, const char*) override {
+        return true;
+    };
+};
 
-            entry->parse(&rmc, sentence);
-            break;
+static void nmea_registry_test() {
+    NmeaSentenceBase*   table[64];
+    NmeaParser          registry(table, 64);
+    NmeaTestProprietary pubx("PUBX");
+    NmeaTestProprietary pcas("PCAS");
+    NmeaTestProprietary pstm("PSTMTG");
+    NmeaTestGpRmc       gpRmc;
+    NmeaSentenceBase*   entry = nullptr;
+
+    registry.sentence_register_default();
+    MU_ASSERT(registry.sentence_register(&pubx));
+    MU_ASSERT(registry.sentence_register(&pcas));
+    MU_ASSERT(registry.sentence_register(&pstm));
+    MU_ASSERT(registry.sentence_register(&gpRmc));
+
+    MU_ASSERT(registry.sentence_entry_get("$GNRMC,081836,A,3751.65,S,14507.36,E,,,130998,,", false,
+                                          &entry));
+    MU_ASSERT(entry != &gpRmc && entry->id == NMEA_SENTENCE_RMC);
+    MU_ASSERT(registry.sentence_entry_get("$GPRMC,081836,A,3751.65,S,14507.36,E,,,130998,,", false,
+                                          &entry));
+    MU_ASSERT(entry == &gpRmc);
+    MU_ASSERT(registry.sentence_entry_get("$PUBX,00,081350.00,4717.113210,N", false, &entry));
+    MU_ASSERT(entry == &pubx);
+    MU_ASSERT(registry.sentence_entry_get("$PSTMTG,1,2", false, &entry));
+    MU_ASSERT(entry == &pstm);
+    MU_ASSERT(!registry.sentence_entry_get("$PSTMTS,1,2", false, &entry));
+    MU_ASSERT(registry.sentence_entry_get("$GPHDT,274.07,T*03", true, &entry));
+    MU_ASSERT(entry->id == NMEA_SENTENCE_HDT);
+
+    NmeaSentenceDataHdt hdt;
+    MU_ASSERT(entry->parse(&hdt, "$GPHDT,274.07,T*03"));
+    MU_ASSERT(hdt.heading.value == 27407 && hdt.heading.scale == 100);
+
+    NmeaSentenceDataGns gns;
+    NmeaSentenceGNS     gnsEntry;
+    MU_ASSERT(gnsEntry.parse(&gns, "$GNGNS,112257.00,3844.24011,N,00908.43828,W,AN,03,10.5,,*57"));
+    MU_ASSERT(!strcmp(gns.mode, "AN") && gns.satellites_used == 3 && gns.longitude.value < 0);
+    MU_ASSERT(gnsEntry.parse(&gns, "$GNGNS,181604.00,,,,,NN,00,99.99,,,,,V*0B"));
+    MU_ASSERT(gns.nav_status == 'V');
+
+    NmeaSentenceDataGbs gbs;
+    NmeaSentenceGBS     gbsEntry;
+    MU_ASSERT(gbsEntry.parse(&gbs, "$GPGBS,235458.00,1.4,1.3,3.1,03,,-21.4,3.8,1,0*5B"));
+    MU_ASSERT(gbs.failed_sat == 3 && gbs.system_id == 1 && gbs.bias.value == -214);
+
+    // Rounded down to 4 slots, full at 3 entries.
+    NmeaSentenceBase* smallTable[6];
+    NmeaParser        small(smallTable, 6);
+    MU_ASSERT(small.sentence_register(&pubx) && small.sentence_register(&pcas));
+    MU_ASSERT(small.sentence_register(&pstm) && small.sentence_register(&pubx));
+    MU_ASSERT(!small.sentence_register(&gpRmc));
+    MU_ASSERT(small.sentence_entry_get("$PSTMTG,1,2", false, &entry) && entry == &pstm);
+}
+
+static void nmea_view_test() {
+    const char*         rmcSentence = "$GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*62";
+    NmeaSentenceDataRmc rmc;
+    NmeaSentenceRMC     rmcEntry;
+    MU_ASSERT(rmcEntry.parse(&rmc, rmcSentence));
+
+    NmeaRmcView rmcView;
+    MU_ASSERT(rmcView.init(rmcSentence, strlen(rmcSentence)));
+    MU_ASSERT(rmcView.field_count() == 12);
+    struct NmeaFloat latitude;
+    struct NmeaTime  time;
+    struct NmeaDate  date;
+    bool             valid;
+    MU_ASSERT(rmcView.latitude(&latitude) && !memcmp(&latitude, &rmc.latitude, sizeof(latitude)));
+    // Memoized, same value on the second read.
+    MU_ASSERT(rmcView.latitude(&latitude) && latitude.value == -375165 && latitude.scale == 100);
+    MU_ASSERT(rmcView.time(&time) && !memcmp(&time, &rmc.time, sizeof(time)));
+    MU_ASSERT(rmcView.date(&date) && !memcmp(&date, &rmc.date, sizeof(date)));
+    MU_ASSERT(rmcView.valid(&valid) && valid);
+
+    // Only the fields that are read must be well formed.
+    const char* ggaSentence = "$GPGGA,123519,48x7.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,";
+    NmeaGgaView ggaView;
+    MU_ASSERT(ggaView.init(ggaSentence, strlen(ggaSentence)));
+    int fixQuality;
+    MU_ASSERT(ggaView.fix_quality(&fixQuality) && fixQuality == 1);
+    MU_ASSERT(ggaView.time(&time) && time.hours == 12 && time.seconds == 19);
+    MU_ASSERT(!ggaView.latitude(&latitude));
+    char talker[3];
+    MU_ASSERT(ggaView.talker(talker) && !strcmp(talker, "GP"));
+    uint32_t length;
+    MU_ASSERT(ggaView.field(14, &length) != nullptr && length == 0);
+    MU_ASSERT(ggaView.field(15, &length) == nullptr);
+    MU_ASSERT(!rmcView.init(ggaSentence, strlen(ggaSentence)));
+
+    // The view is bounded by length, the sentence needs no terminator.
+    const char* gsaSentence = "$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1,1*39 trailing";
+    NmeaGsaView gsaView;
+    MU_ASSERT(gsaView.init(gsaSentence, 46));
+    int prn, systemId;
+    MU_ASSERT(gsaView.sats(1, &prn) && prn == 5);
+    MU_ASSERT(gsaView.sats(2, &prn) && prn == 0);
+    MU_ASSERT(gsaView.system_id(&systemId) && systemId == 1);
+    MU_ASSERT(gsaView.init(gsaSentence, 44));
+    MU_ASSERT(gsaView.system_id(&systemId) && systemId == 0);
+
+    // Every view reads what the matching parser decodes.
+    static const char* gsvSentences[] = {
+        "$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D",
+        "$GPGSV,1,1,02,03,03,111,00,04,15,270,00,1*67",
+    };
+    for (auto sentence : gsvSentences) {
+        NmeaSentenceDataGsv gsv;
+        NmeaSentenceGSV     gsvEntry;
+        NmeaGsvView         gsvView;
+        MU_ASSERT(gsvEntry.parse(&gsv, sentence));
+        MU_ASSERT(gsvView.init(sentence, strlen(sentence)));
+        int value;
+        MU_ASSERT(gsvView.msg_nr(&value) && value == gsv.msg_nr);
+        MU_ASSERT(gsvView.total_sats(&value) && value == gsv.total_sats);
+        MU_ASSERT(gsvView.signal_id(&value) && value == gsv.signal_id);
+        for (uint32_t i = 0; i < 4; i++) {
+            struct NmeaSatInfo sat;
+            MU_ASSERT(gsvView.sats(i, &sat) && !memcmp(&sat, &gsv.sats[i], sizeof(sat)));
+        }
+    }
+
+    const char*         gnsSentence = "$GNGNS,181604.00,,,,,NN,00,99.99,,,,,V*23";
+    NmeaSentenceDataGns gns;
+    NmeaSentenceGNS     gnsEntry;
+    NmeaGnsView         gnsView;
+    char                mode[NMEA_GNS_MODE_SIZE];
+    char                status;
+    struct NmeaFloat    value;
+    MU_ASSERT(gnsEntry.parse(&gns, gnsSentence));
+    MU_ASSERT(gnsView.init(gnsSentence, strlen(gnsSentence)));
+    MU_ASSERT(gnsView.mode(mode) && !strcmp(mode, gns.mode));
+    MU_ASSERT(gnsView.hdop(&value) && !memcmp(&value, &gns.hdop, sizeof(value)));
+    MU_ASSERT(gnsView.nav_status(&status) && status == 'V');
+
+    const char*         gbsSentence = "$GPGBS,235458.00,1.4,1.3,3.1,03,,-21.4,3.8,1,0*5A";
+    NmeaSentenceDataGbs gbs;
+    NmeaSentenceGBS     gbsEntry;
+    NmeaGbsView         gbsView;
+    int                 failedSat, signalId;
+    MU_ASSERT(gbsEntry.parse(&gbs, gbsSentence));
+    MU_ASSERT(gbsView.init(gbsSentence, strlen(gbsSentence)));
+    MU_ASSERT(gbsView.failed_sat(&failedSat) && failedSat == 3);
+    MU_ASSERT(gbsView.bias(&value) && !memcmp(&value, &gbs.bias, sizeof(value)));
+    MU_ASSERT(gbsView.system_id(&systemId) && systemId == 1);
+    MU_ASSERT(gbsView.signal_id(&signalId) && signalId == 0);
+
+    NmeaHdtView hdtView;
+    NmeaThsView thsView;
+    MU_ASSERT(hdtView.init("$GPHDT,274.07,T*03", 18));
+    MU_ASSERT(hdtView.heading(&value) && value.value == 27407 && value.scale == 100);
+    MU_ASSERT(thsView.init("$GPTHS,77.52,E*34", 17));
+    MU_ASSERT(thsView.heading(&value) && value.value == 7752 && thsView.mode(&status) &&
+              status == 'E');
+}
+
+static void nmea_cache_test() {
+    static const char* sentences[] = {
+        "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74",
+        "$GPGSV,3,2,11,14,25,170,00,16,57,208,39,18,67,296,40,19,40,246,00*74",
+        "$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D",
+        "$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1,1*3A",
+        "$GNGSA,A,3,65,66,,,,,,,,,,,2.5,1.3,2.1,2*37",
+    };
+    NmeaSentenceCache cache(parser);
+    cache.init(NMEA_SENTENCE_BIT(NMEA_SENTENCE_GSV) | NMEA_SENTENCE_BIT(NMEA_SENTENCE_GSA));
+
+    NmeaSentenceBase*                entry;
+    const union NmeaSentenceDataAny* data;
+    bool                             unchanged;
+    for (int epoch = 0; epoch < 2; epoch++) {
+        for (uint32_t i = 0; i < sizeof(sentences) / sizeof(sentences[0]); i++) {
+            MU_ASSERT(cache.parse(sentences[i], false, &entry, &data, &unchanged));
+            MU_ASSERT(unchanged == (epoch == 1));
+        }
+    }
+    MU_ASSERT(cache.hits == 5 && cache.misses == 5);
+    MU_ASSERT(cache.parse(sentences[1], false, &entry, &data, &unchanged));
+    MU_ASSERT(entry->id == NMEA_SENTENCE_GSV && data->gsv.msg_nr == 2 &&
+              data->gsv.sats[1].nr == 16);
+    MU_ASSERT(cache.parse(sentences[4], false, &entry, &data, &unchanged));
+    MU_ASSERT(data->gsa.system_id == 2 && data->gsa.sats[1] == 66);
+
+    // Any change of the raw bytes is decoded again.
+    MU_ASSERT(cache.parse("$GPGSV,3,2,11,14,25,170,00,16,57,208,38,18,67,296,40,19,40,246,00*75",
+                          false, &entry, &data, &unchanged));
+    MU_ASSERT(!unchanged && data->gsv.sats[1].snr == 38);
+
+    // Sentences left out of the cache are always decoded.
+    const char* rmc = "$GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*62";
+    MU_ASSERT(cache.parse(rmc, false, &entry, &data, &unchanged) && !unchanged);
+    MU_ASSERT(cache.parse(rmc, false, &entry, &data, &unchanged) && !unchanged);
+    MU_ASSERT(data->rmc.valid && data->rmc.date.year == 98);
+
+    cache.reset();
+    MU_ASSERT(cache.parse(sentences[0], false, &entry, &data, &unchanged) && !unchanged);
+
+    // GSA without system id are told apart by their order, GSV fragments by their signal.
+    static const char* epoch[] = {
+        "$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*27",
+        "$GNGSA,A,3,65,66,,,,,,,,,,,2.5,1.3,2.1*29",
+        "$GPGSV,1,1,02,03,03,111,00,04,15,270,00,1*62",
+        "$GPGSV,1,1,02,03,03,111,00,04,15,270,00,7*64",
+        rmc,
+    };
+    cache.reset();
+    for (int pass = 0; pass < 2; pass++) {
+        for (auto sentence : epoch) {
+            MU_ASSERT(cache.parse(sentence, false, &entry, &data, &unchanged));
+        }
+    }
+    MU_ASSERT(cache.hits == 4 && cache.misses == 4);
+
+    // A rejected sentence ends a run of GSA too, the next epoch finds its slots.
+    cache.reset();
+    for (int pass = 0; pass < 2; pass++) {
+        MU_ASSERT(cache.parse(epoch[0], false, &entry, &data, &unchanged));
+        MU_ASSERT(cache.parse(epoch[1], false, &entry, &data, &unchanged));
+        MU_ASSERT(unchanged == (pass == 1) && data->gsa.sats[0] == 65);
+        MU_ASSERT(!cache.parse("$GNGSA,A,3,04*00", true, &entry, &data, &unchanged));
+    }
+    MU_ASSERT(cache.hits == 2 && cache.misses == 2);
+}
+
+static void nmea_coord_test() {
+    // 37 deg 51.65 min S = -37.86083333... deg.
+    struct NmeaFloat coord = {-375165, 100};
+    int64_t          nano;
+    int32_t          e7;
+    MU_ASSERT(NmeaCoord::to_nanodegrees(&coord, &nano) && nano == -37860833333LL);
+    MU_ASSERT(NmeaCoord::to_degrees_e7(&coord, &e7) && e7 == -378608333);
+    // Halves round away from zero: 0.000003 min = 0.5e-7 deg.
+    coord = {3, 1000000};
+    MU_ASSERT(NmeaCoord::to_degrees_e7(&coord, &e7) && e7 == 1);
+    coord = {-3, 1000000};
+    MU_ASSERT(NmeaCoord::to_degrees_e7(&coord, &e7) && e7 == -1);
+    // RTK grade, 113 deg 10.00001 min, a float would be off by up to 4e-6 deg.
+    coord = {1131000001, 100000};
+    MU_ASSERT(NmeaCoord::to_nanodegrees(&coord, &nano) && nano == 113166666833LL);
+
+    coord = {0, 0};
+    MU_ASSERT(!NmeaCoord::to_nanodegrees(&coord, &nano));
+    coord = {4875000, 1000};
+    MU_ASSERT(!NmeaCoord::to_nanodegrees(&coord, &nano));
+
+    struct NmeaFloat altitude = {5454, 10};
+    int64_t          millimetres;
+    MU_ASSERT(NmeaCoord::to_fixed(&altitude, 1000, &millimetres) && millimetres == 545400);
+
+    struct NmeaFloat coords[11];
+    int64_t          batch[11];
+    int64_t          scalar[11];
+    int32_t          batchE7[11];
+    for (int i = 0; i < 11; i++) {
+        coords[i] = {(i & 1 ? -1 : 1) * (1131000 + i * 7919), i == 5 ? 0 : 1000};
+    }
+    coords[7] = {113100000, 7};
+    NmeaCoord::to_nanodegrees(coords, 11, batch);
+    NmeaCoord::to_nanodegrees_scalar(coords, 11, scalar);
+    NmeaCoord::to_degrees_e7(coords, 11, batchE7);
+    MU_ASSERT(!memcmp(batch, scalar, sizeof(batch)));
+    MU_ASSERT(batch[5] == NMEA_COORD_UNKNOWN_NANO && batchE7[5] == NMEA_COORD_UNKNOWN_E7);
+    MU_ASSERT(NmeaCoord::to_degrees_e7(&coords[3], &e7) && batchE7[3] == e7);
+}
+
+static void nmea_subscribe_test() {
+    NmeaParser subscriber;
+    subscriber.sentence_register_default();
+    subscriber.subscribe(NMEA_SENTENCE_BIT(NMEA_SENTENCE_RMC) | NMEA_SENTENCE_BIT(NMEA_SENTENCE_GGA));
+
+    NmeaSentenceBase* entry;
+    MU_ASSERT(subscriber.sentence_entry_get(
+        "$GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*62", true, &entry));
+    MU_ASSERT(entry->id == NMEA_SENTENCE_RMC);
+    // Dropped on the address, whatever the checksum.
+    MU_ASSERT(!subscriber.sentence_entry_get(
+        "$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D", true, &entry));
+    MU_ASSERT(!subscriber.sentence_entry_get("$GLGSV,3,3,11,22,42,067,42*00", true, &entry));
+    MU_ASSERT(!subscriber.sentence_entry_get("$GPTXT,01,01,02,ANTSTATUS=OK*3B", true, &entry));
+    MU_ASSERT(subscriber.dropped[NMEA_SENTENCE_GSV] == 2);
+    MU_ASSERT(subscriber.dropped[NMEA_UNKNOWN] == 1);
+    MU_ASSERT(subscriber.dropped[NMEA_SENTENCE_RMC] == 0);
+    // A subscribed sentence with a bad checksum is rejected, but not counted as dropped.
+    MU_ASSERT(!subscriber.sentence_entry_get(
+        "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*48", true, &entry));
+    MU_ASSERT(subscriber.dropped[NMEA_SENTENCE_GGA] == 0);
+    MU_ASSERT(!subscriber.sentence_entry_get("", true, &entry));
+
+    subscriber.dropped_reset();
+    MU_ASSERT(subscriber.dropped[NMEA_SENTENCE_GSV] == 0);
+}
+
+void nmea_test() {
+    parser.sentence_register_default();
+
+    nmea_kernel_test();
+    nmea_registry_test();
+    nmea_satellite_test();
+    nmea_epoch_test();
+    nmea_encoder_test();
+    nmea_view_test();
+    nmea_cache_test();
+    nmea_coord_test();
+    nmea_subscribe_test();
+    nmea_test_sentence("", false);
+    nmea_test_sentence("$GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*62", true);
+    nmea_test_sentence("$GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*63", false);
+}
 
-        default:
-            break;
+static void nmea_test_sentence(const char* sentence, bool accepted) {
+    NmeaSentenceBase*         entry = nullptr;
+    union NmeaSentenceDataAny data;
+    bool                      parsed = parser.sentence_entry_get(sentence, true, &entry);
+    if (parsed) {
+        parsed = entry->parse(&data, sentence);
     }
+    MU_ASSERT(parsed == accepted);
 };
 
 }  // namespace wibot::protocal::gnss::test
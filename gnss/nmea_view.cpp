@@ -0,0 +1,101 @@
+#include "nmea_view.hpp"
+
+#include "string.h"
+
+namespace wibot::protocal::gnss {
+
+NmeaSentenceView::NmeaSentenceView() : _sentence(nullptr) {
+    _fields.count = 0;
+};
+
+bool NmeaSentenceView::init(const char* sentence, uint32_t length) {
+    _sentence     = sentence;
+    _fields.count = 0;
+    memset(_decoded, 0, sizeof(_decoded));
+    if (length == 0 || sentence[0] != '$') return false;
+
+    NmeaKernel::tokenize(sentence, length, &_fields);
+    return true;
+};
+
+uint32_t NmeaSentenceView::field_count() const {
+    return _fields.count;
+};
+
+const char* NmeaSentenceView::field(uint32_t index, uint32_t* length) const {
+    if (index >= _fields.count) return nullptr;
+    *length = _fields.length(index);
+    return _sentence + _fields.start[index];
+};
+
+bool NmeaSentenceView::talker(char talker[3]) const {
+    uint32_t length;
+    auto     address = field(0, &length);
+    if (address == nullptr || length < 3) return false;
+    talker[0] = address[1];
+    talker[1] = address[2];
+    talker[2] = '\0';
+    return true;
+};
+
+bool NmeaSentenceView::is_type(const char* type) const {
+    uint32_t length;
+    auto     address = field(0, &length);
+    if (address == nullptr || length < 4) return false;
+    return !memcmp(address + length - 3, type, 3);
+};
+
+template <typename T>
+bool NmeaSentenceView::_get(uint32_t index, char format, T NmeaFieldValue::*member,
+                            bool (*decode)(const char* field, uint32_t length, T* value),
+                            T* value) {
+    if (index >= _fields.count) return false;
+    T* cached = &(_cache[index].*member);
+    if (_decoded[index] != format) {
+        // The cache slot is about to be overwritten, whatever it held is gone.
+        _decoded[index] = 0;
+        if (!decode(_sentence + _fields.start[index], _fields.length(index), cached)) {
+            return false;
+        }
+        _decoded[index] = format;
+    }
+    *value = *cached;
+    return true;
+};
+
+bool NmeaSentenceView::get_char(uint32_t index, char* value) {
+    return _get(index, 'c', &NmeaFieldValue::c, Sentence::field_char, value);
+};
+
+bool NmeaSentenceView::get_direction(uint32_t index, int* value) {
+    return _get(index, 'd', &NmeaFieldValue::i, Sentence::field_direction, value);
+};
+
+bool NmeaSentenceView::get_int(uint32_t index, int* value) {
+    return _get(index, 'i', &NmeaFieldValue::i, Sentence::field_int, value);
+};
+
+bool NmeaSentenceView::get_float(uint32_t index, struct NmeaFloat* value) {
+    return _get(index, 'f', &NmeaFieldValue::f, Sentence::field_float, value);
+};
+
+bool NmeaSentenceView::get_coord(uint32_t index, struct NmeaFloat* value) {
+    int direction;
+    if (!get_float(index, value) || !get_direction(index + 1, &direction)) return false;
+    value->value *= direction;
+    return true;
+};
+
+bool NmeaSentenceView::get_time(uint32_t index, struct NmeaTime* value) {
+    return _get(index, 'T', &NmeaFieldValue::t, Sentence::field_time, value);
+};
+
+bool NmeaSentenceView::get_date(uint32_t index, struct NmeaDate* value) {
+    return _get(index, 'D', &NmeaFieldValue::d, Sentence::field_date, value);
+};
+
+bool NmeaSentenceView::get_hex(uint32_t index, int* value) {
+    return _get(index, 'x', &NmeaFieldValue::i, Sentence::field_hex, value);
+};
+
+}  // namespace wibot::protocal::gnss
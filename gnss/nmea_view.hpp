@@ -0,0 +1,325 @@
+#ifndef __WWTALK_GNSS_NMEA_VIEW_HPP__
+#define __WWTALK_GNSS_NMEA_VIEW_HPP__
+#include "base.hpp"
+#include "nmea.hpp"
+#include "nmea_kernel.hpp"
+namespace wibot::protocal::gnss {
+
+/**
+ * Lazy access to the fields of a sentence. The field offsets are indexed once by init, a field
+ * is only decoded when it is read, and the decoded value is kept for the next read. The view
+ * refers to the caller's sentence, which must stay valid and unchanged while the view is used.
+ * Field 0 is the "$xxxxx" address field. Decoding follows Sentence::scan, get_* return false
+ * if the field does not exist or is malformed.
+ */
+class NmeaSentenceView {
+   public:
+    NmeaSentenceView();
+
+    /**
+     * Index the fields of sentence, up to "*", the line end or length. The checksum is not
+     * verified, use Sentence::check first. Return false if sentence does not start with '$'.
+     */
+    bool        init(const char* sentence, uint32_t length);
+
+    uint32_t    field_count() const;
+    /**
+     * Return the start of a field and its length, nullptr if the field does not exist.
+     */
+    const char* field(uint32_t index, uint32_t* length) const;
+    /**
+     * Copy the 2 characters talker of the address field, return false if it is shorter.
+     */
+    bool        talker(char talker[3]) const;
+    /**
+     * Match the last 3 characters of the address field, e.g. "RMC".
+     */
+    bool        is_type(const char* type) const;
+
+    bool get_char(uint32_t index, char* value);
+    bool get_direction(uint32_t index, int* value);
+    bool get_int(uint32_t index, int* value);
+    bool get_float(uint32_t index, struct NmeaFloat* value);
+    /**
+     * Fractional field at index, signed by the direction field following it.
+     */
+    bool get_coord(uint32_t index, struct NmeaFloat* value);
+    bool get_time(uint32_t index, struct NmeaTime* value);
+    bool get_date(uint32_t index, struct NmeaDate* value);
+    /**
+     * Single hexadecimal digit, as the NMEA 4.10 signal ID.
+     */
+    bool get_hex(uint32_t index, int* value);
+
+   private:
+    union NmeaFieldValue {
+        char             c;
+        int              i;
+        struct NmeaFloat f;
+        struct NmeaTime  t;
+        struct NmeaDate  d;
+    };
+
+    const char*    _sentence;
+    NmeaFields     _fields;
+    /**
+     * Format character of the value cached for every field, 0 if not decoded yet.
+     */
+    char           _decoded[NMEA_FIELD_MAX_COUNT];
+    NmeaFieldValue _cache[NMEA_FIELD_MAX_COUNT];
+
+    /**
+     * Decode a field with decode into its cache slot, unless it holds the value of format.
+     */
+    template <typename T>
+    bool _get(uint32_t index, char format, T NmeaFieldValue::*member,
+              bool (*decode)(const char* field, uint32_t length, T* value), T* value);
+};
+
+/**
+ * Views of the standard sentences. Accessors are named after the fields of the matching
+ * NmeaSentenceData* struct and decode like the matching NmeaSentence* parser. init also checks
+ * the sentence type.
+ */
+class NmeaRmcView : public NmeaSentenceView {
+   public:
+    // $GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*62
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("RMC");
+    };
+    bool time(struct NmeaTime* value) { return get_time(1, value); };
+    bool valid(bool* value) {
+        char validity;
+        if (!get_char(2, &validity)) return false;
+        *value = (validity == 'A');
+        return true;
+    };
+    bool latitude(struct NmeaFloat* value) { return get_coord(3, value); };
+    bool longitude(struct NmeaFloat* value) { return get_coord(5, value); };
+    bool speed(struct NmeaFloat* value) { return get_float(7, value); };
+    bool course(struct NmeaFloat* value) { return get_float(8, value); };
+    bool date(struct NmeaDate* value) { return get_date(9, value); };
+    bool variation(struct NmeaFloat* value) { return get_coord(10, value); };
+};
+
+class NmeaGgaView : public NmeaSentenceView {
+   public:
+    // $GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("GGA");
+    };
+    bool time(struct NmeaTime* value) { return get_time(1, value); };
+    bool latitude(struct NmeaFloat* value) { return get_coord(2, value); };
+    bool longitude(struct NmeaFloat* value) { return get_coord(4, value); };
+    bool fix_quality(int* value) { return get_int(6, value); };
+    bool satellites_tracked(int* value) { return get_int(7, value); };
+    bool hdop(struct NmeaFloat* value) { return get_float(8, value); };
+    bool altitude(struct NmeaFloat* value) { return get_float(9, value); };
+    bool altitude_units(char* value) { return get_char(10, value); };
+    bool height(struct NmeaFloat* value) { return get_float(11, value); };
+    bool height_units(char* value) { return get_char(12, value); };
+    bool dgps_age(struct NmeaFloat* value) { return get_float(13, value); };
+};
+
+class NmeaGsaView : public NmeaSentenceView {
+   public:
+    // $GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("GSA");
+    };
+    bool mode(char* value) { return get_char(1, value); };
+    bool fix_type(int* value) { return get_int(2, value); };
+    /**
+     * PRN of channel 0 to 11.
+     */
+    bool sats(uint32_t channel, int* value) { return channel < 12 && get_int(3 + channel, value); };
+    bool pdop(struct NmeaFloat* value) { return get_float(15, value); };
+    bool hdop(struct NmeaFloat* value) { return get_float(16, value); };
+    bool vdop(struct NmeaFloat* value) { return get_float(17, value); };
+    bool system_id(int* value) {
+        *value = 0;
+        return field_count() <= 18 || get_int(18, value);
+    };
+};
+
+class NmeaGllView : public NmeaSentenceView {
+   public:
+    // $GPGLL,3723.2475,N,12158.3416,W,161229.487,A,A*41
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("GLL");
+    };
+    bool latitude(struct NmeaFloat* value) { return get_coord(1, value); };
+    bool longitude(struct NmeaFloat* value) { return get_coord(3, value); };
+    bool time(struct NmeaTime* value) { return get_time(5, value); };
+    bool status(char* value) { return get_char(6, value); };
+    bool mode(char* value) {
+        *value = '\0';
+        return field_count() <= 7 || get_char(7, value);
+    };
+};
+
+class NmeaGstView : public NmeaSentenceView {
+   public:
+    // $GPGST,024603.00,3.2,6.6,4.7,47.3,5.8,5.6,22.0*58
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("GST");
+    };
+    bool time(struct NmeaTime* value) { return get_time(1, value); };
+    bool rms_deviation(struct NmeaFloat* value) { return get_float(2, value); };
+    bool semi_major_deviation(struct NmeaFloat* value) { return get_float(3, value); };
+    bool semi_minor_deviation(struct NmeaFloat* value) { return get_float(4, value); };
+    bool semi_major_orientation(struct NmeaFloat* value) { return get_float(5, value); };
+    bool latitude_error_deviation(struct NmeaFloat* value) { return get_float(6, value); };
+    bool longitude_error_deviation(struct NmeaFloat* value) { return get_float(7, value); };
+    bool altitude_error_deviation(struct NmeaFloat* value) { return get_float(8, value); };
+};
+
+class NmeaVtgView : public NmeaSentenceView {
+   public:
+    // $GPVTG,096.5,T,083.5,M,0.0,N,0.0,K,D*22
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("VTG");
+    };
+    bool true_track_degrees(struct NmeaFloat* value) { return get_float(1, value); };
+    bool magnetic_track_degrees(struct NmeaFloat* value) { return get_float(3, value); };
+    bool speed_knots(struct NmeaFloat* value) { return get_float(5, value); };
+    bool speed_kph(struct NmeaFloat* value) { return get_float(7, value); };
+    bool faa_mode(enum NMEA_FAA_MODE* value) {
+        char mode = '\0';
+        if (field_count() > 9 && !get_char(9, &mode)) return false;
+        *value = (enum NMEA_FAA_MODE)mode;
+        return true;
+    };
+};
+
+class NmeaZdaView : public NmeaSentenceView {
+   public:
+    // $GPZDA,201530.00,04,07,2002,00,00*60
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("ZDA");
+    };
+    bool time(struct NmeaTime* value) { return get_time(1, value); };
+    bool date(struct NmeaDate* value) {
+        return get_int(2, &value->day) && get_int(3, &value->month) && get_int(4, &value->year);
+    };
+    bool hour_offset(int* value) { return get_int(5, value); };
+    bool minute_offset(int* value) { return get_int(6, value); };
+};
+
+class NmeaGsvView : public NmeaSentenceView {
+   public:
+    // $GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("GSV");
+    };
+    bool total_msgs(int* value) { return get_int(1, value); };
+    bool msg_nr(int* value) { return get_int(2, value); };
+    bool total_sats(int* value) { return get_int(3, value); };
+    /**
+     * Satellites listed by the fragment, 0 to 4.
+     */
+    uint32_t sat_count() const { return field_count() > 4 ? (field_count() - 4) / 4 : 0; };
+    /**
+     * Satellite 0 to 3 of the fragment, all 0 past sat_count.
+     */
+    bool sats(uint32_t index, struct NmeaSatInfo* value) {
+        *value = (struct NmeaSatInfo){0, 0, 0, 0};
+        if (index >= 4) return false;
+        if (index >= sat_count()) return true;
+        uint32_t first = 4 + 4 * index;
+        return get_int(first, &value->nr) && get_int(first + 1, &value->elevation) &&
+               get_int(first + 2, &value->azimuth) && get_int(first + 3, &value->snr);
+    };
+    bool signal_id(int* value) {
+        *value = 0;
+        if (field_count() <= 4 || (field_count() - 4) % 4 != 1) return true;
+        uint32_t length;
+        field(field_count() - 1, &length);
+        return length != 1 || get_hex(field_count() - 1, value);
+    };
+};
+
+class NmeaGnsView : public NmeaSentenceView {
+   public:
+    // $GNGNS,112257.00,3844.24011,N,00908.43828,W,AN,03,10.5,,*57
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("GNS");
+    };
+    bool time(struct NmeaTime* value) { return get_time(1, value); };
+    bool latitude(struct NmeaFloat* value) { return get_coord(2, value); };
+    bool longitude(struct NmeaFloat* value) { return get_coord(4, value); };
+    /**
+     * One FAA mode character per system, '\0' terminated.
+     */
+    bool mode(char (&value)[NMEA_GNS_MODE_SIZE]) {
+        uint32_t    length;
+        const char* data = field(6, &length);
+        return data != nullptr && length < NMEA_GNS_MODE_SIZE &&
+               Sentence::field_string(data, length, value);
+    };
+    bool satellites_used(int* value) { return get_int(7, value); };
+    bool hdop(struct NmeaFloat* value) { return get_float(8, value); };
+    bool altitude(struct NmeaFloat* value) { return get_float(9, value); };
+    bool height(struct NmeaFloat* value) { return get_float(10, value); };
+    bool dgps_age(struct NmeaFloat* value) {
+        *value = (struct NmeaFloat){0, 0};
+        return field_count() <= 11 || get_float(11, value);
+    };
+    bool station_id(int* value) {
+        *value = 0;
+        return field_count() <= 12 || get_int(12, value);
+    };
+    bool nav_status(char* value) {
+        *value = '\0';
+        return field_count() <= 13 || get_char(13, value);
+    };
+};
+
+class NmeaGbsView : public NmeaSentenceView {
+   public:
+    // $GPGBS,235458.00,1.4,1.3,3.1,03,,-21.4,3.8,1,0*5A
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("GBS");
+    };
+    bool time(struct NmeaTime* value) { return get_time(1, value); };
+    bool latitude_error(struct NmeaFloat* value) { return get_float(2, value); };
+    bool longitude_error(struct NmeaFloat* value) { return get_float(3, value); };
+    bool altitude_error(struct NmeaFloat* value) { return get_float(4, value); };
+    bool failed_sat(int* value) { return get_int(5, value); };
+    bool probability(struct NmeaFloat* value) { return get_float(6, value); };
+    bool bias(struct NmeaFloat* value) { return get_float(7, value); };
+    bool bias_deviation(struct NmeaFloat* value) { return get_float(8, value); };
+    bool system_id(int* value) {
+        *value = 0;
+        return field_count() <= 9 || get_int(9, value);
+    };
+    bool signal_id(int* value) {
+        *value = 0;
+        uint32_t length;
+        if (field(10, &length) == nullptr || length == 0) return true;
+        return get_hex(10, value);
+    };
+};
+
+class NmeaHdtView : public NmeaSentenceView {
+   public:
+    // $GPHDT,274.07,T*03
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("HDT");
+    };
+    bool heading(struct NmeaFloat* value) { return get_float(1, value); };
+};
+
+class NmeaThsView : public NmeaSentenceView {
+   public:
+    // $GPTHS,77.52,E*34
+    bool init(const char* sentence, uint32_t length) {
+        return NmeaSentenceView::init(sentence, length) && is_type("THS");
+    };
+    bool heading(struct NmeaFloat* value) { return get_float(1, value); };
+    bool mode(char* value) { return get_char(2, value); };
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NMEA_VIEW_HPP__
@@ -0,0 +1,182 @@
+#ifndef __WWTALK_GNSS_NOVATEL_HPP__
+#define __WWTALK_GNSS_NOVATEL_HPP__
+#include "base.hpp"
+#include "gnss_bytes.hpp"
+namespace wibot::protocal::gnss {
+
+#define NOVATEL_SYNC_CHAR_1 0xAA
+#define NOVATEL_SYNC_CHAR_2 0x44
+#define NOVATEL_SYNC_CHAR_3 0x12
+#define NOVATEL_HEADER_SIZE 28  // the long header, its length field may announce more.
+#define NOVATEL_CRC_SIZE 4
+
+#define NOVATEL_MESSAGE_BESTPOS 42
+#define NOVATEL_MESSAGE_RANGE 43
+#define NOVATEL_MESSAGE_BESTVEL 99
+#define NOVATEL_MESSAGE_HEADING 971
+
+#define NOVATEL_SOLUTION_COMPUTED 0   // solution status.
+#define NOVATEL_POSITION_NONE 0       // position or velocity type.
+#define NOVATEL_POSITION_SINGLE 16
+#define NOVATEL_POSITION_PSRDIFF 17
+#define NOVATEL_POSITION_WAAS 18
+#define NOVATEL_POSITION_L1_FLOAT 32
+#define NOVATEL_POSITION_NARROW_FLOAT 34
+#define NOVATEL_POSITION_L1_INT 48
+#define NOVATEL_POSITION_NARROW_INT 50
+
+#define NOVATEL_TIME_STATUS_UNKNOWN 20
+#define NOVATEL_TIME_STATUS_FINESTEERING 180
+
+/**
+ * CRC-32 of the OEM logs (reflected polynomial 0xEDB88320, no initial or final inversion) over
+ * data, continued from crc. Eight bytes are folded per step with eight tables (slice-by-8),
+ * the rest byte by byte.
+ */
+uint32_t novatel_crc32(const uint8_t* data, uint32_t length, uint32_t crc = 0);
+
+/**
+ * Same as novatel_crc32 one byte at a time, the reference of the sliced version.
+ */
+uint32_t novatel_crc32_bytewise(const uint8_t* data, uint32_t length, uint32_t crc = 0);
+
+/**
+ * The long header, from the sync chars. Times are GPS time.
+ */
+class NovatelHeaderView {
+   public:
+    explicit NovatelHeaderView(const uint8_t* header) : _p(header){};
+
+    uint8_t  headerLength() const { return gnss_u1(_p + 3); };
+    uint16_t messageId() const { return gnss_u2(_p + 4); };
+    uint8_t  messageType() const { return gnss_u1(_p + 6); };  // binary, response bit 7.
+    uint8_t  portAddress() const { return gnss_u1(_p + 7); };
+    uint16_t messageLength() const { return gnss_u2(_p + 8); };  // payload bytes.
+    uint16_t sequence() const { return gnss_u2(_p + 10); };
+    uint8_t  idleTime() const { return gnss_u1(_p + 12); };  // 0.5 %
+    uint8_t  timeStatus() const { return gnss_u1(_p + 13); };
+    uint16_t week() const { return gnss_u2(_p + 14); };
+    uint32_t ms() const { return gnss_u4(_p + 16); };  // ms of week.
+    uint32_t receiverStatus() const { return gnss_u4(_p + 20); };
+    uint16_t swVersion() const { return gnss_u2(_p + 26); };
+
+   private:
+    const uint8_t* _p;
+};
+
+/**
+ * Views of payloads, read in place whatever their alignment, as the UBX views. validate checks
+ * the payload length against the length the message declares. Units are the ones of the OEM
+ * reference manual.
+ */
+class NovatelBestposView {
+   public:
+    explicit NovatelBestposView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t       solutionStatus() const { return gnss_u4(_p + 0); };
+    uint32_t       positionType() const { return gnss_u4(_p + 4); };
+    double         lat() const { return gnss_r8(_p + 8); };  // deg
+    double         lon() const { return gnss_r8(_p + 16); };
+    double         height() const { return gnss_r8(_p + 24); };  // m above mean sea level.
+    float          undulation() const { return gnss_r4(_p + 32); };
+    uint32_t       datumId() const { return gnss_u4(_p + 36); };
+    float          latStdDev() const { return gnss_r4(_p + 40); };  // m
+    float          lonStdDev() const { return gnss_r4(_p + 44); };
+    float          heightStdDev() const { return gnss_r4(_p + 48); };
+    const uint8_t* stationId() const { return _p + 52; };  // 4 chars.
+    float          differentialAge() const { return gnss_r4(_p + 56); };  // s
+    float          solutionAge() const { return gnss_r4(_p + 60); };
+    uint8_t        numSV() const { return gnss_u1(_p + 64); };
+    uint8_t        numSolutionSV() const { return gnss_u1(_p + 65); };
+    uint8_t        numSolutionL1SV() const { return gnss_u1(_p + 66); };
+    uint8_t        numSolutionMultiSV() const { return gnss_u1(_p + 67); };
+    uint8_t        extendedStatus() const { return gnss_u1(_p + 69); };
+    uint8_t        galileoBeidouMask() const { return gnss_u1(_p + 70); };
+    uint8_t        gpsGlonassMask() const { return gnss_u1(_p + 71); };
+
+   private:
+    const uint8_t* _p;
+};
+
+class NovatelBestvelView {
+   public:
+    explicit NovatelBestvelView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t solutionStatus() const { return gnss_u4(_p + 0); };
+    uint32_t velocityType() const { return gnss_u4(_p + 4); };
+    float    latency() const { return gnss_r4(_p + 8); };  // s
+    float    age() const { return gnss_r4(_p + 12); };
+    double   horizontalSpeed() const { return gnss_r8(_p + 16); };  // m/s
+    double   trackOverGround() const { return gnss_r8(_p + 24); };  // deg from true north.
+    double   verticalSpeed() const { return gnss_r8(_p + 32); };    // m/s, up.
+
+   private:
+    const uint8_t* _p;
+};
+
+/**
+ * RANGE, 4 bytes then 44 per observation.
+ */
+class NovatelRangeView {
+   public:
+    explicit NovatelRangeView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t numObs() const { return gnss_u4(_p + 0); };
+
+    uint16_t prn(uint32_t i) const { return gnss_u2(_obs(i) + 0); };
+    uint16_t glonassFrequency(uint32_t i) const { return gnss_u2(_obs(i) + 2); };  // + 7.
+    double   psr(uint32_t i) const { return gnss_r8(_obs(i) + 4); };              // m
+    float    psrStdDev(uint32_t i) const { return gnss_r4(_obs(i) + 12); };
+    double   adr(uint32_t i) const { return gnss_r8(_obs(i) + 16); };  // cycles
+    float    adrStdDev(uint32_t i) const { return gnss_r4(_obs(i) + 24); };
+    float    doppler(uint32_t i) const { return gnss_r4(_obs(i) + 28); };   // Hz
+    float    cn0(uint32_t i) const { return gnss_r4(_obs(i) + 32); };       // dBHz
+    float    lockTime(uint32_t i) const { return gnss_r4(_obs(i) + 36); };  // s
+    uint32_t trackingStatus(uint32_t i) const { return gnss_u4(_obs(i) + 40); };
+
+   private:
+    const uint8_t* _p;
+
+    inline const uint8_t* _obs(uint32_t i) const {
+        return _p + 4 + 44 * i;
+    };
+};
+
+class NovatelHeadingView {
+   public:
+    explicit NovatelHeadingView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t       solutionStatus() const { return gnss_u4(_p + 0); };
+    uint32_t       positionType() const { return gnss_u4(_p + 4); };
+    float          baselineLength() const { return gnss_r4(_p + 8); };  // m
+    float          heading() const { return gnss_r4(_p + 12); };         // deg
+    float          pitch() const { return gnss_r4(_p + 16); };
+    float          headingStdDev() const { return gnss_r4(_p + 24); };
+    float          pitchStdDev() const { return gnss_r4(_p + 28); };
+    const uint8_t* stationId() const { return _p + 32; };  // 4 chars.
+    uint8_t        numSV() const { return gnss_u1(_p + 36); };
+    uint8_t        numSolutionSV() const { return gnss_u1(_p + 37); };
+    uint8_t        numObs() const { return gnss_u1(_p + 38); };
+    uint8_t        numMulti() const { return gnss_u1(_p + 39); };
+    uint8_t        solutionSource() const { return gnss_u1(_p + 40); };
+    uint8_t        extendedStatus() const { return gnss_u1(_p + 41); };
+    uint8_t        galileoBeidouMask() const { return gnss_u1(_p + 42); };
+    uint8_t        gpsGlonassMask() const { return gnss_u1(_p + 43); };
+
+   private:
+    const uint8_t* _p;
+};
+
+/**
+ * Check a complete log, including the sync chars, the header and message lengths and the CRC.
+ * @param payload Points after the header, whose length is read from the header.
+ */
+bool novatel_parse(uint8_t* msg, uint32_t length, uint16_t* messageId, void** payload);
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NOVATEL_HPP__
@@ -0,0 +1,117 @@
+#include "novatel_bench.hpp"
+#ifdef __linux__
+
+#include <chrono>
+
+#include "CircularBuffer.hpp"
+#include "log.h"
+#include "minunit.h"
+#include "novatel.hpp"
+#include "novatel_framer.hpp"
+#include "string.h"
+
+LOGGER("novatel_bench")
+
+namespace wibot::protocal::gnss::test {
+
+#define NOVATEL_BENCH_OBSERVATIONS 120  // 40 satellites on 3 bands.
+#define NOVATEL_BENCH_PAYLOAD_SIZE (4 + 44 * NOVATEL_BENCH_OBSERVATIONS)
+#define NOVATEL_BENCH_FRAME_SIZE \
+    (NOVATEL_HEADER_SIZE + NOVATEL_BENCH_PAYLOAD_SIZE + NOVATEL_CRC_SIZE)
+#define NOVATEL_BENCH_RING_SIZE 16384
+#define NOVATEL_BENCH_CHUNK_SIZE 1500  // a serial DMA or network read.
+#define NOVATEL_BENCH_FRAMES 10000
+#define NOVATEL_BENCH_RATE 20  // Hz
+
+static uint8_t benchRing[NOVATEL_BENCH_RING_SIZE];
+static uint8_t benchScratch[NOVATEL_BENCH_PAYLOAD_SIZE];
+static uint8_t benchFrame[NOVATEL_BENCH_FRAME_SIZE];
+
+static uint64_t novatel_bench_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+};
+
+static void novatel_bench_crc() {
+    volatile uint32_t sink = 0;
+    for (int sliced = 0; sliced < 2; sliced++) {
+        uint64_t start = novatel_bench_now();
+        for (uint32_t i = 0; i < NOVATEL_BENCH_FRAMES; i++) {
+            sink = sink + (sliced ? novatel_crc32(benchFrame, NOVATEL_BENCH_FRAME_SIZE)
+                                  : novatel_crc32_bytewise(benchFrame, NOVATEL_BENCH_FRAME_SIZE));
+        }
+        uint64_t elapsed = novatel_bench_now() - start;
+        if (elapsed == 0) elapsed = 1;
+        LOG_I("CRC-32 %s: %.1f MB/s", sliced ? "slice-by-8" : "bytewise",
+              (double)NOVATEL_BENCH_FRAMES * NOVATEL_BENCH_FRAME_SIZE * 1e3 / elapsed);
+    }
+};
+
+void novatel_bench() {
+    memset(benchFrame, 0, NOVATEL_HEADER_SIZE);
+    benchFrame[0] = NOVATEL_SYNC_CHAR_1;
+    benchFrame[1] = NOVATEL_SYNC_CHAR_2;
+    benchFrame[2] = NOVATEL_SYNC_CHAR_3;
+    benchFrame[3] = NOVATEL_HEADER_SIZE;
+    benchFrame[4] = NOVATEL_MESSAGE_RANGE;
+    benchFrame[8] = NOVATEL_BENCH_PAYLOAD_SIZE & 0xFF;
+    benchFrame[9] = NOVATEL_BENCH_PAYLOAD_SIZE >> 8;
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < NOVATEL_BENCH_PAYLOAD_SIZE; i++) {
+        seed                                = seed * 1103515245 + 12345;
+        benchFrame[NOVATEL_HEADER_SIZE + i] = seed >> 16;
+    }
+    memset(benchFrame + NOVATEL_HEADER_SIZE, 0, 4);
+    benchFrame[NOVATEL_HEADER_SIZE] = NOVATEL_BENCH_OBSERVATIONS;
+    uint32_t crc = novatel_crc32(benchFrame, NOVATEL_HEADER_SIZE + NOVATEL_BENCH_PAYLOAD_SIZE);
+    for (uint32_t i = 0; i < 4; i++) {
+        benchFrame[NOVATEL_BENCH_FRAME_SIZE - 4 + i] = crc >> (8 * i);
+    }
+
+    CircularBuffer8 rb(benchRing, NOVATEL_BENCH_RING_SIZE);
+    NovatelFramer   framer(rb, {.data = benchScratch, .size = NOVATEL_BENCH_PAYLOAD_SIZE});
+    NovatelFrame    frame;
+
+    volatile double sink   = 0;
+    uint64_t        total  = (uint64_t)NOVATEL_BENCH_FRAMES * NOVATEL_BENCH_FRAME_SIZE;
+    uint64_t        offset = 0;
+    uint32_t        frames = 0;
+    uint64_t        start  = novatel_bench_now();
+    while (offset < total) {
+        uint32_t chunk = NOVATEL_BENCH_CHUNK_SIZE;
+        if (offset + chunk > total) chunk = total - offset;
+        for (uint32_t written = 0; written < chunk;) {
+            uint32_t position = (offset + written) % NOVATEL_BENCH_FRAME_SIZE;
+            uint32_t length   = NOVATEL_BENCH_FRAME_SIZE - position;
+            if (length > chunk - written) length = chunk - written;
+            rb.write(benchFrame + position, length, false);
+            written += length;
+        }
+        offset += chunk;
+        while (framer.parse(&frame)) {
+            if (!NovatelRangeView::validate(frame.payload, frame.length)) continue;
+            NovatelRangeView range(frame.payload);
+            double           sum = 0;
+            for (uint32_t i = 0; i < range.numObs(); i++) {
+                sum += range.psr(i) + range.cn0(i);
+            }
+            sink = sink + sum;
+            frames++;
+        }
+    }
+    uint64_t elapsed = novatel_bench_now() - start;
+    if (elapsed == 0) elapsed = 1;
+
+    MU_ASSERT(frames == NOVATEL_BENCH_FRAMES && framer.checksumErrors == 0);
+    double perFrame = (double)elapsed / frames;
+    LOG_I("RANGE %u bytes: %.0f logs/s, %.1f MB/s, %.1f us/log, %.3f%% of a %u Hz epoch",
+          NOVATEL_BENCH_FRAME_SIZE, frames * 1e9 / elapsed, total * 1e3 / elapsed, perFrame / 1e3,
+          perFrame * NOVATEL_BENCH_RATE / 1e7, NOVATEL_BENCH_RATE);
+
+    novatel_bench_crc();
+};
+
+}  // namespace wibot::protocal::gnss::test
+
+#endif  // __linux__
@@ -0,0 +1,12 @@
+#ifndef __WWTALK_NOVATEL_BENCH_HPP__
+#define __WWTALK_NOVATEL_BENCH_HPP__
+
+namespace wibot::protocal::gnss::test {
+/**
+ * Throughput of the OEM framer on RANGE logs of a multi-band receiver, and of the sliced CRC-32
+ * against the bytewise one.
+ */
+void novatel_bench();
+}
+
+#endif  // __WWTALK_NOVATEL_BENCH_HPP__
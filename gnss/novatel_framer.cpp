@@ -0,0 +1,20 @@
+#include "novatel_framer.hpp"
+
+namespace wibot::protocal::gnss {
+
+bool NovatelFramerTraits::header(const uint8_t* header, uint32_t* headerLength,
+                                 uint32_t* length, NovatelFrame* frame) {
+    NovatelHeaderView view(header);
+    frame->messageId      = view.messageId();
+    frame->messageType    = view.messageType();
+    frame->timeStatus     = view.timeStatus();
+    frame->sequence       = view.sequence();
+    frame->week           = view.week();
+    frame->ms             = view.ms();
+    frame->receiverStatus = view.receiverStatus();
+    *headerLength         = header[3];
+    *length               = view.messageLength();
+    return *headerLength >= NOVATEL_HEADER_SIZE;
+};
+
+}  // namespace wibot::protocal::gnss
@@ -0,0 +1,75 @@
+#ifndef __WWTALK_GNSS_NOVATEL_FRAMER_HPP__
+#define __WWTALK_GNSS_NOVATEL_FRAMER_HPP__
+#include "gnss_framer.hpp"
+#include "novatel.hpp"
+namespace wibot::protocal::gnss {
+
+/**
+ * A validated log, the header fields decoded, with the lifetime of a UbxFrame.
+ */
+struct NovatelFrame {
+    uint16_t       messageId;
+    uint8_t        messageType;
+    uint8_t        timeStatus;
+    uint16_t       sequence;
+    uint16_t       week;
+    uint32_t       ms;  // ms of week.
+    uint32_t       receiverStatus;
+    uint16_t       length;
+    const uint8_t* payload;
+};
+
+/**
+ * The CRC-32 of a log as it arrives.
+ */
+struct NovatelCrc {
+    uint32_t crc;
+
+    inline void reset() {
+        crc = 0;
+    };
+    inline void update(uint8_t data) {
+        crc = novatel_crc32(&data, 1, crc);
+    };
+    inline void update(const uint8_t* data, uint32_t length) {
+        crc = novatel_crc32(data, length, crc);
+    };
+};
+
+/**
+ * The OEM binary log for GnssFramer: AA 44 12, the header, its length in its 4th byte, and the
+ * payload, the little-endian CRC-32 over the whole log. Headers longer than the long header
+ * are accepted, their extra bytes skipped, as some compatible receivers send.
+ */
+struct NovatelFramerTraits {
+    typedef NovatelFrame Frame;
+    typedef NovatelCrc   Checksum;
+
+    static constexpr uint32_t SYNC_SIZE   = 3;
+    static constexpr uint8_t  SYNC[]      = {NOVATEL_SYNC_CHAR_1, NOVATEL_SYNC_CHAR_2,
+                                             NOVATEL_SYNC_CHAR_3};
+    static constexpr uint8_t  SYNC_MASK[] = {0xFF, 0xFF, 0xFF};
+    static constexpr uint32_t HEADER_SIZE    = NOVATEL_HEADER_SIZE;
+    static constexpr uint32_t CHECKSUM_START = 0;
+    static constexpr uint32_t CHECKSUM_SIZE  = NOVATEL_CRC_SIZE;
+
+    static bool header(const uint8_t* header, uint32_t* headerLength, uint32_t* length,
+                       NovatelFrame* frame);
+    static inline bool check(const NovatelCrc& crc, const uint8_t* bytes) {
+        return crc.crc == gnss_u4(bytes);
+    };
+    static inline void complete(NovatelFrame*){};
+};
+
+/**
+ * Split the bytes of a ring into OEM binary logs, see GnssFramer. The header fields are
+ * decoded once the header is complete.
+ */
+class NovatelFramer : public GnssFramer<NovatelFramerTraits> {
+   public:
+    using GnssFramer::GnssFramer;
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_NOVATEL_FRAMER_HPP__
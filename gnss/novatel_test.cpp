@@ -0,0 +1,225 @@
+#include "novatel_test.hpp"
+
+#include "CircularBuffer.hpp"
+#include "minunit.h"
+#include "novatel.hpp"
+#include "novatel_framer.hpp"
+#include "string.h"
+
+namespace wibot::protocal::gnss::test {
+
+static void novatel_test_put(uint8_t* p, const void* value, uint32_t size) {
+    memcpy(p, value, size);  // the host is little-endian, as the logs.
+};
+
+static uint32_t novatel_test_frame(uint8_t* buffer, uint16_t messageId, uint32_t ms,
+                                   const uint8_t* payload, uint16_t length,
+                                   uint8_t headerLength = NOVATEL_HEADER_SIZE) {
+    memset(buffer, 0, headerLength);
+    buffer[0]       = NOVATEL_SYNC_CHAR_1;
+    buffer[1]       = NOVATEL_SYNC_CHAR_2;
+    buffer[2]       = NOVATEL_SYNC_CHAR_3;
+    buffer[3]       = headerLength;
+    uint16_t week   = 2345;
+    uint16_t seq    = 7;
+    uint32_t status = 0x02000020;
+    novatel_test_put(buffer + 4, &messageId, 2);
+    novatel_test_put(buffer + 8, &length, 2);
+    novatel_test_put(buffer + 10, &seq, 2);
+    buffer[13] = NOVATEL_TIME_STATUS_FINESTEERING;
+    novatel_test_put(buffer + 14, &week, 2);
+    novatel_test_put(buffer + 16, &ms, 4);
+    novatel_test_put(buffer + 20, &status, 4);
+    memcpy(buffer + headerLength, payload, length);
+    uint32_t crc = novatel_crc32(buffer, headerLength + length);
+    novatel_test_put(buffer + headerLength + length, &crc, 4);
+    return headerLength + length + NOVATEL_CRC_SIZE;
+};
+
+static void novatel_crc_test() {
+    MU_ASSERT(novatel_crc32((const uint8_t*)"123456789", 9) == 0x2DFD2D88);
+    MU_ASSERT(novatel_crc32_bytewise((const uint8_t*)"123456789", 9) == 0x2DFD2D88);
+
+    uint8_t  data[300];
+    uint32_t seed = 11;
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        seed    = seed * 1103515245 + 12345;
+        data[i] = seed >> 16;
+    }
+    // Any length, alignment and split give the CRC of the bytewise reference.
+    for (uint32_t length = 0; length + 3 < sizeof(data); length += 5) {
+        uint32_t crc = novatel_crc32_bytewise(data + 3, length);
+        MU_ASSERT(novatel_crc32(data + 3, length) == crc);
+        uint32_t split = length / 3;
+        MU_ASSERT(novatel_crc32(data + 3 + split, length - split,
+                                novatel_crc32(data + 3, split)) == crc);
+    }
+}
+
+static void novatel_parse_test() {
+    uint8_t payload[72];
+    uint8_t frame[128];
+    for (int i = 0; i < 72; i++) {
+        payload[i] = i * 3;
+    }
+    uint32_t length = novatel_test_frame(frame, NOVATEL_MESSAGE_BESTPOS, 1000, payload, 72);
+    MU_ASSERT(length == 104);
+
+    uint16_t messageId;
+    void*    data;
+    MU_ASSERT(novatel_parse(frame, length, &messageId, &data));
+    MU_ASSERT(messageId == NOVATEL_MESSAGE_BESTPOS && data == frame + NOVATEL_HEADER_SIZE);
+    MU_ASSERT(!novatel_parse(frame, length - 1, &messageId, &data));
+    frame[40] ^= 0x80;
+    MU_ASSERT(!novatel_parse(frame, length, &messageId, &data));
+
+    // A longer header, the payload follows it.
+    length = novatel_test_frame(frame, NOVATEL_MESSAGE_BESTVEL, 1000, payload, 44, 32);
+    MU_ASSERT(novatel_parse(frame, length, &messageId, &data) && data == frame + 32);
+    frame[3] = 20;
+    MU_ASSERT(!novatel_parse(frame, length, &messageId, &data));
+
+    NovatelHeaderView header(frame);
+    MU_ASSERT(header.messageId() == NOVATEL_MESSAGE_BESTVEL && header.messageLength() == 44);
+    MU_ASSERT(header.week() == 2345 && header.ms() == 1000 && header.sequence() == 7);
+    MU_ASSERT(header.timeStatus() == NOVATEL_TIME_STATUS_FINESTEERING);
+    MU_ASSERT(header.receiverStatus() == 0x02000020);
+}
+
+static void novatel_framer_test() {
+    uint8_t         ring[512];
+    uint8_t         scratch[256];
+    CircularBuffer8 rb(ring, sizeof(ring));
+    NovatelFramer   framer(rb, {.data = scratch, .size = sizeof(scratch)});
+    NovatelFrame    frame;
+
+    uint8_t payload[200];
+    uint8_t stream[1024];
+    for (int i = 0; i < 200; i++) {
+        payload[i] = i;
+    }
+    uint32_t length  = 0;
+    stream[length++] = NOVATEL_SYNC_CHAR_1;
+    stream[length++] = NOVATEL_SYNC_CHAR_2;  // a cut sync.
+    length += novatel_test_frame(stream + length, NOVATEL_MESSAGE_BESTPOS, 100, payload, 72);
+    length += novatel_test_frame(stream + length, NOVATEL_MESSAGE_RANGE, 200, payload, 136, 32);
+    uint32_t corrupted = length;
+    length += novatel_test_frame(stream + length, NOVATEL_MESSAGE_HEADING, 300, payload, 44);
+    stream[corrupted + 30] ^= 0x01;
+    length += novatel_test_frame(stream + length, NOVATEL_MESSAGE_BESTVEL, 400, payload, 44);
+
+    // Fed byte by byte, the header is decoded once complete and the CRC continued.
+    uint16_t ids[4];
+    uint32_t ms[4];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        rb.write(&stream[i], 1, true);
+        while (framer.parse(&frame)) {
+            MU_ASSERT(!memcmp(frame.payload, payload, frame.length));
+            MU_ASSERT(frame.week == 2345 && frame.sequence == 7);
+            if (count < 4) {
+                ids[count] = frame.messageId;
+                ms[count]  = frame.ms;
+            }
+            count++;
+        }
+    }
+    MU_ASSERT(count == 3 && framer.checksumErrors == 1);
+    MU_ASSERT(ids[0] == NOVATEL_MESSAGE_BESTPOS && ms[0] == 100);
+    MU_ASSERT(ids[1] == NOVATEL_MESSAGE_RANGE && ms[1] == 200);
+    MU_ASSERT(ids[2] == NOVATEL_MESSAGE_BESTVEL && ms[2] == 400);
+
+    // Headers shorter than the long header, and payloads beyond the payload buffer, are
+    // dropped as soon as their length is read.
+    length = novatel_test_frame(stream, NOVATEL_MESSAGE_BESTPOS, 500, payload, 72);
+    stream[3] = 12;
+    rb.write(stream, length, true);
+    uint8_t big[NOVATEL_HEADER_SIZE] = {NOVATEL_SYNC_CHAR_1, NOVATEL_SYNC_CHAR_2,
+                                        NOVATEL_SYNC_CHAR_3, NOVATEL_HEADER_SIZE};
+    big[9] = 0x10;
+    rb.write(big, sizeof(big), true);
+    length = novatel_test_frame(stream, NOVATEL_MESSAGE_BESTPOS, 600, payload, 72);
+    rb.write(stream, length, true);
+    MU_ASSERT(framer.parse(&frame) && frame.ms == 600);
+    MU_ASSERT(framer.lengthErrors == 2);
+
+    // Headers and payloads wrapping around the end of the ring are read from copies.
+    for (uint32_t i = 0; i < 12; i++) {
+        length = novatel_test_frame(stream, NOVATEL_MESSAGE_RANGE, 700 + i, payload, 136);
+        rb.write(stream, length, true);
+        MU_ASSERT(framer.parse(&frame) && frame.ms == 700 + i && frame.length == 136);
+        MU_ASSERT(!memcmp(frame.payload, payload, 136));
+    }
+    MU_ASSERT(!framer.parse(&frame) && rb.getSize() == 0);
+}
+
+static void novatel_view_test() {
+    uint8_t payload[4 + 44 * 3];
+    memset(payload, 0, sizeof(payload));
+
+    uint32_t u      = NOVATEL_POSITION_NARROW_INT;
+    double   lat    = 51.116377;
+    double   lon    = -114.038830;
+    float    stdDev = 0.0123f;
+    novatel_test_put(payload + 4, &u, 4);
+    novatel_test_put(payload + 8, &lat, 8);
+    novatel_test_put(payload + 16, &lon, 8);
+    novatel_test_put(payload + 44, &stdDev, 4);
+    memcpy(payload + 52, "AAAA", 4);
+    payload[64] = 30;
+    payload[65] = 27;
+    MU_ASSERT(NovatelBestposView::validate(payload, 72));
+    MU_ASSERT(!NovatelBestposView::validate(payload, 76));
+    NovatelBestposView bestpos(payload);
+    MU_ASSERT(bestpos.solutionStatus() == NOVATEL_SOLUTION_COMPUTED);
+    MU_ASSERT(bestpos.positionType() == NOVATEL_POSITION_NARROW_INT);
+    MU_ASSERT(bestpos.lat() == lat && bestpos.lon() == lon && bestpos.lonStdDev() == stdDev);
+    MU_ASSERT(!memcmp(bestpos.stationId(), "AAAA", 4));
+    MU_ASSERT(bestpos.numSV() == 30 && bestpos.numSolutionSV() == 27);
+
+    double speed = 12.5;
+    novatel_test_put(payload + 16, &speed, 8);
+    MU_ASSERT(NovatelBestvelView::validate(payload, 44));
+    MU_ASSERT(NovatelBestvelView(payload).horizontalSpeed() == 12.5);
+
+    float heading = 271.25f;
+    novatel_test_put(payload + 12, &heading, 4);
+    MU_ASSERT(NovatelHeadingView::validate(payload, 44));
+    MU_ASSERT(NovatelHeadingView(payload).heading() == heading);
+
+    // RANGE, at an odd address.
+    uint8_t  storage[1 + 4 + 44 * 3];
+    uint8_t* range = storage + 1;
+    memset(storage, 0, sizeof(storage));
+    u = 3;
+    novatel_test_put(range, &u, 4);
+    for (uint32_t i = 0; i < 3; i++) {
+        uint16_t prn = 5 + i;
+        double   psr = 21000000.0 + i;
+        float    cn0 = 40.0f + i;
+        novatel_test_put(range + 4 + 44 * i, &prn, 2);
+        novatel_test_put(range + 4 + 44 * i + 4, &psr, 8);
+        novatel_test_put(range + 4 + 44 * i + 32, &cn0, 4);
+    }
+    MU_ASSERT(NovatelRangeView::validate(range, 136));
+    MU_ASSERT(!NovatelRangeView::validate(range, 92));
+    NovatelRangeView view(range);
+    MU_ASSERT(view.numObs() == 3);
+    for (uint32_t i = 0; i < 3; i++) {
+        MU_ASSERT(view.prn(i) == 5 + i && view.psr(i) == 21000000.0 + i);
+        MU_ASSERT(view.cn0(i) == 40.0f + i);
+    }
+    // A count whose product wraps is rejected.
+    u = 0x40000003;
+    novatel_test_put(range, &u, 4);
+    MU_ASSERT(!NovatelRangeView::validate(range, 136));
+}
+
+void novatel_test() {
+    novatel_crc_test();
+    novatel_parse_test();
+    novatel_framer_test();
+    novatel_view_test();
+};
+
+}  // namespace wibot::protocal::gnss::test
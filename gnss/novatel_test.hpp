@@ -0,0 +1,8 @@
+#ifndef __WWTALK_NOVATEL_TEST_HPP__
+#define __WWTALK_NOVATEL_TEST_HPP__
+
+namespace wibot::protocal::gnss::test {
+void novatel_test();
+}
+
+#endif  // __WWTALK_NOVATEL_TEST_HPP__
@@ -0,0 +1,302 @@
+#include "rtcm.hpp"
+
+#include "string.h"
+
+namespace wibot::protocal::gnss {
+
+/**
+ * CRC-24Q (polynomial 0x1864CFB) tables, the CRC left aligned in 32 bits. Table k folds a byte
+ * followed by k zero bytes.
+ */
+static const uint32_t crc24qTable[4][256] = {
+    {
+        0x00000000, 0x864CFB00, 0x8AD50D00, 0x0C99F600, 0x93E6E100, 0x15AA1A00,
+        0x1933EC00, 0x9F7F1700, 0xA1813900, 0x27CDC200, 0x2B543400, 0xAD18CF00,
+        0x3267D800, 0xB42B2300, 0xB8B2D500, 0x3EFE2E00, 0xC54E8900, 0x43027200,
+        0x4F9B8400, 0xC9D77F00, 0x56A86800, 0xD0E49300, 0xDC7D6500, 0x5A319E00,
+        0x64CFB000, 0xE2834B00, 0xEE1ABD00, 0x68564600, 0xF7295100, 0x7165AA00,
+        0x7DFC5C00, 0xFBB0A700, 0x0CD1E900, 0x8A9D1200, 0x8604E400, 0x00481F00,
+        0x9F370800, 0x197BF300, 0x15E20500, 0x93AEFE00, 0xAD50D000, 0x2B1C2B00,
+        0x2785DD00, 0xA1C92600, 0x3EB63100, 0xB8FACA00, 0xB4633C00, 0x322FC700,
+        0xC99F6000, 0x4FD39B00, 0x434A6D00, 0xC5069600, 0x5A798100, 0xDC357A00,
+        0xD0AC8C00, 0x56E07700, 0x681E5900, 0xEE52A200, 0xE2CB5400, 0x6487AF00,
+        0xFBF8B800, 0x7DB44300, 0x712DB500, 0xF7614E00, 0x19A3D200, 0x9FEF2900,
+        0x9376DF00, 0x153A2400, 0x8A453300, 0x0C09C800, 0x00903E00, 0x86DCC500,
+        0xB822EB00, 0x3E6E1000, 0x32F7E600, 0xB4BB1D00, 0x2BC40A00, 0xAD88F100,
+        0xA1110700, 0x275DFC00, 0xDCED5B00, 0x5AA1A000, 0x56385600, 0xD074AD00,
+        0x4F0BBA00, 0xC9474100, 0xC5DEB700, 0x43924C00, 0x7D6C6200, 0xFB209900,
+        0xF7B96F00, 0x71F59400, 0xEE8A8300, 0x68C67800, 0x645F8E00, 0xE2137500,
+        0x15723B00, 0x933EC000, 0x9FA73600, 0x19EBCD00, 0x8694DA00, 0x00D82100,
+        0x0C41D700, 0x8A0D2C00, 0xB4F30200, 0x32BFF900, 0x3E260F00, 0xB86AF400,
+        0x2715E300, 0xA1591800, 0xADC0EE00, 0x2B8C1500, 0xD03CB200, 0x56704900,
+        0x5AE9BF00, 0xDCA54400, 0x43DA5300, 0xC596A800, 0xC90F5E00, 0x4F43A500,
+        0x71BD8B00, 0xF7F17000, 0xFB688600, 0x7D247D00, 0xE25B6A00, 0x64179100,
+        0x688E6700, 0xEEC29C00, 0x3347A400, 0xB50B5F00, 0xB992A900, 0x3FDE5200,
+        0xA0A14500, 0x26EDBE00, 0x2A744800, 0xAC38B300, 0x92C69D00, 0x148A6600,
+        0x18139000, 0x9E5F6B00, 0x01207C00, 0x876C8700, 0x8BF57100, 0x0DB98A00,
+        0xF6092D00, 0x7045D600, 0x7CDC2000, 0xFA90DB00, 0x65EFCC00, 0xE3A33700,
+        0xEF3AC100, 0x69763A00, 0x57881400, 0xD1C4EF00, 0xDD5D1900, 0x5B11E200,
+        0xC46EF500, 0x42220E00, 0x4EBBF800, 0xC8F70300, 0x3F964D00, 0xB9DAB600,
+        0xB5434000, 0x330FBB00, 0xAC70AC00, 0x2A3C5700, 0x26A5A100, 0xA0E95A00,
+        0x9E177400, 0x185B8F00, 0x14C27900, 0x928E8200, 0x0DF19500, 0x8BBD6E00,
+        0x87249800, 0x01686300, 0xFAD8C400, 0x7C943F00, 0x700DC900, 0xF6413200,
+        0x693E2500, 0xEF72DE00, 0xE3EB2800, 0x65A7D300, 0x5B59FD00, 0xDD150600,
+        0xD18CF000, 0x57C00B00, 0xC8BF1C00, 0x4EF3E700, 0x426A1100, 0xC426EA00,
+        0x2AE47600, 0xACA88D00, 0xA0317B00, 0x267D8000, 0xB9029700, 0x3F4E6C00,
+        0x33D79A00, 0xB59B6100, 0x8B654F00, 0x0D29B400, 0x01B04200, 0x87FCB900,
+        0x1883AE00, 0x9ECF5500, 0x9256A300, 0x141A5800, 0xEFAAFF00, 0x69E60400,
+        0x657FF200, 0xE3330900, 0x7C4C1E00, 0xFA00E500, 0xF6991300, 0x70D5E800,
+        0x4E2BC600, 0xC8673D00, 0xC4FECB00, 0x42B23000, 0xDDCD2700, 0x5B81DC00,
+        0x57182A00, 0xD154D100, 0x26359F00, 0xA0796400, 0xACE09200, 0x2AAC6900,
+        0xB5D37E00, 0x339F8500, 0x3F067300, 0xB94A8800, 0x87B4A600, 0x01F85D00,
+        0x0D61AB00, 0x8B2D5000, 0x14524700, 0x921EBC00, 0x9E874A00, 0x18CBB100,
+        0xE37B1600, 0x6537ED00, 0x69AE1B00, 0xEFE2E000, 0x709DF700, 0xF6D10C00,
+        0xFA48FA00, 0x7C040100, 0x42FA2F00, 0xC4B6D400, 0xC82F2200, 0x4E63D900,
+        0xD11CCE00, 0x57503500, 0x5BC9C300, 0xDD853800,
+    },
+    {
+        0x00000000, 0x668F4800, 0xCD1E9000, 0xAB91D800, 0x1C71DB00, 0x7AFE9300,
+        0xD16F4B00, 0xB7E00300, 0x38E3B600, 0x5E6CFE00, 0xF5FD2600, 0x93726E00,
+        0x24926D00, 0x421D2500, 0xE98CFD00, 0x8F03B500, 0x71C76C00, 0x17482400,
+        0xBCD9FC00, 0xDA56B400, 0x6DB6B700, 0x0B39FF00, 0xA0A82700, 0xC6276F00,
+        0x4924DA00, 0x2FAB9200, 0x843A4A00, 0xE2B50200, 0x55550100, 0x33DA4900,
+        0x984B9100, 0xFEC4D900, 0xE38ED800, 0x85019000, 0x2E904800, 0x481F0000,
+        0xFFFF0300, 0x99704B00, 0x32E19300, 0x546EDB00, 0xDB6D6E00, 0xBDE22600,
+        0x1673FE00, 0x70FCB600, 0xC71CB500, 0xA193FD00, 0x0A022500, 0x6C8D6D00,
+        0x9249B400, 0xF4C6FC00, 0x5F572400, 0x39D86C00, 0x8E386F00, 0xE8B72700,
+        0x4326FF00, 0x25A9B700, 0xAAAA0200, 0xCC254A00, 0x67B49200, 0x013BDA00,
+        0xB6DBD900, 0xD0549100, 0x7BC54900, 0x1D4A0100, 0x41514B00, 0x27DE0300,
+        0x8C4FDB00, 0xEAC09300, 0x5D209000, 0x3BAFD800, 0x903E0000, 0xF6B14800,
+        0x79B2FD00, 0x1F3DB500, 0xB4AC6D00, 0xD2232500, 0x65C32600, 0x034C6E00,
+        0xA8DDB600, 0xCE52FE00, 0x30962700, 0x56196F00, 0xFD88B700, 0x9B07FF00,
+        0x2CE7FC00, 0x4A68B400, 0xE1F96C00, 0x87762400, 0x08759100, 0x6EFAD900,
+        0xC56B0100, 0xA3E44900, 0x14044A00, 0x728B0200, 0xD91ADA00, 0xBF959200,
+        0xA2DF9300, 0xC450DB00, 0x6FC10300, 0x094E4B00, 0xBEAE4800, 0xD8210000,
+        0x73B0D800, 0x153F9000, 0x9A3C2500, 0xFCB36D00, 0x5722B500, 0x31ADFD00,
+        0x864DFE00, 0xE0C2B600, 0x4B536E00, 0x2DDC2600, 0xD318FF00, 0xB597B700,
+        0x1E066F00, 0x78892700, 0xCF692400, 0xA9E66C00, 0x0277B400, 0x64F8FC00,
+        0xEBFB4900, 0x8D740100, 0x26E5D900, 0x406A9100, 0xF78A9200, 0x9105DA00,
+        0x3A940200, 0x5C1B4A00, 0x82A29600, 0xE42DDE00, 0x4FBC0600, 0x29334E00,
+        0x9ED34D00, 0xF85C0500, 0x53CDDD00, 0x35429500, 0xBA412000, 0xDCCE6800,
+        0x775FB000, 0x11D0F800, 0xA630FB00, 0xC0BFB300, 0x6B2E6B00, 0x0DA12300,
+        0xF365FA00, 0x95EAB200, 0x3E7B6A00, 0x58F42200, 0xEF142100, 0x899B6900,
+        0x220AB100, 0x4485F900, 0xCB864C00, 0xAD090400, 0x0698DC00, 0x60179400,
+        0xD7F79700, 0xB178DF00, 0x1AE90700, 0x7C664F00, 0x612C4E00, 0x07A30600,
+        0xAC32DE00, 0xCABD9600, 0x7D5D9500, 0x1BD2DD00, 0xB0430500, 0xD6CC4D00,
+        0x59CFF800, 0x3F40B000, 0x94D16800, 0xF25E2000, 0x45BE2300, 0x23316B00,
+        0x88A0B300, 0xEE2FFB00, 0x10EB2200, 0x76646A00, 0xDDF5B200, 0xBB7AFA00,
+        0x0C9AF900, 0x6A15B100, 0xC1846900, 0xA70B2100, 0x28089400, 0x4E87DC00,
+        0xE5160400, 0x83994C00, 0x34794F00, 0x52F60700, 0xF967DF00, 0x9FE89700,
+        0xC3F3DD00, 0xA57C9500, 0x0EED4D00, 0x68620500, 0xDF820600, 0xB90D4E00,
+        0x129C9600, 0x7413DE00, 0xFB106B00, 0x9D9F2300, 0x360EFB00, 0x5081B300,
+        0xE761B000, 0x81EEF800, 0x2A7F2000, 0x4CF06800, 0xB234B100, 0xD4BBF900,
+        0x7F2A2100, 0x19A56900, 0xAE456A00, 0xC8CA2200, 0x635BFA00, 0x05D4B200,
+        0x8AD70700, 0xEC584F00, 0x47C99700, 0x2146DF00, 0x96A6DC00, 0xF0299400,
+        0x5BB84C00, 0x3D370400, 0x207D0500, 0x46F24D00, 0xED639500, 0x8BECDD00,
+        0x3C0CDE00, 0x5A839600, 0xF1124E00, 0x979D0600, 0x189EB300, 0x7E11FB00,
+        0xD5802300, 0xB30F6B00, 0x04EF6800, 0x62602000, 0xC9F1F800, 0xAF7EB000,
+        0x51BA6900, 0x37352100, 0x9CA4F900, 0xFA2BB100, 0x4DCBB200, 0x2B44FA00,
+        0x80D52200, 0xE65A6A00, 0x6959DF00, 0x0FD69700, 0xA4474F00, 0xC2C80700,
+        0x75280400, 0x13A74C00, 0xB8369400, 0xDEB9DC00,
+    },
+    {
+        0x00000000, 0x8309D700, 0x805F5500, 0x03568200, 0x86F25100, 0x05FB8600,
+        0x06AD0400, 0x85A4D300, 0x8BA85900, 0x08A18E00, 0x0BF70C00, 0x88FEDB00,
+        0x0D5A0800, 0x8E53DF00, 0x8D055D00, 0x0E0C8A00, 0x911C4900, 0x12159E00,
+        0x11431C00, 0x924ACB00, 0x17EE1800, 0x94E7CF00, 0x97B14D00, 0x14B89A00,
+        0x1AB41000, 0x99BDC700, 0x9AEB4500, 0x19E29200, 0x9C464100, 0x1F4F9600,
+        0x1C191400, 0x9F10C300, 0xA4746900, 0x277DBE00, 0x242B3C00, 0xA722EB00,
+        0x22863800, 0xA18FEF00, 0xA2D96D00, 0x21D0BA00, 0x2FDC3000, 0xACD5E700,
+        0xAF836500, 0x2C8AB200, 0xA92E6100, 0x2A27B600, 0x29713400, 0xAA78E300,
+        0x35682000, 0xB661F700, 0xB5377500, 0x363EA200, 0xB39A7100, 0x3093A600,
+        0x33C52400, 0xB0CCF300, 0xBEC07900, 0x3DC9AE00, 0x3E9F2C00, 0xBD96FB00,
+        0x38322800, 0xBB3BFF00, 0xB86D7D00, 0x3B64AA00, 0xCEA42900, 0x4DADFE00,
+        0x4EFB7C00, 0xCDF2AB00, 0x48567800, 0xCB5FAF00, 0xC8092D00, 0x4B00FA00,
+        0x450C7000, 0xC605A700, 0xC5532500, 0x465AF200, 0xC3FE2100, 0x40F7F600,
+        0x43A17400, 0xC0A8A300, 0x5FB86000, 0xDCB1B700, 0xDFE73500, 0x5CEEE200,
+        0xD94A3100, 0x5A43E600, 0x59156400, 0xDA1CB300, 0xD4103900, 0x5719EE00,
+        0x544F6C00, 0xD746BB00, 0x52E26800, 0xD1EBBF00, 0xD2BD3D00, 0x51B4EA00,
+        0x6AD04000, 0xE9D99700, 0xEA8F1500, 0x6986C200, 0xEC221100, 0x6F2BC600,
+        0x6C7D4400, 0xEF749300, 0xE1781900, 0x6271CE00, 0x61274C00, 0xE22E9B00,
+        0x678A4800, 0xE4839F00, 0xE7D51D00, 0x64DCCA00, 0xFBCC0900, 0x78C5DE00,
+        0x7B935C00, 0xF89A8B00, 0x7D3E5800, 0xFE378F00, 0xFD610D00, 0x7E68DA00,
+        0x70645000, 0xF36D8700, 0xF03B0500, 0x7332D200, 0xF6960100, 0x759FD600,
+        0x76C95400, 0xF5C08300, 0x1B04A900, 0x980D7E00, 0x9B5BFC00, 0x18522B00,
+        0x9DF6F800, 0x1EFF2F00, 0x1DA9AD00, 0x9EA07A00, 0x90ACF000, 0x13A52700,
+        0x10F3A500, 0x93FA7200, 0x165EA100, 0x95577600, 0x9601F400, 0x15082300,
+        0x8A18E000, 0x09113700, 0x0A47B500, 0x894E6200, 0x0CEAB100, 0x8FE36600,
+        0x8CB5E400, 0x0FBC3300, 0x01B0B900, 0x82B96E00, 0x81EFEC00, 0x02E63B00,
+        0x8742E800, 0x044B3F00, 0x071DBD00, 0x84146A00, 0xBF70C000, 0x3C791700,
+        0x3F2F9500, 0xBC264200, 0x39829100, 0xBA8B4600, 0xB9DDC400, 0x3AD41300,
+        0x34D89900, 0xB7D14E00, 0xB487CC00, 0x378E1B00, 0xB22AC800, 0x31231F00,
+        0x32759D00, 0xB17C4A00, 0x2E6C8900, 0xAD655E00, 0xAE33DC00, 0x2D3A0B00,
+        0xA89ED800, 0x2B970F00, 0x28C18D00, 0xABC85A00, 0xA5C4D000, 0x26CD0700,
+        0x259B8500, 0xA6925200, 0x23368100, 0xA03F5600, 0xA369D400, 0x20600300,
+        0xD5A08000, 0x56A95700, 0x55FFD500, 0xD6F60200, 0x5352D100, 0xD05B0600,
+        0xD30D8400, 0x50045300, 0x5E08D900, 0xDD010E00, 0xDE578C00, 0x5D5E5B00,
+        0xD8FA8800, 0x5BF35F00, 0x58A5DD00, 0xDBAC0A00, 0x44BCC900, 0xC7B51E00,
+        0xC4E39C00, 0x47EA4B00, 0xC24E9800, 0x41474F00, 0x4211CD00, 0xC1181A00,
+        0xCF149000, 0x4C1D4700, 0x4F4BC500, 0xCC421200, 0x49E6C100, 0xCAEF1600,
+        0xC9B99400, 0x4AB04300, 0x71D4E900, 0xF2DD3E00, 0xF18BBC00, 0x72826B00,
+        0xF726B800, 0x742F6F00, 0x7779ED00, 0xF4703A00, 0xFA7CB000, 0x79756700,
+        0x7A23E500, 0xF92A3200, 0x7C8EE100, 0xFF873600, 0xFCD1B400, 0x7FD86300,
+        0xE0C8A000, 0x63C17700, 0x6097F500, 0xE39E2200, 0x663AF100, 0xE5332600,
+        0xE665A400, 0x656C7300, 0x6B60F900, 0xE8692E00, 0xEB3FAC00, 0x68367B00,
+        0xED92A800, 0x6E9B7F00, 0x6DCDFD00, 0xEEC42A00,
+    },
+    {
+        0x00000000, 0x36095200, 0x6C12A400, 0x5A1BF600, 0xD8254800, 0xEE2C1A00,
+        0xB437EC00, 0x823EBE00, 0x36066B00, 0x000F3900, 0x5A14CF00, 0x6C1D9D00,
+        0xEE232300, 0xD82A7100, 0x82318700, 0xB438D500, 0x6C0CD600, 0x5A058400,
+        0x001E7200, 0x36172000, 0xB4299E00, 0x8220CC00, 0xD83B3A00, 0xEE326800,
+        0x5A0ABD00, 0x6C03EF00, 0x36181900, 0x00114B00, 0x822FF500, 0xB426A700,
+        0xEE3D5100, 0xD8340300, 0xD819AC00, 0xEE10FE00, 0xB40B0800, 0x82025A00,
+        0x003CE400, 0x3635B600, 0x6C2E4000, 0x5A271200, 0xEE1FC700, 0xD8169500,
+        0x820D6300, 0xB4043100, 0x363A8F00, 0x0033DD00, 0x5A282B00, 0x6C217900,
+        0xB4157A00, 0x821C2800, 0xD807DE00, 0xEE0E8C00, 0x6C303200, 0x5A396000,
+        0x00229600, 0x362BC400, 0x82131100, 0xB41A4300, 0xEE01B500, 0xD808E700,
+        0x5A365900, 0x6C3F0B00, 0x3624FD00, 0x002DAF00, 0x367FA300, 0x0076F100,
+        0x5A6D0700, 0x6C645500, 0xEE5AEB00, 0xD853B900, 0x82484F00, 0xB4411D00,
+        0x0079C800, 0x36709A00, 0x6C6B6C00, 0x5A623E00, 0xD85C8000, 0xEE55D200,
+        0xB44E2400, 0x82477600, 0x5A737500, 0x6C7A2700, 0x3661D100, 0x00688300,
+        0x82563D00, 0xB45F6F00, 0xEE449900, 0xD84DCB00, 0x6C751E00, 0x5A7C4C00,
+        0x0067BA00, 0x366EE800, 0xB4505600, 0x82590400, 0xD842F200, 0xEE4BA000,
+        0xEE660F00, 0xD86F5D00, 0x8274AB00, 0xB47DF900, 0x36434700, 0x004A1500,
+        0x5A51E300, 0x6C58B100, 0xD8606400, 0xEE693600, 0xB472C000, 0x827B9200,
+        0x00452C00, 0x364C7E00, 0x6C578800, 0x5A5EDA00, 0x826AD900, 0xB4638B00,
+        0xEE787D00, 0xD8712F00, 0x5A4F9100, 0x6C46C300, 0x365D3500, 0x00546700,
+        0xB46CB200, 0x8265E000, 0xD87E1600, 0xEE774400, 0x6C49FA00, 0x5A40A800,
+        0x005B5E00, 0x36520C00, 0x6CFF4600, 0x5AF61400, 0x00EDE200, 0x36E4B000,
+        0xB4DA0E00, 0x82D35C00, 0xD8C8AA00, 0xEEC1F800, 0x5AF92D00, 0x6CF07F00,
+        0x36EB8900, 0x00E2DB00, 0x82DC6500, 0xB4D53700, 0xEECEC100, 0xD8C79300,
+        0x00F39000, 0x36FAC200, 0x6CE13400, 0x5AE86600, 0xD8D6D800, 0xEEDF8A00,
+        0xB4C47C00, 0x82CD2E00, 0x36F5FB00, 0x00FCA900, 0x5AE75F00, 0x6CEE0D00,
+        0xEED0B300, 0xD8D9E100, 0x82C21700, 0xB4CB4500, 0xB4E6EA00, 0x82EFB800,
+        0xD8F44E00, 0xEEFD1C00, 0x6CC3A200, 0x5ACAF000, 0x00D10600, 0x36D85400,
+        0x82E08100, 0xB4E9D300, 0xEEF22500, 0xD8FB7700, 0x5AC5C900, 0x6CCC9B00,
+        0x36D76D00, 0x00DE3F00, 0xD8EA3C00, 0xEEE36E00, 0xB4F89800, 0x82F1CA00,
+        0x00CF7400, 0x36C62600, 0x6CDDD000, 0x5AD48200, 0xEEEC5700, 0xD8E50500,
+        0x82FEF300, 0xB4F7A100, 0x36C91F00, 0x00C04D00, 0x5ADBBB00, 0x6CD2E900,
+        0x5A80E500, 0x6C89B700, 0x36924100, 0x009B1300, 0x82A5AD00, 0xB4ACFF00,
+        0xEEB70900, 0xD8BE5B00, 0x6C868E00, 0x5A8FDC00, 0x00942A00, 0x369D7800,
+        0xB4A3C600, 0x82AA9400, 0xD8B16200, 0xEEB83000, 0x368C3300, 0x00856100,
+        0x5A9E9700, 0x6C97C500, 0xEEA97B00, 0xD8A02900, 0x82BBDF00, 0xB4B28D00,
+        0x008A5800, 0x36830A00, 0x6C98FC00, 0x5A91AE00, 0xD8AF1000, 0xEEA64200,
+        0xB4BDB400, 0x82B4E600, 0x82994900, 0xB4901B00, 0xEE8BED00, 0xD882BF00,
+        0x5ABC0100, 0x6CB55300, 0x36AEA500, 0x00A7F700, 0xB49F2200, 0x82967000,
+        0xD88D8600, 0xEE84D400, 0x6CBA6A00, 0x5AB33800, 0x00A8CE00, 0x36A19C00,
+        0xEE959F00, 0xD89CCD00, 0x82873B00, 0xB48E6900, 0x36B0D700, 0x00B98500,
+        0x5AA27300, 0x6CAB2100, 0xD893F400, 0xEE9AA600, 0xB4815000, 0x82880200,
+        0x00B6BC00, 0x36BFEE00, 0x6CA41800, 0x5AAD4A00,
+    },
+};
+
+uint32_t rtcm_crc24q_bytewise(const uint8_t* data, uint32_t length, uint32_t crc) {
+    uint32_t r = crc << 8;
+    for (uint32_t i = 0; i < length; i++) {
+        r = (r << 8) ^ crc24qTable[0][(r >> 24) ^ data[i]];
+    }
+    return r >> 8;
+};
+
+uint32_t rtcm_crc24q(const uint8_t* data, uint32_t length, uint32_t crc) {
+    uint32_t r = crc << 8;
+    uint32_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        uint32_t x = r ^ ((uint32_t)data[i] << 24 | (uint32_t)data[i + 1] << 16 |
+                          (uint32_t)data[i + 2] << 8 | data[i + 3]);
+        r          = crc24qTable[3][x >> 24] ^ crc24qTable[2][(x >> 16) & 0xFF] ^
+            crc24qTable[1][(x >> 8) & 0xFF] ^ crc24qTable[0][x & 0xFF];
+    }
+    for (; i < length; i++) {
+        r = (r << 8) ^ crc24qTable[0][(r >> 24) ^ data[i]];
+    }
+    return r >> 8;
+};
+
+RtcmBitReader::RtcmBitReader(const uint8_t* data, uint32_t length)
+    : overrun(false), _data(data), _length(length), _next(0), _cache(0), _cached(0){};
+
+void RtcmBitReader::_refill_tail(uint32_t bits) {
+    while (_cached <= 56 && _next < _length) {
+        _cache |= (uint64_t)_data[_next++] << (56 - _cached);
+        _cached += 8;
+    }
+    if (_cached < bits) {
+        // Past the end, the cache holds zeros.
+        overrun = true;
+        _next += (bits - _cached + 7) / 8;
+        _cached += (bits - _cached + 7) / 8 * 8;
+    }
+};
+
+int64_t RtcmBitReader::s64(uint32_t bits) {
+    uint64_t high  = u(bits - 32);
+    uint64_t value = high << 32 | u(32);
+    return (int64_t)(value << (64 - bits)) >> (64 - bits);
+};
+
+void RtcmBitReader::skip(uint32_t bits) {
+    while (bits > 32) {
+        u(32);
+        bits -= 32;
+    }
+    if (bits > 0) u(bits);
+};
+
+RtcmBitWriter::RtcmBitWriter(uint8_t* data, uint32_t size)
+    : overflow(false), _data(data), _size(size), _position(0){};
+
+void RtcmBitWriter::put(uint64_t value, uint32_t bits) {
+    if (_position + bits > _size * 8) {
+        overflow = true;
+        return;
+    }
+    for (uint32_t i = 0; i < bits; i++) {
+        // A byte is cleared when its first bit is written, the last one is zero padded.
+        uint8_t* byte = &_data[_position / 8];
+        if (_position % 8 == 0) *byte = 0;
+        *byte |= ((value >> (bits - 1 - i)) & 1) << (7 - _position % 8);
+        _position++;
+    }
+};
+
+bool rtcm_parse(uint8_t* msg, uint32_t length, uint16_t* type, void** payload) {
+    if (length < RTCM3_FRAME_OVERHEAD + 2) {
+        return false;
+    }
+    if (msg[0] != RTCM3_PREAMBLE || (msg[1] & 0xFC) != 0) {
+        return false;
+    }
+    uint32_t payloadLength = ((msg[1] & 0x03) << 8) | msg[2];
+    if (payloadLength + RTCM3_FRAME_OVERHEAD != length) {
+        return false;
+    }
+    uint8_t* end = msg + length - RTCM3_CRC_SIZE;
+    uint32_t crc = (uint32_t)end[0] << 16 | (uint32_t)end[1] << 8 | end[2];
+    if (rtcm_crc24q(msg, length - RTCM3_CRC_SIZE) != crc) {
+        return false;
+    }
+    *type    = (msg[RTCM3_HEADER_SIZE] << 4) | (msg[RTCM3_HEADER_SIZE + 1] >> 4);
+    *payload = msg + RTCM3_HEADER_SIZE;
+    return true;
+};
+
+uint32_t rtcm_encode(uint8_t* buffer, uint32_t size, const uint8_t* payload, uint16_t length) {
+    if (length > RTCM3_PAYLOAD_MAX_SIZE || size < (uint32_t)length + RTCM3_FRAME_OVERHEAD) {
+        return 0;
+    }
+    buffer[0] = RTCM3_PREAMBLE;
+    buffer[1] = length >> 8;
+    buffer[2] = length & 0xFF;
+    if (payload != buffer + RTCM3_HEADER_SIZE) {
+        memmove(buffer + RTCM3_HEADER_SIZE, payload, length);
+    }
+    uint32_t crc = rtcm_crc24q(buffer, RTCM3_HEADER_SIZE + length);
+    buffer[RTCM3_HEADER_SIZE + length]     = crc >> 16;
+    buffer[RTCM3_HEADER_SIZE + length + 1] = crc >> 8;
+    buffer[RTCM3_HEADER_SIZE + length + 2] = crc;
+    return length + RTCM3_FRAME_OVERHEAD;
+};
+
+}  // namespace wibot::protocal::gnss
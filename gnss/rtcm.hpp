@@ -0,0 +1,147 @@
+#ifndef __WWTALK_GNSS_RTCM_HPP__
+#define __WWTALK_GNSS_RTCM_HPP__
+#include "base.hpp"
+namespace wibot::protocal::gnss {
+
+#define RTCM3_PREAMBLE 0xD3
+#define RTCM3_HEADER_SIZE 3  // preamble, 6 reserved bits and 10 bits of length.
+#define RTCM3_CRC_SIZE 3
+#define RTCM3_FRAME_OVERHEAD 6
+#define RTCM3_PAYLOAD_MAX_SIZE 1023
+
+/**
+ * CRC-24Q over data, continued from crc. Four bytes are folded per step with four tables
+ * (slice-by-4), the rest byte by byte.
+ */
+uint32_t rtcm_crc24q(const uint8_t* data, uint32_t length, uint32_t crc = 0);
+
+/**
+ * Same as rtcm_crc24q one byte at a time, the reference of the sliced version.
+ */
+uint32_t rtcm_crc24q_bytewise(const uint8_t* data, uint32_t length, uint32_t crc = 0);
+
+/**
+ * Read the big-endian bit fields of a payload, MSB first. Bits are served from a 64-bit cache
+ * refilled 8 bytes at a time, so any field costs a shift and a mask whatever its alignment.
+ * Reading past the end gives zero bits and sets overrun.
+ */
+class RtcmBitReader {
+   public:
+    RtcmBitReader(const uint8_t* data, uint32_t length);
+
+    /**
+     * Unsigned field of 1 to 32 bits.
+     */
+    inline uint32_t u(uint32_t bits) {
+        if (_cached < bits) _refill(bits);
+        uint32_t value = (uint32_t)(_cache >> (64 - bits));
+        _cache <<= bits;
+        _cached -= bits;
+        return value;
+    };
+
+    /**
+     * Two's complement field of 1 to 32 bits.
+     */
+    inline int32_t s(uint32_t bits) {
+        uint32_t value = u(bits);
+        return (int32_t)(value << (32 - bits)) >> (32 - bits);
+    };
+
+    /**
+     * Two's complement field of 33 to 64 bits, e.g. the 38 bits of an ECEF coordinate.
+     */
+    int64_t s64(uint32_t bits);
+
+    /**
+     * Sign-magnitude field of 2 to 32 bits, as GLONASS data.
+     */
+    inline int32_t sm(uint32_t bits) {
+        uint32_t value     = u(bits);
+        int32_t  magnitude = value & ((1U << (bits - 1)) - 1);
+        return value >> (bits - 1) ? -magnitude : magnitude;
+    };
+
+    void skip(uint32_t bits);
+
+    /**
+     * Bits read so far.
+     */
+    inline uint32_t position() const {
+        return _next * 8 - _cached;
+    };
+
+    bool overrun;
+
+   private:
+    const uint8_t* _data;
+    uint32_t       _length;
+    uint32_t       _next;    // next byte to load into the cache.
+    uint64_t       _cache;   // left aligned.
+    uint32_t       _cached;  // valid bits of the cache, beyond the end included.
+
+    static inline uint64_t _load(const uint8_t* p) {
+        return (uint64_t)p[0] << 56 | (uint64_t)p[1] << 48 | (uint64_t)p[2] << 40 |
+               (uint64_t)p[3] << 32 | (uint64_t)p[4] << 24 | (uint64_t)p[5] << 16 |
+               (uint64_t)p[6] << 8 | p[7];
+    };
+
+    inline void _refill(uint32_t bits) {
+        if (_next + 8 > _length) {
+            _refill_tail(bits);
+            return;
+        }
+        // Load 8 bytes at once and keep the whole bytes that fit. The bits of the partial byte
+        // below them are the same that the next load ORs in, so they are left in place.
+        uint32_t bytes = (63 - _cached) / 8;
+        _cache |= _load(_data + _next) >> _cached;
+        _next += bytes;
+        _cached += bytes * 8;
+    };
+    void _refill_tail(uint32_t bits);  // the last 7 bytes, and beyond.
+};
+
+/**
+ * Write big-endian bit fields, the counterpart of RtcmBitReader.
+ */
+class RtcmBitWriter {
+   public:
+    RtcmBitWriter(uint8_t* data, uint32_t size);
+
+    /**
+     * Write the low bits of value, 1 to 64 bits. Signed values are written in two's complement
+     * by passing them cast to uint64_t.
+     */
+    void put(uint64_t value, uint32_t bits);
+
+    /**
+     * @return Return the bytes written, the last one zero padded.
+     */
+    inline uint32_t length() const {
+        return (_position + 7) / 8;
+    };
+
+    bool overflow;
+
+   private:
+    uint8_t* _data;
+    uint32_t _size;
+    uint32_t _position;  // bits written.
+};
+
+/**
+ * Check a complete frame, including the preamble, the reserved bits, the length field and the
+ * CRC.
+ * @param type Message number, the first 12 bits of the payload.
+ */
+bool rtcm_parse(uint8_t* msg, uint32_t length, uint16_t* type, void** payload);
+
+/**
+ * Write a frame around payload, which may already be in place at buffer + RTCM3_HEADER_SIZE.
+ * @return Return the frame length, 0 if the buffer is too small or the payload too long.
+ */
+uint32_t rtcm_encode(uint8_t* buffer, uint32_t size, const uint8_t* payload, uint16_t length);
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_RTCM_HPP__
@@ -0,0 +1,136 @@
+#include "rtcm_bench.hpp"
+#ifdef __linux__
+
+#include <chrono>
+
+#include "CircularBuffer.hpp"
+#include "log.h"
+#include "minunit.h"
+#include "rtcm.hpp"
+#include "rtcm_framer.hpp"
+#include "rtcm_message.hpp"
+
+LOGGER("rtcm_bench")
+
+namespace wibot::protocal::gnss::test {
+
+#define RTCM_BENCH_SATELLITES 16
+#define RTCM_BENCH_SIGNALS 4  // 64 cells, a full MSM7.
+#define RTCM_BENCH_RING_SIZE 16384
+#define RTCM_BENCH_CHUNK_SIZE 1500  // a serial DMA or network read.
+#define RTCM_BENCH_FRAMES 20000
+#define RTCM_BENCH_CRC_ROUNDS 20000
+
+static uint8_t             benchRing[RTCM_BENCH_RING_SIZE];
+static uint8_t             benchScratch[RTCM3_PAYLOAD_MAX_SIZE];
+static uint8_t             benchFrame[RTCM3_PAYLOAD_MAX_SIZE + RTCM3_FRAME_OVERHEAD];
+static struct RtcmMsmEpoch benchEpoch;
+
+static uint64_t rtcm_bench_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+};
+
+/**
+ * A GPS MSM7 with every satellite observed on every signal, random observations.
+ * @return Return the frame length.
+ */
+static uint32_t rtcm_bench_frame() {
+    uint8_t*      payload = benchFrame + RTCM3_HEADER_SIZE;
+    RtcmBitWriter w(payload, RTCM3_PAYLOAD_MAX_SIZE);
+    w.put(1077, 12);
+    w.put(2003, 12);
+    w.put(345600000, 30);
+    w.put(0, 19);  // multiple message to smoothing interval.
+    w.put(0xFFFF000000000000ULL, 64);
+    w.put(0x61010000, 32);  // 1C, 2W, 2L and 5Q.
+    w.put(~0ULL, RTCM_BENCH_SATELLITES * RTCM_BENCH_SIGNALS);
+
+    uint32_t seed = 1;
+    for (uint32_t s = 0; s < RTCM_BENCH_SATELLITES; s++) w.put(64 + s, 8);
+    for (uint32_t s = 0; s < RTCM_BENCH_SATELLITES; s++) w.put(0, 4);
+    for (uint32_t s = 0; s < RTCM_BENCH_SATELLITES; s++) w.put(s * 60, 10);
+    for (uint32_t s = 0; s < RTCM_BENCH_SATELLITES; s++) w.put(s * 100, 14);
+    const uint32_t fields[] = {20, 24, 10, 1, 10, 15};
+    for (uint32_t f = 0; f < 6; f++) {
+        for (uint32_t k = 0; k < RTCM_BENCH_SATELLITES * RTCM_BENCH_SIGNALS; k++) {
+            seed = seed * 1103515245 + 12345;
+            w.put(seed >> 8, fields[f]);
+        }
+    }
+    return rtcm_encode(benchFrame, sizeof(benchFrame), payload, w.length());
+};
+
+static void rtcm_bench_crc(uint32_t length) {
+    volatile uint32_t sink = 0;
+    for (int sliced = 0; sliced < 2; sliced++) {
+        uint64_t start = rtcm_bench_now();
+        for (uint32_t i = 0; i < RTCM_BENCH_CRC_ROUNDS; i++) {
+            sink = sink + (sliced ? rtcm_crc24q(benchFrame, length)
+                                  : rtcm_crc24q_bytewise(benchFrame, length));
+        }
+        uint64_t elapsed = rtcm_bench_now() - start;
+        if (elapsed == 0) elapsed = 1;
+        LOG_I("CRC-24Q %s: %.1f MB/s", sliced ? "slice-by-4" : "bytewise",
+              (double)RTCM_BENCH_CRC_ROUNDS * length * 1e3 / elapsed);
+    }
+};
+
+static void rtcm_bench_msm(uint32_t length) {
+    volatile uint32_t sink  = 0;
+    uint64_t          start = rtcm_bench_now();
+    for (uint32_t i = 0; i < RTCM_BENCH_FRAMES; i++) {
+        benchEpoch.decode(benchFrame + RTCM3_HEADER_SIZE, length - RTCM3_FRAME_OVERHEAD);
+        sink = sink + benchEpoch.count;
+    }
+    uint64_t elapsed = rtcm_bench_now() - start;
+    if (elapsed == 0) elapsed = 1;
+
+    MU_ASSERT(sink == (uint32_t)RTCM_BENCH_FRAMES * RTCM_BENCH_SATELLITES * RTCM_BENCH_SIGNALS);
+    LOG_I("MSM7 decode: %.0f epochs/s, %.2f ns/cell", RTCM_BENCH_FRAMES * 1e9 / elapsed,
+          (double)elapsed /
+              ((double)RTCM_BENCH_FRAMES * RTCM_BENCH_SATELLITES * RTCM_BENCH_SIGNALS));
+};
+
+void rtcm_bench() {
+    uint32_t frameSize = rtcm_bench_frame();
+    MU_ASSERT(frameSize > 0);
+
+    CircularBuffer8 rb(benchRing, RTCM_BENCH_RING_SIZE);
+    RtcmFramer      framer(rb, {.data = benchScratch, .size = sizeof(benchScratch)});
+    RtcmFrame       frame;
+
+    uint64_t total  = (uint64_t)RTCM_BENCH_FRAMES * frameSize;
+    uint64_t offset = 0;
+    uint32_t frames = 0;
+    uint64_t start  = rtcm_bench_now();
+    while (offset < total) {
+        uint32_t chunk = RTCM_BENCH_CHUNK_SIZE;
+        if (offset + chunk > total) chunk = total - offset;
+        for (uint32_t written = 0; written < chunk;) {
+            uint32_t position = (offset + written) % frameSize;
+            uint32_t length   = frameSize - position;
+            if (length > chunk - written) length = chunk - written;
+            rb.write(benchFrame + position, length, false);
+            written += length;
+        }
+        offset += chunk;
+        while (framer.parse(&frame)) {
+            frames++;
+        }
+    }
+    uint64_t elapsed = rtcm_bench_now() - start;
+    if (elapsed == 0) elapsed = 1;
+
+    MU_ASSERT(frames == RTCM_BENCH_FRAMES && framer.checksumErrors == 0);
+    LOG_I("MSM7 %u bytes: %.0f frames/s, %.1f MB/s, %.2f ns/byte", frameSize,
+          frames * 1e9 / elapsed, total * 1e3 / elapsed, (double)elapsed / total);
+
+    rtcm_bench_msm(frameSize);
+    rtcm_bench_crc(frameSize);
+};
+
+}  // namespace wibot::protocal::gnss::test
+
+#endif  // __linux__
@@ -0,0 +1,12 @@
+#ifndef __WWTALK_RTCM_BENCH_HPP__
+#define __WWTALK_RTCM_BENCH_HPP__
+
+namespace wibot::protocal::gnss::test {
+/**
+ * Throughput of the RTCM framer on a correction stream of MSM7 frames, of their decoding into
+ * columns, and of the sliced CRC-24Q against the bytewise one.
+ */
+void rtcm_bench();
+}
+
+#endif  // __WWTALK_RTCM_BENCH_HPP__
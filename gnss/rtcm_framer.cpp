@@ -0,0 +1,10 @@
+#include "rtcm_framer.hpp"
+
+namespace wibot::protocal::gnss {
+
+void RtcmFramerTraits::complete(RtcmFrame* frame) {
+    frame->type =
+        frame->length >= 2 ? (frame->payload[0] << 4) | (frame->payload[1] >> 4) : 0;
+};
+
+}  // namespace wibot::protocal::gnss
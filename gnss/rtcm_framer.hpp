@@ -0,0 +1,71 @@
+#ifndef __WWTALK_GNSS_RTCM_FRAMER_HPP__
+#define __WWTALK_GNSS_RTCM_FRAMER_HPP__
+#include "gnss_framer.hpp"
+#include "rtcm.hpp"
+namespace wibot::protocal::gnss {
+
+/**
+ * A validated frame, with the lifetime of a UbxFrame.
+ */
+struct RtcmFrame {
+    uint16_t       type;
+    uint16_t       length;
+    const uint8_t* payload;
+};
+
+/**
+ * The CRC-24Q of a frame as it arrives.
+ */
+struct RtcmCrc {
+    uint32_t crc;
+
+    inline void reset() {
+        crc = 0;
+    };
+    inline void update(uint8_t data) {
+        crc = rtcm_crc24q(&data, 1, crc);
+    };
+    inline void update(const uint8_t* data, uint32_t length) {
+        crc = rtcm_crc24q(data, length, crc);
+    };
+};
+
+/**
+ * The RTCM 3 frame for GnssFramer: D3, 6 zero bits, 10 bits of length and the payload, the
+ * big-endian CRC-24Q over the whole frame.
+ */
+struct RtcmFramerTraits {
+    typedef RtcmFrame Frame;
+    typedef RtcmCrc   Checksum;
+
+    static constexpr uint32_t SYNC_SIZE      = 2;
+    static constexpr uint8_t  SYNC[]         = {RTCM3_PREAMBLE, 0x00};
+    static constexpr uint8_t  SYNC_MASK[]    = {0xFF, 0xFC};
+    static constexpr uint32_t HEADER_SIZE    = RTCM3_HEADER_SIZE;
+    static constexpr uint32_t CHECKSUM_START = 0;
+    static constexpr uint32_t CHECKSUM_SIZE  = 3;
+
+    static inline bool header(const uint8_t* header, uint32_t* headerLength, uint32_t* length,
+                              RtcmFrame*) {
+        *headerLength = RTCM3_HEADER_SIZE;
+        *length       = ((header[1] & 0x03) << 8) | header[2];
+        return true;
+    };
+    static inline bool check(const RtcmCrc& crc, const uint8_t* bytes) {
+        return crc.crc == ((uint32_t)bytes[0] << 16 | (uint32_t)bytes[1] << 8 | bytes[2]);
+    };
+    static void complete(RtcmFrame* frame);
+};
+
+/**
+ * Split the bytes of a ring into RTCM 3 frames, see GnssFramer. payloadBuffer of
+ * RTCM3_PAYLOAD_MAX_SIZE accepts any frame.
+ */
+class RtcmFramer : public GnssFramer<RtcmFramerTraits> {
+   public:
+    using GnssFramer::GnssFramer;
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_RTCM_FRAMER_HPP__
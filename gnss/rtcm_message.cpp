@@ -0,0 +1,230 @@
+#include "rtcm_message.hpp"
+
+#include "math.h"
+
+namespace wibot::protocal::gnss {
+
+#define RTCM_SEMICIRCLE 3.1415926535898  // rad, as the GPS interface specification.
+
+#define RTCM_MSM4_FINE_PSEUDORANGE_INVALID (-16384)   // DF400
+#define RTCM_MSM4_FINE_PHASERANGE_INVALID (-2097152)  // DF401
+#define RTCM_MSM7_FINE_PSEUDORANGE_INVALID (-524288)  // DF405
+#define RTCM_MSM7_FINE_PHASERANGE_INVALID (-8388608)  // DF406
+#define RTCM_MSM7_FINE_RATE_INVALID (-16384)          // DF404
+#define RTCM_MSM7_ROUGH_RATE_INVALID (-8192)          // DF399
+#define RTCM_MSM_ROUGH_INVALID 255                    // DF397
+
+RTCM_SYSTEM RtcmMsmEpoch::system_of(uint16_t type) {
+    switch (type / 10) {
+        case 107:
+            return RTCM_SYSTEM::GPS;
+        case 108:
+            return RTCM_SYSTEM::GLONASS;
+        case 109:
+            return RTCM_SYSTEM::GALILEO;
+        case 110:
+            return RTCM_SYSTEM::SBAS;
+        case 111:
+            return RTCM_SYSTEM::QZSS;
+        case 112:
+            return RTCM_SYSTEM::BEIDOU;
+        case 113:
+            return RTCM_SYSTEM::NAVIC;
+        default:
+            return RTCM_SYSTEM::UNKNOWN;
+    }
+};
+
+bool RtcmMsmEpoch::decode(const uint8_t* payload, uint16_t length) {
+    RtcmBitReader r(payload, length);
+    type   = r.u(12);
+    system = system_of(type);
+    msm    = type % 10;
+    if (system == RTCM_SYSTEM::UNKNOWN || (msm != 4 && msm != 7)) return false;
+
+    stationId       = r.u(12);
+    epochTime       = r.u(30);
+    multipleMessage = r.u(1);
+    iods            = r.u(3);
+    r.skip(7);
+    clockSteering     = r.u(2);
+    externalClock     = r.u(2);
+    smoothing         = r.u(1);
+    smoothingInterval = r.u(3);
+
+    // The masks are walked from a set bit to the next, the first bit being number 1.
+    uint8_t  satellites[64];
+    uint8_t  signals[32];
+    uint32_t satelliteMaskHigh = r.u(32);
+    uint64_t satelliteMask     = (uint64_t)satelliteMaskHigh << 32 | r.u(32);
+    uint64_t signalMask        = (uint64_t)r.u(32) << 32;
+    satelliteCount             = 0;
+    signalCount                = 0;
+    for (; satelliteMask; satelliteCount++) {
+        uint32_t bit               = __builtin_clzll(satelliteMask);
+        satellites[satelliteCount] = bit + 1;
+        satelliteMask &= ~(0x8000000000000000ULL >> bit);
+    }
+    for (; signalMask; signalCount++) {
+        uint32_t bit         = __builtin_clzll(signalMask);
+        signals[signalCount] = bit + 1;
+        signalMask &= ~(0x8000000000000000ULL >> bit);
+    }
+    uint32_t cellBits = satelliteCount * signalCount;
+    if (cellBits > RTCM_MSM_CELL_MAX_COUNT) return false;
+
+    uint64_t cellMask = 0;
+    for (uint32_t bits = cellBits; bits > 0;) {
+        uint32_t chunk = bits > 32 ? 32 : bits;
+        cellMask       = cellMask << chunk | r.u(chunk);
+        bits -= chunk;
+    }
+    if (r.overrun) return false;
+    cellMask = cellBits > 0 ? cellMask << (64 - cellBits) : 0;
+
+    // Every cell is written, the count only moves past the cells present.
+    uint8_t cellSatellite[RTCM_MSM_CELL_MAX_COUNT];
+    count = 0;
+    for (uint32_t s = 0; s < satelliteCount; s++) {
+        for (uint32_t g = 0; g < signalCount; g++) {
+            cellSatellite[count] = s;
+            prn[count]           = satellites[s];
+            signal[count]        = signals[g];
+            count += cellMask >> 63;
+            cellMask <<= 1;
+        }
+    }
+
+    // Satellite data, field by field over all satellites.
+    bool     msm7 = msm == 7;
+    uint8_t  roughInteger[64];
+    uint8_t  extendedInfo[64];
+    uint16_t roughModulo[64];
+    int16_t  roughRate[64];
+    for (uint32_t s = 0; s < satelliteCount; s++) roughInteger[s] = r.u(8);
+    if (msm7) {
+        for (uint32_t s = 0; s < satelliteCount; s++) extendedInfo[s] = r.u(4);
+    }
+    for (uint32_t s = 0; s < satelliteCount; s++) roughModulo[s] = r.u(10);
+    if (msm7) {
+        for (uint32_t s = 0; s < satelliteCount; s++) roughRate[s] = r.s(14);
+    }
+
+    // Signal data, field by field over all cells.
+    int32_t  finePseudorange[RTCM_MSM_CELL_MAX_COUNT];
+    int32_t  finePhaseRange[RTCM_MSM_CELL_MAX_COUNT];
+    int32_t  fineRate[RTCM_MSM_CELL_MAX_COUNT];
+    uint16_t rawCnr[RTCM_MSM_CELL_MAX_COUNT];
+    uint32_t n = count;
+    for (uint32_t k = 0; k < n; k++) finePseudorange[k] = r.s(msm7 ? 20 : 15);
+    for (uint32_t k = 0; k < n; k++) finePhaseRange[k] = r.s(msm7 ? 24 : 22);
+    for (uint32_t k = 0; k < n; k++) lockTime[k] = r.u(msm7 ? 10 : 4);
+    for (uint32_t k = 0; k < n; k++) halfCycle[k] = r.u(1);
+    for (uint32_t k = 0; k < n; k++) rawCnr[k] = r.u(msm7 ? 10 : 6);
+    if (msm7) {
+        for (uint32_t k = 0; k < n; k++) fineRate[k] = r.s(15);
+    }
+    if (r.overrun) return false;
+
+    // Conversions, without branches on the cells.
+    int32_t pseudorangeInvalid =
+        msm7 ? RTCM_MSM7_FINE_PSEUDORANGE_INVALID : RTCM_MSM4_FINE_PSEUDORANGE_INVALID;
+    int32_t phaseRangeInvalid =
+        msm7 ? RTCM_MSM7_FINE_PHASERANGE_INVALID : RTCM_MSM4_FINE_PHASERANGE_INVALID;
+    double pseudorangeScale = msm7 ? 1.0 / (1 << 29) : 1.0 / (1 << 24);  // ms
+    double phaseRangeScale  = msm7 ? 1.0 / (1U << 31) : 1.0 / (1 << 29);
+    float  cnrScale         = msm7 ? 1.0f / 16 : 1.0f;
+
+    // An invalid rough range invalidates the fine values of its cells.
+    double rough[RTCM_MSM_CELL_MAX_COUNT];  // ms
+    float  rate[RTCM_MSM_CELL_MAX_COUNT];
+    for (uint32_t k = 0; k < n; k++) {
+        uint32_t s  = cellSatellite[k];
+        rough[k]    = roughInteger[s] + roughModulo[s] / 1024.0;
+        extended[k] = msm7 ? extendedInfo[s] : 0;
+        rate[k]     = msm7 ? roughRate[s] : 0;
+        if (roughInteger[s] == RTCM_MSM_ROUGH_INVALID) {
+            finePseudorange[k] = pseudorangeInvalid;
+            finePhaseRange[k]  = phaseRangeInvalid;
+        }
+        if (!msm7 || roughRate[s] == RTCM_MSM7_ROUGH_RATE_INVALID) {
+            fineRate[k] = RTCM_MSM7_FINE_RATE_INVALID;
+        }
+    }
+    for (uint32_t k = 0; k < n; k++) {
+        double value   = (rough[k] + finePseudorange[k] * pseudorangeScale) * RTCM_LIGHT_MS;
+        pseudorange[k] = value * (finePseudorange[k] != pseudorangeInvalid);
+    }
+    for (uint32_t k = 0; k < n; k++) {
+        double value  = (rough[k] + finePhaseRange[k] * phaseRangeScale) * RTCM_LIGHT_MS;
+        phaseRange[k] = value * (finePhaseRange[k] != phaseRangeInvalid);
+    }
+    for (uint32_t k = 0; k < n; k++) {
+        cnr[k] = rawCnr[k] * cnrScale;
+    }
+    for (uint32_t k = 0; k < n; k++) {
+        float value       = rate[k] + fineRate[k] * 0.0001f;
+        phaseRangeRate[k] = value * (fineRate[k] != RTCM_MSM7_FINE_RATE_INVALID);
+    }
+    return true;
+};
+
+bool RtcmStation::decode(const uint8_t* payload, uint16_t length) {
+    RtcmBitReader r(payload, length);
+    type = r.u(12);
+    if (type != 1005 && type != 1006) return false;
+
+    stationId        = r.u(12);
+    itrf             = r.u(6);
+    gps              = r.u(1);
+    glonass          = r.u(1);
+    galileo          = r.u(1);
+    referenceStation = r.u(1);
+    x                = r.s64(38) * 0.0001;
+    singleOscillator = r.u(1);
+    r.skip(1);
+    y            = r.s64(38) * 0.0001;
+    quarterCycle = r.u(2);
+    z            = r.s64(38) * 0.0001;
+    height       = type == 1006 ? r.u(16) * 0.0001 : 0.0;
+    return !r.overrun;
+};
+
+bool RtcmGpsEphemeris::decode(const uint8_t* payload, uint16_t length) {
+    RtcmBitReader r(payload, length);
+    if (r.u(12) != 1019) return false;
+
+    prn         = r.u(6);
+    week        = r.u(10);
+    ura         = r.u(4);
+    codeOnL2    = r.u(2);
+    idot        = ldexp(r.s(14), -43) * RTCM_SEMICIRCLE;
+    iode        = r.u(8);
+    toc         = r.u(16) * 16.0;
+    af2         = ldexp(r.s(8), -55);
+    af1         = ldexp(r.s(16), -43);
+    af0         = ldexp(r.s(22), -31);
+    iodc        = r.u(10);
+    crs         = ldexp(r.s(16), -5);
+    deltaN      = ldexp(r.s(16), -43) * RTCM_SEMICIRCLE;
+    m0          = ldexp(r.s(32), -31) * RTCM_SEMICIRCLE;
+    cuc         = ldexp(r.s(16), -29);
+    e           = ldexp(r.u(32), -33);
+    cus         = ldexp(r.s(16), -29);
+    sqrtA       = ldexp(r.u(32), -19);
+    toe         = r.u(16) * 16.0;
+    cic         = ldexp(r.s(16), -29);
+    omega0      = ldexp(r.s(32), -31) * RTCM_SEMICIRCLE;
+    cis         = ldexp(r.s(16), -29);
+    i0          = ldexp(r.s(32), -31) * RTCM_SEMICIRCLE;
+    crc         = ldexp(r.s(16), -5);
+    omega       = ldexp(r.s(32), -31) * RTCM_SEMICIRCLE;
+    omegaDot    = ldexp(r.s(24), -43) * RTCM_SEMICIRCLE;
+    tgd         = ldexp(r.s(8), -31);
+    health      = r.u(6);
+    l2pData     = r.u(1);
+    fitInterval = r.u(1);
+    return !r.overrun;
+};
+
+}  // namespace wibot::protocal::gnss
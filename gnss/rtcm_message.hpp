@@ -0,0 +1,122 @@
+#ifndef __WWTALK_GNSS_RTCM_MESSAGE_HPP__
+#define __WWTALK_GNSS_RTCM_MESSAGE_HPP__
+#include "base.hpp"
+#include "rtcm.hpp"
+namespace wibot::protocal::gnss {
+
+#define RTCM_MSM_CELL_MAX_COUNT 64  // the cell mask holds 64 bits at most.
+#define RTCM_LIGHT_MS 299792.458    // m travelled in 1 ms.
+
+enum class RTCM_SYSTEM : uint8_t {
+    GPS = 0,
+    GLONASS,
+    GALILEO,
+    SBAS,
+    QZSS,
+    BEIDOU,
+    NAVIC,
+    UNKNOWN,
+};
+
+/**
+ * The observations of an MSM4 or MSM7 message, one column per field and one row per cell, a
+ * cell being a signal of a satellite. Bit fields are read in message order into raw columns,
+ * then converted by branch-free loops over all cells. Invalid observations are 0.
+ */
+struct RtcmMsmEpoch {
+    uint16_t    type;
+    RTCM_SYSTEM system;
+    uint8_t     msm;  // 4 or 7.
+    uint16_t    stationId;
+    uint32_t    epochTime;  // ms of week, GLONASS: day of week above bit 27, ms of day below.
+    uint8_t     multipleMessage;
+    uint8_t     iods;
+    uint8_t     clockSteering;
+    uint8_t     externalClock;
+    uint8_t     smoothing;
+    uint8_t     smoothingInterval;
+    uint32_t    satelliteCount;
+    uint32_t    signalCount;
+    uint32_t    count;  // cells.
+
+    uint8_t  prn[RTCM_MSM_CELL_MAX_COUNT];        // 1 to 64.
+    uint8_t  signal[RTCM_MSM_CELL_MAX_COUNT];     // signal id, 1 to 32.
+    uint8_t  extended[RTCM_MSM_CELL_MAX_COUNT];   // MSM7 extended info, GLONASS channel + 7.
+    double   pseudorange[RTCM_MSM_CELL_MAX_COUNT];     // m
+    double   phaseRange[RTCM_MSM_CELL_MAX_COUNT];      // m
+    float    phaseRangeRate[RTCM_MSM_CELL_MAX_COUNT];  // m/s, MSM7 only.
+    float    cnr[RTCM_MSM_CELL_MAX_COUNT];             // dBHz
+    uint16_t lockTime[RTCM_MSM_CELL_MAX_COUNT];        // indicator, DF402 or DF407.
+    uint8_t  halfCycle[RTCM_MSM_CELL_MAX_COUNT];
+
+    /**
+     * @return Return false if the message is not an MSM4 or MSM7, is truncated, or has more
+     * cells than the columns.
+     */
+    bool decode(const uint8_t* payload, uint16_t length);
+
+    static RTCM_SYSTEM system_of(uint16_t type);
+};
+
+/**
+ * Message 1005, and 1006 with the antenna height.
+ */
+struct RtcmStation {
+    uint16_t type;
+    uint16_t stationId;
+    uint8_t  itrf;
+    uint8_t  gps;
+    uint8_t  glonass;
+    uint8_t  galileo;
+    uint8_t  referenceStation;
+    uint8_t  singleOscillator;
+    uint8_t  quarterCycle;
+    double   x;  // m, ECEF of the antenna reference point.
+    double   y;
+    double   z;
+    double   height;  // m, 0 for 1005.
+
+    bool decode(const uint8_t* payload, uint16_t length);
+};
+
+/**
+ * Message 1019, angles in rad and times in s.
+ */
+struct RtcmGpsEphemeris {
+    uint8_t  prn;
+    uint16_t week;  // modulo 1024.
+    uint8_t  ura;
+    uint8_t  codeOnL2;
+    double   idot;
+    uint8_t  iode;
+    double   toc;
+    double   af2;
+    double   af1;
+    double   af0;
+    uint16_t iodc;
+    double   crs;  // m
+    double   deltaN;
+    double   m0;
+    double   cuc;
+    double   e;
+    double   cus;
+    double   sqrtA;  // m^1/2
+    double   toe;
+    double   cic;
+    double   omega0;
+    double   cis;
+    double   i0;
+    double   crc;  // m
+    double   omega;
+    double   omegaDot;
+    double   tgd;
+    uint8_t  health;
+    uint8_t  l2pData;
+    uint8_t  fitInterval;
+
+    bool decode(const uint8_t* payload, uint16_t length);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_RTCM_MESSAGE_HPP__
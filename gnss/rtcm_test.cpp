@@ -0,0 +1,395 @@
+#include "rtcm_test.hpp"
+
+#include "CircularBuffer.hpp"
+#include "math.h"
+#include "minunit.h"
+#include "rtcm.hpp"
+#include "rtcm_framer.hpp"
+#include "rtcm_message.hpp"
+#include "string.h"
+
+namespace wibot::protocal::gnss::test {
+
+static void rtcm_crc_test() {
+    MU_ASSERT(rtcm_crc24q((const uint8_t*)"123456789", 9) == 0xCDE703);
+    MU_ASSERT(rtcm_crc24q_bytewise((const uint8_t*)"123456789", 9) == 0xCDE703);
+
+    uint8_t  data[300];
+    uint32_t seed = 7;
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        seed    = seed * 1103515245 + 12345;
+        data[i] = seed >> 16;
+    }
+    // Any length and any split give the CRC of the bytewise reference.
+    for (uint32_t length = 0; length < sizeof(data); length += 7) {
+        uint32_t crc = rtcm_crc24q_bytewise(data, length);
+        MU_ASSERT(rtcm_crc24q(data, length) == crc);
+        uint32_t split = length / 3;
+        MU_ASSERT(rtcm_crc24q(data + split, length - split, rtcm_crc24q(data, split)) == crc);
+    }
+}
+
+static void rtcm_bit_test() {
+    uint8_t       data[32];
+    RtcmBitWriter w(data, sizeof(data));
+    w.put(0xABC, 12);
+    w.put(1, 1);
+    w.put((uint64_t)-5, 7);
+    w.put((uint64_t)-123456789012LL, 38);
+    w.put(0x15, 5);  // sign-magnitude -5.
+    w.put(0xFFFFFFFF, 32);
+    w.put(0x123456789ULL, 40);
+    MU_ASSERT(!w.overflow && w.length() == 17);
+    w.put(0, 200);
+    MU_ASSERT(w.overflow && w.length() == 17);
+
+    RtcmBitReader r(data, 17);
+    MU_ASSERT(r.u(12) == 0xABC && r.u(1) == 1 && r.s(7) == -5);
+    MU_ASSERT(r.s64(38) == -123456789012LL);
+    MU_ASSERT(r.sm(5) == -5 && r.position() == 63);
+    MU_ASSERT(r.u(32) == 0xFFFFFFFF);
+    r.skip(8);
+    MU_ASSERT(r.u(32) == 0x23456789 && !r.overrun);
+    MU_ASSERT(r.u(1) == 0 && !r.overrun);  // padding of the last byte.
+    MU_ASSERT(r.u(16) == 0 && r.overrun);
+}
+
+static void rtcm_parse_test() {
+    uint8_t payload[20];
+    uint8_t frame[32];
+    for (int i = 0; i < 20; i++) {
+        payload[i] = i * 11;
+    }
+    payload[0] = 1077 >> 4;
+    payload[1] = (1077 & 0x0F) << 4;
+    uint32_t length = rtcm_encode(frame, sizeof(frame), payload, 20);
+    MU_ASSERT(length == 26 && frame[0] == RTCM3_PREAMBLE && frame[1] == 0 && frame[2] == 20);
+
+    uint16_t type;
+    void*    data;
+    MU_ASSERT(rtcm_parse(frame, length, &type, &data));
+    MU_ASSERT(type == 1077 && data == frame + RTCM3_HEADER_SIZE);
+    MU_ASSERT(!rtcm_parse(frame, length - 1, &type, &data));
+    frame[7] ^= 0x40;
+    MU_ASSERT(!rtcm_parse(frame, length, &type, &data));
+
+    // In place, the payload is not moved.
+    MU_ASSERT(rtcm_encode(frame, sizeof(frame), frame + RTCM3_HEADER_SIZE, 20) == 26);
+    MU_ASSERT(rtcm_parse(frame, length, &type, &data));
+    MU_ASSERT(!rtcm_encode(frame, 25, payload, 20));
+}
+
+static uint32_t rtcm_test_frame(uint8_t* buffer, uint16_t type, uint16_t length, uint8_t fill) {
+    uint8_t payload[RTCM3_PAYLOAD_MAX_SIZE];
+    for (uint32_t i = 0; i < length; i++) {
+        payload[i] = fill + i;
+    }
+    payload[0] = type >> 4;
+    payload[1] = (type & 0x0F) << 4;
+    return rtcm_encode(buffer, RTCM3_PAYLOAD_MAX_SIZE + RTCM3_FRAME_OVERHEAD, payload, length);
+};
+
+static void rtcm_framer_test() {
+    uint8_t         ring[512];
+    uint8_t         scratch[256];
+    CircularBuffer8 rb(ring, sizeof(ring));
+    RtcmFramer      framer(rb, {.data = scratch, .size = sizeof(scratch)});
+    RtcmFrame       frame;
+
+    static uint8_t stream[2048];
+    uint32_t       length = 0;
+    stream[length++]      = 0x55;
+    stream[length++]      = RTCM3_PREAMBLE;  // reserved bits set.
+    stream[length++]      = 0x80;
+    length += rtcm_test_frame(stream + length, 1005, 19, 0);
+    length += rtcm_test_frame(stream + length, 1077, 200, 3);
+    uint32_t corrupted = length;
+    length += rtcm_test_frame(stream + length, 1230, 8, 5);
+    stream[corrupted + 6] ^= 0x01;
+    length += rtcm_test_frame(stream + length, 1019, 61, 7);
+
+    // Fed byte by byte, the CRC is continued across calls.
+    uint16_t types[4];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        rb.write(&stream[i], 1, true);
+        while (framer.parse(&frame)) {
+            if (count < 4) {
+                types[count] = frame.type;
+            }
+            count++;
+        }
+    }
+    MU_ASSERT(count == 3 && framer.checksumErrors == 1);
+    MU_ASSERT(types[0] == 1005 && types[1] == 1077 && types[2] == 1019);
+
+    // Lengths beyond the payload buffer are dropped on the header.
+    uint8_t bad[3] = {RTCM3_PREAMBLE, 0x01, 0x10};
+    rb.write(bad, sizeof(bad), true);
+    length = rtcm_test_frame(stream, 1006, 21, 9);
+    rb.write(stream, length, true);
+    MU_ASSERT(framer.parse(&frame) && frame.type == 1006 && frame.length == 21);
+    MU_ASSERT(framer.lengthErrors == 1);
+
+    // Payloads wrapping around the end of the ring are copied to the payload buffer.
+    for (int i = 0; i < 8; i++) {
+        length = rtcm_test_frame(stream, 1087, 150, i);
+        rb.write(stream, length, true);
+        MU_ASSERT(framer.parse(&frame) && frame.type == 1087 && frame.length == 150);
+        MU_ASSERT(!memcmp(frame.payload, stream + RTCM3_HEADER_SIZE, 150));
+    }
+    MU_ASSERT(!framer.parse(&frame) && rb.getSize() == 0);
+}
+
+struct RtcmTestCell {
+    uint8_t  satellite;  // index in the satellite mask.
+    uint8_t  signal;
+    int32_t  finePseudorange;
+    int32_t  finePhaseRange;
+    uint16_t lockTime;
+    uint8_t  halfCycle;
+    uint16_t cnr;
+    int32_t  fineRate;
+};
+
+struct RtcmTestSatellite {
+    uint8_t  prn;
+    uint8_t  roughInteger;
+    uint8_t  extended;
+    uint16_t roughModulo;
+    int16_t  roughRate;
+};
+
+static const uint8_t rtcmTestSignals[] = {2, 16};
+
+/**
+ * An MSM4 or MSM7 payload, every satellite observed on the signals of rtcmTestSignals.
+ */
+static uint32_t rtcm_test_msm(uint8_t* buffer, uint16_t type, const RtcmTestSatellite* satellites,
+                              uint32_t satelliteCount, const RtcmTestCell* cells,
+                              uint32_t cellCount) {
+    bool          msm7 = type % 10 == 7;
+    RtcmBitWriter w(buffer, RTCM3_PAYLOAD_MAX_SIZE);
+    w.put(type, 12);
+    w.put(2003, 12);
+    w.put(345600000, 30);
+    w.put(0, 1);
+    w.put(5, 3);
+    w.put(0, 7);
+    w.put(1, 2);
+    w.put(0, 2);
+    w.put(1, 1);
+    w.put(3, 3);
+
+    uint64_t satelliteMask = 0;
+    for (uint32_t s = 0; s < satelliteCount; s++) {
+        satelliteMask |= 1ULL << (64 - satellites[s].prn);
+    }
+    uint32_t signalMask = 0;
+    for (uint32_t g = 0; g < sizeof(rtcmTestSignals); g++) {
+        signalMask |= 1U << (32 - rtcmTestSignals[g]);
+    }
+    w.put(satelliteMask, 64);
+    w.put(signalMask, 32);
+    for (uint32_t s = 0; s < satelliteCount; s++) {
+        for (uint32_t g = 0; g < sizeof(rtcmTestSignals); g++) {
+            bool present = false;
+            for (uint32_t k = 0; k < cellCount; k++) {
+                present |= cells[k].satellite == s && cells[k].signal == rtcmTestSignals[g];
+            }
+            w.put(present, 1);
+        }
+    }
+
+    for (uint32_t s = 0; s < satelliteCount; s++) w.put(satellites[s].roughInteger, 8);
+    if (msm7) {
+        for (uint32_t s = 0; s < satelliteCount; s++) w.put(satellites[s].extended, 4);
+    }
+    for (uint32_t s = 0; s < satelliteCount; s++) w.put(satellites[s].roughModulo, 10);
+    if (msm7) {
+        for (uint32_t s = 0; s < satelliteCount; s++) w.put(satellites[s].roughRate, 14);
+    }
+    for (uint32_t k = 0; k < cellCount; k++) w.put(cells[k].finePseudorange, msm7 ? 20 : 15);
+    for (uint32_t k = 0; k < cellCount; k++) w.put(cells[k].finePhaseRange, msm7 ? 24 : 22);
+    for (uint32_t k = 0; k < cellCount; k++) w.put(cells[k].lockTime, msm7 ? 10 : 4);
+    for (uint32_t k = 0; k < cellCount; k++) w.put(cells[k].halfCycle, 1);
+    for (uint32_t k = 0; k < cellCount; k++) w.put(cells[k].cnr, msm7 ? 10 : 6);
+    if (msm7) {
+        for (uint32_t k = 0; k < cellCount; k++) w.put(cells[k].fineRate, 15);
+    }
+    return w.length();
+};
+
+static bool rtcm_test_near(double value, double expected, double tolerance) {
+    return fabs(value - expected) <= tolerance;
+};
+
+static void rtcm_msm_test() {
+    static uint8_t      payload[RTCM3_PAYLOAD_MAX_SIZE];
+    static RtcmMsmEpoch epoch;
+
+    // The third satellite has an invalid rough range and rate.
+    const RtcmTestSatellite satellites[] = {
+        {3, 70, 1, 512, 120},
+        {17, 75, 8, 0, -300},
+        {32, 255, 0, 100, -8192},
+    };
+    // In the order of the cell mask, satellite by satellite then signal by signal.
+    const RtcmTestCell cells[] = {
+        {0, 2, 1000, 3000, 700, 0, 720, 1234},
+        {0, 16, -2000, -4000, 650, 1, 600, -16384},
+        {1, 2, -524288, 5000, 10, 0, 512, -77},
+        {2, 2, 5, 6, 1, 0, 400, 10},
+        {2, 16, 7, 8, 2, 1, 300, 20},
+    };
+    uint32_t length = rtcm_test_msm(payload, 1077, satellites, 3, cells, 5);
+    MU_ASSERT(epoch.decode(payload, length));
+    MU_ASSERT(epoch.type == 1077 && epoch.system == RTCM_SYSTEM::GPS && epoch.msm == 7);
+    MU_ASSERT(epoch.stationId == 2003 && epoch.epochTime == 345600000 && epoch.iods == 5);
+    MU_ASSERT(epoch.clockSteering == 1 && epoch.smoothing == 1 && epoch.smoothingInterval == 3);
+    MU_ASSERT(epoch.satelliteCount == 3 && epoch.signalCount == 2 && epoch.count == 5);
+
+    const uint8_t prns[]    = {3, 3, 17, 32, 32};
+    const uint8_t signals[] = {2, 16, 2, 2, 16};
+    for (uint32_t k = 0; k < 5; k++) {
+        MU_ASSERT(epoch.prn[k] == prns[k] && epoch.signal[k] == signals[k]);
+        MU_ASSERT(epoch.lockTime[k] == cells[k].lockTime);
+        MU_ASSERT(epoch.halfCycle[k] == cells[k].halfCycle);
+        MU_ASSERT(epoch.cnr[k] == cells[k].cnr / 16.0f);
+        MU_ASSERT(epoch.extended[k] == satellites[cells[k].satellite].extended);
+    }
+    double rough = 70 + 512 / 1024.0;
+    MU_ASSERT(rtcm_test_near(epoch.pseudorange[0], (rough + 1000 * ldexp(1, -29)) * RTCM_LIGHT_MS,
+                             1e-6));
+    MU_ASSERT(rtcm_test_near(epoch.phaseRange[0], (rough + 3000 * ldexp(1, -31)) * RTCM_LIGHT_MS,
+                             1e-6));
+    MU_ASSERT(rtcm_test_near(epoch.pseudorange[1], (rough - 2000 * ldexp(1, -29)) * RTCM_LIGHT_MS,
+                             1e-6));
+    MU_ASSERT(rtcm_test_near(epoch.phaseRangeRate[0], 120 + 0.1234, 1e-4));
+    MU_ASSERT(epoch.phaseRangeRate[1] == 0);  // invalid fine rate.
+    MU_ASSERT(epoch.pseudorange[2] == 0);      // invalid fine pseudorange.
+    MU_ASSERT(rtcm_test_near(epoch.phaseRange[2], (75 + 5000 * ldexp(1, -31)) * RTCM_LIGHT_MS,
+                             1e-6));
+    MU_ASSERT(rtcm_test_near(epoch.phaseRangeRate[2], -300 - 0.0077, 1e-4));
+    for (uint32_t k = 3; k < 5; k++) {
+        MU_ASSERT(epoch.pseudorange[k] == 0 && epoch.phaseRange[k] == 0);
+        MU_ASSERT(epoch.phaseRangeRate[k] == 0);
+    }
+    MU_ASSERT(!epoch.decode(payload, length - 2));
+
+    // MSM4, without extended info nor rates, BeiDou.
+    length = rtcm_test_msm(payload, 1124, satellites, 2, cells, 3);
+    MU_ASSERT(epoch.decode(payload, length));
+    MU_ASSERT(epoch.system == RTCM_SYSTEM::BEIDOU && epoch.msm == 4 && epoch.count == 3);
+    MU_ASSERT(rtcm_test_near(epoch.pseudorange[0], (rough + 1000 * ldexp(1, -24)) * RTCM_LIGHT_MS,
+                             1e-6));
+    MU_ASSERT(rtcm_test_near(epoch.phaseRange[1], (rough - 4000 * ldexp(1, -29)) * RTCM_LIGHT_MS,
+                             1e-6));
+    MU_ASSERT(epoch.cnr[0] == (720 & 0x3F) && epoch.lockTime[0] == (700 & 0x0F));
+    MU_ASSERT(epoch.extended[0] == 0 && epoch.phaseRangeRate[0] == 0);
+
+    // Not an MSM4 or MSM7, or more cells than the columns.
+    payload[0] = 1075 >> 4;
+    payload[1] = (1075 & 0x0F) << 4;
+    MU_ASSERT(!epoch.decode(payload, length));
+    RtcmBitWriter w(payload, RTCM3_PAYLOAD_MAX_SIZE);
+    w.put(1087, 12);
+    w.put(0, 57);
+    w.put(~0ULL, 64);
+    w.put(3, 32);
+    w.put(0, 64);
+    MU_ASSERT(!epoch.decode(payload, w.length()));
+}
+
+static void rtcm_station_test() {
+    uint8_t       payload[32];
+    RtcmBitWriter w(payload, sizeof(payload));
+    w.put(1006, 12);
+    w.put(2003, 12);
+    w.put(0, 6);
+    w.put(1, 1);
+    w.put(1, 1);
+    w.put(0, 1);
+    w.put(0, 1);
+    w.put((uint64_t)-26948924602LL, 38);
+    w.put(1, 1);
+    w.put(0, 1);
+    w.put((uint64_t)-43168524011LL, 38);
+    w.put(0, 2);
+    w.put(38186216327LL, 38);
+    w.put(15000, 16);
+    MU_ASSERT(w.length() == 21);
+
+    RtcmStation station;
+    MU_ASSERT(station.decode(payload, 21));
+    MU_ASSERT(station.type == 1006 && station.stationId == 2003);
+    MU_ASSERT(station.gps && station.glonass && !station.galileo && station.singleOscillator);
+    MU_ASSERT(rtcm_test_near(station.x, -2694892.4602, 1e-6));
+    MU_ASSERT(rtcm_test_near(station.y, -4316852.4011, 1e-6));
+    MU_ASSERT(rtcm_test_near(station.z, 3818621.6327, 1e-6));
+    MU_ASSERT(rtcm_test_near(station.height, 1.5, 1e-9));
+    MU_ASSERT(!station.decode(payload, 20));
+}
+
+static void rtcm_ephemeris_test() {
+    uint8_t       payload[61];
+    RtcmBitWriter w(payload, sizeof(payload));
+    w.put(1019, 12);
+    w.put(12, 6);
+    w.put(251, 10);
+    w.put(0, 4);
+    w.put(1, 2);
+    w.put((uint64_t)-100, 14);
+    w.put(77, 8);
+    w.put(22500, 16);  // toc 360000 s.
+    w.put(0, 8);
+    w.put((uint64_t)-3, 16);
+    w.put(123456, 22);
+    w.put(77, 10);
+    w.put(400, 16);
+    w.put(10000, 16);
+    w.put(0x40000000, 32);  // m0, half a semicircle.
+    w.put(5, 16);
+    w.put(42949673, 32);  // e, about 0.005.
+    w.put(6, 16);
+    w.put(2702002176U, 32);  // sqrtA 5153.66 m^1/2.
+    w.put(22500, 16);
+    w.put(7, 16);
+    w.put((uint64_t)-0x20000000LL, 32);
+    w.put(8, 16);
+    w.put(0x30000000, 32);
+    w.put(500, 16);
+    w.put(0x10000000, 32);
+    w.put((uint64_t)-20000, 24);
+    w.put((uint64_t)-9, 8);
+    w.put(0, 6);
+    w.put(0, 1);
+    w.put(1, 1);
+    MU_ASSERT(!w.overflow && w.length() == 61);
+
+    RtcmGpsEphemeris ephemeris;
+    MU_ASSERT(ephemeris.decode(payload, 61));
+    MU_ASSERT(ephemeris.prn == 12 && ephemeris.week == 251 && ephemeris.codeOnL2 == 1);
+    MU_ASSERT(ephemeris.iode == 77 && ephemeris.iodc == 77 && ephemeris.fitInterval == 1);
+    MU_ASSERT(ephemeris.toc == 360000 && ephemeris.toe == 360000);
+    MU_ASSERT(ephemeris.af0 == ldexp(123456, -31) && ephemeris.af1 == ldexp(-3, -43));
+    MU_ASSERT(rtcm_test_near(ephemeris.m0, 3.1415926535898 / 2, 1e-12));
+    MU_ASSERT(rtcm_test_near(ephemeris.omega0, -3.1415926535898 / 4, 1e-12));
+    MU_ASSERT(rtcm_test_near(ephemeris.e, 0.005, 1e-9));
+    MU_ASSERT(rtcm_test_near(ephemeris.sqrtA, 5153.66, 0.01));
+    MU_ASSERT(ephemeris.crs == 12.5 && ephemeris.crc == 15.625);
+    MU_ASSERT(ephemeris.tgd == ldexp(-9, -31));
+    MU_ASSERT(!ephemeris.decode(payload, 60));
+}
+
+void rtcm_test() {
+    rtcm_crc_test();
+    rtcm_bit_test();
+    rtcm_parse_test();
+    rtcm_framer_test();
+    rtcm_msm_test();
+    rtcm_station_test();
+    rtcm_ephemeris_test();
+};
+
+}  // namespace wibot::protocal::gnss::test
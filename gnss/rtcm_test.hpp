@@ -0,0 +1,8 @@
+#ifndef __WWTALK_RTCM_TEST_HPP__
+#define __WWTALK_RTCM_TEST_HPP__
+
+namespace wibot::protocal::gnss::test {
+void rtcm_test();
+}
+
+#endif  // __WWTALK_RTCM_TEST_HPP__
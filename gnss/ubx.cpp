@@ -1,25 +1,89 @@
 #include "ubx.hpp"
 
 namespace wibot::protocal::gnss {
-static inline bool checksum(uint8_t* msg, uint32_t length) {
-    uint8_t* p    = msg + 2;
-    uint32_t l    = length - 4;
-    uint8_t  ck_a = 0, ck_b = 0;
-    for (uint32_t i = 0; i < l; i++) {
-        ck_a += *p++;
-        ck_b += ck_a;
+
+void UbxChecksum::update(const uint8_t* data, uint32_t length) {
+    uint8_t ckA = a, ckB = b;
+    for (uint32_t i = 0; i < length; i++) {
+        ckA += data[i];
+        ckB += ckA;
     }
-    return (ck_a == p[0]) && (ck_b == p[1]);
-}
+    a = ckA;
+    b = ckB;
+};
+
+bool UbxNavPvtView::validate(const uint8_t*, uint16_t length) {
+    return length == 92;
+};
+
+bool UbxNavHpposllhView::validate(const uint8_t*, uint16_t length) {
+    return length == 36;
+};
+
+bool UbxNavSatView::validate(const uint8_t* payload, uint16_t length) {
+    return length >= 8 && length == 8 + 12 * payload[5];
+};
+
+bool UbxNavSigView::validate(const uint8_t* payload, uint16_t length) {
+    return length >= 8 && length == 8 + 16 * payload[5];
+};
+
+bool UbxNavTimeUtcView::validate(const uint8_t*, uint16_t length) {
+    return length == 20;
+};
+
+bool UbxMonHwView::validate(const uint8_t*, uint16_t length) {
+    return length == 60;
+};
+
+bool UbxEsfMeasView::validate(const uint8_t* payload, uint16_t length) {
+    if (length < 8) return false;
+    UbxEsfMeasView view(payload);
+    return length == 8 + 4 * view.numMeas() + (view.calibTtagValid() ? 4 : 0);
+};
 
 bool ubx_parse(uint8_t* msg, uint32_t length, uint16_t* classId, void** payload) {
-    if (!checksum(msg, length)) {
+    if (length < UBX_FRAME_OVERHEAD) {
+        return false;
+    }
+    if (msg[0] != UBX_SYNC_CHAR_1 || msg[1] != UBX_SYNC_CHAR_2) {
+        return false;
+    }
+    if ((uint32_t)getUint16(msg + 4, true) + UBX_FRAME_OVERHEAD != length) {
+        return false;
+    }
+
+    UbxChecksum checksum;
+    checksum.reset();
+    checksum.update(msg + 2, length - 4);
+    if (checksum.a != msg[length - 2] || checksum.b != msg[length - 1]) {
         return false;
     }
-    msg += 2;
-    *classId = *(uint16_t*)msg;
-    msg += 4;
-    *payload = msg;
+    *classId = UBX_CLASSID(msg[2], msg[3]);
+    *payload = msg + UBX_HEADER_SIZE;
     return true;
 }
+
+uint32_t ubx_encode(uint8_t* buffer, uint32_t size, uint16_t classId, const uint8_t* payload,
+                    uint16_t length) {
+    if (size < (uint32_t)length + UBX_FRAME_OVERHEAD) {
+        return 0;
+    }
+    buffer[0] = UBX_SYNC_CHAR_1;
+    buffer[1] = UBX_SYNC_CHAR_2;
+    buffer[2] = classId & 0xFF;
+    buffer[3] = classId >> 8;
+    buffer[4] = length & 0xFF;
+    buffer[5] = length >> 8;
+    if (payload != buffer + UBX_HEADER_SIZE) {
+        memmove(buffer + UBX_HEADER_SIZE, payload, length);
+    }
+
+    UbxChecksum checksum;
+    checksum.reset();
+    checksum.update(buffer + 2, length + 4);
+    buffer[UBX_HEADER_SIZE + length]     = checksum.a;
+    buffer[UBX_HEADER_SIZE + length + 1] = checksum.b;
+    return length + UBX_FRAME_OVERHEAD;
+};
 }  // namespace wibot::protocal::gnss
@@ -1,9 +1,31 @@
 #ifndef __WWTALK_GNSS_UBX_HPP__
 #define __WWTALK_GNSS_UBX_HPP__
 #include "base.hpp"
+#include "gnss_bytes.hpp"
 namespace wibot::protocal::gnss {
 
-#define UBX_CLASSID_NAV_PVT 0x0701
+#define UBX_SYNC_CHAR_1 0xB5
+#define UBX_SYNC_CHAR_2 0x62
+#define UBX_HEADER_SIZE 6  // sync chars, class, id and length.
+#define UBX_FRAME_OVERHEAD 8
+
+/**
+ * Class in the low byte and id in the high byte, as read little-endian from the frame.
+ */
+#define UBX_CLASSID(cls, id) ((uint16_t)((cls) | ((id) << 8)))
+
+#define UBX_CLASSID_NAV_PVT UBX_CLASSID(0x01, 0x07)
+#define UBX_CLASSID_NAV_HPPOSLLH UBX_CLASSID(0x01, 0x14)
+#define UBX_CLASSID_NAV_SAT UBX_CLASSID(0x01, 0x35)
+#define UBX_CLASSID_NAV_SIG UBX_CLASSID(0x01, 0x43)
+#define UBX_CLASSID_NAV_TIMEUTC UBX_CLASSID(0x01, 0x21)
+#define UBX_CLASSID_MON_HW UBX_CLASSID(0x0A, 0x09)
+#define UBX_CLASSID_ESF_MEAS UBX_CLASSID(0x10, 0x02)
+#define UBX_CLASSID_RXM_RAWX UBX_CLASSID(0x02, 0x15)
+#define UBX_CLASSID_RXM_SFRBX UBX_CLASSID(0x02, 0x13)
+#define UBX_CLASSID_ACK_ACK UBX_CLASSID(0x05, 0x01)
+#define UBX_CLASSID_ACK_NAK UBX_CLASSID(0x05, 0x00)
+#define UBX_CLASSID_CFG_VALSET UBX_CLASSID(0x06, 0x8A)
 
 struct UbxFrameNavPvt {
     uint32_t iTow;
@@ -55,7 +77,226 @@ struct UbxFrameNavPvt {
     float    cAcc;
 } PACKED;
 
+/**
+ * 8-bit Fletcher checksum over class, id, length and payload, updated as bytes arrive.
+ */
+struct UbxChecksum {
+    uint8_t a;
+    uint8_t b;
+
+    inline void reset() {
+        a = 0;
+        b = 0;
+    };
+    inline void update(uint8_t data) {
+        a += data;
+        b += a;
+    };
+    void update(const uint8_t* data, uint32_t length);
+};
+
+/**
+ * Views of payloads, read in place whatever their alignment. validate checks the payload
+ * length against the length the message declares, a view must only be built on a validated
+ * payload. Units are the ones of the u-blox interface description.
+ */
+class UbxNavPvtView {
+   public:
+    explicit UbxNavPvtView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t iTow() const { return gnss_u4(_p + 0); };
+    uint16_t year() const { return gnss_u2(_p + 4); };
+    uint8_t  month() const { return gnss_u1(_p + 6); };
+    uint8_t  day() const { return gnss_u1(_p + 7); };
+    uint8_t  hour() const { return gnss_u1(_p + 8); };
+    uint8_t  min() const { return gnss_u1(_p + 9); };
+    uint8_t  sec() const { return gnss_u1(_p + 10); };
+    uint8_t  valid() const { return gnss_u1(_p + 11); };
+    uint32_t tAcc() const { return gnss_u4(_p + 12); };
+    int32_t  nano() const { return gnss_i4(_p + 16); };
+    uint8_t  fixType() const { return gnss_u1(_p + 20); };
+    uint8_t  flags() const { return gnss_u1(_p + 21); };
+    uint8_t  flags2() const { return gnss_u1(_p + 22); };
+    uint8_t  numSV() const { return gnss_u1(_p + 23); };
+    int32_t  lon() const { return gnss_i4(_p + 24); };  // 1e-7 deg
+    int32_t  lat() const { return gnss_i4(_p + 28); };  // 1e-7 deg
+    int32_t  height() const { return gnss_i4(_p + 32); };  // mm
+    int32_t  hMSL() const { return gnss_i4(_p + 36); };    // mm
+    uint32_t hAcc() const { return gnss_u4(_p + 40); };
+    uint32_t vAcc() const { return gnss_u4(_p + 44); };
+    int32_t  velN() const { return gnss_i4(_p + 48); };
+    int32_t  velE() const { return gnss_i4(_p + 52); };
+    int32_t  velD() const { return gnss_i4(_p + 56); };
+    int32_t  gSpeed() const { return gnss_i4(_p + 60); };
+    int32_t  headMot() const { return gnss_i4(_p + 64); };
+    uint32_t sAcc() const { return gnss_u4(_p + 68); };
+    uint32_t headAcc() const { return gnss_u4(_p + 72); };
+    uint16_t pDOP() const { return gnss_u2(_p + 76); };
+
+   private:
+    const uint8_t* _p;
+};
+
+class UbxNavHpposllhView {
+   public:
+    explicit UbxNavHpposllhView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint8_t  version() const { return gnss_u1(_p + 0); };
+    bool     invalidLlh() const { return gnss_u1(_p + 3) & 0x01; };
+    uint32_t iTow() const { return gnss_u4(_p + 4); };
+    int32_t  lon() const { return gnss_i4(_p + 8); };  // 1e-7 deg
+    int32_t  lat() const { return gnss_i4(_p + 12); };
+    int32_t  height() const { return gnss_i4(_p + 16); };  // mm
+    int32_t  hMSL() const { return gnss_i4(_p + 20); };
+    int8_t   lonHp() const { return gnss_i1(_p + 24); };  // 1e-9 deg
+    int8_t   latHp() const { return gnss_i1(_p + 25); };
+    int8_t   heightHp() const { return gnss_i1(_p + 26); };  // 0.1 mm
+    int8_t   hMSLHp() const { return gnss_i1(_p + 27); };
+    uint32_t hAcc() const { return gnss_u4(_p + 28); };  // 0.1 mm
+    uint32_t vAcc() const { return gnss_u4(_p + 32); };
+
+    /**
+     * lon and lonHp combined, in 1e-9 deg.
+     */
+    int64_t lonNano() const { return (int64_t)lon() * 100 + lonHp(); };
+    int64_t latNano() const { return (int64_t)lat() * 100 + latHp(); };
+
+   private:
+    const uint8_t* _p;
+};
+
+class UbxNavSatView {
+   public:
+    explicit UbxNavSatView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t iTow() const { return gnss_u4(_p + 0); };
+    uint8_t  version() const { return gnss_u1(_p + 4); };
+    uint8_t  numSvs() const { return gnss_u1(_p + 5); };
+
+    uint8_t  gnssId(uint32_t i) const { return gnss_u1(_sv(i) + 0); };
+    uint8_t  svId(uint32_t i) const { return gnss_u1(_sv(i) + 1); };
+    uint8_t  cno(uint32_t i) const { return gnss_u1(_sv(i) + 2); };
+    int8_t   elev(uint32_t i) const { return gnss_i1(_sv(i) + 3); };
+    int16_t  azim(uint32_t i) const { return gnss_i2(_sv(i) + 4); };
+    int16_t  prRes(uint32_t i) const { return gnss_i2(_sv(i) + 6); };  // 0.1 m
+    uint32_t flags(uint32_t i) const { return gnss_u4(_sv(i) + 8); };
+
+   private:
+    const uint8_t* _p;
+
+    const uint8_t* _sv(uint32_t i) const { return _p + 8 + 12 * i; };
+};
+
+class UbxNavSigView {
+   public:
+    explicit UbxNavSigView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t iTow() const { return gnss_u4(_p + 0); };
+    uint8_t  version() const { return gnss_u1(_p + 4); };
+    uint8_t  numSigs() const { return gnss_u1(_p + 5); };
+
+    uint8_t  gnssId(uint32_t i) const { return gnss_u1(_sig(i) + 0); };
+    uint8_t  svId(uint32_t i) const { return gnss_u1(_sig(i) + 1); };
+    uint8_t  sigId(uint32_t i) const { return gnss_u1(_sig(i) + 2); };
+    uint8_t  freqId(uint32_t i) const { return gnss_u1(_sig(i) + 3); };
+    int16_t  prRes(uint32_t i) const { return gnss_i2(_sig(i) + 4); };  // 0.1 m
+    uint8_t  cno(uint32_t i) const { return gnss_u1(_sig(i) + 6); };
+    uint8_t  qualityInd(uint32_t i) const { return gnss_u1(_sig(i) + 7); };
+    uint8_t  corrSource(uint32_t i) const { return gnss_u1(_sig(i) + 8); };
+    uint8_t  ionoModel(uint32_t i) const { return gnss_u1(_sig(i) + 9); };
+    uint16_t sigFlags(uint32_t i) const { return gnss_u2(_sig(i) + 10); };
+
+   private:
+    const uint8_t* _p;
+
+    const uint8_t* _sig(uint32_t i) const { return _p + 8 + 16 * i; };
+};
+
+class UbxNavTimeUtcView {
+   public:
+    explicit UbxNavTimeUtcView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t iTow() const { return gnss_u4(_p + 0); };
+    uint32_t tAcc() const { return gnss_u4(_p + 4); };
+    int32_t  nano() const { return gnss_i4(_p + 8); };
+    uint16_t year() const { return gnss_u2(_p + 12); };
+    uint8_t  month() const { return gnss_u1(_p + 14); };
+    uint8_t  day() const { return gnss_u1(_p + 15); };
+    uint8_t  hour() const { return gnss_u1(_p + 16); };
+    uint8_t  min() const { return gnss_u1(_p + 17); };
+    uint8_t  sec() const { return gnss_u1(_p + 18); };
+    uint8_t  valid() const { return gnss_u1(_p + 19); };
+
+   private:
+    const uint8_t* _p;
+};
+
+class UbxMonHwView {
+   public:
+    explicit UbxMonHwView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t pinSel() const { return gnss_u4(_p + 0); };
+    uint32_t pinBank() const { return gnss_u4(_p + 4); };
+    uint32_t pinDir() const { return gnss_u4(_p + 8); };
+    uint32_t pinVal() const { return gnss_u4(_p + 12); };
+    uint16_t noisePerMS() const { return gnss_u2(_p + 16); };
+    uint16_t agcCnt() const { return gnss_u2(_p + 18); };
+    uint8_t  aStatus() const { return gnss_u1(_p + 20); };
+    uint8_t  aPower() const { return gnss_u1(_p + 21); };
+    uint8_t  flags() const { return gnss_u1(_p + 22); };
+    uint32_t usedMask() const { return gnss_u4(_p + 24); };
+    uint8_t  vp(uint32_t i) const { return gnss_u1(_p + 28 + i); };  // 17 pins.
+    uint8_t  jamInd() const { return gnss_u1(_p + 45); };
+    uint32_t pinIrq() const { return gnss_u4(_p + 48); };
+    uint32_t pullH() const { return gnss_u4(_p + 52); };
+    uint32_t pullL() const { return gnss_u4(_p + 56); };
+
+   private:
+    const uint8_t* _p;
+};
+
+class UbxEsfMeasView {
+   public:
+    explicit UbxEsfMeasView(const uint8_t* payload) : _p(payload){};
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    uint32_t timeTag() const { return gnss_u4(_p + 0); };
+    uint16_t flags() const { return gnss_u2(_p + 4); };
+    uint16_t id() const { return gnss_u2(_p + 6); };
+    uint8_t  numMeas() const { return flags() >> 11; };
+    bool     calibTtagValid() const { return flags() & 0x0008; };
+
+    /**
+     * Signed 24 bits value of measurement i.
+     */
+    int32_t  dataField(uint32_t i) const {
+        return (int32_t)(gnss_u4(_p + 8 + 4 * i) << 8) >> 8;
+    };
+    uint8_t  dataType(uint32_t i) const { return (gnss_u4(_p + 8 + 4 * i) >> 24) & 0x3F; };
+    uint32_t calibTtag() const { return gnss_u4(_p + 8 + 4 * numMeas()); };
+
+   private:
+    const uint8_t* _p;
+};
+
+/**
+ * Check a complete frame, including the sync chars, the length field and the checksum.
+ */
 bool ubx_parse(uint8_t* msg, uint32_t length, uint16_t* classId, void** payload);
+
+/**
+ * Write a frame of classId into buffer. payload may already be in place at
+ * buffer + UBX_HEADER_SIZE.
+ * @return Return the frame length, 0 if the buffer is too small.
+ */
+uint32_t ubx_encode(uint8_t* buffer, uint32_t size, uint16_t classId, const uint8_t* payload,
+                    uint16_t length);
 }  // namespace wibot::protocal::gnss
 
 #endif  // __WWTALK_GNSS_UBX_HPP__
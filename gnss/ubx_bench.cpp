@@ -0,0 +1,105 @@
+#include "ubx_bench.hpp"
+#ifdef __linux__
+
+#include <chrono>
+
+#include "CircularBuffer.hpp"
+#include "log.h"
+#include "minunit.h"
+#include "string.h"
+#include "ubx.hpp"
+#include "ubx_framer.hpp"
+#include "ubx_raw.hpp"
+
+LOGGER("ubx_bench")
+
+namespace wibot::protocal::gnss::test {
+
+#define UBX_BENCH_MEASUREMENTS 64  // RXM-RAWX of a multi-band receiver.
+#define UBX_BENCH_PAYLOAD_SIZE (16 + 32 * UBX_BENCH_MEASUREMENTS)
+#define UBX_BENCH_FRAME_SIZE (UBX_BENCH_PAYLOAD_SIZE + UBX_FRAME_OVERHEAD)
+#define UBX_BENCH_RING_SIZE 16384
+#define UBX_BENCH_CHUNK_SIZE 1500  // a serial DMA or network read.
+#define UBX_BENCH_FRAMES 20000
+
+static uint8_t benchRing[UBX_BENCH_RING_SIZE];
+static uint8_t benchScratch[UBX_BENCH_PAYLOAD_SIZE];
+static uint8_t benchFrame[UBX_BENCH_FRAME_SIZE];
+static struct UbxRawxEpoch benchEpoch;
+
+static uint64_t ubx_bench_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+};
+
+static void ubx_bench_rawx() {
+    volatile uint32_t sink  = 0;
+    uint64_t          start = ubx_bench_now();
+    for (uint32_t i = 0; i < UBX_BENCH_FRAMES; i++) {
+        benchEpoch.decode(benchFrame + UBX_HEADER_SIZE, UBX_BENCH_PAYLOAD_SIZE);
+        sink = sink + benchEpoch.count;
+    }
+    uint64_t elapsed = ubx_bench_now() - start;
+    if (elapsed == 0) elapsed = 1;
+
+    MU_ASSERT(sink == (uint32_t)UBX_BENCH_FRAMES * UBX_BENCH_MEASUREMENTS);
+    LOG_I("RXM-RAWX decode: %.0f epochs/s, %.2f ns/measurement", UBX_BENCH_FRAMES * 1e9 / elapsed,
+          (double)elapsed / ((double)UBX_BENCH_FRAMES * UBX_BENCH_MEASUREMENTS));
+};
+
+void ubx_bench() {
+    benchFrame[0] = UBX_SYNC_CHAR_1;
+    benchFrame[1] = UBX_SYNC_CHAR_2;
+    benchFrame[2] = 0x02;
+    benchFrame[3] = 0x15;
+    benchFrame[4] = UBX_BENCH_PAYLOAD_SIZE & 0xFF;
+    benchFrame[5] = UBX_BENCH_PAYLOAD_SIZE >> 8;
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < UBX_BENCH_PAYLOAD_SIZE; i++) {
+        seed                            = seed * 1103515245 + 12345;
+        benchFrame[UBX_HEADER_SIZE + i] = seed >> 16;
+    }
+    benchFrame[UBX_HEADER_SIZE + 11] = UBX_BENCH_MEASUREMENTS;
+    UbxChecksum checksum;
+    checksum.reset();
+    checksum.update(benchFrame + 2, UBX_BENCH_PAYLOAD_SIZE + 4);
+    benchFrame[UBX_BENCH_FRAME_SIZE - 2] = checksum.a;
+    benchFrame[UBX_BENCH_FRAME_SIZE - 1] = checksum.b;
+
+    CircularBuffer8 rb(benchRing, UBX_BENCH_RING_SIZE);
+    UbxFramer       framer(rb, {.data = benchScratch, .size = UBX_BENCH_PAYLOAD_SIZE});
+    UbxFrame        frame;
+
+    uint64_t total  = (uint64_t)UBX_BENCH_FRAMES * UBX_BENCH_FRAME_SIZE;
+    uint64_t offset = 0;
+    uint32_t frames = 0;
+    uint64_t start  = ubx_bench_now();
+    while (offset < total) {
+        uint32_t chunk = UBX_BENCH_CHUNK_SIZE;
+        if (offset + chunk > total) chunk = total - offset;
+        for (uint32_t written = 0; written < chunk;) {
+            uint32_t position = (offset + written) % UBX_BENCH_FRAME_SIZE;
+            uint32_t length   = UBX_BENCH_FRAME_SIZE - position;
+            if (length > chunk - written) length = chunk - written;
+            rb.write(benchFrame + position, length, false);
+            written += length;
+        }
+        offset += chunk;
+        while (framer.parse(&frame)) {
+            frames++;
+        }
+    }
+    uint64_t elapsed = ubx_bench_now() - start;
+    if (elapsed == 0) elapsed = 1;
+
+    MU_ASSERT(frames == UBX_BENCH_FRAMES && framer.checksumErrors == 0);
+    LOG_I("RXM-RAWX %u bytes: %.0f frames/s, %.1f MB/s, %.2f ns/byte", UBX_BENCH_FRAME_SIZE,
+          frames * 1e9 / elapsed, total * 1e3 / elapsed, (double)elapsed / total);
+
+    ubx_bench_rawx();
+};
+
+}  // namespace wibot::protocal::gnss::test
+
+#endif  // __linux__
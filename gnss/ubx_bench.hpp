@@ -0,0 +1,11 @@
+#ifndef __WWTALK_UBX_BENCH_HPP__
+#define __WWTALK_UBX_BENCH_HPP__
+
+namespace wibot::protocal::gnss::test {
+/**
+ * Throughput of the UBX framer on RXM-RAWX sized frames, and of their decoding into columns.
+ */
+void ubx_bench();
+}
+
+#endif  // __WWTALK_UBX_BENCH_HPP__
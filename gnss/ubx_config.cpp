@@ -0,0 +1,115 @@
+#include "ubx_config.hpp"
+
+namespace wibot::protocal::gnss {
+
+UbxValsetEncoder::UbxValsetEncoder() {
+    begin(nullptr, 0, UBX_CFG_LAYER_RAM, false);
+};
+
+uint32_t UbxValsetEncoder::key_size(uint32_t key) {
+    static const uint8_t sizes[8] = {0, 1, 1, 2, 4, 8, 0, 0};
+    return sizes[(key >> 28) & 0x07];
+};
+
+void UbxValsetEncoder::begin(uint8_t* buffer, uint32_t size, uint8_t layers, bool transaction) {
+    _buffer      = buffer;
+    _size        = size;
+    _length      = 0;
+    _frame       = 0;
+    _keys        = 0;
+    _layers      = layers;
+    _transaction = transaction;
+    _overflow    = false;
+    frameCount   = 0;
+};
+
+bool UbxValsetEncoder::add(uint32_t key, uint64_t value) {
+    uint32_t valueSize = key_size(key);
+    if (valueSize == 0 || _overflow) {
+        _overflow = true;
+        return false;
+    }
+    if (_keys == UBX_VALSET_KEY_MAX_COUNT) {
+        _frame_close();
+    }
+    if (_keys == 0) {
+        // Room for the header, the pair and the checksum, the rest is written on close.
+        if (_length + UBX_FRAME_OVERHEAD + UBX_VALSET_HEADER_SIZE + 4 + valueSize > _size) {
+            _overflow = true;
+            return false;
+        }
+        _frame = _length;
+        _length += UBX_HEADER_SIZE + UBX_VALSET_HEADER_SIZE;
+    } else if (_length + 4 + valueSize + 2 > _size) {
+        _overflow = true;
+        return false;
+    }
+
+    uint8_t* p = _buffer + _length;
+    for (uint32_t i = 0; i < 4; i++) {
+        p[i] = key >> (8 * i);
+    }
+    for (uint32_t i = 0; i < valueSize; i++) {
+        p[4 + i] = value >> (8 * i);
+    }
+    _length += 4 + valueSize;
+    _keys++;
+    return true;
+};
+
+void UbxValsetEncoder::_frame_close() {
+    uint8_t* frame   = _buffer + _frame;
+    uint32_t payload = _length - _frame - UBX_HEADER_SIZE;
+    frame[4]         = payload & 0xFF;
+    frame[5]         = payload >> 8;
+    _length += 2;
+    _keys = 0;
+    frameCount++;
+};
+
+uint32_t UbxValsetEncoder::end() {
+    if (_overflow) {
+        return 0;
+    }
+    if (_keys > 0) {
+        _frame_close();
+    }
+
+    // The transaction fields depend on the frame count, so headers are written last.
+    bool     transaction = _transaction && frameCount > 1;
+    uint32_t index       = 0;
+    for (uint32_t offset = 0; offset < _length; index++) {
+        uint8_t* frame   = _buffer + offset;
+        uint16_t payload = frame[4] | (frame[5] << 8);
+        uint8_t* header  = frame + UBX_HEADER_SIZE;
+        header[0]        = transaction ? 1 : 0;
+        header[1]        = _layers;
+        header[2]        = !transaction ? 0 : index == 0 ? 1 : index + 1 < frameCount ? 2 : 3;
+        header[3]        = 0;
+        offset += ubx_encode(frame, _length - offset, UBX_CLASSID_CFG_VALSET, header, payload);
+    }
+    return _length;
+};
+
+const uint8_t* UbxValsetEncoder::frame(uint32_t index, uint32_t* length) const {
+    uint32_t offset = 0;
+    for (; index > 0 && offset < _length; index--) {
+        offset += (_buffer[offset + 4] | (_buffer[offset + 5] << 8)) + UBX_FRAME_OVERHEAD;
+    }
+    if (offset >= _length) {
+        return nullptr;
+    }
+    *length = (_buffer[offset + 4] | (_buffer[offset + 5] << 8)) + UBX_FRAME_OVERHEAD;
+    return _buffer + offset;
+};
+
+bool UbxAckTracker::receive(const struct UbxFrame* frame) {
+    uint16_t classId = frame->classId();
+    if ((classId != UBX_CLASSID_ACK_ACK && classId != UBX_CLASSID_ACK_NAK) || frame->length != 2) {
+        return false;
+    }
+    return resolve(UBX_CLASSID(frame->payload[0], frame->payload[1]),
+                   classId == UBX_CLASSID_ACK_ACK);
+};
+
+}  // namespace wibot::protocal::gnss
@@ -0,0 +1,79 @@
+#ifndef __WWTALK_GNSS_UBX_CONFIG_HPP__
+#define __WWTALK_GNSS_UBX_CONFIG_HPP__
+#include "ack_tracker.hpp"
+#include "base.hpp"
+#include "ubx.hpp"
+#include "ubx_framer.hpp"
+namespace wibot::protocal::gnss {
+
+#define UBX_CFG_LAYER_RAM 0x01
+#define UBX_CFG_LAYER_BBR 0x02
+#define UBX_CFG_LAYER_FLASH 0x04
+
+#define UBX_VALSET_HEADER_SIZE 4      // version, layers and transaction.
+#define UBX_VALSET_KEY_MAX_COUNT 64   // per frame, a receiver limit.
+
+/**
+ * Pack key/value pairs into as few CFG-VALSET frames as the key limit of a frame allows, back
+ * to back in a caller buffer. With transaction set and more than one frame, the frames form a
+ * transaction, so the receiver applies all of them or none.
+ */
+class UbxValsetEncoder {
+   public:
+    UbxValsetEncoder();
+
+    void begin(uint8_t* buffer, uint32_t size, uint8_t layers, bool transaction);
+
+    /**
+     * Append a pair, the value size comes from the key.
+     * @return Return false if the key has no value size or the buffer is too small.
+     */
+    bool add(uint32_t key, uint64_t value);
+
+    /**
+     * Finish the frames.
+     * @return Return the length of all frames, 0 if any pair did not fit.
+     */
+    uint32_t end();
+
+    /**
+     * @return Return the frame at index in the buffer, nullptr past the last frame.
+     */
+    const uint8_t* frame(uint32_t index, uint32_t* length) const;
+
+    /**
+     * Value size of a key in bytes, 0 if the key has an invalid size field.
+     */
+    static uint32_t key_size(uint32_t key);
+
+    uint32_t frameCount;
+
+   private:
+    uint8_t* _buffer;
+    uint32_t _size;
+    uint32_t _length;
+    uint32_t _frame;  // offset of the open frame.
+    uint32_t _keys;   // pairs of the open frame.
+    uint8_t  _layers;
+    bool     _transaction;
+    bool     _overflow;
+
+    void _frame_close();
+};
+
+/**
+ * AckTracker fed with ACK-ACK and ACK-NAK frames.
+ */
+class UbxAckTracker : public AckTracker {
+   public:
+    using AckTracker::AckTracker;
+
+    /**
+     * @return Return true if frame answers a pending request.
+     */
+    bool receive(const struct UbxFrame* frame);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_UBX_CONFIG_HPP__
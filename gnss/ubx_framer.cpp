@@ -0,0 +1,14 @@
+#include "ubx_framer.hpp"
+
+namespace wibot::protocal::gnss {
+
+bool UbxFramerTraits::header(const uint8_t* header, uint32_t* headerLength, uint32_t* length,
+                             UbxFrame* frame) {
+    frame->msgClass = header[2];
+    frame->msgId    = header[3];
+    *headerLength   = UBX_HEADER_SIZE;
+    *length         = gnss_u2(header + 4);
+    return true;
+};
+
+}  // namespace wibot::protocal::gnss
@@ -0,0 +1,55 @@
+#ifndef __WWTALK_GNSS_UBX_FRAMER_HPP__
+#define __WWTALK_GNSS_UBX_FRAMER_HPP__
+#include "gnss_framer.hpp"
+#include "ubx.hpp"
+namespace wibot::protocal::gnss {
+
+/**
+ * A validated frame. payload points into the ring when the payload is contiguous there,
+ * otherwise into the payload buffer of the framer. Valid until the next parse or reset.
+ */
+struct UbxFrame {
+    uint8_t        msgClass;
+    uint8_t        msgId;
+    uint16_t       length;
+    const uint8_t* payload;
+
+    inline uint16_t classId() const {
+        return UBX_CLASSID(msgClass, msgId);
+    };
+};
+
+/**
+ * The UBX frame for GnssFramer: B5 62, class, id, the little-endian length and the payload,
+ * the Fletcher checksum over all but the sync chars.
+ */
+struct UbxFramerTraits {
+    typedef UbxFrame    Frame;
+    typedef UbxChecksum Checksum;
+
+    static constexpr uint32_t SYNC_SIZE      = 2;
+    static constexpr uint8_t  SYNC[]         = {UBX_SYNC_CHAR_1, UBX_SYNC_CHAR_2};
+    static constexpr uint8_t  SYNC_MASK[]    = {0xFF, 0xFF};
+    static constexpr uint32_t HEADER_SIZE    = UBX_HEADER_SIZE;
+    static constexpr uint32_t CHECKSUM_START = 2;
+    static constexpr uint32_t CHECKSUM_SIZE  = 2;
+
+    static bool header(const uint8_t* header, uint32_t* headerLength, uint32_t* length,
+                       UbxFrame* frame);
+    static inline bool check(const UbxChecksum& checksum, const uint8_t* bytes) {
+        return checksum.a == bytes[0] && checksum.b == bytes[1];
+    };
+    static inline void complete(UbxFrame*){};
+};
+
+/**
+ * Split the bytes of a ring into UBX frames, see GnssFramer.
+ */
+class UbxFramer : public GnssFramer<UbxFramerTraits> {
+   public:
+    using GnssFramer::GnssFramer;
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_UBX_FRAMER_HPP__
@@ -0,0 +1,129 @@
+#include "ubx_raw.hpp"
+
+namespace wibot::protocal::gnss {
+
+#define UBX_SFRBX_KEY(gnssId, svId, sigId) \
+    ((uint32_t)1 << 24 | (uint32_t)(gnssId) << 16 | (uint32_t)(svId) << 8 | (sigId))
+
+bool UbxRawxEpoch::validate(const uint8_t* payload, uint16_t length) {
+    return length >= UBX_RAWX_HEADER_SIZE &&
+           length == UBX_RAWX_HEADER_SIZE + UBX_RAWX_MEASUREMENT_SIZE * payload[11];
+};
+
+bool UbxRawxEpoch::decode(const uint8_t* payload, uint16_t length) {
+    if (!validate(payload, length)) return false;
+
+    rcvTow   = gnss_r8(payload + 0);
+    week     = gnss_u2(payload + 8);
+    leapS    = gnss_i1(payload + 10);
+    recStat  = gnss_u1(payload + 12);
+    version  = gnss_u1(payload + 13);
+    uint32_t numMeas = payload[11];
+    count     = numMeas < UBX_RAWX_MEASUREMENT_MAX_COUNT ? numMeas : UBX_RAWX_MEASUREMENT_MAX_COUNT;
+    truncated = numMeas - count;
+
+    const uint8_t* m = payload + UBX_RAWX_HEADER_SIZE;
+    uint32_t       n = count;
+    for (uint32_t i = 0; i < n; i++) {
+        pseudorange[i] = gnss_r8(m + UBX_RAWX_MEASUREMENT_SIZE * i + 0);
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        carrierPhase[i] = gnss_r8(m + UBX_RAWX_MEASUREMENT_SIZE * i + 8);
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        doppler[i] = gnss_r4(m + UBX_RAWX_MEASUREMENT_SIZE * i + 16);
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        const uint8_t* meas = m + UBX_RAWX_MEASUREMENT_SIZE * i;
+        gnssId[i]           = meas[20];
+        svId[i]             = meas[21];
+        sigId[i]            = meas[22];
+        freqId[i]           = meas[23];
+        lockTime[i]         = gnss_u2(meas + 24);
+        cno[i]              = meas[26];
+        trkStat[i]          = meas[30];
+    }
+    return true;
+};
+
+const uint32_t* UbxSfrbxSatellite::subframe(uint32_t back, uint8_t* count) const {
+    if (back >= subframeCount || back >= UBX_SFRBX_SUBFRAME_MAX_COUNT) {
+        return nullptr;
+    }
+    uint32_t index = (subframeCount - 1 - back) % UBX_SFRBX_SUBFRAME_MAX_COUNT;
+    *count         = numWords[index];
+    return words[index];
+};
+
+UbxSfrbxCollector::UbxSfrbxCollector() {
+    reset();
+};
+
+void UbxSfrbxCollector::reset() {
+    count     = 0;
+    overflows = 0;
+    evictions = 0;
+    _clock    = 0;
+};
+
+bool UbxSfrbxCollector::validate(const uint8_t* payload, uint16_t length) {
+    return length >= UBX_SFRBX_HEADER_SIZE && length == UBX_SFRBX_HEADER_SIZE + 4 * payload[4];
+};
+
+bool UbxSfrbxCollector::decode(const uint8_t* payload, uint16_t length) {
+    if (!validate(payload, length)) return false;
+
+    uint8_t numWords = payload[4];
+    if (numWords > UBX_SFRBX_WORD_MAX_COUNT) {
+        overflows++;
+        return false;
+    }
+
+    // sigId is reserved, so 0, before version 2 of the message.
+    uint32_t key = UBX_SFRBX_KEY(payload[0], payload[1], payload[2]);
+    uint32_t slot;
+    for (slot = 0; slot < count && _keys[slot] != key; slot++) {
+    }
+    if (slot == count) {
+        if (count < UBX_SFRBX_SATELLITE_MAX_COUNT) {
+            count++;
+        } else {
+            // Evict the satellite updated least recently, wrapping _clock compares alike.
+            slot = 0;
+            for (uint32_t i = 1; i < count; i++) {
+                if (_clock - _updates[i] > _clock - _updates[slot]) slot = i;
+            }
+            evictions++;
+        }
+        UbxSfrbxSatellite* satellite = &satellites[slot];
+        satellite->gnssId            = payload[0];
+        satellite->svId              = payload[1];
+        satellite->sigId             = payload[2];
+        satellite->subframeCount     = 0;
+        _keys[slot]                  = key;
+    }
+
+    UbxSfrbxSatellite* satellite = &satellites[slot];
+    uint32_t           index     = satellite->subframeCount % UBX_SFRBX_SUBFRAME_MAX_COUNT;
+    satellite->freqId            = payload[3];
+    satellite->numWords[index]   = numWords;
+    for (uint32_t i = 0; i < numWords; i++) {
+        satellite->words[index][i] = gnss_u4(payload + UBX_SFRBX_HEADER_SIZE + 4 * i);
+    }
+    satellite->subframeCount++;
+    _updates[slot] = _clock++;
+    return true;
+};
+
+const struct UbxSfrbxSatellite* UbxSfrbxCollector::find(uint8_t gnssId, uint8_t svId,
+                                                        uint8_t sigId) const {
+    uint32_t key = UBX_SFRBX_KEY(gnssId, svId, sigId);
+    for (uint32_t slot = 0; slot < count; slot++) {
+        if (_keys[slot] == key) {
+            return &satellites[slot];
+        }
+    }
+    return nullptr;
+};
+
+}  // namespace wibot::protocal::gnss
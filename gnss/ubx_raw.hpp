@@ -0,0 +1,107 @@
+#ifndef __WWTALK_GNSS_UBX_RAW_HPP__
+#define __WWTALK_GNSS_UBX_RAW_HPP__
+#include "base.hpp"
+#include "ubx.hpp"
+namespace wibot::protocal::gnss {
+
+#define UBX_RAWX_MEASUREMENT_MAX_COUNT 64
+#define UBX_RAWX_HEADER_SIZE 16
+#define UBX_RAWX_MEASUREMENT_SIZE 32
+
+#define UBX_SFRBX_SATELLITE_MAX_COUNT 48  // satellite and signal pairs.
+#define UBX_SFRBX_SUBFRAME_MAX_COUNT 5    // a GPS LNAV frame.
+#define UBX_SFRBX_WORD_MAX_COUNT 10
+#define UBX_SFRBX_HEADER_SIZE 8
+
+/**
+ * The measurements of an RXM-RAWX epoch, one column per field. Columns are filled by one loop
+ * each, reading a field at a fixed stride of the payload, so every loop compiles to plain
+ * strided loads and stores without branches.
+ */
+struct UbxRawxEpoch {
+    double   rcvTow;  // s
+    uint16_t week;
+    int8_t   leapS;
+    uint8_t  recStat;
+    uint8_t  version;
+    uint32_t count;      // measurements decoded.
+    uint32_t truncated;  // measurements of the epoch beyond the columns.
+
+    double   pseudorange[UBX_RAWX_MEASUREMENT_MAX_COUNT];   // m
+    double   carrierPhase[UBX_RAWX_MEASUREMENT_MAX_COUNT];  // cycles
+    float    doppler[UBX_RAWX_MEASUREMENT_MAX_COUNT];       // Hz
+    uint16_t lockTime[UBX_RAWX_MEASUREMENT_MAX_COUNT];      // ms
+    uint8_t  cno[UBX_RAWX_MEASUREMENT_MAX_COUNT];           // dBHz
+    uint8_t  gnssId[UBX_RAWX_MEASUREMENT_MAX_COUNT];
+    uint8_t  svId[UBX_RAWX_MEASUREMENT_MAX_COUNT];
+    uint8_t  sigId[UBX_RAWX_MEASUREMENT_MAX_COUNT];
+    uint8_t  freqId[UBX_RAWX_MEASUREMENT_MAX_COUNT];
+    uint8_t  trkStat[UBX_RAWX_MEASUREMENT_MAX_COUNT];
+
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    /**
+     * Replace the epoch by the one of payload. Measurements beyond the columns are counted in
+     * truncated and not decoded.
+     * @return Return false if the payload length does not match its numMeas.
+     */
+    bool decode(const uint8_t* payload, uint16_t length);
+};
+
+/**
+ * The last subframes received on a signal of a satellite, oldest overwritten first.
+ */
+struct UbxSfrbxSatellite {
+    uint8_t  gnssId;
+    uint8_t  svId;
+    uint8_t  sigId;
+    uint8_t  freqId;
+    uint32_t subframeCount;  // received since the slot was taken.
+    uint8_t  numWords[UBX_SFRBX_SUBFRAME_MAX_COUNT];
+    uint32_t words[UBX_SFRBX_SUBFRAME_MAX_COUNT][UBX_SFRBX_WORD_MAX_COUNT];
+
+    /**
+     * @param back 0 for the last subframe, 1 for the one before...
+     * @return Return the words of the subframe, nullptr if it was not received or overwritten.
+     */
+    const uint32_t* subframe(uint32_t back, uint8_t* count) const;
+};
+
+/**
+ * Collect the navigation words of RXM-SFRBX by satellite and signal, in a fixed table. Once the
+ * table is full, a new satellite takes the slot of the one updated least recently, as satellites
+ * set or signals are lost.
+ */
+class UbxSfrbxCollector {
+   public:
+    UbxSfrbxCollector();
+
+    static bool validate(const uint8_t* payload, uint16_t length);
+
+    /**
+     * Append the subframe of payload to its satellite.
+     * @return Return false if the payload is invalid or has more words than a subframe holds.
+     */
+    bool decode(const uint8_t* payload, uint16_t length);
+
+    const struct UbxSfrbxSatellite* find(uint8_t gnssId, uint8_t svId, uint8_t sigId) const;
+
+    /**
+     * Release all satellites.
+     */
+    void reset();
+
+    struct UbxSfrbxSatellite satellites[UBX_SFRBX_SATELLITE_MAX_COUNT];
+    uint32_t                 count;
+    uint32_t                 overflows;  // subframes dropped, too many words.
+    uint32_t                 evictions;  // satellites evicted for a new one, the table full.
+
+   private:
+    uint32_t _keys[UBX_SFRBX_SATELLITE_MAX_COUNT];
+    uint32_t _updates[UBX_SFRBX_SATELLITE_MAX_COUNT];  // _clock of the last subframe.
+    uint32_t _clock;
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_UBX_RAW_HPP__
@@ -0,0 +1,17 @@
+#include "ubx_registry.hpp"
+
+namespace wibot::protocal::gnss {
+
+bool UbxRegistry::message_register_default(UbxMessageHandler handler, void* context) {
+    return message_register(UBX_CLASSID_NAV_PVT, UbxNavPvtView::validate, handler, context) &&
+           message_register(UBX_CLASSID_NAV_HPPOSLLH, UbxNavHpposllhView::validate, handler,
+                            context) &&
+           message_register(UBX_CLASSID_NAV_SAT, UbxNavSatView::validate, handler, context) &&
+           message_register(UBX_CLASSID_NAV_SIG, UbxNavSigView::validate, handler, context) &&
+           message_register(UBX_CLASSID_NAV_TIMEUTC, UbxNavTimeUtcView::validate, handler,
+                            context) &&
+           message_register(UBX_CLASSID_MON_HW, UbxMonHwView::validate, handler, context) &&
+           message_register(UBX_CLASSID_ESF_MEAS, UbxEsfMeasView::validate, handler, context);
+};
+
+}  // namespace wibot::protocal::gnss
@@ -0,0 +1,31 @@
+#ifndef __WWTALK_GNSS_UBX_REGISTRY_HPP__
+#define __WWTALK_GNSS_UBX_REGISTRY_HPP__
+#include "base.hpp"
+#include "gnss_registry.hpp"
+#include "ubx.hpp"
+#include "ubx_framer.hpp"
+namespace wibot::protocal::gnss {
+
+#define UBX_REGISTRY_CLASS_MAX_COUNT 8     // distinct message classes.
+#define UBX_REGISTRY_MESSAGE_MAX_COUNT 32  // at most 255.
+
+typedef GnssMessageValidator       UbxMessageValidator;
+typedef GnssMessageEntry<UbxFrame> UbxMessageEntry;
+typedef UbxMessageEntry::Handler   UbxMessageHandler;
+
+/**
+ * UBX messages keyed by class and id, see GnssRegistry.
+ */
+class UbxRegistry : public GnssRegistry<UbxFrame, UBX_REGISTRY_CLASS_MAX_COUNT,
+                                        UBX_REGISTRY_MESSAGE_MAX_COUNT> {
+   public:
+    /**
+     * Register NAV-PVT, NAV-HPPOSLLH, NAV-SAT, NAV-SIG, NAV-TIMEUTC, MON-HW and ESF-MEAS with
+     * the validate of their view, all handled by handler.
+     */
+    bool message_register_default(UbxMessageHandler handler, void* context);
+};
+
+}  // namespace wibot::protocal::gnss
+
+#endif  // __WWTALK_GNSS_UBX_REGISTRY_HPP__
@@ -0,0 +1,515 @@
+#include "ubx_test.hpp"
+
+#include "CircularBuffer.hpp"
+#include "minunit.h"
+#include "string.h"
+#include "ubx.hpp"
+#include "ubx_config.hpp"
+#include "ubx_framer.hpp"
+#include "ubx_raw.hpp"
+#include "ubx_registry.hpp"
+
+namespace wibot::protocal::gnss::test {
+
+static uint32_t ubx_test_frame(uint8_t* buffer, uint8_t msgClass, uint8_t msgId,
+                               const uint8_t* payload, uint16_t length) {
+    buffer[0] = UBX_SYNC_CHAR_1;
+    buffer[1] = UBX_SYNC_CHAR_2;
+    buffer[2] = msgClass;
+    buffer[3] = msgId;
+    buffer[4] = length & 0xFF;
+    buffer[5] = length >> 8;
+    memcpy(buffer + UBX_HEADER_SIZE, payload, length);
+
+    UbxChecksum checksum;
+    checksum.reset();
+    checksum.update(buffer + 2, length + 4);
+    buffer[UBX_HEADER_SIZE + length]     = checksum.a;
+    buffer[UBX_HEADER_SIZE + length + 1] = checksum.b;
+    return length + UBX_FRAME_OVERHEAD;
+};
+
+static void ubx_parse_test() {
+    uint8_t payload[92];
+    uint8_t frame[100];
+    for (int i = 0; i < 92; i++) {
+        payload[i] = i * 7;
+    }
+    uint32_t length = ubx_test_frame(frame, 0x01, 0x07, payload, 92);
+
+    uint16_t classId;
+    void*    data;
+    MU_ASSERT(ubx_parse(frame, length, &classId, &data));
+    MU_ASSERT(classId == UBX_CLASSID_NAV_PVT && data == frame + UBX_HEADER_SIZE);
+    // The length field must match the frame.
+    MU_ASSERT(!ubx_parse(frame, length - 1, &classId, &data));
+    frame[10] ^= 1;
+    MU_ASSERT(!ubx_parse(frame, length, &classId, &data));
+}
+
+static void ubx_framer_test() {
+    uint8_t         ring[256];
+    uint8_t         scratch[128];
+    CircularBuffer8 rb(ring, sizeof(ring));
+    UbxFramer       framer(rb, {.data = scratch, .size = sizeof(scratch)});
+    UbxFrame        frame;
+
+    uint8_t payload[100];
+    uint8_t stream[512];
+    for (int i = 0; i < 100; i++) {
+        payload[i] = i;
+    }
+    uint32_t length = 0;
+    stream[length++] = 0x00;
+    stream[length++] = UBX_SYNC_CHAR_1;  // a lone sync char.
+    length += ubx_test_frame(stream + length, 0x01, 0x07, payload, 92);
+    length += ubx_test_frame(stream + length, 0x0A, 0x09, payload, 60);
+    uint32_t corrupted = length;
+    length += ubx_test_frame(stream + length, 0x01, 0x35, payload, 20);
+    stream[corrupted + 10] ^= 0xFF;
+    length += ubx_test_frame(stream + length, 0x05, 0x01, payload, 2);
+
+    // Fed byte by byte, the checksum is updated across calls.
+    uint16_t classIds[4];
+    uint16_t lengths[4];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        rb.write(&stream[i], 1, true);
+        while (framer.parse(&frame)) {
+            MU_ASSERT(!memcmp(frame.payload, payload, frame.length));
+            if (count < 4) {
+                classIds[count] = frame.classId();
+                lengths[count]  = frame.length;
+            }
+            count++;
+        }
+    }
+    MU_ASSERT(count == 3);
+    MU_ASSERT(classIds[0] == UBX_CLASSID_NAV_PVT && lengths[0] == 92);
+    MU_ASSERT(classIds[1] == UBX_CLASSID(0x0A, 0x09) && lengths[1] == 60);
+    MU_ASSERT(classIds[2] == UBX_CLASSID(0x05, 0x01) && lengths[2] == 2);
+    MU_ASSERT(framer.checksumErrors == 1 && framer.frameCount == 3);
+
+    // A length beyond the payload buffer is dropped on the header, without waiting for it.
+    uint8_t big[8] = {UBX_SYNC_CHAR_1, UBX_SYNC_CHAR_2, 0x02, 0x15, 0xFF, 0x7F, 0x00, 0x00};
+    rb.write(big, sizeof(big), true);
+    length = ubx_test_frame(stream, 0x01, 0x07, payload, 92);
+    rb.write(stream, length, true);
+    MU_ASSERT(framer.parse(&frame) && frame.classId() == UBX_CLASSID_NAV_PVT);
+    MU_ASSERT(framer.lengthErrors == 1);
+
+    // Payloads wrapping around the end of the ring are copied to the payload buffer.
+    for (int i = 0; i < 8; i++) {
+        length = ubx_test_frame(stream, 0x01, 0x07, payload, 92);
+        rb.write(stream, length, true);
+        MU_ASSERT(framer.parse(&frame) && frame.length == 92);
+        MU_ASSERT(!memcmp(frame.payload, payload, 92));
+    }
+    MU_ASSERT(!framer.parse(&frame) && rb.getSize() == 0);
+
+    // A payload buffer larger than the ring, a length the ring cannot hold is dropped too.
+    uint8_t         smallRing[64];
+    CircularBuffer8 smallRb(smallRing, sizeof(smallRing));
+    UbxFramer       smallFramer(smallRb, {.data = scratch, .size = sizeof(scratch)});
+    big[4] = 60;
+    big[5] = 0;
+    smallRb.write(big, sizeof(big), true);
+    length = ubx_test_frame(stream, 0x01, 0x07, payload, 20);
+    smallRb.write(stream, length, true);
+    MU_ASSERT(smallFramer.parse(&frame) && frame.length == 20);
+    MU_ASSERT(smallFramer.lengthErrors == 1);
+}
+
+struct UbxTestRecord {
+    uint32_t count;
+    uint16_t classId;
+    int32_t  lat;
+    int64_t  latNano;
+    uint8_t  numSvs;
+    uint8_t  cno;
+    int32_t  dataField;
+};
+
+static void ubx_test_handler(void* context, const UbxFrame* frame) {
+    auto record = (UbxTestRecord*)context;
+    record->count++;
+    record->classId = frame->classId();
+    switch (frame->classId()) {
+        case UBX_CLASSID_NAV_PVT:
+            record->lat = UbxNavPvtView(frame->payload).lat();
+            break;
+        case UBX_CLASSID_NAV_HPPOSLLH:
+            record->latNano = UbxNavHpposllhView(frame->payload).latNano();
+            break;
+        case UBX_CLASSID_NAV_SAT: {
+            UbxNavSatView sat(frame->payload);
+            record->numSvs = sat.numSvs();
+            record->cno    = sat.cno(sat.numSvs() - 1);
+        } break;
+        case UBX_CLASSID_ESF_MEAS:
+            record->dataField = UbxEsfMeasView(frame->payload).dataField(1);
+            break;
+        default:
+            break;
+    }
+};
+
+static void ubx_registry_test() {
+    UbxTestRecord record;
+    memset(&record, 0, sizeof(record));
+    UbxRegistry registry;
+    MU_ASSERT(registry.message_register_default(ubx_test_handler, &record));
+    MU_ASSERT(registry.message_find(UBX_CLASSID_NAV_SIG) != nullptr);
+    MU_ASSERT(registry.message_find(UBX_CLASSID(0x01, 0x15)) == nullptr);
+    MU_ASSERT(registry.message_find(UBX_CLASSID(0x02, 0x15)) == nullptr);
+
+    // Views read at any alignment, the payload starts at an odd address.
+    uint8_t  storage[128];
+    uint8_t* payload = storage + 1;
+    UbxFrame frame;
+    frame.payload = payload;
+
+    memset(storage, 0, sizeof(storage));
+    frame.msgClass = 0x01;
+    frame.msgId    = 0x07;
+    frame.length   = 92;
+    payload[28]    = 0x78;  // lat = -123456392 = 0xF8A4_3278
+    payload[29]    = 0x32;
+    payload[30]    = 0xA4;
+    payload[31]    = 0xF8;
+    MU_ASSERT(registry.dispatch(&frame));
+    MU_ASSERT(record.classId == UBX_CLASSID_NAV_PVT && record.lat == (int32_t)0xF8A43278);
+    frame.length = 84;
+    MU_ASSERT(!registry.dispatch(&frame) && registry.lengthErrors == 1);
+
+    memset(storage, 0, sizeof(storage));
+    frame.msgClass = 0x01;
+    frame.msgId    = 0x14;
+    frame.length   = 36;
+    payload[12]    = 10;   // lat
+    payload[25]    = 0xFB;  // latHp = -5
+    MU_ASSERT(registry.dispatch(&frame) && record.latNano == 995);
+
+    // NAV-SAT is 8 bytes plus 12 per satellite.
+    memset(storage, 0, sizeof(storage));
+    frame.msgClass = 0x01;
+    frame.msgId    = 0x35;
+    payload[5]     = 3;
+    payload[8 + 12 * 2 + 2] = 42;
+    frame.length   = 8 + 12 * 3;
+    MU_ASSERT(registry.dispatch(&frame) && record.numSvs == 3 && record.cno == 42);
+    frame.length = 8 + 12 * 2;
+    MU_ASSERT(!registry.dispatch(&frame) && registry.lengthErrors == 2);
+
+    // ESF-MEAS, 2 measurements and a calibrated time tag.
+    memset(storage, 0, sizeof(storage));
+    frame.msgClass = 0x10;
+    frame.msgId    = 0x02;
+    payload[4]     = 0x08;
+    payload[5]     = 2 << 3;
+    payload[12]    = 0xFE;  // -2
+    payload[13]    = 0xFF;
+    payload[14]    = 0xFF;
+    payload[15]    = 14;  // gyro z
+    frame.length   = 8 + 4 * 2 + 4;
+    MU_ASSERT(registry.dispatch(&frame) && record.dataField == -2);
+    MU_ASSERT(UbxEsfMeasView(payload).dataType(1) == 14);
+
+    frame.msgClass = 0x01;
+    frame.msgId    = 0x15;
+    MU_ASSERT(!registry.dispatch(&frame) && registry.unknownCount == 1);
+    MU_ASSERT(record.count == 4);
+}
+
+static void ubx_test_put(uint8_t* p, uint64_t value, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+        p[i] = value >> (8 * i);
+    }
+};
+
+static void ubx_test_put_r8(uint8_t* p, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    ubx_test_put(p, bits, 8);
+};
+
+static void ubx_test_put_r4(uint8_t* p, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    ubx_test_put(p, bits, 4);
+};
+
+static uint8_t rawStorage[UBX_RAWX_HEADER_SIZE + UBX_RAWX_MEASUREMENT_SIZE * 80 + 1];
+static struct UbxRawxEpoch rawEpoch;
+
+static void ubx_raw_test() {
+    uint8_t* payload = rawStorage + 1;
+    memset(rawStorage, 0, sizeof(rawStorage));
+    ubx_test_put_r8(payload, 345600.5);
+    ubx_test_put(payload + 8, 2335, 2);
+    payload[10] = 18;
+    payload[11] = 3;
+    payload[12] = 0x01;
+    for (uint32_t i = 0; i < 3; i++) {
+        uint8_t* meas = payload + UBX_RAWX_HEADER_SIZE + UBX_RAWX_MEASUREMENT_SIZE * i;
+        ubx_test_put_r8(meas, 20000000.25 + i);
+        ubx_test_put_r8(meas + 8, -1234567.5 * (i + 1));
+        ubx_test_put_r4(meas + 16, -512.5f + i);
+        meas[20] = i;  // GPS, SBAS, Galileo.
+        meas[21] = 10 + i;
+        meas[22] = i == 2 ? 6 : 0;
+        ubx_test_put(meas + 24, 64500 + i, 2);
+        meas[26] = 40 + i;
+        meas[30] = 0x0F;
+    }
+    uint16_t length = UBX_RAWX_HEADER_SIZE + UBX_RAWX_MEASUREMENT_SIZE * 3;
+
+    MU_ASSERT(rawEpoch.decode(payload, length));
+    MU_ASSERT(rawEpoch.rcvTow == 345600.5 && rawEpoch.week == 2335 && rawEpoch.leapS == 18);
+    MU_ASSERT(rawEpoch.count == 3 && rawEpoch.truncated == 0);
+    MU_ASSERT(rawEpoch.pseudorange[2] == 20000002.25);
+    MU_ASSERT(rawEpoch.carrierPhase[1] == -2469135.0);
+    MU_ASSERT(rawEpoch.doppler[0] == -512.5f);
+    MU_ASSERT(rawEpoch.gnssId[2] == 2 && rawEpoch.svId[2] == 12 && rawEpoch.sigId[2] == 6);
+    MU_ASSERT(rawEpoch.lockTime[1] == 64501 && rawEpoch.cno[1] == 41);
+    MU_ASSERT(rawEpoch.trkStat[0] == 0x0F);
+    MU_ASSERT(!rawEpoch.decode(payload, length - 1));
+
+    // More measurements than columns.
+    payload[11] = 80;
+    length      = UBX_RAWX_HEADER_SIZE + UBX_RAWX_MEASUREMENT_SIZE * 80;
+    MU_ASSERT(rawEpoch.decode(payload, length));
+    MU_ASSERT(rawEpoch.count == UBX_RAWX_MEASUREMENT_MAX_COUNT && rawEpoch.truncated == 16);
+    MU_ASSERT(rawEpoch.svId[1] == 11);
+
+    UbxSfrbxCollector collector;
+    memset(rawStorage, 0, sizeof(rawStorage));
+    payload[0] = 0;  // GPS 5 L1C/A
+    payload[1] = 5;
+    payload[4] = 10;
+    payload[6] = 2;
+    for (uint32_t subframe = 1; subframe <= 6; subframe++) {
+        for (uint32_t i = 0; i < 10; i++) {
+            ubx_test_put(payload + UBX_SFRBX_HEADER_SIZE + 4 * i, subframe * 100 + i, 4);
+        }
+        MU_ASSERT(collector.decode(payload, UBX_SFRBX_HEADER_SIZE + 40));
+    }
+    payload[1] = 7;
+    MU_ASSERT(collector.decode(payload, UBX_SFRBX_HEADER_SIZE + 40));
+    MU_ASSERT(!collector.decode(payload, UBX_SFRBX_HEADER_SIZE + 36));
+    payload[4] = 11;
+    MU_ASSERT(!collector.decode(payload, UBX_SFRBX_HEADER_SIZE + 44) && collector.overflows == 1);
+
+    MU_ASSERT(collector.count == 2 && collector.find(0, 5, 1) == nullptr);
+    const struct UbxSfrbxSatellite* satellite = collector.find(0, 5, 0);
+    uint8_t                         words;
+    MU_ASSERT(satellite != nullptr && satellite->subframeCount == 6);
+    const uint32_t* subframe = satellite->subframe(0, &words);
+    MU_ASSERT(subframe != nullptr && words == 10 && subframe[9] == 609);
+    subframe = satellite->subframe(4, &words);
+    MU_ASSERT(subframe != nullptr && subframe[0] == 200);
+    MU_ASSERT(satellite->subframe(5, &words) == nullptr);
+    MU_ASSERT(collector.find(0, 7, 0)->subframe(1, &words) == nullptr);
+
+    // A full table evicts the satellite updated least recently.
+    payload[4] = 10;
+    for (uint32_t svId = 10; svId < 10 + UBX_SFRBX_SATELLITE_MAX_COUNT - 1; svId++) {
+        payload[1] = svId;
+        MU_ASSERT(collector.decode(payload, UBX_SFRBX_HEADER_SIZE + 40));
+    }
+    MU_ASSERT(collector.count == UBX_SFRBX_SATELLITE_MAX_COUNT && collector.evictions == 1);
+    MU_ASSERT(collector.find(0, 5, 0) == nullptr && collector.find(0, 7, 0) != nullptr);
+    MU_ASSERT(collector.find(0, 56, 0)->subframeCount == 1);
+}
+
+#define UBX_TEST_KEY_COUNT 100
+#define UBX_TEST_KEY_UNKNOWN 0x4099FFFF
+
+/**
+ * Stand-in for a receiver: applies CFG-VALSET transactions and answers ACK-ACK, or ACK-NAK if
+ * any key is unknown, as a receiver does.
+ */
+struct UbxTestReceiver {
+    uint8_t  inRing[2048];
+    uint8_t  outRing[256];
+    uint8_t  scratch[1024];
+    uint64_t values[UBX_TEST_KEY_COUNT];
+    uint64_t staged[UBX_TEST_KEY_COUNT];
+    bool     failed;
+    uint32_t frames;
+
+    bool key_apply(uint64_t* table, uint32_t key, const uint8_t* value) {
+        uint32_t index = key & 0xFFFF;
+        if (index >= UBX_TEST_KEY_COUNT) return false;
+        uint64_t v = 0;
+        for (uint32_t i = 0; i < UbxValsetEncoder::key_size(key); i++) {
+            v |= (uint64_t)value[i] << (8 * i);
+        }
+        table[index] = v;
+        return true;
+    };
+
+    void answer(CircularBuffer8& out, uint16_t classId, bool ack) {
+        uint8_t  frame[10];
+        uint8_t  payload[2] = {(uint8_t)(classId & 0xFF), (uint8_t)(classId >> 8)};
+        uint16_t answer     = ack ? UBX_CLASSID_ACK_ACK : UBX_CLASSID_ACK_NAK;
+        uint32_t length     = ubx_encode(frame, sizeof(frame), answer, payload, 2);
+        out.write(frame, length, false);
+    };
+
+    void process(CircularBuffer8& in, CircularBuffer8& out) {
+        UbxFramer framer(in, {.data = scratch, .size = sizeof(scratch)});
+        UbxFrame  frame;
+        while (framer.parse(&frame)) {
+            frames++;
+            if (frame.classId() != UBX_CLASSID_CFG_VALSET) continue;
+
+            const uint8_t* p           = frame.payload;
+            uint8_t        transaction = p[0] == 1 ? p[2] : 0;
+            if (transaction <= 1) {
+                memcpy(staged, values, sizeof(values));
+                failed = false;
+            }
+            bool ok = true;
+            for (uint32_t offset = UBX_VALSET_HEADER_SIZE; offset < frame.length;) {
+                uint32_t key = gnss_u4(p + offset);
+                ok           = key_apply(staged, key, p + offset + 4) && ok;
+                offset += 4 + UbxValsetEncoder::key_size(key);
+            }
+            failed = failed || !ok;
+            if ((transaction == 0 || transaction == 3) && !failed) {
+                memcpy(values, staged, sizeof(values));
+            }
+            answer(out, frame.classId(), ok);
+        }
+    };
+};
+
+struct UbxTestAcks {
+    uint32_t   count;
+    uint32_t   tags[16];
+    ACK_RESULT results[16];
+};
+
+static void ubx_test_ack(void* context, uint32_t tag, ACK_RESULT result) {
+    auto acks                    = (UbxTestAcks*)context;
+    acks->tags[acks->count]      = tag;
+    acks->results[acks->count++] = result;
+};
+
+static uint64_t ubx_test_key_value(uint32_t key, uint32_t i) {
+    switch (key >> 28) {
+        case 1:
+            return i & 1;
+        case 5:
+            return 0x0102030405060708ULL + i;
+        default:
+            return (i * 37) & ((1ULL << (8 * UbxValsetEncoder::key_size(key))) - 1);
+    }
+};
+
+static uint8_t               configBuffer[2048];
+static struct UbxTestReceiver configReceiver;
+
+static void ubx_config_test() {
+    // 1 bit, U1, U2, U4 and U8 keys in turn.
+    static const uint32_t sizes[] = {0x10000000, 0x20000000, 0x30000000, 0x40000000, 0x50000000};
+    UbxValsetEncoder      encoder;
+    encoder.begin(configBuffer, sizeof(configBuffer), UBX_CFG_LAYER_RAM | UBX_CFG_LAYER_BBR, true);
+    for (uint32_t i = 0; i < UBX_TEST_KEY_COUNT; i++) {
+        uint32_t key = sizes[i % 5] | 0x00910000 | i;
+        MU_ASSERT(encoder.add(key, ubx_test_key_value(key, i)));
+    }
+    uint32_t length = encoder.end();
+    MU_ASSERT(length > 0 && encoder.frameCount == 2);  // 64 keys at most per frame.
+
+    uint32_t frameLength;
+    uint8_t* first = (uint8_t*)encoder.frame(0, &frameLength);
+    uint16_t classId;
+    void*    payload;
+    MU_ASSERT(ubx_parse(first, frameLength, &classId, &payload));
+    MU_ASSERT(classId == UBX_CLASSID_CFG_VALSET && first[UBX_HEADER_SIZE + 2] == 1);
+    uint8_t* second = (uint8_t*)encoder.frame(1, &frameLength);
+    MU_ASSERT(second == first + (length - frameLength) && second[UBX_HEADER_SIZE + 2] == 3);
+    MU_ASSERT(ubx_parse(second, frameLength, &classId, &payload));
+    MU_ASSERT(encoder.frame(2, &frameLength) == nullptr);
+
+    // All frames in one burst, answered in one round trip.
+    UbxTestReceiver* receiver = &configReceiver;
+    memset(receiver, 0, sizeof(*receiver));
+    CircularBuffer8 toReceiver(receiver->inRing, sizeof(receiver->inRing));
+    CircularBuffer8 fromReceiver(receiver->outRing, sizeof(receiver->outRing));
+    uint8_t         scratch[16];
+    UbxFramer       framer(fromReceiver, {.data = scratch, .size = sizeof(scratch)});
+    UbxFrame        frame;
+    UbxTestAcks     acks;
+    memset(&acks, 0, sizeof(acks));
+    UbxAckTracker tracker(100, ubx_test_ack, &acks);
+
+    for (uint32_t i = 0; i < encoder.frameCount; i++) {
+        const uint8_t* data = encoder.frame(i, &frameLength);
+        toReceiver.write((uint8_t*)data, frameLength, false);
+        MU_ASSERT(tracker.sent(UBX_CLASSID_CFG_VALSET, i, 0));
+    }
+    MU_ASSERT(tracker.pending() == 2);
+    receiver->process(toReceiver, fromReceiver);
+    while (framer.parse(&frame)) {
+        MU_ASSERT(tracker.receive(&frame));
+    }
+    MU_ASSERT(tracker.pending() == 0 && tracker.acked == 2 && acks.count == 2);
+    MU_ASSERT(acks.tags[0] == 0 && acks.tags[1] == 1 && acks.results[1] == ACK_RESULT::ACK);
+    MU_ASSERT(receiver->values[4] == 0x0102030405060708ULL + 4);
+    MU_ASSERT(receiver->values[98] == 98 * 37 && receiver->values[95] == 1);
+
+    // An unknown key fails its transaction, nothing is applied.
+    encoder.begin(configBuffer, sizeof(configBuffer), UBX_CFG_LAYER_RAM, true);
+    for (uint32_t i = 0; i < 70; i++) {
+        MU_ASSERT(encoder.add(0x20910000 | (i % UBX_TEST_KEY_COUNT), 0xAA));
+    }
+    MU_ASSERT(encoder.add(UBX_TEST_KEY_UNKNOWN, 1));
+    MU_ASSERT(encoder.end() > 0 && encoder.frameCount == 2);
+    for (uint32_t i = 0; i < encoder.frameCount; i++) {
+        const uint8_t* data = encoder.frame(i, &frameLength);
+        toReceiver.write((uint8_t*)data, frameLength, false);
+        MU_ASSERT(tracker.sent(UBX_CLASSID_CFG_VALSET, 10 + i, 5));
+    }
+    receiver->process(toReceiver, fromReceiver);
+    while (framer.parse(&frame)) {
+        MU_ASSERT(tracker.receive(&frame));
+    }
+    MU_ASSERT(tracker.acked == 3 && tracker.naked == 1 && acks.results[3] == ACK_RESULT::NAK);
+    MU_ASSERT(acks.tags[3] == 11 && receiver->values[1] == 37);
+
+    // Unanswered requests time out, oldest first, and the window bounds the requests in flight.
+    for (uint32_t i = 0; i < ACK_TRACKER_MAX_PENDING; i++) {
+        MU_ASSERT(tracker.sent(UBX_CLASSID_CFG_VALSET, 20 + i, 200 + i));
+    }
+    MU_ASSERT(!tracker.sent(UBX_CLASSID_CFG_VALSET, 28, 210));
+    MU_ASSERT(tracker.expire(299) == 0 && tracker.expire(301) == 2);
+    MU_ASSERT(acks.tags[4] == 20 && acks.results[5] == ACK_RESULT::TIMEOUT);
+    MU_ASSERT(tracker.pending() == ACK_TRACKER_MAX_PENDING - 2);
+
+    // A frame that is not an answer, or answers nothing pending, is ignored.
+    uint8_t ackPayload[2] = {0x06, 0x01};
+    frame.msgClass        = 0x05;
+    frame.msgId           = 0x01;
+    frame.length          = 2;
+    frame.payload         = ackPayload;
+    MU_ASSERT(!tracker.receive(&frame));
+
+    // Too small a buffer or a key without a size fails the whole batch.
+    encoder.begin(configBuffer, 24, UBX_CFG_LAYER_RAM, false);
+    MU_ASSERT(encoder.add(0x40910000, 1) && !encoder.add(0x40910001, 2) && encoder.end() == 0);
+    encoder.begin(configBuffer, sizeof(configBuffer), UBX_CFG_LAYER_RAM, false);
+    MU_ASSERT(!encoder.add(0x70910000, 1) && encoder.end() == 0);
+}
+
+void ubx_test() {
+    ubx_parse_test();
+    ubx_framer_test();
+    ubx_registry_test();
+    ubx_raw_test();
+    ubx_config_test();
+}
+
+}  // namespace wibot::protocal::gnss::test
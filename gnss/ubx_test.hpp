@@ -0,0 +1,8 @@
+#ifndef __WWTALK_UBX_TEST_HPP__
+#define __WWTALK_UBX_TEST_HPP__
+
+namespace wibot::protocal::gnss::test {
+void ubx_test();
+}
+
+#endif  // __WWTALK_UBX_TEST_HPP__
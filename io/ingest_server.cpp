@@ -0,0 +1,651 @@
+#include "ingest_server.hpp"
+#ifdef __linux__
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <new>
+
+namespace wibot::comm {
+
+// epoll tags and io_uring user data, other values are connections.
+#define INGEST_SERVER_TAG_LISTEN 0xFFFFFFF0U
+#define INGEST_SERVER_TAG_UDP 0xFFFFFFF1U
+#define INGEST_SERVER_TAG_EPOLL 0xFFFFFFF2U
+#define INGEST_SERVER_TAG_TIMEOUT 0xFFFFFFF3U
+
+#define INGEST_SERVER_UDP_EMPTY 0
+#define INGEST_SERVER_UDP_REMOVED 0xFFFF
+#define INGEST_SERVER_UDP_REMOVED_MAX_COUNT (INGEST_SERVER_UDP_TABLE_SIZE / 4)  // then rehashed.
+
+static_assert(INGEST_SERVER_CONNECTION_MAX_COUNT < INGEST_SERVER_UDP_REMOVED,
+              "connections are stored + 1 in uint16_t");
+static_assert(INGEST_SERVER_UDP_TABLE_SIZE >= 2 * INGEST_SERVER_CONNECTION_MAX_COUNT,
+              "the UDP table is at most half full");
+static_assert(INGEST_SERVER_UDP_TABLE_SIZE / 2 + INGEST_SERVER_UDP_REMOVED_MAX_COUNT <
+                  INGEST_SERVER_UDP_TABLE_SIZE,
+              "a probe of the UDP table always ends on an empty slot");
+
+static inline uint64_t ingest_server_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+};
+
+static inline uint32_t ingest_server_udp_hash(uint32_t address, uint16_t port) {
+    return (address * 2654435761U) ^ (port * 40503U);
+};
+
+static int ingest_server_socket(int type, uint32_t address, uint16_t* port) {
+    int fd = socket(AF_INET, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr;
+    socklen_t          length = sizeof(addr);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(address);
+    addr.sin_port        = htons(*port);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        (type == SOCK_STREAM && listen(fd, INGEST_SERVER_BACKLOG) != 0) ||
+        getsockname(fd, (struct sockaddr*)&addr, &length) != 0) {
+        int error = errno;
+        ::close(fd);
+        errno = error;
+        return -1;
+    }
+    *port = ntohs(addr.sin_port);
+    return fd;
+};
+
+IngestServer::IngestServer(Buffer8 storage, const IngestServerHooks& hooks)
+    : registered(false),
+      lastError(0),
+      _storage(storage),
+      _hooks(hooks),
+      _ringSize(0),
+      _udpRemovedCount(0),
+      _connectionCount(0),
+      _freeCount(0),
+      _udpIdleTimeout(0),
+      _udpExpiry(0),
+      _backend(INGEST_SERVER_BACKEND::EPOLL),
+      _epoll(-1),
+      _listen(-1),
+      _udp(-1),
+      _tcpPort(0),
+      _udpPort(0),
+      _uring(-1){};
+
+IngestServer::~IngestServer() {
+    close();
+};
+
+Result IngestServer::open(const IngestServerConfig& config) {
+    close();
+    if (config.ringSize == 0 || config.ringSize > _storage.size) {
+        return Result::InvalidParameter;
+    }
+    _ringSize        = config.ringSize;
+    _connectionCount = _storage.size / _ringSize;
+    if (_connectionCount > INGEST_SERVER_CONNECTION_MAX_COUNT) {
+        _connectionCount = INGEST_SERVER_CONNECTION_MAX_COUNT;
+    }
+    for (uint32_t i = 0; i < _connectionCount; i++) {
+        Connection* c = &_connections[i];
+        new (c->ring) CircularBuffer8(_storage.data + i * _ringSize, _ringSize);
+        c->type = INGEST_CONNECTION_TYPE::NONE;
+        c->fd   = -1;
+        // Popped from the end, the first connections are used first.
+        _free[i] = _connectionCount - 1 - i;
+    }
+    _freeCount = _connectionCount;
+    memset(_udpTable, 0, sizeof(_udpTable));
+    _udpRemovedCount = 0;
+    _udpIdleTimeout  = config.udpIdleTimeout;
+    _udpExpiry       = 0;
+
+    acceptCount   = 0;
+    closeCount    = 0;
+    refusedCount  = 0;
+    overflowCount = 0;
+    expiredCount  = 0;
+    readCount     = 0;
+    byteCount     = 0;
+    frameCount    = 0;
+
+    struct epoll_event event;
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll < 0) {
+        goto error;
+    }
+    if (config.tcp) {
+        _tcpPort = config.tcpPort;
+        _listen  = ingest_server_socket(SOCK_STREAM, config.address, &_tcpPort);
+        event.events   = EPOLLIN;
+        event.data.u64 = INGEST_SERVER_TAG_LISTEN;
+        if (_listen < 0 || epoll_ctl(_epoll, EPOLL_CTL_ADD, _listen, &event) != 0) {
+            goto error;
+        }
+    }
+    if (config.udp) {
+        _udpPort = config.udpPort;
+        _udp     = ingest_server_socket(SOCK_DGRAM, config.address, &_udpPort);
+        event.events   = EPOLLIN;
+        event.data.u64 = INGEST_SERVER_TAG_UDP;
+        if (_udp < 0 || epoll_ctl(_epoll, EPOLL_CTL_ADD, _udp, &event) != 0) {
+            goto error;
+        }
+    }
+
+    _backend = INGEST_SERVER_BACKEND::EPOLL;
+    if (config.backend == INGEST_SERVER_BACKEND::IO_URING && _uring_open()) {
+        _backend = INGEST_SERVER_BACKEND::IO_URING;
+        _uring_poll();
+    }
+    return Result::OK;
+
+error:
+    lastError = errno;
+    close();
+    return Result::GeneralError;
+};
+
+void IngestServer::close() {
+    // Before the connections, it cancels their reads.
+    _uring_close();
+    for (uint32_t i = 0; i < _connectionCount; i++) {
+        if (_connections[i].type != INGEST_CONNECTION_TYPE::NONE) {
+            _connection_free(i);
+        }
+    }
+    if (_listen >= 0) {
+        ::close(_listen);
+        _listen = -1;
+    }
+    if (_udp >= 0) {
+        ::close(_udp);
+        _udp = -1;
+    }
+    if (_epoll >= 0) {
+        ::close(_epoll);
+        _epoll = -1;
+    }
+    _connectionCount = 0;
+    _freeCount       = 0;
+};
+
+Result IngestServer::poll(int32_t timeout) {
+    _udp_expire();
+    if (_backend == INGEST_SERVER_BACKEND::EPOLL) {
+        struct epoll_event events[INGEST_SERVER_EVENT_COUNT];
+        int                count = epoll_wait(_epoll, events, INGEST_SERVER_EVENT_COUNT, timeout);
+        if (count < 0) {
+            if (errno == EINTR) return Result::OK;
+            lastError = errno;
+            return Result::GeneralError;
+        }
+        for (int i = 0; i < count; i++) {
+            uint32_t tag = events[i].data.u64;
+            if (tag == INGEST_SERVER_TAG_LISTEN) {
+                _accept();
+            } else if (tag == INGEST_SERVER_TAG_UDP) {
+                _receive();
+            } else if (_connections[tag].type == INGEST_CONNECTION_TYPE::TCP) {
+                // Skipped if closed by an earlier event of the same wait.
+                _read(tag);
+            }
+        }
+        return Result::OK;
+    }
+
+    if (timeout >= 0) {
+        // Completes after timeout, or as soon as anything else completes.
+        _timeout.tv_sec          = timeout / 1000;
+        _timeout.tv_nsec         = (timeout % 1000) * 1000000LL;
+        struct io_uring_sqe* sqe = _uring_sqe();
+        sqe->opcode              = IORING_OP_TIMEOUT;
+        sqe->fd                  = -1;
+        sqe->addr                = (uint64_t)(uintptr_t)&_timeout;
+        sqe->len                 = 1;
+        sqe->off                 = 1;
+        sqe->user_data           = INGEST_SERVER_TAG_TIMEOUT;
+    }
+    if (_uring_enter(1) < 0 && errno != EINTR && errno != ETIME) {
+        lastError = errno;
+        return Result::GeneralError;
+    }
+
+    uint32_t head = *_cqHead;
+    uint32_t tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        struct io_uring_cqe* cqe    = &_cqes[head & _cqMask];
+        uint32_t             tag    = cqe->user_data;
+        int32_t              result = cqe->res;
+        // Released first, a completion may queue new requests.
+        __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+        if (tag == INGEST_SERVER_TAG_EPOLL) {
+            _events(0);
+            _uring_poll();
+        } else if (tag != INGEST_SERVER_TAG_TIMEOUT) {
+            _uring_complete(tag, result);
+        }
+    }
+    return Result::OK;
+};
+
+void IngestServer::_events(int32_t timeout) {
+    struct epoll_event events[INGEST_SERVER_EVENT_COUNT];
+    int                count = epoll_wait(_epoll, events, INGEST_SERVER_EVENT_COUNT, timeout);
+    for (int i = 0; i < count; i++) {
+        if (events[i].data.u64 == INGEST_SERVER_TAG_LISTEN) {
+            _accept();
+        } else if (events[i].data.u64 == INGEST_SERVER_TAG_UDP) {
+            _receive();
+        }
+    }
+};
+
+bool IngestServer::_connection_open(int fd, INGEST_CONNECTION_TYPE type, uint32_t* connection) {
+    if (_freeCount == 0) {
+        refusedCount++;
+        return false;
+    }
+    uint32_t    index = _free[_freeCount - 1];
+    Connection* c     = &_connections[index];
+    c->state          = _hooks.open(_hooks.context, index, _buffer(index));
+    if (c->state == nullptr) {
+        refusedCount++;
+        return false;
+    }
+    _freeCount--;
+    c->fd      = fd;
+    c->type    = type;
+    c->reading = false;
+    c->closing = false;
+    acceptCount++;
+    *connection = index;
+    return true;
+};
+
+void IngestServer::_connection_free(uint32_t connection) {
+    Connection* c = &_connections[connection];
+    _hooks.close(_hooks.context, c->state);
+    if (c->type == INGEST_CONNECTION_TYPE::TCP) {
+        // Closing the descriptor also removes it from epoll.
+        ::close(c->fd);
+    } else {
+        uint32_t mask = INGEST_SERVER_UDP_TABLE_SIZE - 1;
+        uint32_t slot = ingest_server_udp_hash(c->address, c->port) & mask;
+        for (uint32_t i = 0; i < INGEST_SERVER_UDP_TABLE_SIZE; i++) {
+            if (_udpTable[slot] == connection + 1) {
+                // A slot before an empty one ends no probe, it is emptied.
+                if (_udpTable[(slot + 1) & mask] == INGEST_SERVER_UDP_EMPTY) {
+                    _udpTable[slot] = INGEST_SERVER_UDP_EMPTY;
+                } else {
+                    _udpTable[slot] = INGEST_SERVER_UDP_REMOVED;
+                    _udpRemovedCount++;
+                }
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+    CircularBuffer8& buffer = _buffer(connection);
+    buffer.readVirtual(buffer.getSize());
+    c->type             = INGEST_CONNECTION_TYPE::NONE;
+    c->fd               = -1;
+    _free[_freeCount++] = connection;
+    closeCount++;
+    if (_udpRemovedCount > INGEST_SERVER_UDP_REMOVED_MAX_COUNT) {
+        _udp_rehash();
+    }
+};
+
+void IngestServer::connection_close(uint32_t connection) {
+    Connection* c = &_connections[connection];
+    if (c->type == INGEST_CONNECTION_TYPE::NONE || c->closing) {
+        return;
+    }
+    if (c->reading) {
+        // Its read is in flight into its ring, it completes with 0 and frees the connection.
+        c->closing = true;
+        shutdown(c->fd, SHUT_RDWR);
+        return;
+    }
+    _connection_free(connection);
+};
+
+void IngestServer::_data(uint32_t connection) {
+    CircularBuffer8& buffer = _buffer(connection);
+    frameCount += _hooks.data(_hooks.context, _connections[connection].state, buffer);
+    if (buffer.getSize() == _ringSize) {
+        // No frame fits, or the parser stalls on the bytes.
+        overflowCount++;
+        connection_close(connection);
+    }
+};
+
+void IngestServer::_accept() {
+    while (true) {
+        int fd = accept4(_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EINTR && errno != ECONNABORTED) {
+                lastError = errno;
+            }
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return;
+        }
+
+        uint32_t connection;
+        if (!_connection_open(fd, INGEST_CONNECTION_TYPE::TCP, &connection)) {
+            ::close(fd);
+            continue;
+        }
+        if (_backend == INGEST_SERVER_BACKEND::IO_URING) {
+            _uring_read(connection);
+            continue;
+        }
+        struct epoll_event event;
+        event.events   = EPOLLIN;
+        event.data.u64 = connection;
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+            lastError = errno;
+            _connection_free(connection);
+        }
+    }
+};
+
+void IngestServer::_receive() {
+    uint64_t now = _udpIdleTimeout ? ingest_server_now() : 0;
+    // Bounded, so that a flood of datagrams does not starve the connections.
+    for (uint32_t i = 0; i < INGEST_SERVER_EVENT_COUNT; i++) {
+        struct sockaddr_in addr;
+        socklen_t          length = sizeof(addr);
+        ssize_t            size   = recvfrom(_udp, _datagram, sizeof(_datagram), 0,
+                                             (struct sockaddr*)&addr, &length);
+        if (size < 0) {
+            if (errno != EAGAIN && errno != EINTR) {
+                lastError = errno;
+            }
+            return;
+        }
+        readCount++;
+        byteCount += size;
+
+        uint32_t connection = _udp_source(ntohl(addr.sin_addr.s_addr), ntohs(addr.sin_port));
+        if (connection == INGEST_SERVER_CONNECTION_MAX_COUNT) continue;
+        _connections[connection].seen = now;
+
+        // A datagram is a whole, it is dropped rather than cut.
+        CircularBuffer8& buffer = _buffer(connection);
+        if (buffer.getSize() + size > _ringSize) {
+            overflowCount++;
+            continue;
+        }
+        buffer.write(_datagram, size, false);
+        _data(connection);
+    }
+};
+
+uint32_t IngestServer::_udp_source(uint32_t address, uint16_t port) {
+    uint32_t mask    = INGEST_SERVER_UDP_TABLE_SIZE - 1;
+    uint32_t slot    = ingest_server_udp_hash(address, port) & mask;
+    uint32_t removed = INGEST_SERVER_UDP_TABLE_SIZE;  // the first removed slot seen.
+    for (uint32_t i = 0; i < INGEST_SERVER_UDP_TABLE_SIZE; i++) {
+        uint16_t entry = _udpTable[slot];
+        if (entry == INGEST_SERVER_UDP_EMPTY) {
+            break;
+        }
+        if (entry == INGEST_SERVER_UDP_REMOVED) {
+            if (removed == INGEST_SERVER_UDP_TABLE_SIZE) removed = slot;
+        } else if (_connections[entry - 1].address == address &&
+                   _connections[entry - 1].port == port) {
+            return entry - 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // A new source, in the first removed slot of its probe, or the empty slot ending it.
+    if (removed < INGEST_SERVER_UDP_TABLE_SIZE) {
+        slot = removed;
+    } else if (_udpTable[slot] != INGEST_SERVER_UDP_EMPTY) {
+        refusedCount++;
+        return INGEST_SERVER_CONNECTION_MAX_COUNT;
+    }
+    uint32_t connection;
+    if (!_connection_open(_udp, INGEST_CONNECTION_TYPE::UDP, &connection)) {
+        return INGEST_SERVER_CONNECTION_MAX_COUNT;
+    }
+    _connections[connection].address = address;
+    _connections[connection].port    = port;
+    if (_udpTable[slot] == INGEST_SERVER_UDP_REMOVED) {
+        _udpRemovedCount--;
+    }
+    _udpTable[slot] = connection + 1;
+    return connection;
+};
+
+void IngestServer::_udp_rehash() {
+    // Removed slots lengthen the probes crossing them, the table is built again from the
+    // sources.
+    uint32_t mask = INGEST_SERVER_UDP_TABLE_SIZE - 1;
+    memset(_udpTable, 0, sizeof(_udpTable));
+    _udpRemovedCount = 0;
+    for (uint32_t i = 0; i < _connectionCount; i++) {
+        Connection* c = &_connections[i];
+        if (c->type != INGEST_CONNECTION_TYPE::UDP) continue;
+        uint32_t slot = ingest_server_udp_hash(c->address, c->port) & mask;
+        while (_udpTable[slot] != INGEST_SERVER_UDP_EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        _udpTable[slot] = i + 1;
+    }
+};
+
+void IngestServer::_udp_expire() {
+    if (_udpIdleTimeout == 0 || _udp < 0) {
+        return;
+    }
+    uint64_t now = ingest_server_now();
+    if (now < _udpExpiry) {
+        return;
+    }
+    // Checked every half timeout, a source is closed 1 to 1.5 timeouts after its last datagram.
+    _udpExpiry = now + _udpIdleTimeout / 2;
+    for (uint32_t i = 0; i < _connectionCount; i++) {
+        Connection* c = &_connections[i];
+        if (c->type == INGEST_CONNECTION_TYPE::UDP && now - c->seen >= _udpIdleTimeout) {
+            expiredCount++;
+            _connection_free(i);
+        }
+    }
+};
+
+uint32_t IngestServer::_write_index(uint32_t connection) {
+    // The ring has no accessor of its write index, it is derived from the memory of the ring.
+    // Unlike the ring of a SerialPort, open builds it over exactly these _ringSize bytes.
+    CircularBuffer8& buffer = _buffer(connection);
+    uint8_t*         ring   = _storage.data + connection * _ringSize;
+    return (buffer.peekPtr(0) - ring + buffer.getSize()) % _ringSize;
+};
+
+void IngestServer::_read(uint32_t connection) {
+    CircularBuffer8& buffer = _buffer(connection);
+    uint8_t*         ring   = _storage.data + connection * _ringSize;
+    uint32_t         free   = _ringSize - buffer.getSize();
+    uint32_t         index  = _write_index(connection);
+
+    // The free space starts after the last byte of the ring, and wraps at its end.
+    struct iovec segments[2];
+    segments[0].iov_base = ring + index;
+    segments[0].iov_len  = _ringSize - index < free ? _ringSize - index : free;
+    segments[1].iov_base = ring;
+    segments[1].iov_len  = free - segments[0].iov_len;
+
+    ssize_t length = readv(_connections[connection].fd, segments, segments[1].iov_len ? 2 : 1);
+    if (length < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return;
+    }
+    if (length <= 0) {
+        if (length < 0) lastError = errno;
+        _connection_free(connection);
+        return;
+    }
+    buffer.writeVirtual(length);
+    readCount++;
+    byteCount += length;
+    _data(connection);
+};
+
+bool IngestServer::_uring_open() {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    _uring = syscall(__NR_io_uring_setup, INGEST_SERVER_URING_ENTRIES, &params);
+    if (_uring < 0) {
+        _uring = -1;
+        return false;
+    }
+
+    _sqMapSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    _cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (_cqMapSize > _sqMapSize) _sqMapSize = _cqMapSize;
+        _cqMapSize = 0;
+    }
+    _sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    _sqMap    = mmap(nullptr, _sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _uring,
+                     IORING_OFF_SQ_RING);
+    _cqMap    = _sqMap;
+    if (_sqMap != MAP_FAILED && _cqMapSize != 0) {
+        _cqMap = mmap(nullptr, _cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      _uring, IORING_OFF_CQ_RING);
+    }
+    _sqes = (struct io_uring_sqe*)mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_POPULATE, _uring, IORING_OFF_SQES);
+    if (_sqMap == MAP_FAILED || _cqMap == MAP_FAILED || _sqes == MAP_FAILED) {
+        _uring_close();
+        return false;
+    }
+
+    uint8_t* sq  = (uint8_t*)_sqMap;
+    uint8_t* cq  = (uint8_t*)_cqMap;
+    _sqHead      = (uint32_t*)(sq + params.sq_off.head);
+    _sqTail      = (uint32_t*)(sq + params.sq_off.tail);
+    _sqArray     = (uint32_t*)(sq + params.sq_off.array);
+    _sqMask      = *(uint32_t*)(sq + params.sq_off.ring_mask);
+    _cqHead      = (uint32_t*)(cq + params.cq_off.head);
+    _cqTail      = (uint32_t*)(cq + params.cq_off.tail);
+    _cqMask      = *(uint32_t*)(cq + params.cq_off.ring_mask);
+    _cqes        = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    _submitCount = 0;
+
+    // Pinned once, reads then skip the mapping of their pages. Without it, as under a low
+    // memlock limit, reads take the ring as any buffer.
+    struct iovec storage;
+    storage.iov_base = _storage.data;
+    storage.iov_len  = _storage.size;
+    registered = syscall(__NR_io_uring_register, _uring, IORING_REGISTER_BUFFERS, &storage, 1) == 0;
+    return true;
+};
+
+void IngestServer::_uring_close() {
+    if (_uring < 0) {
+        return;
+    }
+    if (_sqes != MAP_FAILED) munmap(_sqes, _sqesSize);
+    if (_cqMap != MAP_FAILED && _cqMap != _sqMap) munmap(_cqMap, _cqMapSize);
+    if (_sqMap != MAP_FAILED) munmap(_sqMap, _sqMapSize);
+    ::close(_uring);
+    _uring     = -1;
+    registered = false;
+};
+
+struct io_uring_sqe* IngestServer::_uring_sqe() {
+    uint32_t tail = *_sqTail;
+    if (tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) > _sqMask) {
+        _uring_enter(0);
+    }
+    uint32_t index = tail & _sqMask;
+    _sqArray[index] = index;
+    memset(&_sqes[index], 0, sizeof(struct io_uring_sqe));
+    // Published at once, the kernel reads it on the next enter.
+    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+    _submitCount++;
+    return &_sqes[index];
+};
+
+int IngestServer::_uring_enter(uint32_t wait) {
+    int result = syscall(__NR_io_uring_enter, _uring, _submitCount, wait,
+                         wait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+    if (result >= 0) {
+        _submitCount -= result;
+    }
+    return result;
+};
+
+void IngestServer::_uring_poll() {
+    struct io_uring_sqe* sqe = _uring_sqe();
+    sqe->opcode              = IORING_OP_POLL_ADD;
+    sqe->fd                  = _epoll;
+    sqe->poll32_events       = POLLIN;
+    sqe->user_data           = INGEST_SERVER_TAG_EPOLL;
+};
+
+void IngestServer::_uring_read(uint32_t connection) {
+    CircularBuffer8& buffer = _buffer(connection);
+    uint32_t         index  = _write_index(connection);
+    uint32_t         length = _ringSize - buffer.getSize();
+    if (length > _ringSize - index) {
+        // Up to the end of the ring, the next read continues from its start.
+        length = _ringSize - index;
+    }
+
+    uint8_t*             ring = _storage.data + connection * _ringSize;
+    struct io_uring_sqe* sqe  = _uring_sqe();
+    sqe->opcode               = registered ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    sqe->fd                   = _connections[connection].fd;
+    sqe->addr                 = (uint64_t)(uintptr_t)(ring + index);
+    sqe->len                  = length;
+    sqe->buf_index            = 0;
+    sqe->user_data            = connection;
+    _connections[connection].reading = true;
+};
+
+void IngestServer::_uring_complete(uint32_t connection, int32_t result) {
+    Connection* c = &_connections[connection];
+    c->reading    = false;
+    if (result == -EAGAIN || result == -EINTR) {
+        _uring_read(connection);
+        return;
+    }
+    if (result <= 0 || c->closing) {
+        if (result < 0) lastError = -result;
+        _connection_free(connection);
+        return;
+    }
+    _buffer(connection).writeVirtual(result);
+    readCount++;
+    byteCount += result;
+    _data(connection);
+    if (c->type != INGEST_CONNECTION_TYPE::NONE && !c->closing) {
+        _uring_read(connection);
+    }
+};
+
+}  // namespace wibot::comm
+
+#endif  // __linux__
@@ -0,0 +1,211 @@
+#ifndef __WWTALK_INGEST_SERVER_HPP__
+#define __WWTALK_INGEST_SERVER_HPP__
+#ifdef __linux__
+
+#include <linux/time_types.h>
+
+#include "CircularBuffer.hpp"
+#include "base.hpp"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace wibot::comm {
+
+#define INGEST_SERVER_CONNECTION_MAX_COUNT 4096
+#define INGEST_SERVER_UDP_TABLE_SIZE 8192  // power of 2, twice the connections.
+#define INGEST_SERVER_EVENT_COUNT 64       // epoll events handled per wait.
+#define INGEST_SERVER_URING_ENTRIES 4096   // power of 2, a read in flight per connection.
+#define INGEST_SERVER_DATAGRAM_SIZE 2048
+#define INGEST_SERVER_BACKLOG 1024
+
+enum class INGEST_SERVER_BACKEND : uint8_t {
+    EPOLL = 0,
+    IO_URING,  // reads of TCP connections, into registered buffers.
+};
+
+enum class INGEST_CONNECTION_TYPE : uint8_t {
+    NONE = 0,
+    TCP,
+    UDP,  // the datagrams of a source address and port.
+};
+
+/**
+ * The dispatch hooks, the parser state of a connection is built by open and belongs to the
+ * application, e.g. a MessageParser over the ring of the connection.
+ */
+struct IngestServerHooks {
+    /**
+     * A connection is accepted, or a source sent its first datagram.
+     * @return Return the state of the connection, nullptr to refuse it.
+     */
+    void* (*open)(void* context, uint32_t connection, CircularBuffer8& buffer);
+
+    /**
+     * Bytes arrived in the ring, parse and dispatch the frames. Bytes left in the ring are
+     * kept for the next call, a ring left full closes the connection.
+     * @return Return the frames parsed.
+     */
+    uint32_t (*data)(void* context, void* state, CircularBuffer8& buffer);
+
+    void (*close)(void* context, void* state);
+    void* context;
+};
+
+struct IngestServerConfig {
+    uint32_t              address;  // IPv4 of both sockets, host order.
+    uint16_t              tcpPort;  // 0 for any, see tcp_port.
+    uint16_t              udpPort;  // 0 for any, see udp_port.
+    bool                  tcp;
+    bool                  udp;
+    INGEST_SERVER_BACKEND backend;   // IO_URING falls back to EPOLL if the kernel has none.
+    uint32_t              ringSize;  // bytes of the ring of a connection.
+    uint32_t              udpIdleTimeout;  // ms without a datagram closing a source, 0 never.
+};
+
+/**
+ * A single-threaded server that feeds the bytes of many TCP connections and UDP sources to a
+ * parser per connection. Every connection has a ring in storage, lent while it is open, and
+ * bytes go from the socket straight to its free space: readv into both of its segments with
+ * epoll, a read into the storage registered once with io_uring, so the kernel does not map
+ * the pages of every read. A datagram is copied once, from the buffer it is received in to the
+ * ring of its source, as its source is known only once it is received.
+ *
+ * With io_uring, every TCP connection has one read in flight, and the listening and UDP
+ * sockets are still waited for with epoll, whose descriptor is polled through the ring.
+ *
+ * A UDP source holds its ring until udpIdleTimeout passes without a datagram from it, checked
+ * as poll is called, every half timeout.
+ */
+class IngestServer {
+   public:
+    /**
+     * @param storage The rings of the connections, storage.size / ringSize of them at most.
+     */
+    IngestServer(Buffer8 storage, const IngestServerHooks& hooks);
+    ~IngestServer();
+
+    /**
+     * @return Return InvalidParameter if the storage has no room for a ring, GeneralError if a
+     * socket cannot be opened, see lastError.
+     */
+    Result open(const IngestServerConfig& config);
+    void   close();
+
+    /**
+     * Wait up to timeout ms for events, then handle them all.
+     * @param timeout -1 to wait without limit.
+     * @return Return OK, GeneralError if the wait failed.
+     */
+    Result poll(int32_t timeout);
+
+    /**
+     * Close a connection from a hook or between polls, its close hook is called.
+     */
+    void connection_close(uint32_t connection);
+
+    uint16_t tcp_port() const {
+        return _tcpPort;
+    };
+    uint16_t udp_port() const {
+        return _udpPort;
+    };
+    INGEST_SERVER_BACKEND backend() const {
+        return _backend;
+    };
+    uint32_t connection_count() const {
+        return _connectionCount - _freeCount;
+    };
+
+    bool     registered;     // the storage is registered with io_uring.
+    int      lastError;      // errno of the last failure.
+    uint32_t acceptCount;    // connections and UDP sources opened.
+    uint32_t closeCount;
+    uint32_t refusedCount;   // no ring left, or refused by the open hook.
+    uint32_t overflowCount;  // closed with a full ring, or datagrams dropped by one.
+    uint32_t expiredCount;   // UDP sources closed after udpIdleTimeout.
+    uint64_t readCount;      // reads and datagrams.
+    uint64_t byteCount;
+    uint64_t frameCount;
+
+   private:
+    struct Connection {
+        alignas(CircularBuffer8) uint8_t ring[sizeof(CircularBuffer8)];
+        void*                  state;
+        int                    fd;
+        uint64_t               seen;     // ms, the last datagram of the UDP source.
+        uint32_t               address;  // of the UDP source.
+        uint16_t               port;
+        INGEST_CONNECTION_TYPE type;
+        bool                   reading;  // io_uring, a read is in flight.
+        bool                   closing;  // shut down, the read in flight frees it.
+    };
+
+    Buffer8           _storage;
+    IngestServerHooks _hooks;
+    uint32_t          _ringSize;
+    Connection        _connections[INGEST_SERVER_CONNECTION_MAX_COUNT];
+    uint16_t          _free[INGEST_SERVER_CONNECTION_MAX_COUNT];  // free connections.
+    uint16_t          _udpTable[INGEST_SERVER_UDP_TABLE_SIZE];    // connection + 1 of sources.
+    uint32_t          _udpRemovedCount;  // removed slots of the UDP table.
+    uint32_t          _connectionCount;
+    uint32_t          _freeCount;
+    uint32_t          _udpIdleTimeout;
+    uint64_t          _udpExpiry;  // ms, the next check of the idle sources.
+
+    INGEST_SERVER_BACKEND _backend;
+    int                   _epoll;
+    int                   _listen;
+    int                   _udp;
+    uint16_t              _tcpPort;
+    uint16_t              _udpPort;
+    uint8_t               _datagram[INGEST_SERVER_DATAGRAM_SIZE];
+
+    int                      _uring;
+    void*                    _sqMap;
+    size_t                   _sqMapSize;
+    void*                    _cqMap;
+    size_t                   _cqMapSize;
+    struct io_uring_sqe*     _sqes;
+    size_t                   _sqesSize;
+    uint32_t*                _sqHead;
+    uint32_t*                _sqTail;
+    uint32_t*                _sqArray;
+    uint32_t                 _sqMask;
+    uint32_t*                _cqHead;
+    uint32_t*                _cqTail;
+    uint32_t                 _cqMask;
+    struct io_uring_cqe*     _cqes;
+    uint32_t                 _submitCount;  // queued and not yet submitted.
+    struct __kernel_timespec _timeout;
+
+    inline CircularBuffer8& _buffer(uint32_t connection) {
+        return *(CircularBuffer8*)_connections[connection].ring;
+    };
+    uint32_t _write_index(uint32_t connection);
+
+    bool _connection_open(int fd, INGEST_CONNECTION_TYPE type, uint32_t* connection);
+    void _connection_free(uint32_t connection);
+    void _data(uint32_t connection);
+    void _events(int32_t timeout);
+    void _accept();
+    void _receive();
+    void _read(uint32_t connection);
+
+    uint32_t _udp_source(uint32_t address, uint16_t port);
+    void     _udp_rehash();
+    void     _udp_expire();
+
+    bool                 _uring_open();
+    void                 _uring_close();
+    struct io_uring_sqe* _uring_sqe();
+    int                  _uring_enter(uint32_t wait);
+    void                 _uring_read(uint32_t connection);
+    void                 _uring_poll();
+    void                 _uring_complete(uint32_t connection, int32_t result);
+};
+
+}  // namespace wibot::comm
+
+#endif  // __linux__
+#endif  // __WWTALK_INGEST_SERVER_HPP__
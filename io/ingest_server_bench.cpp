@@ -0,0 +1,236 @@
+#include "ingest_server_bench.hpp"
+#ifdef __linux__
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <new>
+#include <thread>
+
+#include "ingest_server.hpp"
+#include "log.h"
+#include "message_parser.hpp"
+#include "minunit.h"
+#include "string.h"
+
+LOGGER("ingest_server_bench")
+
+namespace wibot::comm::test {
+
+#define INGEST_SERVER_BENCH_PAYLOAD_SIZE 92  // NAV-PVT.
+#define INGEST_SERVER_BENCH_FRAME_SIZE (INGEST_SERVER_BENCH_PAYLOAD_SIZE + 8)
+#define INGEST_SERVER_BENCH_CHUNK_FRAMES 10  // sent at once, a receiver forwards in bursts.
+#define INGEST_SERVER_BENCH_FRAMES 102400    // of a run, whatever the number of clients.
+#define INGEST_SERVER_BENCH_CLIENT_MAX_COUNT 512
+#define INGEST_SERVER_BENCH_RING_SIZE 4096
+#define INGEST_SERVER_BENCH_UDP_WINDOW 256  // datagrams in flight, loopback drops the others.
+#define INGEST_SERVER_BENCH_RECEIVER_RATE 100  // frames/s a receiver forwards.
+
+struct IngestServerBenchState {
+    alignas(MessageParser) uint8_t parser[sizeof(MessageParser)];
+    alignas(MessageFrame) uint8_t frame[sizeof(MessageFrame)];
+    uint8_t data[INGEST_SERVER_BENCH_FRAME_SIZE];
+};
+
+static const MessageSchema ingestServerBenchSchema = {
+    .prefix      = {0xB5, 0x62},
+    .prefixSize  = 2,
+    .commandSize = MESSAGE_SCHEMA_SIZE::BIT16,
+    .defaultLength{
+        .mode = MESSAGE_LENGTH_SCHEMA_MODE::DYNAMIC_LENGTH,
+        .dynamic{
+            .lengthSize = MESSAGE_SCHEMA_SIZE::BIT16,
+            .endian     = MESSAGE_SCHEMA_LENGTH_ENDIAN::LITTLE,
+            .range      = MESSAGE_SCHEMA_RANGE_CONTENT,
+        },
+    },
+    .crcSize = MESSAGE_SCHEMA_SIZE::BIT16,
+};
+
+static uint8_t benchChunk[INGEST_SERVER_BENCH_CHUNK_FRAMES * INGEST_SERVER_BENCH_FRAME_SIZE];
+static uint8_t benchStorage[INGEST_SERVER_BENCH_CLIENT_MAX_COUNT * INGEST_SERVER_BENCH_RING_SIZE];
+static IngestServerBenchState benchStates[INGEST_SERVER_BENCH_CLIENT_MAX_COUNT];
+static int                    benchClients[INGEST_SERVER_BENCH_CLIENT_MAX_COUNT];
+static std::atomic<uint32_t>  benchFrames;
+
+static uint64_t ingest_server_bench_now(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+};
+
+static void* ingest_server_bench_open(void*, uint32_t connection, CircularBuffer8& buffer) {
+    IngestServerBenchState* state  = &benchStates[connection];
+    MessageParser*          parser = new (state->parser) MessageParser(buffer);
+    new (state->frame) MessageFrame({.data = state->data, .size = sizeof(state->data)});
+    parser->init(ingestServerBenchSchema);
+    parser->reset();
+    return state;
+};
+
+static uint32_t ingest_server_bench_data(void*, void* state, CircularBuffer8&) {
+    IngestServerBenchState* s      = (IngestServerBenchState*)state;
+    MessageParser*          parser = (MessageParser*)s->parser;
+    uint32_t                count  = 0;
+    while (parser->parse((MessageFrame*)s->frame) == Result::OK) {
+        count++;
+    }
+    // Read by the clients, to hold UDP to a window.
+    benchFrames.fetch_add(count, std::memory_order_relaxed);
+    return count;
+};
+
+static void ingest_server_bench_close(void*, void*){};
+
+static int ingest_server_bench_client(int type, uint16_t port) {
+    int                fd = socket(AF_INET, type, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = htons(port);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        if (fd >= 0) ::close(fd);
+        return -1;
+    }
+    return fd;
+};
+
+/**
+ * Every client sends its share of the frames, a chunk at a time, round robin. TCP clients
+ * block on a full socket, UDP clients wait for the server to catch up with the window.
+ */
+static void ingest_server_bench_send(uint32_t clients, bool udp) {
+    uint32_t rounds = INGEST_SERVER_BENCH_FRAMES / clients / INGEST_SERVER_BENCH_CHUNK_FRAMES;
+    uint32_t sent   = 0;
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (uint32_t i = 0; i < clients; i++) {
+            if (!udp) {
+                MU_ASSERT(send(benchClients[i], benchChunk, sizeof(benchChunk), MSG_NOSIGNAL) ==
+                          sizeof(benchChunk));
+                continue;
+            }
+            for (uint32_t f = 0; f < INGEST_SERVER_BENCH_CHUNK_FRAMES; f++) {
+                while (sent - benchFrames.load(std::memory_order_relaxed) >=
+                       INGEST_SERVER_BENCH_UDP_WINDOW) {
+                    std::this_thread::yield();
+                }
+                send(benchClients[i], benchChunk + f * INGEST_SERVER_BENCH_FRAME_SIZE,
+                     INGEST_SERVER_BENCH_FRAME_SIZE, 0);
+                sent++;
+            }
+        }
+    }
+};
+
+static void ingest_server_bench_run(INGEST_SERVER_BACKEND backend, uint32_t clients, bool udp) {
+    static IngestServer server({.data = benchStorage, .size = sizeof(benchStorage)},
+                               {
+                                   .open    = ingest_server_bench_open,
+                                   .data    = ingest_server_bench_data,
+                                   .close   = ingest_server_bench_close,
+                                   .context = nullptr,
+                               });
+    IngestServerConfig config = {
+        .address        = INADDR_LOOPBACK,
+        .tcpPort        = 0,
+        .udpPort        = 0,
+        .tcp            = !udp,
+        .udp            = udp,
+        .backend        = backend,
+        .ringSize       = INGEST_SERVER_BENCH_RING_SIZE,
+        .udpIdleTimeout = 0,
+    };
+    if (server.open(config) != Result::OK) {
+        LOG_E("open failed: %d", server.lastError);
+        MU_ASSERT(false);
+        return;
+    }
+
+    for (uint32_t i = 0; i < clients; i++) {
+        benchClients[i] = ingest_server_bench_client(udp ? SOCK_DGRAM : SOCK_STREAM,
+                                                     udp ? server.udp_port() : server.tcp_port());
+        MU_ASSERT(benchClients[i] >= 0);
+    }
+    for (uint32_t i = 0; i < 1000 && !udp && server.connection_count() < clients; i++) {
+        server.poll(10);
+    }
+    MU_ASSERT(udp || server.connection_count() == clients);
+
+    uint32_t total = INGEST_SERVER_BENCH_FRAMES / clients / INGEST_SERVER_BENCH_CHUNK_FRAMES *
+                     INGEST_SERVER_BENCH_CHUNK_FRAMES * clients;
+    benchFrames.store(0);
+    std::atomic<bool> sent(false);
+    uint64_t          start = ingest_server_bench_now(CLOCK_MONOTONIC);
+    uint64_t          cpu   = ingest_server_bench_now(CLOCK_THREAD_CPUTIME_ID);
+    std::thread       sender([clients, udp, &sent]() {
+        ingest_server_bench_send(clients, udp);
+        sent.store(true);
+    });
+    // Until every frame is in, or the datagrams lost stop the count.
+    for (uint32_t idle = 0; server.frameCount < total && idle < 10;) {
+        uint64_t frames = server.frameCount;
+        server.poll(10);
+        idle = sent.load() && server.frameCount == frames ? idle + 1 : 0;
+    }
+    cpu              = ingest_server_bench_now(CLOCK_THREAD_CPUTIME_ID) - cpu;
+    uint64_t elapsed = ingest_server_bench_now(CLOCK_MONOTONIC) - start;
+    sender.join();
+    MU_ASSERT(udp || server.frameCount == total);
+
+    if (elapsed == 0) elapsed = 1;
+    if (cpu == 0) cpu = 1;
+    double perCore = server.frameCount * 1e9 / cpu;
+    LOG_I("%s %s %3u clients: %.0f frames/s, %.1f MB/s, %.1f%% server cpu, %.0f frames/s a core, "
+          "%.0f connections a core at %u frames/s, %llu reads, %u lost",
+          udp ? "udp" : "tcp",
+          server.backend() == INGEST_SERVER_BACKEND::IO_URING ? "io_uring" : "epoll", clients,
+          server.frameCount * 1e9 / elapsed, server.byteCount * 1e3 / elapsed,
+          cpu * 100.0 / elapsed, perCore, perCore / INGEST_SERVER_BENCH_RECEIVER_RATE,
+          INGEST_SERVER_BENCH_RECEIVER_RATE, (unsigned long long)server.readCount,
+          total - (uint32_t)server.frameCount);
+
+    for (uint32_t i = 0; i < clients; i++) {
+        ::close(benchClients[i]);
+    }
+    server.close();
+};
+
+void ingest_server_bench() {
+    uint8_t* frame = benchChunk;
+    for (uint32_t i = 0; i < INGEST_SERVER_BENCH_CHUNK_FRAMES; i++) {
+        frame[0] = 0xB5;
+        frame[1] = 0x62;
+        frame[2] = 0x01;
+        frame[3] = 0x07;
+        frame[4] = INGEST_SERVER_BENCH_PAYLOAD_SIZE;
+        frame[5] = 0;
+        memset(frame + 6, i, INGEST_SERVER_BENCH_PAYLOAD_SIZE);
+        uint8_t a = 0, b = 0;
+        for (uint32_t j = 2; j < INGEST_SERVER_BENCH_FRAME_SIZE - 2; j++) {
+            a += frame[j];
+            b += a;
+        }
+        frame[INGEST_SERVER_BENCH_FRAME_SIZE - 2] = a;
+        frame[INGEST_SERVER_BENCH_FRAME_SIZE - 1] = b;
+        frame += INGEST_SERVER_BENCH_FRAME_SIZE;
+    }
+
+    LOG_I("%u hardware threads", std::thread::hardware_concurrency());
+    const INGEST_SERVER_BACKEND backends[] = {INGEST_SERVER_BACKEND::EPOLL,
+                                              INGEST_SERVER_BACKEND::IO_URING};
+    for (uint32_t clients = 1; clients <= INGEST_SERVER_BENCH_CLIENT_MAX_COUNT; clients *= 8) {
+        for (INGEST_SERVER_BACKEND backend : backends) {
+            ingest_server_bench_run(backend, clients, false);
+        }
+        ingest_server_bench_run(INGEST_SERVER_BACKEND::EPOLL, clients, true);
+    }
+};
+
+}  // namespace wibot::comm::test
+
+#endif  // __linux__
@@ -0,0 +1,12 @@
+#ifndef __WWTALK_INGEST_SERVER_BENCH_HPP__
+#define __WWTALK_INGEST_SERVER_BENCH_HPP__
+
+namespace wibot::comm::test {
+/**
+ * Load generator over loopback, 1 to 512 TCP clients with both backends and UDP sources,
+ * frames/s and connections a core of the server holds.
+ */
+void ingest_server_bench();
+}
+
+#endif  // __WWTALK_INGEST_SERVER_BENCH_HPP__
@@ -0,0 +1,342 @@
+#include "ingest_server_test.hpp"
+#ifdef __linux__
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <new>
+
+#include "message_parser.hpp"
+#include "minunit.h"
+#include "string.h"
+
+namespace wibot::comm::test {
+
+#define INGEST_SERVER_TEST_RING_SIZE 256
+#define INGEST_SERVER_TEST_RING_COUNT 4
+
+// Polls until cond, for 2 s at most.
+#define INGEST_SERVER_TEST_POLL(server, cond)          \
+    for (uint32_t i = 0; i < 200 && !(cond); i++) {    \
+        (server).poll(10);                             \
+    }
+
+/**
+ * The parser of a connection, UBX frames: B5 62, class and id, a little endian length of the
+ * payload, the payload and 2 bytes of checksum.
+ */
+struct IngestServerTestState {
+    alignas(MessageParser) uint8_t parser[sizeof(MessageParser)];
+    alignas(MessageFrame) uint8_t frame[sizeof(MessageFrame)];
+    uint8_t  data[2 * INGEST_SERVER_TEST_RING_SIZE];  // frames longer than the ring fit.
+    uint32_t connection;
+    uint32_t frameCount;
+    uint32_t badCount;  // frames out of order or with another payload.
+};
+
+struct IngestServerTestContext {
+    IngestServerTestState states[INGEST_SERVER_TEST_RING_COUNT];
+    uint32_t              openCount;
+    uint32_t              closeCount;
+    uint32_t              lastConnection;
+    bool                  refuse;
+};
+
+static const MessageSchema ingestServerTestSchema = {
+    .prefix      = {0xB5, 0x62},
+    .prefixSize  = 2,
+    .commandSize = MESSAGE_SCHEMA_SIZE::BIT16,
+    .defaultLength{
+        .mode = MESSAGE_LENGTH_SCHEMA_MODE::DYNAMIC_LENGTH,
+        .dynamic{
+            .lengthSize = MESSAGE_SCHEMA_SIZE::BIT16,
+            .endian     = MESSAGE_SCHEMA_LENGTH_ENDIAN::LITTLE,
+            .range      = MESSAGE_SCHEMA_RANGE_CONTENT,
+        },
+    },
+    .crcSize = MESSAGE_SCHEMA_SIZE::BIT16,
+};
+
+static uint32_t ingest_server_test_frame(uint8_t* out, uint8_t index) {
+    uint32_t length = 4 + index % 3;
+    out[0]          = 0xB5;
+    out[1]          = 0x62;
+    out[2]          = 0x01;
+    out[3]          = 0x07;
+    out[4]          = length;
+    out[5]          = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        out[6 + i] = index + i;
+    }
+    uint8_t a = 0, b = 0;
+    for (uint32_t i = 2; i < 6 + length; i++) {
+        a += out[i];
+        b += a;
+    }
+    out[6 + length] = a;
+    out[7 + length] = b;
+    return 8 + length;
+};
+
+static void* ingest_server_test_open(void* context, uint32_t connection, CircularBuffer8& buffer) {
+    IngestServerTestContext* ctx = (IngestServerTestContext*)context;
+    if (ctx->refuse) {
+        return nullptr;
+    }
+    IngestServerTestState* state = &ctx->states[connection];
+    MessageParser*         parser = new (state->parser) MessageParser(buffer);
+    new (state->frame) MessageFrame({.data = state->data, .size = sizeof(state->data)});
+    parser->init(ingestServerTestSchema);
+    parser->reset();
+    state->connection   = connection;
+    state->frameCount   = 0;
+    state->badCount     = 0;
+    ctx->lastConnection = connection;
+    ctx->openCount++;
+    return state;
+};
+
+static uint32_t ingest_server_test_data(void*, void* state, CircularBuffer8&) {
+    IngestServerTestState* s      = (IngestServerTestState*)state;
+    MessageParser*         parser = (MessageParser*)s->parser;
+    MessageFrame*          frame  = (MessageFrame*)s->frame;
+    uint32_t               count  = 0;
+    while (parser->parse(frame) == Result::OK) {
+        Buffer8 content = frame->getContent();
+        uint8_t index   = s->frameCount;
+        if (content.size != 4U + index % 3 || content.data[0] != index) {
+            s->badCount++;
+        }
+        s->frameCount++;
+        count++;
+    }
+    return count;
+};
+
+static void ingest_server_test_close(void* context, void*) {
+    ((IngestServerTestContext*)context)->closeCount++;
+};
+
+static int ingest_server_test_client(int type, uint16_t port) {
+    int                fd = socket(AF_INET, type, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = htons(port);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        return -1;
+    }
+    struct timeval timeout = {.tv_sec = 2, .tv_usec = 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return fd;
+};
+
+/**
+ * @return Return true if the server closed the connection of fd.
+ */
+static bool ingest_server_test_closed(int fd) {
+    uint8_t data;
+    return recv(fd, &data, 1, 0) <= 0;
+};
+
+static void ingest_server_backend_test(INGEST_SERVER_BACKEND backend) {
+    static uint8_t storage[INGEST_SERVER_TEST_RING_COUNT * INGEST_SERVER_TEST_RING_SIZE];
+    static IngestServerTestContext ctx;
+    static IngestServer            server({.data = storage, .size = sizeof(storage)},
+                                          {
+                                              .open    = ingest_server_test_open,
+                                              .data    = ingest_server_test_data,
+                                              .close   = ingest_server_test_close,
+                                              .context = &ctx,
+                                          });
+    memset(&ctx, 0, sizeof(ctx));
+
+    IngestServerConfig config = {
+        .address        = INADDR_LOOPBACK,
+        .tcpPort        = 0,
+        .udpPort        = 0,
+        .tcp            = true,
+        .udp            = true,
+        .backend        = backend,
+        .ringSize       = INGEST_SERVER_TEST_RING_SIZE,
+        .udpIdleTimeout = 0,
+    };
+    IngestServerConfig noRing = config;
+    noRing.ringSize           = 0;
+    MU_ASSERT(server.open(noRing) == Result::InvalidParameter);
+    MU_ASSERT(server.open(config) == Result::OK);
+    MU_ASSERT(server.tcp_port() != 0 && server.udp_port() != 0);
+    MU_ASSERT(server.connection_count() == 0);
+
+    uint8_t  frames[8][16];
+    uint32_t lengths[8];
+    for (uint32_t i = 0; i < 8; i++) {
+        lengths[i] = ingest_server_test_frame(frames[i], i);
+    }
+
+    // Frames cut in pieces of 3 bytes, the parser resumes on every piece.
+    int a = ingest_server_test_client(SOCK_STREAM, server.tcp_port());
+    MU_ASSERT(a >= 0);
+    INGEST_SERVER_TEST_POLL(server, ctx.openCount == 1);
+    MU_ASSERT(ctx.openCount == 1 && server.acceptCount == 1);
+    uint32_t connectionA = ctx.lastConnection;
+    for (uint32_t i = 0; i < 6; i++) {
+        for (uint32_t j = 0; j < lengths[i]; j += 3) {
+            uint32_t length = lengths[i] - j < 3 ? lengths[i] - j : 3;
+            MU_ASSERT(send(a, frames[i] + j, length, 0) == (ssize_t)length);
+            server.poll(0);
+        }
+    }
+    INGEST_SERVER_TEST_POLL(server, server.frameCount == 6);
+    MU_ASSERT(server.frameCount == 6 && server.byteCount == 78);
+    MU_ASSERT(ctx.states[connectionA].frameCount == 6 && ctx.states[connectionA].badCount == 0);
+
+    // Every source of datagrams has a parser of its own.
+    int b = ingest_server_test_client(SOCK_DGRAM, server.udp_port());
+    int c = ingest_server_test_client(SOCK_DGRAM, server.udp_port());
+    MU_ASSERT(b >= 0 && c >= 0);
+    for (uint32_t i = 0; i < 2; i++) {
+        MU_ASSERT(send(b, frames[i], lengths[i], 0) == (ssize_t)lengths[i]);
+        MU_ASSERT(send(c, frames[i], lengths[i], 0) == (ssize_t)lengths[i]);
+    }
+    INGEST_SERVER_TEST_POLL(server, server.frameCount == 10);
+    MU_ASSERT(server.frameCount == 10 && ctx.openCount == 3);
+    MU_ASSERT(server.connection_count() == 3);
+    for (uint32_t i = 0; i < INGEST_SERVER_TEST_RING_COUNT; i++) {
+        if (i != connectionA) {
+            MU_ASSERT(ctx.states[i].badCount == 0);
+        }
+    }
+
+    // Closed by the application, with a read in flight under io_uring.
+    server.connection_close(connectionA);
+    INGEST_SERVER_TEST_POLL(server, server.closeCount == 1);
+    MU_ASSERT(server.closeCount == 1 && ctx.closeCount == 1);
+    MU_ASSERT(ingest_server_test_closed(a));
+
+    // A frame longer than the ring fills it, which closes the connection.
+    int     d = ingest_server_test_client(SOCK_STREAM, server.tcp_port());
+    uint8_t large[INGEST_SERVER_TEST_RING_SIZE];
+    memset(large, 0, sizeof(large));
+    memcpy(large, frames[0], 6);
+    large[4] = INGEST_SERVER_TEST_RING_SIZE - 6;
+    MU_ASSERT(send(d, large, sizeof(large), 0) == sizeof(large));
+    INGEST_SERVER_TEST_POLL(server, server.closeCount == 2);
+    MU_ASSERT(server.overflowCount == 1 && server.closeCount == 2);
+    MU_ASSERT(ingest_server_test_closed(d));
+
+    // Refused by the open hook.
+    ctx.refuse = true;
+    int e      = ingest_server_test_client(SOCK_STREAM, server.tcp_port());
+    INGEST_SERVER_TEST_POLL(server, server.refusedCount == 1);
+    MU_ASSERT(server.refusedCount == 1 && ingest_server_test_closed(e));
+    ctx.refuse = false;
+
+    // Two rings are left, the third connection is refused.
+    int f = ingest_server_test_client(SOCK_STREAM, server.tcp_port());
+    int g = ingest_server_test_client(SOCK_STREAM, server.tcp_port());
+    int h = ingest_server_test_client(SOCK_STREAM, server.tcp_port());
+    INGEST_SERVER_TEST_POLL(server, server.refusedCount == 2);
+    MU_ASSERT(server.refusedCount == 2 && server.connection_count() == 4);
+    MU_ASSERT(ingest_server_test_closed(h));
+
+    // Closed by the client.
+    ::close(f);
+    INGEST_SERVER_TEST_POLL(server, server.closeCount == 3);
+    MU_ASSERT(server.closeCount == 3 && server.connection_count() == 3);
+
+    server.close();
+    MU_ASSERT(ctx.openCount == 6 && ctx.closeCount == 6);
+    MU_ASSERT(ingest_server_test_closed(g));
+
+    ::close(a);
+    ::close(b);
+    ::close(c);
+    ::close(d);
+    ::close(e);
+    ::close(g);
+    ::close(h);
+};
+
+/**
+ * UDP sources are closed once idle, and open again on their next datagram.
+ */
+static void ingest_server_udp_idle_test() {
+    static uint8_t storage[INGEST_SERVER_TEST_RING_COUNT * INGEST_SERVER_TEST_RING_SIZE];
+    static IngestServerTestContext ctx;
+    static IngestServer            server({.data = storage, .size = sizeof(storage)},
+                                          {
+                                              .open    = ingest_server_test_open,
+                                              .data    = ingest_server_test_data,
+                                              .close   = ingest_server_test_close,
+                                              .context = &ctx,
+                                          });
+    memset(&ctx, 0, sizeof(ctx));
+
+    IngestServerConfig config = {
+        .address        = INADDR_LOOPBACK,
+        .tcpPort        = 0,
+        .udpPort        = 0,
+        .tcp            = false,
+        .udp            = true,
+        .backend        = INGEST_SERVER_BACKEND::EPOLL,
+        .ringSize       = INGEST_SERVER_TEST_RING_SIZE,
+        .udpIdleTimeout = 100,
+    };
+    MU_ASSERT(server.open(config) == Result::OK);
+
+    uint8_t  frame[16];
+    uint32_t length = ingest_server_test_frame(frame, 0);
+
+    // Sources come and go many times over, their slots are reused.
+    for (uint32_t source = 0; source < 64; source++) {
+        int c = ingest_server_test_client(SOCK_DGRAM, server.udp_port());
+        MU_ASSERT(c >= 0 && send(c, frame, length, 0) == (ssize_t)length);
+        INGEST_SERVER_TEST_POLL(server, ctx.openCount == 1 + source);
+        server.connection_close(ctx.lastConnection);
+        ::close(c);
+    }
+    MU_ASSERT(ctx.openCount == 64 && ctx.closeCount == 64 && server.connection_count() == 0);
+
+    int a = ingest_server_test_client(SOCK_DGRAM, server.udp_port());
+    int b = ingest_server_test_client(SOCK_DGRAM, server.udp_port());
+    MU_ASSERT(a >= 0 && b >= 0);
+    MU_ASSERT(send(a, frame, length, 0) == (ssize_t)length);
+    MU_ASSERT(send(b, frame, length, 0) == (ssize_t)length);
+    INGEST_SERVER_TEST_POLL(server, server.frameCount == 66);
+    MU_ASSERT(server.frameCount == 66 && server.connection_count() == 2);
+
+    // b keeps sending, a goes quiet and loses its ring.
+    for (uint32_t i = 0; i < 200 && server.expiredCount == 0; i++) {
+        if (i % 5 == 0) {
+            MU_ASSERT(send(b, frame, length, 0) == (ssize_t)length);
+        }
+        server.poll(10);
+    }
+    MU_ASSERT(server.expiredCount == 1 && ctx.closeCount == 65);
+    MU_ASSERT(server.connection_count() == 1);
+
+    // Back, a starts over with a new parser.
+    MU_ASSERT(send(a, frame, length, 0) == (ssize_t)length);
+    INGEST_SERVER_TEST_POLL(server, ctx.openCount == 67);
+    MU_ASSERT(ctx.openCount == 67 && server.connection_count() == 2);
+    MU_ASSERT(ctx.states[ctx.lastConnection].frameCount == 1);
+
+    server.close();
+    MU_ASSERT(ctx.openCount == ctx.closeCount);
+    ::close(a);
+    ::close(b);
+};
+
+void ingest_server_test() {
+    ingest_server_backend_test(INGEST_SERVER_BACKEND::EPOLL);
+    ingest_server_backend_test(INGEST_SERVER_BACKEND::IO_URING);
+    ingest_server_udp_idle_test();
+};
+
+}  // namespace wibot::comm::test
+
+#endif  // __linux__
@@ -0,0 +1,10 @@
+#ifndef __WWTALK_INGEST_SERVER_TEST_HPP__
+#define __WWTALK_INGEST_SERVER_TEST_HPP__
+
+#include "ingest_server.hpp"
+
+namespace wibot::comm::test {
+void ingest_server_test();
+}  // namespace wibot::comm::test
+
+#endif  // __WWTALK_INGEST_SERVER_TEST_HPP__
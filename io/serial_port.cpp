@@ -0,0 +1,191 @@
+#include "serial_port.hpp"
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace wibot::comm {
+
+struct SerialPortBaud {
+    uint32_t rate;
+    speed_t  speed;
+};
+
+static const SerialPortBaud serialPortBauds[] = {
+    {9600, B9600},       {19200, B19200},     {38400, B38400},     {57600, B57600},
+    {115200, B115200},   {230400, B230400},   {460800, B460800},   {921600, B921600},
+    {1000000, B1000000}, {1500000, B1500000}, {2000000, B2000000}, {3000000, B3000000},
+    {4000000, B4000000},
+};
+
+static inline uint64_t serial_port_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+};
+
+SerialPort::SerialPort(CircularBuffer8& buffer, Buffer8 storage)
+    : lowLatency(false),
+      lastError(0),
+      position(0),
+      readCount(0),
+      _buffer(buffer),
+      _storage(storage),
+      _fd(-1),
+      _epoll(-1){};
+
+SerialPort::~SerialPort() {
+    close();
+};
+
+Result SerialPort::open(const char* path, uint32_t baud) {
+    const SerialPortBaud* rate = nullptr;
+    for (uint32_t i = 0; i < sizeof(serialPortBauds) / sizeof(serialPortBauds[0]); i++) {
+        if (serialPortBauds[i].rate == baud) {
+            rate = &serialPortBauds[i];
+            break;
+        }
+    }
+    if (rate == nullptr) {
+        return Result::NotSupport;
+    }
+
+    // The ring has no accessor of its write index, read derives it from storage, which must be
+    // the whole memory of the ring: its last byte, then its first, follow its first byte.
+    uintptr_t index = (uintptr_t)_buffer.peekPtr(0) - (uintptr_t)_storage.data;
+    if (_storage.size == 0 || index >= _storage.size ||
+        _buffer.peekPtr(_storage.size - 1 - index) != _storage.data + _storage.size - 1 ||
+        _buffer.peekPtr(_storage.size - index) != _storage.data) {
+        return Result::InvalidParameter;
+    }
+
+    close();
+    _fd = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (_fd < 0) {
+        lastError = errno;
+        return Result::GeneralError;
+    }
+
+    struct termios tio;
+    if (tcgetattr(_fd, &tio) != 0) {
+        goto error;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cc[VMIN]  = 0;
+    tio.c_cc[VTIME] = 0;
+    if (cfsetispeed(&tio, rate->speed) != 0 || cfsetospeed(&tio, rate->speed) != 0 ||
+        tcsetattr(_fd, TCSANOW, &tio) != 0) {
+        goto error;
+    }
+    tcflush(_fd, TCIFLUSH);
+
+    // The driver passes bytes up as they arrive instead of on its timer.
+    struct serial_struct serial;
+    lowLatency = false;
+    if (ioctl(_fd, TIOCGSERIAL, &serial) == 0) {
+        serial.flags |= ASYNC_LOW_LATENCY;
+        lowLatency = ioctl(_fd, TIOCSSERIAL, &serial) == 0;
+    }
+
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll < 0) {
+        goto error;
+    }
+    struct epoll_event event;
+    event.events  = EPOLLIN;
+    event.data.fd = _fd;
+    if (epoll_ctl(_epoll, EPOLL_CTL_ADD, _fd, &event) != 0) {
+        goto error;
+    }
+
+    position  = 0;
+    readCount = 0;
+    return Result::OK;
+
+error:
+    lastError = errno;
+    close();
+    return Result::GeneralError;
+};
+
+void SerialPort::close() {
+    if (_epoll >= 0) {
+        ::close(_epoll);
+        _epoll = -1;
+    }
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+};
+
+Result SerialPort::read(SerialPortRead* read) {
+    uint32_t size = _buffer.getSize();
+    uint32_t free = _storage.size - size;
+    if (free == 0) {
+        return Result::NoResource;
+    }
+
+    // The free space starts after the last byte of the ring, and wraps at its end.
+    uint32_t     index = (_buffer.peekPtr(0) - _storage.data + size) % _storage.size;
+    struct iovec segments[2];
+    segments[0].iov_base = _storage.data + index;
+    segments[0].iov_len  = _storage.size - index < free ? _storage.size - index : free;
+    segments[1].iov_base = _storage.data;
+    segments[1].iov_len  = free - segments[0].iov_len;
+
+    ssize_t length = readv(_fd, segments, segments[1].iov_len ? 2 : 1);
+    uint64_t time  = serial_port_now();
+    if (length < 0) {
+        if (errno == EAGAIN || errno == EINTR) {
+            return Result::NoResource;
+        }
+        lastError = errno;
+        return Result::GeneralError;
+    }
+    if (length == 0) {
+        return Result::NoResource;
+    }
+
+    _buffer.writeVirtual(length);
+    read->time     = time;
+    read->position = position;
+    read->length   = length;
+    position += length;
+    readCount++;
+    return Result::OK;
+};
+
+Result SerialPort::wait(SerialPortRead* read, int32_t timeout) {
+    struct epoll_event event;
+    int                count = epoll_wait(_epoll, &event, 1, timeout);
+    if (count < 0) {
+        if (errno == EINTR) {
+            return Result::NoResource;
+        }
+        lastError = errno;
+        return Result::GeneralError;
+    }
+    if (count == 0) {
+        return Result::NoResource;
+    }
+    Result result = this->read(read);
+    if (result == Result::NoResource && (event.events & (EPOLLHUP | EPOLLERR))) {
+        lastError = EIO;
+        return Result::GeneralError;
+    }
+    return result;
+};
+
+}  // namespace wibot::comm
+
+#endif  // __linux__
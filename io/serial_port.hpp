@@ -0,0 +1,77 @@
+#ifndef __WWTALK_SERIAL_PORT_HPP__
+#define __WWTALK_SERIAL_PORT_HPP__
+#ifdef __linux__
+
+#include "CircularBuffer.hpp"
+#include "base.hpp"
+
+namespace wibot::comm {
+
+/**
+ * A read, the bytes of the stream from position to position + length, received at time.
+ */
+struct SerialPortRead {
+    uint64_t time;      // ns, CLOCK_MONOTONIC, right after the read returned.
+    uint64_t position;  // bytes read before this read.
+    uint32_t length;
+};
+
+/**
+ * A receiver on /dev/ttyS*, /dev/ttyUSB* or /dev/ttyACM*, raw 8N1 without flow control.
+ * Reads go straight into the free space of the ring the parser reads, both of its segments
+ * when it wraps in one readv, so bytes are never copied between the driver and the parser.
+ *
+ * The port is non-blocking, wait blocks on its own epoll, and fd may be added to the epoll of
+ * the application instead.
+ */
+class SerialPort {
+   public:
+    /**
+     * @param storage The memory of buffer, as given to its constructor.
+     */
+    SerialPort(CircularBuffer8& buffer, Buffer8 storage);
+    ~SerialPort();
+
+    /**
+     * Open and configure path. Low latency mode is requested from the driver, which some
+     * drivers, as USB ACM and pseudo-terminals, do not have.
+     * @param baud A standard rate, 9600 to 4000000.
+     * @return Return NotSupport for other rates, InvalidParameter if storage is not the memory
+     * of the ring, GeneralError if the port cannot be opened or configured, see lastError.
+     */
+    Result open(const char* path, uint32_t baud);
+    void   close();
+
+    /**
+     * Read what the driver has, as far as the ring has room.
+     * @return Return OK, NoResource if the driver or the ring has no byte for now, GeneralError
+     * if the port failed or hung up.
+     */
+    Result read(SerialPortRead* read);
+
+    /**
+     * Wait up to timeout ms for bytes, then read them.
+     * @param timeout -1 to wait without limit.
+     */
+    Result wait(SerialPortRead* read, int32_t timeout);
+
+    int fd() const {
+        return _fd;
+    };
+
+    bool     lowLatency;  // the driver accepted low latency mode.
+    int      lastError;   // errno of the last failure.
+    uint64_t position;    // bytes read since open.
+    uint32_t readCount;
+
+   private:
+    CircularBuffer8& _buffer;
+    Buffer8          _storage;
+    int              _fd;
+    int              _epoll;
+};
+
+}  // namespace wibot::comm
+
+#endif  // __linux__
+#endif  // __WWTALK_SERIAL_PORT_HPP__
@@ -0,0 +1,122 @@
+#include "serial_port_test.hpp"
+#ifdef __linux__
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "CircularBuffer.hpp"
+#include "minunit.h"
+#include "string.h"
+
+namespace wibot::comm::test {
+
+/**
+ * The master side of a pseudo-terminal, whose slave stands in for the receiver port.
+ */
+static int serial_port_test_pty(char* path, uint32_t size) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0 ||
+        ptsname_r(master, path, size) != 0) {
+        return -1;
+    }
+    return master;
+};
+
+static void serial_port_open_test() {
+    uint8_t         ring[64];
+    CircularBuffer8 rb(ring, sizeof(ring));
+    SerialPort      port(rb, {.data = ring, .size = sizeof(ring)});
+    char            path[64];
+    int             master = serial_port_test_pty(path, sizeof(path));
+    MU_ASSERT(master >= 0);
+
+    MU_ASSERT(port.open(path, 12345) == Result::NotSupport);
+
+    // Reads are written through storage, it must be the memory of the ring.
+    SerialPort half(rb, {.data = ring, .size = sizeof(ring) / 2});
+    MU_ASSERT(half.open(path, 115200) == Result::InvalidParameter);
+    uint8_t    elsewhere[64];
+    SerialPort other(rb, {.data = elsewhere, .size = sizeof(elsewhere)});
+    MU_ASSERT(other.open(path, 115200) == Result::InvalidParameter);
+    rb.write(ring, 40, false);
+    rb.readVirtual(30);  // read from the 30th byte, as the ring is checked from there.
+    MU_ASSERT(half.open(path, 115200) == Result::InvalidParameter);
+    rb.readVirtual(10);  // the ring empty, opened below from its 40th byte.
+    MU_ASSERT(port.open("/dev/wwtalk-none", 115200) == Result::GeneralError);
+    MU_ASSERT(port.lastError != 0 && port.fd() < 0);
+    MU_ASSERT(port.open(path, 921600) == Result::OK && port.fd() >= 0);
+
+    SerialPortRead read;
+    MU_ASSERT(port.read(&read) == Result::NoResource);
+    MU_ASSERT(port.wait(&read, 10) == Result::NoResource);
+
+    // The master hangs up.
+    ::close(master);
+    MU_ASSERT(port.wait(&read, 100) == Result::GeneralError);
+    port.close();
+    MU_ASSERT(port.fd() < 0);
+};
+
+static void serial_port_read_test() {
+    uint8_t         ring[64];
+    CircularBuffer8 rb(ring, sizeof(ring));
+    SerialPort      port(rb, {.data = ring, .size = sizeof(ring)});
+    char            path[64];
+    int             master = serial_port_test_pty(path, sizeof(path));
+    MU_ASSERT(master >= 0);
+    MU_ASSERT(port.open(path, 115200) == Result::OK);
+
+    uint8_t data[100];
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = i * 13 + 1;
+    }
+
+    // Bytes in order and nowhere else than the ring.
+    MU_ASSERT(write(master, data, 40) == 40);
+    SerialPortRead read;
+    uint32_t       received = 0;
+    uint64_t       time     = 0;
+    while (received < 40 && port.wait(&read, 1000) == Result::OK) {
+        MU_ASSERT(read.position == received && read.time >= time);
+        received += read.length;
+        time = read.time;
+    }
+    MU_ASSERT(received == 40 && rb.getSize() == 40 && port.position == 40);
+    MU_ASSERT(!memcmp(ring, data, 40));
+
+    // The free space now wraps, a read fills both of its segments.
+    rb.readVirtual(30);
+    MU_ASSERT(write(master, data + 40, 50) == 50);
+    received = 0;
+    while (received < 50 && port.wait(&read, 1000) == Result::OK) {
+        MU_ASSERT(read.position == 40 + received);
+        received += read.length;
+    }
+    MU_ASSERT(received == 50 && rb.getSize() == 60);
+    uint8_t out[60];
+    rb.peek(out, 0, 60);
+    MU_ASSERT(!memcmp(out, data + 30, 60));
+    MU_ASSERT(!memcmp(ring, data + 64, 26));
+
+    // A full ring leaves the bytes to the driver.
+    MU_ASSERT(write(master, data, 10) == 10);
+    usleep(10000);
+    MU_ASSERT(port.read(&read) == Result::OK && read.length == 4);
+    MU_ASSERT(port.read(&read) == Result::NoResource);
+    rb.readVirtual(64);
+    MU_ASSERT(port.wait(&read, 1000) == Result::OK && read.length == 6);
+    MU_ASSERT(port.position == 100);
+
+    port.close();
+    ::close(master);
+};
+
+void serial_port_test() {
+    serial_port_open_test();
+    serial_port_read_test();
+};
+
+}  // namespace wibot::comm::test
+
+#endif  // __linux__
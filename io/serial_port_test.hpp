@@ -0,0 +1,10 @@
+#ifndef __WWTALK_SERIAL_PORT_TEST_HPP__
+#define __WWTALK_SERIAL_PORT_TEST_HPP__
+
+#include "serial_port.hpp"
+
+namespace wibot::comm::test {
+void serial_port_test();
+}  // namespace wibot::comm::test
+
+#endif  // __WWTALK_SERIAL_PORT_TEST_HPP__
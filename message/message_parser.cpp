@@ -131,48 +131,69 @@ Buffer8 MessageFrame::getFrameData() const {
         .size = this->_frameLength,
     };
 }
-MessageParser::MessageParser(CircularBuffer<uint8_t>& buffer) : _buffer(buffer) {}
+MessageParser::MessageParser(CircularBuffer<uint8_t>& buffer) : _buffer(buffer), _frame(nullptr) {
+    _schema.reset(&_state);
+}
 Result MessageParser::init(const MessageSchema& schema) {
-    _schema = schema;
-
-    //    _lengthOverhead = _schema.getDynamicLengthOverhead();
-    //    _contentOverhead = _schema.getContentOverhead();
-    return _checkSchema();
+    _schema.reset(&_state);
+    return _schema.compile(schema);
 }
 Result MessageParser::parse(MessageFrame* parsedFrame) {
     if (parsedFrame == nullptr) {
         return Result::InvalidParameter;
     }
-
-    MESSAGE_PARSE_STAGE stage = _stage;
-    auto needNewEpic = false;
     if (_frame != parsedFrame) {
         _frame = parsedFrame;
-        stage = MESSAGE_PARSE_STAGE::INIT;
+        _schema.reset(&_state);
     }
+    return _schema.parse(&_state, _buffer, parsedFrame);
+}
+void MessageParser::reset() { _schema.reset(&_state); }
 
+Result CompiledMessageSchema::compile(const MessageSchema& schema) {
+    _schema = schema;
+    if (_schema.lengthSchemaCount > UINT8_MAX - 1) {
+        LOG_E("length schemas must not be more than %d.", UINT8_MAX - 1);
+        return Result::GeneralError;
+    }
+    return _checkSchema();
+}
+void CompiledMessageSchema::reset(MessageParseState* state) const {
+    state->offset = 0;
+    state->contentLength = 0;
+    state->stage = MESSAGE_PARSE_STAGE::INIT;
+    state->lengthIndex = 0;
+}
+Result CompiledMessageSchema::parse(MessageParseState* state, CircularBuffer8& buffer,
+                                    MessageFrame* parsedFrame) const {
+    if (parsedFrame == nullptr) {
+        return Result::InvalidParameter;
+    }
+
+    MESSAGE_PARSE_STAGE stage = state->stage;
+    bool needNewEpic;
     do {
+        // Set when a byte is discarded, so that every new epic makes progress.
+        needNewEpic = false;
         if (stage == MESSAGE_PARSE_STAGE::INIT) {
-            _offset = 0;
+            state->offset = 0;
             stage = MESSAGE_PARSE_STAGE::PREPARING;
         }
         if (stage == MESSAGE_PARSE_STAGE::PREPARING) {
-            _prepareFrame();
-
+            state->contentLength = 0;
+            state->lengthIndex = _schema.lengthSchemaCount;
             stage = MESSAGE_PARSE_STAGE::SEEKING_PREFIX;
         }
         if (stage == MESSAGE_PARSE_STAGE::SEEKING_PREFIX) {
             if (_schema.prefixSize > 0) {
-                _frame->_prefix.offset = 0;
-                auto result = _seek(_schema.prefix, _schema.prefixSize);
+                auto result = _seek(state, buffer, _schema.prefix, _schema.prefixSize);
+                // Bytes before the offset never start a frame, the ring keeps the rest only.
+                buffer.readVirtual(state->offset);
+                state->offset = 0;
                 if (result) {
                     // found prefix
-                    _remove(_offset);
-                    _move(_schema.prefixSize);
-
-                    _frame->_prefix.length = _schema.prefixSize;
+                    state->offset = _schema.prefixSize;
                     stage = MESSAGE_PARSE_STAGE::PARSING_CMD;
-
                 } else {
                     // not found prefix
                     // stay in this stage, and wait for more data.
@@ -183,156 +204,121 @@ Result MessageParser::parse(MessageFrame* parsedFrame) {
         }
 
         if (stage == MESSAGE_PARSE_STAGE::PARSING_CMD) {
-            if (static_cast<uint8_t>(_schema.commandSize) > 0) {
-                _frame->_command.offset = _offset;
-                auto result = _fetch(_command, static_cast<uint8_t>(_schema.commandSize));
-                if (result) {
-                    _frame->_command.length = static_cast<uint8_t>(_schema.commandSize);
-                    stage = MESSAGE_PARSE_STAGE::PARSING_LENGTH;
-                } else {
-                    // Not enough data to parse command, stay in this stage.
-                }
-            } else {
+            // The command stays in the ring, it is matched once.
+            if (_move(state, buffer, static_cast<uint8_t>(_schema.commandSize))) {
+                state->lengthIndex = _lengthSchemaMatch(buffer);
                 stage = MESSAGE_PARSE_STAGE::PARSING_LENGTH;
+            } else {
+                // Not enough data to parse command, stay in this stage.
             }
         }
 
+        const MessageLengthSchema* lengthSchema = _lengthSchema(state->lengthIndex);
+        uint32_t contentOverhead = _schema.getContentOverhead(lengthSchema);
         if (stage == MESSAGE_PARSE_STAGE::PARSING_LENGTH) {
-            _lengthSchema = _lengthSchemaMatch();
-            _contentOverhead = _schema.getContentOverhead(_lengthSchema);
-
-            if (_lengthSchema->mode == MESSAGE_LENGTH_SCHEMA_MODE::FIXED_LENGTH) {
-                _contentLength = _lengthSchema->fixed.length;
-                if ((_contentLength + _contentOverhead) > _frame->_buffer.size) {
-                    _buffer.readVirtual(1);
-                    _offset = 0;
-                    stage = MESSAGE_PARSE_STAGE::PREPARING;
-                    needNewEpic = true;
-                } else {
-                    stage = MESSAGE_PARSE_STAGE::PARSING_ALTERDATA;
-                }
-            } else if (_lengthSchema->mode == MESSAGE_LENGTH_SCHEMA_MODE::DYNAMIC_LENGTH) {
-                _frame->_length.offset = _offset;
+            uint32_t contentLength = 0;
+            bool parsed = true;
+            if (lengthSchema->mode == MESSAGE_LENGTH_SCHEMA_MODE::FIXED_LENGTH) {
+                contentLength = lengthSchema->fixed.length;
+            } else if (lengthSchema->mode == MESSAGE_LENGTH_SCHEMA_MODE::DYNAMIC_LENGTH) {
                 uint8_t lengthBuf[MESSAGE_PARSER_CMD_LENGTH_CRC_BUFFER_SIZE];
-
-                auto result =
-                    _fetch(lengthBuf, static_cast<uint8_t>(_lengthSchema->dynamic.lengthSize));
-                if (result) {
-                    auto lengthOverhead = _schema.getDynamicLengthOverhead(_lengthSchema);
-                    _contentLength = _parseLength(_lengthSchema, lengthBuf) - lengthOverhead;
-                    // check length limitation.
-                    if ((_contentLength + _contentOverhead) > _frame->_buffer.size) {
-                        _buffer.readVirtual(1);
-                        _offset = 0;
-                        stage = MESSAGE_PARSE_STAGE::PREPARING;
-                        needNewEpic = true;
-                    } else {
-                        _frame->_length.length =
-                            static_cast<uint8_t>(_lengthSchema->dynamic.lengthSize);
-                        stage = MESSAGE_PARSE_STAGE::PARSING_ALTERDATA;
-                    }
+                uint8_t lengthSize = static_cast<uint8_t>(lengthSchema->dynamic.lengthSize);
+                parsed = state->offset + lengthSize <= buffer.getSize();
+                if (parsed) {
+                    buffer.peek(lengthBuf, state->offset, lengthSize);
+                    state->offset += lengthSize;
+                    contentLength = _parseLength(lengthSchema, lengthBuf) -
+                                    _schema.getDynamicLengthOverhead(lengthSchema);
                 } else {
                     // Not enough data to parse length, stay in this stage.
                 }
             } else {
                 // free length mode, no length field.
+            }
+
+            if (!parsed) {
+                // wait for the length.
+            } else if (lengthSchema->mode != MESSAGE_LENGTH_SCHEMA_MODE::FREE_LENGTH &&
+                       (contentLength > UINT16_MAX ||
+                        (contentLength + contentOverhead) > parsedFrame->_buffer.size)) {
+                // check length limitation.
+                buffer.readVirtual(1);
+                state->offset = 0;
+                stage = MESSAGE_PARSE_STAGE::PREPARING;
+                needNewEpic = true;
+                continue;
+            } else {
+                state->contentLength = contentLength;
                 stage = MESSAGE_PARSE_STAGE::PARSING_ALTERDATA;
             }
         }
 
         if (stage == MESSAGE_PARSE_STAGE::PARSING_ALTERDATA) {
-            if (static_cast<uint8_t>(_schema.alterDataSize) > 0) {
-                _frame->_alterData.offset = _offset;
-                auto result = _move(static_cast<uint8_t>(_schema.alterDataSize));
-                if (result) {
-                    _frame->_alterData.length = static_cast<uint8_t>(_schema.alterDataSize);
-                    stage = MESSAGE_PARSE_STAGE::SEEKING_CONTENT;
-                } else {
-                    // Not enough data to parse command, stay in this stage.
-                }
-            } else {
+            if (_move(state, buffer, static_cast<uint8_t>(_schema.alterDataSize))) {
                 stage = MESSAGE_PARSE_STAGE::SEEKING_CONTENT;
+            } else {
+                // Not enough data to parse alter data, stay in this stage.
             }
         }
 
         if (stage == MESSAGE_PARSE_STAGE::SEEKING_CONTENT) {
-            if (_lengthSchema->mode != MESSAGE_LENGTH_SCHEMA_MODE::FREE_LENGTH) {
-                if (_contentLength > 0) {
-                    _frame->_content.offset = _offset;
-                    auto result = _move(_contentLength);
-                    if (result) {
-                        _frame->_content.length = _contentLength;
-                        stage = MESSAGE_PARSE_STAGE::SEEKING_CRC;
-                    } else {
-                        // Not enough data for content, stay in this stage.
-                    }
-                } else {
+            if (lengthSchema->mode != MESSAGE_LENGTH_SCHEMA_MODE::FREE_LENGTH) {
+                if (_move(state, buffer, state->contentLength)) {
                     stage = MESSAGE_PARSE_STAGE::SEEKING_CRC;
+                } else {
+                    // Not enough data for content, stay in this stage.
                 }
             } else {
-                // free mode
-                // record the start index.
-                _freeContentStartIndex = _offset;
-                _frame->_content.offset = _freeContentStartIndex;
+                // free mode, the content starts at the offset, after the alter data.
                 // not support crc, so skip crc stage.
                 stage = MESSAGE_PARSE_STAGE::MATCHING_SUFFIX;
             }
         }
 
         if (stage == MESSAGE_PARSE_STAGE::SEEKING_CRC) {
-            if (static_cast<uint8_t>(_schema.crcSize) > 0) {
-                _frame->_crc.offset = _offset;
-                auto result = _move(static_cast<uint8_t>(_schema.crcSize));
-                if (result) {
-                    _frame->_crc.length = static_cast<uint8_t>(_schema.crcSize);
-                    stage = MESSAGE_PARSE_STAGE::MATCHING_SUFFIX;
-                } else {
-                    // Not enough data for crc, stay in this stage.
-                }
-            } else {
+            if (_move(state, buffer, static_cast<uint8_t>(_schema.crcSize))) {
                 stage = MESSAGE_PARSE_STAGE::MATCHING_SUFFIX;
+            } else {
+                // Not enough data for crc, stay in this stage.
             }
         }
 
         if (stage == MESSAGE_PARSE_STAGE::MATCHING_SUFFIX) {
-            if (_lengthSchema->mode != MESSAGE_LENGTH_SCHEMA_MODE::FREE_LENGTH) {
-                if (_schema.suffixSize > 0) {
-                    _frame->_suffix.offset = _offset;
-                    auto result = _match(_schema.suffix, _schema.suffixSize);
-                    if (result == -1) {
-                        // not enough buffer, stay in this stage.
-
-                    } else if (result == 1) {
-                        // success
-                        _frame->_suffix.length = _schema.suffixSize;
-                        stage = MESSAGE_PARSE_STAGE::DONE;
-                    } else {
-                        // mismatch
-                        // discard one data that has been parsed.
-                        _buffer.readVirtual(1);
-                        _offset = 0;
-                        stage = MESSAGE_PARSE_STAGE::PREPARING;
-                        needNewEpic = true;
-                    }
-                } else {
+            if (lengthSchema->mode != MESSAGE_LENGTH_SCHEMA_MODE::FREE_LENGTH) {
+                auto result = _match(state, buffer, _schema.suffix, _schema.suffixSize);
+                if (result == -1) {
+                    // not enough buffer, stay in this stage.
+                } else if (result == 1) {
+                    // success
                     stage = MESSAGE_PARSE_STAGE::DONE;
+                } else {
+                    // mismatch
+                    // discard one data that has been parsed.
+                    buffer.readVirtual(1);
+                    state->offset = 0;
+                    stage = MESSAGE_PARSE_STAGE::PREPARING;
+                    needNewEpic = true;
+                    continue;
                 }
             } else {
                 // free mode
-                auto result = _seek(_schema.suffix, _schema.suffixSize);
-                if (_offset - _freeContentStartIndex + _contentOverhead > _frame->_buffer.size) {
+                uint32_t contentStart = _schema.prefixSize +
+                                        static_cast<uint8_t>(_schema.commandSize) +
+                                        static_cast<uint8_t>(_schema.alterDataSize);
+                auto result = _seek(state, buffer, _schema.suffix, _schema.suffixSize);
+                uint32_t contentLength = state->offset - contentStart;
+                if (contentLength > UINT16_MAX ||
+                    contentLength + contentOverhead > parsedFrame->_buffer.size) {
                     // discard one data that has been parsed.
-                    _buffer.readVirtual(1);
-                    _offset = 0;
+                    buffer.readVirtual(1);
+                    state->offset = 0;
                     stage = MESSAGE_PARSE_STAGE::PREPARING;
                     needNewEpic = true;
+                    continue;
                 }
                 if (result) {
-                    _contentLength = _offset - _freeContentStartIndex;
-                    _frame->_content.length = _contentLength;
-                    _frame->_suffix.offset = _offset;
-                    _move(_schema.suffixSize);
-                    _frame->_suffix.length = _schema.suffixSize;
+                    state->contentLength = contentLength;
+                    state->offset += _schema.suffixSize;
                     stage = MESSAGE_PARSE_STAGE::DONE;
                 } else {
                     // suffix not found, stay in this stage.
@@ -341,23 +327,20 @@ Result MessageParser::parse(MessageFrame* parsedFrame) {
         }
 
         if (stage == MESSAGE_PARSE_STAGE::DONE) {
-            _frame->_frameLength = _offset;
-            _buffer.read(_frame->_buffer.data, _offset);
-            _offset = 0;
-            stage = MESSAGE_PARSE_STAGE::PREPARING;
-
-            _stage = stage;
+            _completeFrame(state, parsedFrame);
+            buffer.read(parsedFrame->_buffer.data, state->offset);
+            state->offset = 0;
+            state->stage = MESSAGE_PARSE_STAGE::PREPARING;
             return Result::OK;
         }
 
     } while (needNewEpic);
 
-    _stage = stage;
+    state->stage = stage;
 
     return Result::NoResource;
 }
-void MessageParser::reset() { _stage = MESSAGE_PARSE_STAGE::INIT; }
-Result MessageParser::_checkLengthSchema(const MessageLengthSchema* lengthSchema,
+Result CompiledMessageSchema::_checkLengthSchema(const MessageLengthSchema* lengthSchema,
                                          bool isDefault) const {
     if (!isDefault && (_schema.commandSize == MESSAGE_SCHEMA_SIZE::NONE)) {
         LOG_E("command size must be none, if use multiple length definition.");
@@ -397,7 +380,7 @@ Result MessageParser::_checkLengthSchema(const MessageLengthSchema* lengthSchema
     return Result::OK;
 };
 
-Result MessageParser::_checkSchema() const {
+Result CompiledMessageSchema::_checkSchema() const {
     if (static_cast<uint8_t>(_schema.commandSize) > MESSAGE_PARSER_CMD_LENGTH_CRC_BUFFER_SIZE) {
         LOG_E("cmd length must not less than %d.", MESSAGE_PARSER_CMD_LENGTH_CRC_BUFFER_SIZE);
         return Result::GeneralError;
@@ -416,81 +399,79 @@ Result MessageParser::_checkSchema() const {
     }
     return _checkLengthSchema(&_schema.defaultLength, true);
 }
-bool MessageParser::_seek(const uint8_t (&pattern)[MESSAGE_SCHEMA_PERFIX_SUFFIX_MAX_SIZE],
-                          uint8_t patternSize) {
-    uint32_t totalLength = _buffer.getSize();
-    auto offset = _offset;
-    while ((offset + patternSize) <= totalLength) {
+bool CompiledMessageSchema::_seek(MessageParseState* state, CircularBuffer8& buffer,
+                                  const uint8_t (&pattern)[MESSAGE_SCHEMA_PERFIX_SUFFIX_MAX_SIZE],
+                                  uint8_t patternSize) const {
+    uint32_t totalLength = buffer.getSize();
+    auto offset = state->offset;
+    while (offset < totalLength) {
+        // At the end of the buffer, the bytes left may start the pattern.
+        uint32_t length = totalLength - offset < patternSize ? totalLength - offset : patternSize;
         auto matched = true;
-        for (int i = 0; i < patternSize; ++i) {
-            if (pattern[i] != *_buffer.peekPtr(offset + i)) {
+        for (uint32_t i = 0; i < length; ++i) {
+            if (pattern[i] != *buffer.peekPtr(offset + i)) {
                 matched = false;
                 break;
             }
         }
         if (matched) {
-            _offset = offset;
-            return true;
+            state->offset = offset;
+            return length == patternSize;
         }
         offset++;
     }
-    _offset = offset;
+    state->offset = offset;
     return false;
 }
-int32_t MessageParser::_match(const uint8_t (&pattern)[MESSAGE_SCHEMA_PERFIX_SUFFIX_MAX_SIZE],
-                              uint8_t patternSize) {
-    uint32_t totalLength = _buffer.getSize();
-    if (_offset + patternSize > totalLength) {
+int32_t CompiledMessageSchema::_match(
+    MessageParseState* state, CircularBuffer8& buffer,
+    const uint8_t (&pattern)[MESSAGE_SCHEMA_PERFIX_SUFFIX_MAX_SIZE], uint8_t patternSize) const {
+    uint32_t totalLength = buffer.getSize();
+    if (state->offset + patternSize > totalLength) {
         return -1;
     }
     for (int i = 0; i < patternSize; ++i) {
-        if (pattern[i] != *_buffer.peekPtr(_offset + i)) {
+        if (pattern[i] != *buffer.peekPtr(state->offset + i)) {
             return 0;
         }
     }
-    _offset += patternSize;
+    state->offset += patternSize;
     return 1;
 }
-bool MessageParser::_fetch(uint8_t* data, uint16_t length) {
-    if (_offset + length > _buffer.getSize()) {
-        return false;
-    }
-    _buffer.peek(data, _offset, length);
-    _offset += length;
-    return true;
-}
-bool MessageParser::_move(uint16_t length) {
-    if (_offset + length > _buffer.getSize()) {
-        return false;
-    }
-    _offset += length;
-    return true;
-}
-bool MessageParser::_remove(uint16_t length) {
-    if (length > _buffer.getSize()) {
+bool CompiledMessageSchema::_move(MessageParseState* state, CircularBuffer8& buffer,
+                                  uint32_t length) const {
+    if (state->offset + length > buffer.getSize()) {
         return false;
     }
-    _buffer.readVirtual(length);
-    _offset -= length;
+    state->offset += length;
     return true;
 }
-const MessageLengthSchema* MessageParser::_lengthSchemaMatch() {
+uint8_t CompiledMessageSchema::_lengthSchemaMatch(CircularBuffer8& buffer) const {
+    uint8_t command[MESSAGE_PARSER_CMD_LENGTH_CRC_BUFFER_SIZE];
+    uint8_t commandSize = static_cast<uint8_t>(_schema.commandSize);
+    buffer.peek(command, _schema.prefixSize, commandSize);
     for (uint32_t i = 0; i < _schema.lengthSchemaCount; ++i) {
         auto& def = _schema.lengthSchemas[i];
         auto cmdMatched = true;
-        for (int j = 0; j < static_cast<uint8_t>(_schema.commandSize); ++j) {
-            if (def.command[j] != _command[j]) {
+        for (int j = 0; j < commandSize; ++j) {
+            if (def.command[j] != command[j]) {
                 cmdMatched = false;
                 break;
             }
         }
         if (cmdMatched) {
-            return &def.length;
+            return i;
         }
     }
+    return _schema.lengthSchemaCount;
+}
+const MessageLengthSchema* CompiledMessageSchema::_lengthSchema(uint8_t index) const {
+    if (index < _schema.lengthSchemaCount) {
+        return &_schema.lengthSchemas[index].length;
+    }
     return &_schema.defaultLength;
 }
-uint32_t MessageParser::_parseLength(
+uint32_t CompiledMessageSchema::_parseLength(
     const MessageLengthSchema* lengthSchema,
     uint8_t (&buf)[MESSAGE_PARSER_CMD_LENGTH_CRC_BUFFER_SIZE]) const {
     if (lengthSchema->dynamic.lengthSize == MESSAGE_SCHEMA_SIZE::BIT8) {
@@ -504,11 +485,27 @@ uint32_t MessageParser::_parseLength(
         return 0;
     }
 }
-void MessageParser::_prepareFrame() {
-    _freeContentStartIndex = 0;
-    _contentLength = 0;
-    for (uint8_t i = 0; i < MESSAGE_PARSER_CMD_LENGTH_CRC_BUFFER_SIZE; i++) {
-        _command[i] = 0;
-    }
+void CompiledMessageSchema::_completeFrame(const MessageParseState* state,
+                                           MessageFrame* frame) const {
+    // Every segment follows from the schema and the content length.
+    const MessageLengthSchema* lengthSchema = _lengthSchema(state->lengthIndex);
+    frame->_prefix.offset = 0;
+    frame->_prefix.length = _schema.prefixSize;
+    frame->_command.offset = frame->_prefix.offset + frame->_prefix.length;
+    frame->_command.length = static_cast<uint8_t>(_schema.commandSize);
+    frame->_length.offset = frame->_command.offset + frame->_command.length;
+    frame->_length.length =
+        lengthSchema->mode == MESSAGE_LENGTH_SCHEMA_MODE::DYNAMIC_LENGTH
+            ? static_cast<uint8_t>(lengthSchema->dynamic.lengthSize)
+            : 0;
+    frame->_alterData.offset = frame->_length.offset + frame->_length.length;
+    frame->_alterData.length = static_cast<uint8_t>(_schema.alterDataSize);
+    frame->_content.offset = frame->_alterData.offset + frame->_alterData.length;
+    frame->_content.length = state->contentLength;
+    frame->_crc.offset = frame->_content.offset + frame->_content.length;
+    frame->_crc.length = static_cast<uint8_t>(_schema.crcSize);
+    frame->_suffix.offset = frame->_crc.offset + frame->_crc.length;
+    frame->_suffix.length = _schema.suffixSize;
+    frame->_frameLength = state->offset;
 }
 }  // namespace wibot::comm
@@ -122,7 +122,7 @@ struct MessageSchema {
      */
     uint32_t getLength(const MessageLengthSchema* lengthSchema, uint32_t contentLength) const;
 };
-class MessageParser;
+class CompiledMessageSchema;
 
 struct MessageFrameSegment {
     uint16_t offset;
@@ -151,7 +151,7 @@ struct MessageFrame {
     Buffer8 getFrameData() const;
 
    private:
-    friend class MessageParser;
+    friend class CompiledMessageSchema;
     MessageFrameSegment _prefix;
     MessageFrameSegment _command;
     MessageFrameSegment _length;
@@ -163,25 +163,44 @@ struct MessageFrame {
     uint32_t _frameLength;
 };
 
-class MessageParser {
+/**
+ * @brief What a stream needs between two parses, every other field of a frame is found again
+ * in its ring or derived from the schema.
+ */
+struct MessageParseState {
+    uint32_t offset;          // seek offset from the first byte of the ring.
+    uint16_t contentLength;   // of the frame being parsed, frames are at most 64 KiB.
+    MESSAGE_PARSE_STAGE stage;
+    uint8_t lengthIndex;      // matched length schema, lengthSchemaCount for the default.
+};
+static_assert(sizeof(MessageParseState) == 8, "MessageParseState is the state of a stream");
+
+/**
+ * @brief A schema checked once, immutable and shared by any number of streams, each of which
+ * only keeps its MessageParseState and its ring.
+ */
+class CompiledMessageSchema {
    public:
-    explicit MessageParser(CircularBuffer<uint8_t>& buffer);
+    /**
+     * @brief Copy and check the schema, lengthSchemas must outlive this object.
+     * @return Return OK, or GeneralError if the schema is invalid.
+     */
+    Result compile(const MessageSchema& schema);
 
-    Result init(const MessageSchema& schema);
-    Result parse(MessageFrame* parsedFrame);
-    void reset();
+    void reset(MessageParseState* state) const;
+
+    /**
+     * @brief Parse the next frame of a stream out of its ring. The frame is copied to the
+     * buffer of parsedFrame, which any number of streams may share.
+     * @return Return OK if a frame is parsed, NoResource if the ring has no whole frame yet.
+     */
+    Result parse(MessageParseState* state, CircularBuffer8& buffer,
+                 MessageFrame* parsedFrame) const;
+
+    const MessageSchema& getSchema() const { return _schema; }
 
    private:
-    CircularBuffer8& _buffer;
     MessageSchema _schema;
-    MESSAGE_PARSE_STAGE _stage;
-    uint32_t _offset;  // current working seek offset. initial value is -1.
-    uint32_t _freeContentStartIndex;
-    const MessageLengthSchema* _lengthSchema;
-    uint32_t _contentLength;
-    uint32_t _contentOverhead;
-    MessageFrame* _frame;
-    uint8_t _command[MESSAGE_PARSER_CMD_LENGTH_CRC_BUFFER_SIZE];
 
     Result _checkSchema() const;
     Result _checkLengthSchema(const MessageLengthSchema* lengthSchema, bool isDefault) const;
@@ -189,56 +208,62 @@ class MessageParser {
     /**
      * seek the pattern in the buffer, from the current offset to the end.
      * if found, the offset will be set to the beginning of the pattern.
-     * otherwise the offset will set to seek position.
-     * @param pattern
-     * @param patternSize
+     * otherwise the offset will set to where the pattern may start, the end of the
+     * buffer if no byte left may start it.
      * @return Return true if the pattern is found, otherwise false.
      */
-    bool _seek(const uint8_t (&pattern)[MESSAGE_SCHEMA_PERFIX_SUFFIX_MAX_SIZE],
-               uint8_t patternSize);
-    ;
+    bool _seek(MessageParseState* state, CircularBuffer8& buffer,
+               const uint8_t (&pattern)[MESSAGE_SCHEMA_PERFIX_SUFFIX_MAX_SIZE],
+               uint8_t patternSize) const;
 
     /**
      * match the pattern in the buffer, at the current offset. if matched, the
      * offset will be set to the the next position of the pattern. otherwise the
      * offset will not be changed.
-     * @param pattern
-     * @param patternSize
      * @return If matched, return 1, not matched, return 0, no enough space
      * return -1.
      */
-    int32_t _match(const uint8_t (&pattern)[MESSAGE_SCHEMA_PERFIX_SUFFIX_MAX_SIZE],
-                   uint8_t patternSize);
+    int32_t _match(MessageParseState* state, CircularBuffer8& buffer,
+                   const uint8_t (&pattern)[MESSAGE_SCHEMA_PERFIX_SUFFIX_MAX_SIZE],
+                   uint8_t patternSize) const;
 
-    /**
-     * @brief fetch data from the buffer, at the current offset, and move the
-     * offset to the next position.
-     * @param data
-     * @param length
-     * @return Return true if the data is fetched successfully, otherwise false.
-     */
-    bool _fetch(uint8_t* data, uint16_t length);
     /**
      * @brief move the offset to the next position.
-     * @param length
      * @return Return true if the offset is moved successfully, otherwise false.
      */
-    bool _move(uint16_t length);
+    bool _move(MessageParseState* state, CircularBuffer8& buffer, uint32_t length) const;
 
     /**
-     * @brief remove data from the buffer, at the current offset, and sync the
-     * offset.
-     * @param length
-     * @return Return true if the data is removed successfully, otherwise false.
+     * @brief Match the command, which is in the ring right after the prefix.
+     * @return Return the index of the length schema, lengthSchemaCount for the default.
      */
-    bool _remove(uint16_t length);
+    uint8_t _lengthSchemaMatch(CircularBuffer8& buffer) const;
 
-    const MessageLengthSchema* _lengthSchemaMatch();
+    const MessageLengthSchema* _lengthSchema(uint8_t index) const;
 
     uint32_t _parseLength(const MessageLengthSchema* lengthSchema,
                           uint8_t (&buf)[MESSAGE_PARSER_CMD_LENGTH_CRC_BUFFER_SIZE]) const;
 
-    void _prepareFrame();
+    void _completeFrame(const MessageParseState* state, MessageFrame* frame) const;
+};
+
+/**
+ * @brief A parser of a single stream, with a schema of its own.
+ * @note For many streams, share a CompiledMessageSchema instead, see MessageStreamPool.
+ */
+class MessageParser {
+   public:
+    explicit MessageParser(CircularBuffer<uint8_t>& buffer);
+
+    Result init(const MessageSchema& schema);
+    Result parse(MessageFrame* parsedFrame);
+    void reset();
+
+   private:
+    CircularBuffer8& _buffer;
+    CompiledMessageSchema _schema;
+    MessageParseState _state;
+    MessageFrame* _frame;
 };
 
 }  // namespace wibot::comm
@@ -425,6 +425,7 @@ static void message_parser_dynamic_test_3() {
             .mode = MESSAGE_LENGTH_SCHEMA_MODE::DYNAMIC_LENGTH,
             .dynamic{
                 .lengthSize = MESSAGE_SCHEMA_SIZE::BIT16,
+                .endian     = MESSAGE_SCHEMA_LENGTH_ENDIAN::LITTLE,
                 .range      = MESSAGE_SCHEMA_RANGE_PREFIX | MESSAGE_SCHEMA_RANGE_CMD |
                          MESSAGE_SCHEMA_RANGE_LENGTH | MESSAGE_SCHEMA_RANGE_CONTENT |
                          MESSAGE_SCHEMA_RANGE_CRC,
@@ -446,12 +447,12 @@ static void message_parser_dynamic_test_3() {
     parser.init(schema);
 
     uint8_t wr0Data[50] = {0x33,                                             // 1
-                           0xB5, 0x62, 0x01, 0x02, 0x0F, 0x00, 0x01, 0x01,
+                           0xB5, 0x62, 0x01, 0x02, 0x10, 0x00, 0x01, 0x01,
                            0x01, 0x01, 0x01, 0x02, 0x03, 0x04, 0x0E, 0x0F,   // 16
                            0x33,                                             // 1
-                           0xB5, 0x62, 0x01, 0x02, 0x0F, 0x00, 0x01, 0x01,
+                           0xB5, 0x62, 0x01, 0x02, 0x10, 0x00, 0x01, 0x01,
                            0x01, 0x01, 0x01, 0x02, 0x03, 0x04, 0x1E, 0x0F,   // 16
-                           0xB5, 0x62, 0x01, 0x02, 0x0F, 0x00, 0x01, 0x01,
+                           0xB5, 0x62, 0x01, 0x02, 0x10, 0x00, 0x01, 0x01,
                            0x01, 0x01, 0x01, 0x02, 0x03, 0x04, 0x0E, 0x0F};  // 16
 
     rb.write(wr0Data, 50, true);
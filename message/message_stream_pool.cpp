@@ -0,0 +1,76 @@
+#include "message_stream_pool.hpp"
+
+#include <new>
+
+namespace wibot::comm {
+
+static_assert(MESSAGE_STREAM_POOL_BLOCK_MAX_COUNT <= MESSAGE_STREAM_NO_BLOCK,
+              "blocks are stored in uint16_t");
+
+MessageStreamPool::MessageStreamPool(const CompiledMessageSchema& schema, Buffer8 storage,
+                                     uint32_t blockSize)
+    : exhaustedCount(0), _schema(schema), _storage(storage), _blockSize(blockSize) {
+    _blockCount = blockSize == 0 ? 0 : storage.size / blockSize;
+    if (_blockCount > MESSAGE_STREAM_POOL_BLOCK_MAX_COUNT) {
+        _blockCount = MESSAGE_STREAM_POOL_BLOCK_MAX_COUNT;
+    }
+    for (uint32_t i = 0; i < _blockCount; i++) {
+        new (_rings[i]) CircularBuffer8(storage.data + i * blockSize, blockSize);
+        // Popped from the end, the first rings are lent first.
+        _free[i] = _blockCount - 1 - i;
+    }
+    _freeCount = _blockCount;
+}
+
+void MessageStreamPool::init(MessageStream* stream) const {
+    _schema.reset(&stream->state);
+    stream->block = MESSAGE_STREAM_NO_BLOCK;
+}
+
+CircularBuffer8* MessageStreamPool::lend(MessageStream* stream) {
+    if (stream->block == MESSAGE_STREAM_NO_BLOCK) {
+        if (_freeCount == 0) {
+            exhaustedCount++;
+            return nullptr;
+        }
+        stream->block = _free[--_freeCount];
+    }
+    return &_ring(stream->block);
+}
+
+uint32_t MessageStreamPool::write(MessageStream* stream, const uint8_t* data, uint32_t length) {
+    CircularBuffer8* buffer = lend(stream);
+    if (buffer == nullptr) {
+        return 0;
+    }
+    uint32_t free = _blockSize - buffer->getSize();
+    if (length > free) {
+        length = free;
+    }
+    buffer->write(data, length, false);
+    return length;
+}
+
+Result MessageStreamPool::parse(MessageStream* stream, MessageFrame* parsedFrame) {
+    if (stream->block == MESSAGE_STREAM_NO_BLOCK) {
+        return Result::NoResource;
+    }
+    Result result = _schema.parse(&stream->state, _ring(stream->block), parsedFrame);
+    if (result == Result::NoResource && _ring(stream->block).getSize() == 0) {
+        // Nothing pending, the stream starts over from its next byte as from this one.
+        release(stream);
+    }
+    return result;
+}
+
+void MessageStreamPool::release(MessageStream* stream) {
+    if (stream->block == MESSAGE_STREAM_NO_BLOCK) {
+        return;
+    }
+    CircularBuffer8& buffer = _ring(stream->block);
+    buffer.readVirtual(buffer.getSize());
+    _free[_freeCount++] = stream->block;
+    init(stream);
+}
+
+}  // namespace wibot::comm
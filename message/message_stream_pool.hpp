@@ -0,0 +1,89 @@
+#ifndef __WWTALK_MESSAGE_STREAM_POOL_HPP__
+#define __WWTALK_MESSAGE_STREAM_POOL_HPP__
+
+#include "CircularBuffer.hpp"
+#include "base.hpp"
+#include "message_parser.hpp"
+
+namespace wibot::comm {
+
+#define MESSAGE_STREAM_POOL_BLOCK_MAX_COUNT 1024
+#define MESSAGE_STREAM_NO_BLOCK 0xFFFF
+
+/**
+ * @brief A stream parsed with a ring of a MessageStreamPool, all it keeps while it is idle.
+ */
+struct MessageStream {
+    MessageParseState state;
+    uint16_t block;  // the ring lent to the stream, MESSAGE_STREAM_NO_BLOCK while idle.
+};
+static_assert(sizeof(MessageStream) <= 12, "an idle stream is 12 bytes");
+
+/**
+ * @brief Rings lent to streams of a schema only while they have pending bytes, for tens of
+ * thousands of mostly idle streams.
+ *
+ * A stream is a MessageStream, 12 bytes while idle, against 104 bytes of MessageParser, 24 of
+ * CircularBuffer8, its ring, 56 of MessageFrame and its frame buffer when every stream parses on
+ * its own. The schema is compiled once and shared, a ring is lent on the first byte and given
+ * back once parse found every frame in it, and the frame buffer is the caller's, shared by all
+ * the streams it parses.
+ */
+class MessageStreamPool {
+   public:
+    /**
+     * @param storage The rings, storage.size / blockSize of them, and
+     * MESSAGE_STREAM_POOL_BLOCK_MAX_COUNT at most.
+     * @param blockSize The size of a ring, a frame must fit in it.
+     */
+    MessageStreamPool(const CompiledMessageSchema& schema, Buffer8 storage, uint32_t blockSize);
+
+    /**
+     * @brief Make stream idle, without a ring.
+     */
+    void init(MessageStream* stream) const;
+
+    /**
+     * @brief The ring of a stream, to read bytes into it. One is lent if the stream is idle.
+     * @return Return nullptr if every ring is lent.
+     */
+    CircularBuffer8* lend(MessageStream* stream);
+
+    /**
+     * @return Return the bytes written, as far as the ring has room, 0 if every ring is lent.
+     */
+    uint32_t write(MessageStream* stream, const uint8_t* data, uint32_t length);
+
+    /**
+     * @brief Parse the next frame of a stream, see CompiledMessageSchema::parse. Its ring is given
+     * back once it is empty.
+     * @return Return OK if a frame is parsed, NoResource if there is none, as for an idle stream.
+     */
+    Result parse(MessageStream* stream, MessageFrame* parsedFrame);
+
+    /**
+     * @brief Drop the pending bytes of a stream and give its ring back, as it closes.
+     */
+    void release(MessageStream* stream);
+
+    uint32_t getBlockCount() const { return _blockCount; }
+    uint32_t getLentCount() const { return _blockCount - _freeCount; }
+
+    uint32_t exhaustedCount;  // lends refused, every ring was lent.
+
+   private:
+    const CompiledMessageSchema& _schema;
+    Buffer8 _storage;
+    uint32_t _blockSize;
+    uint32_t _blockCount;
+    uint32_t _freeCount;
+    alignas(CircularBuffer8) uint8_t _rings[MESSAGE_STREAM_POOL_BLOCK_MAX_COUNT]
+                                           [sizeof(CircularBuffer8)];
+    uint16_t _free[MESSAGE_STREAM_POOL_BLOCK_MAX_COUNT];  // rings not lent.
+
+    inline CircularBuffer8& _ring(uint16_t block) { return *(CircularBuffer8*)_rings[block]; }
+};
+
+}  // namespace wibot::comm
+
+#endif  // __WWTALK_MESSAGE_STREAM_POOL_HPP__
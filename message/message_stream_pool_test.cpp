@@ -0,0 +1,224 @@
+#include "message_stream_pool_test.hpp"
+
+#include <new>
+
+#include "CircularBuffer.hpp"
+#include "minunit.h"
+#include "string.h"
+
+LOGGER("message_stream_pool_test")
+
+namespace wibot::comm::test {
+
+#define MESSAGE_STREAM_POOL_TEST_BLOCK_SIZE 64
+
+static const MessageSchema messageStreamPoolTestSchema = {
+    .prefix      = {0xB5, 0x62},
+    .prefixSize  = 2,
+    .commandSize = MESSAGE_SCHEMA_SIZE::BIT16,
+    .defaultLength{
+        .mode = MESSAGE_LENGTH_SCHEMA_MODE::DYNAMIC_LENGTH,
+        .dynamic{
+            .lengthSize = MESSAGE_SCHEMA_SIZE::BIT8,
+            .range      = MESSAGE_SCHEMA_RANGE_CONTENT,
+        },
+    },
+    .crcSize = MESSAGE_SCHEMA_SIZE::BIT16,
+};
+
+/**
+ * @brief B5 62, class and id, the length, index + i as payload and 2 bytes of checksum.
+ */
+static uint32_t message_stream_pool_test_frame(uint8_t* out, uint8_t index) {
+    uint32_t length = 3 + index % 5;
+    out[0] = 0xB5;
+    out[1] = 0x62;
+    out[2] = 0x01;
+    out[3] = 0x07;
+    out[4] = length;
+    for (uint32_t i = 0; i < length; i++) {
+        out[5 + i] = index + i;
+    }
+    out[5 + length] = 0xCC;
+    out[6 + length] = 0xDD;
+    return 7 + length;
+}
+
+static bool message_stream_pool_test_check(const MessageFrame& frame, uint8_t index) {
+    Buffer8 content = frame.getContent();
+    Buffer8 crc = frame.getCrc();
+    return content.size == 3U + index % 5 && content.data[0] == index &&
+           content.data[content.size - 1] == (uint8_t)(index + content.size - 1) &&
+           crc.size == 2 && crc.data[0] == 0xCC;
+}
+
+static void message_stream_pool_lend_test() {
+    static uint8_t storage[4 * MESSAGE_STREAM_POOL_TEST_BLOCK_SIZE];
+    uint8_t frameBuf[64];
+    MessageFrame frame({.data = frameBuf, .size = sizeof(frameBuf)});
+    static CompiledMessageSchema schema;
+    MU_ASSERT(schema.compile(messageStreamPoolTestSchema) == Result::OK);
+    static MessageStreamPool pool(schema, {.data = storage, .size = sizeof(storage)},
+                                  MESSAGE_STREAM_POOL_TEST_BLOCK_SIZE);
+    MU_ASSERT(pool.getBlockCount() == 4 && pool.getLentCount() == 0);
+
+    MessageStream streams[6];
+    for (auto& stream : streams) {
+        pool.init(&stream);
+    }
+    MU_ASSERT(pool.parse(&streams[0], &frame) == Result::NoResource);
+    MU_ASSERT(pool.getLentCount() == 0);
+
+    // A ring is lent while a frame is pending, and given back once it is out.
+    uint8_t data[16];
+    uint32_t length = message_stream_pool_test_frame(data, 7);
+    MU_ASSERT(pool.write(&streams[0], data, 5) == 5);
+    MU_ASSERT(pool.parse(&streams[0], &frame) == Result::NoResource);
+    MU_ASSERT(pool.getLentCount() == 1 && streams[0].block != MESSAGE_STREAM_NO_BLOCK);
+    MU_ASSERT(pool.write(&streams[0], data + 5, length - 5) == length - 5);
+    MU_ASSERT(pool.parse(&streams[0], &frame) == Result::OK);
+    MU_ASSERT(message_stream_pool_test_check(frame, 7));
+    MU_ASSERT(frame.getFrameData().size == length);
+    MU_ASSERT(pool.parse(&streams[0], &frame) == Result::NoResource);
+    MU_ASSERT(pool.getLentCount() == 0 && streams[0].block == MESSAGE_STREAM_NO_BLOCK);
+
+    // Bytes before a prefix are dropped, they do not hold the ring.
+    uint8_t noise[3] = {0x00, 0x62, 0xB5};
+    MU_ASSERT(pool.write(&streams[1], noise, 2) == 2);
+    MU_ASSERT(pool.parse(&streams[1], &frame) == Result::NoResource);
+    MU_ASSERT(pool.getLentCount() == 0);
+    MU_ASSERT(pool.write(&streams[1], noise + 2, 1) == 1);
+    MU_ASSERT(pool.parse(&streams[1], &frame) == Result::NoResource);
+    MU_ASSERT(pool.getLentCount() == 1);  // B5 may start a prefix.
+    MU_ASSERT(pool.write(&streams[1], data, length) == length);
+    MU_ASSERT(pool.parse(&streams[1], &frame) == Result::OK);
+    MU_ASSERT(message_stream_pool_test_check(frame, 7));
+    MU_ASSERT(pool.parse(&streams[1], &frame) == Result::NoResource);
+    MU_ASSERT(pool.getLentCount() == 0);
+
+    // Every ring lent, the fifth stream waits for one.
+    for (uint32_t i = 0; i < 4; i++) {
+        MU_ASSERT(pool.write(&streams[i], data, 3) == 3);
+    }
+    MU_ASSERT(pool.getLentCount() == 4);
+    MU_ASSERT(pool.write(&streams[4], data, length) == 0 && pool.exhaustedCount == 1);
+    MU_ASSERT(pool.lend(&streams[4]) == nullptr && pool.exhaustedCount == 2);
+    MU_ASSERT(pool.write(&streams[2], data + 3, length - 3) == length - 3);
+    MU_ASSERT(pool.parse(&streams[2], &frame) == Result::OK);
+    MU_ASSERT(pool.parse(&streams[2], &frame) == Result::NoResource);
+    MU_ASSERT(pool.getLentCount() == 3);
+    MU_ASSERT(pool.write(&streams[4], data, length) == length);
+    MU_ASSERT(pool.parse(&streams[4], &frame) == Result::OK);
+    MU_ASSERT(message_stream_pool_test_check(frame, 7));
+    MU_ASSERT(pool.parse(&streams[4], &frame) == Result::NoResource);
+    MU_ASSERT(pool.getLentCount() == 3);
+
+    // A ring holds a frame at most, the rest is left to the caller.
+    uint8_t large[MESSAGE_STREAM_POOL_TEST_BLOCK_SIZE + 8];
+    memset(large, 0xB5, sizeof(large));
+    MU_ASSERT(pool.write(&streams[5], large, sizeof(large)) == MESSAGE_STREAM_POOL_TEST_BLOCK_SIZE);
+
+    // Released as the stream closes, the next one starts from scratch.
+    pool.release(&streams[0]);
+    pool.release(&streams[1]);
+    pool.release(&streams[3]);
+    pool.release(&streams[5]);
+    MU_ASSERT(pool.getLentCount() == 0);
+    MU_ASSERT(pool.write(&streams[0], data, length) == length);
+    MU_ASSERT(pool.parse(&streams[0], &frame) == Result::OK);
+    MU_ASSERT(message_stream_pool_test_check(frame, 7));
+    MU_ASSERT(pool.parse(&streams[0], &frame) == Result::NoResource);
+    MU_ASSERT(pool.getLentCount() == 0);
+}
+
+/**
+ * @brief Streams fed in pieces of 1 to 13 bytes in turn, through the pool and through a
+ * MessageParser each, parse the same frames.
+ */
+static void message_stream_pool_interleave_test() {
+    static uint8_t storage[16 * MESSAGE_STREAM_POOL_TEST_BLOCK_SIZE];
+    static uint8_t parserRings[16][MESSAGE_STREAM_POOL_TEST_BLOCK_SIZE];
+    static uint8_t stream[16][2048];
+    uint32_t streamLengths[16];
+    uint32_t offsets[16];
+    uint8_t frameBuf[64];
+    uint8_t parserFrameBuf[64];
+    MessageFrame frame({.data = frameBuf, .size = sizeof(frameBuf)});
+    MessageFrame parserFrame({.data = parserFrameBuf, .size = sizeof(parserFrameBuf)});
+
+    static CompiledMessageSchema schema;
+    schema.compile(messageStreamPoolTestSchema);
+    static MessageStreamPool pool(schema, {.data = storage, .size = sizeof(storage)},
+                                  MESSAGE_STREAM_POOL_TEST_BLOCK_SIZE);
+    MessageStream streams[16];
+    uint32_t frames[16];
+    uint32_t parserFramesCount[16];
+    uint32_t bad = 0;
+
+    for (uint32_t s = 0; s < 16; s++) {
+        uint32_t length = 0;
+        uint8_t index = 0;
+        while (length + 16 <= sizeof(stream[s])) {
+            length += message_stream_pool_test_frame(stream[s] + length, index++);
+            if (index % 7 == s % 7) {
+                stream[s][length++] = 0x55;  // noise between frames.
+            }
+        }
+        streamLengths[s] = length;
+        offsets[s] = 0;
+        frames[s] = 0;
+        parserFramesCount[s] = 0;
+        pool.init(&streams[s]);
+    }
+
+    alignas(CircularBuffer8) uint8_t rbs[16][sizeof(CircularBuffer8)];
+    alignas(MessageParser) uint8_t parsers[16][sizeof(MessageParser)];
+    for (uint32_t s = 0; s < 16; s++) {
+        CircularBuffer8* rb =
+            new (rbs[s]) CircularBuffer8(parserRings[s], MESSAGE_STREAM_POOL_TEST_BLOCK_SIZE);
+        MessageParser* parser = new (parsers[s]) MessageParser(*rb);
+        parser->init(messageStreamPoolTestSchema);
+    }
+
+    uint32_t seed = 1;
+    for (uint32_t done = 0; done < 16;) {
+        done = 0;
+        for (uint32_t s = 0; s < 16; s++) {
+            seed = seed * 1103515245 + 12345;
+            uint32_t piece = 1 + (seed >> 16) % 13;
+            if (piece > streamLengths[s] - offsets[s]) piece = streamLengths[s] - offsets[s];
+            if (piece == 0) {
+                done++;
+                continue;
+            }
+            MU_ASSERT(pool.write(&streams[s], stream[s] + offsets[s], piece) == piece);
+            while (pool.parse(&streams[s], &frame) == Result::OK) {
+                bad += !message_stream_pool_test_check(frame, frames[s]);
+                frames[s]++;
+            }
+
+            CircularBuffer8* rb = (CircularBuffer8*)rbs[s];
+            MessageParser* parser = (MessageParser*)parsers[s];
+            rb->write(stream[s] + offsets[s], piece, false);
+            while (parser->parse(&parserFrame) == Result::OK) {
+                bad += !message_stream_pool_test_check(parserFrame, parserFramesCount[s]);
+                parserFramesCount[s]++;
+            }
+            offsets[s] += piece;
+        }
+    }
+    MU_ASSERT(bad == 0 && pool.exhaustedCount == 0 && pool.getLentCount() == 0);
+    for (uint32_t s = 0; s < 16; s++) {
+        MU_ASSERT(frames[s] == parserFramesCount[s] && frames[s] > 100);
+    }
+}
+
+void message_stream_pool_test() {
+    LOG_D("-----message_stream_pool_test start----------");
+    MU_ASSERT(sizeof(MessageStream) == 12);
+    message_stream_pool_lend_test();
+    message_stream_pool_interleave_test();
+    LOG_D("-----message_stream_pool_test finish----------");
+}
+
+}  // namespace wibot::comm::test
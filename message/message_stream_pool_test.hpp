@@ -0,0 +1,10 @@
+#ifndef __WWTALK_MESSAGE_STREAM_POOL_TEST_HPP__
+#define __WWTALK_MESSAGE_STREAM_POOL_TEST_HPP__
+
+#include "message_stream_pool.hpp"
+
+namespace wibot::comm::test {
+void message_stream_pool_test();
+}  // namespace wibot::comm::test
+
+#endif  // __WWTALK_MESSAGE_STREAM_POOL_TEST_HPP__